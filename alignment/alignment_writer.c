@@ -0,0 +1,371 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Buffered PAF/SAM writer (straight from the CIGAR)
+ */
+
+#include "alignment/alignment_writer.h"
+
+/*
+ * Setup
+ */
+alignment_writer_t* alignment_writer_new(
+    const alignment_format_t format,
+    FILE* const file) {
+  alignment_writer_t* const writer = malloc(sizeof(alignment_writer_t));
+  writer->format = format;
+  writer->file = file;
+  writer->buffer = NULL;
+  writer->used = 0;
+  writer->allocated = 0;
+  return writer;
+}
+void alignment_writer_delete(
+    alignment_writer_t* const writer) {
+  if (writer->file != NULL) alignment_writer_flush(writer);
+  free(writer->buffer);
+  free(writer);
+}
+/*
+ * Formatting (the space needed must be reserved beforehand)
+ */
+char* alignment_writer_reserve(
+    alignment_writer_t* const writer,
+    const uint64_t size) {
+  if (writer->used + size > writer->allocated) {
+    writer->allocated = MAX(writer->used+size,2*writer->allocated);
+    writer->buffer = realloc(writer->buffer,writer->allocated);
+    if (writer->buffer == NULL) {
+      fprintf(stderr,"[AlignmentWriter] Error allocating output buffer\n");
+      exit(1);
+    }
+  }
+  return writer->buffer + writer->used;
+}
+char* alignment_writer_put_uint(
+    char* output,
+    uint64_t value) {
+  char digits[20];
+  int num_digits = 0;
+  do {
+    digits[num_digits++] = '0' + (value % 10);
+    value /= 10;
+  } while (value > 0);
+  while (num_digits > 0) *(output++) = digits[--num_digits];
+  return output;
+}
+char* alignment_writer_put_int(
+    char* output,
+    const int64_t value) {
+  if (value >= 0) return alignment_writer_put_uint(output,value);
+  *(output++) = '-';
+  return alignment_writer_put_uint(output,-(uint64_t)value);
+}
+char* alignment_writer_put_string(
+    char* output,
+    const char* const string,
+    const uint64_t length) {
+  memcpy(output,string,length);
+  return output + length;
+}
+char* alignment_writer_put_name(
+    char* output,
+    const char* const name,
+    const uint32_t name_length,
+    const uint64_t pair_id) {
+  if (name != NULL) return alignment_writer_put_string(output,name,name_length);
+  return alignment_writer_put_uint(output,pair_id);
+}
+char* alignment_writer_put_lowercase(
+    char* output,
+    const char* const sequence,
+    const uint64_t length) {
+  uint64_t i;
+  for (i=0;i<length;++i) output[i] = tolower(sequence[i]);
+  return output + length;
+}
+/*
+ * CIGAR formats
+ */
+char alignment_writer_sam_operation(
+    const char operation) {
+  // Matches & mismatches merged; insertion/deletion swapped (pattern is the query)
+  switch (operation) {
+    case 'M': case 'X': return 'M';
+    case 'I': return 'D';
+    default:  return 'I';
+  }
+}
+char* alignment_writer_put_cigar(
+    char* output,
+    cigar_t* const cigar) {
+  const char* const operations = cigar->operations;
+  int i = cigar->begin_offset;
+  while (i < cigar->end_offset) {
+    const char operation = alignment_writer_sam_operation(operations[i]);
+    int run_end = i + 1;
+    while (run_end < cigar->end_offset &&
+           alignment_writer_sam_operation(operations[run_end]) == operation) ++run_end;
+    output = alignment_writer_put_uint(output,run_end-i);
+    *(output++) = operation;
+    i = run_end;
+  }
+  return output;
+}
+char* alignment_writer_put_cs(
+    char* output,
+    cigar_t* const cigar,
+    const char* const pattern,
+    const char* const text) {
+  // Short form (:matches, *target-query, +insertion, -deletion)
+  const char* const operations = cigar->operations;
+  int pattern_pos = 0, text_pos = 0;
+  int i = cigar->begin_offset;
+  while (i < cigar->end_offset) {
+    const char operation = operations[i];
+    int run_end = i + 1;
+    while (run_end < cigar->end_offset && operations[run_end] == operation) ++run_end;
+    const int run_length = run_end - i;
+    switch (operation) {
+      case 'M':
+        *(output++) = ':';
+        output = alignment_writer_put_uint(output,run_length);
+        pattern_pos += run_length;
+        text_pos += run_length;
+        break;
+      case 'X': {
+        int j;
+        for (j=0;j<run_length;++j) {
+          *(output++) = '*';
+          *(output++) = tolower(text[text_pos++]);
+          *(output++) = tolower(pattern[pattern_pos++]);
+        }
+        break;
+      }
+      case 'I': // Text-only (deletion from the query)
+        *(output++) = '-';
+        output = alignment_writer_put_lowercase(output,text+text_pos,run_length);
+        text_pos += run_length;
+        break;
+      default: // 'D' Pattern-only (insertion into the query)
+        *(output++) = '+';
+        output = alignment_writer_put_lowercase(output,pattern+pattern_pos,run_length);
+        pattern_pos += run_length;
+        break;
+    }
+    i = run_end;
+  }
+  return output;
+}
+char* alignment_writer_put_md(
+    char* output,
+    cigar_t* const cigar,
+    const char* const text) {
+  // Matches counted; mismatches & deletions spell the target
+  const char* const operations = cigar->operations;
+  uint64_t matches = 0;
+  int text_pos = 0, i;
+  char last_operation = 'M';
+  for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
+    switch (operations[i]) {
+      case 'M':
+        ++matches;
+        ++text_pos;
+        break;
+      case 'X':
+        output = alignment_writer_put_uint(output,matches);
+        *(output++) = toupper(text[text_pos++]);
+        matches = 0;
+        break;
+      case 'I':
+        if (last_operation != 'I') {
+          output = alignment_writer_put_uint(output,matches);
+          *(output++) = '^';
+          matches = 0;
+        }
+        *(output++) = toupper(text[text_pos++]);
+        break;
+      default: // 'D' (query-only; not in the MD)
+        break;
+    }
+    if (operations[i] != 'D') last_operation = operations[i];
+  }
+  return alignment_writer_put_uint(output,matches);
+}
+/*
+ * Records
+ */
+void alignment_writer_add_header(
+    alignment_writer_t* const writer) {
+  if (writer->format != alignment_format_sam) return;
+  static const char header[] = "@HD\tVN:1.6\tSO:unsorted\n";
+  char* const output = alignment_writer_reserve(writer,sizeof(header));
+  writer->used += alignment_writer_put_string(output,header,sizeof(header)-1) - output;
+}
+void alignment_writer_add_reference(
+    alignment_writer_t* const writer,
+    const alignment_record_t* const record) {
+  if (writer->format != alignment_format_sam) return;
+  char* const begin = alignment_writer_reserve(writer,64+record->target_name_length);
+  char* output = alignment_writer_put_string(begin,"@SQ\tSN:",7);
+  output = alignment_writer_put_name(output,
+      record->target_name,record->target_name_length,record->pair_id);
+  output = alignment_writer_put_string(output,"\tLN:",4);
+  output = alignment_writer_put_uint(output,record->target_length);
+  *(output++) = '\n';
+  writer->used += output - begin;
+}
+void alignment_writer_add(
+    alignment_writer_t* const writer,
+    const alignment_record_t* const record,
+    const char* const pattern,
+    const char* const text,
+    cigar_t* const cigar,
+    const int score) {
+  // Summarize alignment
+  const bool cigar_null = (cigar->begin_offset >= cigar->end_offset);
+  const int num_operations = cigar_null ? 0 : cigar->end_offset - cigar->begin_offset;
+  uint64_t matches = 0, edits = 0;
+  int i;
+  for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
+    if (cigar->operations[i] == 'M') ++matches; else ++edits;
+  }
+  // Reserve (upper bound)
+  const uint64_t query_aligned = record->query_end - record->query_begin;
+  char* const begin = alignment_writer_reserve(writer,
+      256 + record->query_name_length + record->target_name_length +
+      query_aligned + 40*(uint64_t)num_operations);
+  char* output = begin;
+  if (writer->format == alignment_format_paf) {
+    // Columns
+    output = alignment_writer_put_name(output,
+        record->query_name,record->query_name_length,record->pair_id);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,record->query_length);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,record->query_begin);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,record->query_end);
+    *(output++) = '\t'; *(output++) = record->reverse ? '-' : '+';
+    *(output++) = '\t';
+    output = alignment_writer_put_name(output,
+        record->target_name,record->target_name_length,record->pair_id);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,record->target_length);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,record->target_begin);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,record->target_end);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,matches);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,num_operations);
+    output = alignment_writer_put_string(output,"\t255",4);
+    // Tags
+    if (!cigar_null) {
+      output = alignment_writer_put_string(output,"\tNM:i:",6);
+      output = alignment_writer_put_uint(output,edits);
+    }
+    output = alignment_writer_put_string(output,"\tAS:i:",6);
+    output = alignment_writer_put_int(output,score);
+    if (!cigar_null) {
+      output = alignment_writer_put_string(output,"\tcg:Z:",6);
+      output = alignment_writer_put_cigar(output,cigar);
+      output = alignment_writer_put_string(output,"\tcs:Z:",6);
+      output = alignment_writer_put_cs(output,cigar,pattern,text);
+    }
+  } else {
+    // QNAME FLAG RNAME POS MAPQ
+    output = alignment_writer_put_name(output,
+        record->query_name,record->query_name_length,record->pair_id);
+    output = alignment_writer_put_string(output,"\t",1);
+    output = alignment_writer_put_uint(output,record->reverse ? 16 : 0);
+    *(output++) = '\t';
+    output = alignment_writer_put_name(output,
+        record->target_name,record->target_name_length,record->pair_id);
+    *(output++) = '\t'; output = alignment_writer_put_uint(output,record->target_begin+1);
+    output = alignment_writer_put_string(output,"\t255\t",5);
+    // CIGAR (unaligned query ends hard-clipped)
+    if (cigar_null) {
+      *(output++) = '*';
+    } else {
+      const uint64_t clip_left = record->reverse ?
+          record->query_length - record->query_end : record->query_begin;
+      const uint64_t clip_right = record->reverse ?
+          record->query_begin : record->query_length - record->query_end;
+      if (clip_left > 0) {
+        output = alignment_writer_put_uint(output,clip_left);
+        *(output++) = 'H';
+      }
+      output = alignment_writer_put_cigar(output,cigar);
+      if (clip_right > 0) {
+        output = alignment_writer_put_uint(output,clip_right);
+        *(output++) = 'H';
+      }
+    }
+    // RNEXT PNEXT TLEN SEQ QUAL
+    output = alignment_writer_put_string(output,"\t*\t0\t0\t",7);
+    if (query_aligned > 0) {
+      output = alignment_writer_put_string(output,pattern,query_aligned);
+    } else {
+      *(output++) = '*';
+    }
+    output = alignment_writer_put_string(output,"\t*",2);
+    // Tags
+    if (!cigar_null) {
+      output = alignment_writer_put_string(output,"\tNM:i:",6);
+      output = alignment_writer_put_uint(output,edits);
+    }
+    output = alignment_writer_put_string(output,"\tAS:i:",6);
+    output = alignment_writer_put_int(output,score);
+    if (!cigar_null) {
+      output = alignment_writer_put_string(output,"\tMD:Z:",6);
+      output = alignment_writer_put_md(output,cigar,text);
+    }
+  }
+  *(output++) = '\n';
+  writer->used += output - begin;
+  // Flush
+  if (writer->file != NULL && writer->used >= ALIGNMENT_WRITER_FLUSH_SIZE) {
+    alignment_writer_flush(writer);
+  }
+}
+/*
+ * Output
+ */
+void alignment_writer_flush(
+    alignment_writer_t* const writer) {
+  if (writer->used > 0 && fwrite(writer->buffer,1,writer->used,writer->file) != writer->used) {
+    fprintf(stderr,"[AlignmentWriter] Error writing output\n");
+    exit(1);
+  }
+  writer->used = 0;
+}
+void alignment_writer_detach(
+    alignment_writer_t* const writer,
+    char** const buffer,
+    size_t* const size) {
+  // Hand over the buffer (a new one is allocated on demand)
+  *buffer = writer->buffer;
+  *size = writer->used;
+  writer->buffer = NULL;
+  writer->used = 0;
+  writer->allocated = 0;
+}
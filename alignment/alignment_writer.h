@@ -0,0 +1,122 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Buffered PAF/SAM writer (straight from the CIGAR)
+ *   Records are formatted into a growable buffer (no intermediate strings):
+ *     PAF => 12 columns + NM:i, AS:i, cg:Z and cs:Z (short form)
+ *     SAM => 11 columns + NM:i, AS:i and MD:Z
+ *   The pattern is the query and the text the target. Hence, CIGAR
+ *   insertions ('I'; text-only) become deletions in PAF/SAM, and vice versa.
+ *   The buffer is either flushed to a file when full, or detached so that
+ *   several writers (e.g. one per thread) can be output in order.
+ */
+
+#ifndef ALIGNMENT_WRITER_H_
+#define ALIGNMENT_WRITER_H_
+
+#include "utils/commons.h"
+#include "alignment/cigar.h"
+
+/*
+ * Constants
+ */
+#define ALIGNMENT_WRITER_FLUSH_SIZE BUFFER_SIZE_1M
+
+/*
+ * Record (columns other than the alignment itself)
+ */
+typedef struct {
+  uint64_t pair_id;               // Name used if a name is missing
+  // Query (pattern)
+  const char* query_name;         // Name (not NULL-terminated; NULL to use the pair_id)
+  uint32_t query_name_length;
+  uint64_t query_length;          // Full length
+  uint64_t query_begin;           // Aligned range (end excluded)
+  uint64_t query_end;
+  bool reverse;                   // Query aligned reverse-complemented
+  // Target (text)
+  const char* target_name;        // Name (not NULL-terminated; NULL to use the pair_id)
+  uint32_t target_name_length;
+  uint64_t target_length;         // Full length
+  uint64_t target_begin;          // Aligned range (end excluded)
+  uint64_t target_end;
+} alignment_record_t;
+
+/*
+ * Writer
+ */
+typedef enum {
+  alignment_format_paf = 0,
+  alignment_format_sam = 1,
+} alignment_format_t;
+typedef struct {
+  // Format
+  alignment_format_t format;      // Output format
+  FILE* file;                     // Flushed here when full (NULL if detached by the caller)
+  // Buffer
+  char* buffer;                   // Formatted records
+  uint64_t used;                  // Used
+  uint64_t allocated;             // Allocated
+} alignment_writer_t;
+
+/*
+ * Setup
+ */
+alignment_writer_t* alignment_writer_new(
+    const alignment_format_t format,
+    FILE* const file);
+void alignment_writer_delete(
+    alignment_writer_t* const writer);
+
+/*
+ * Records
+ */
+void alignment_writer_add_header(
+    alignment_writer_t* const writer);
+void alignment_writer_add_reference(
+    alignment_writer_t* const writer,
+    const alignment_record_t* const record);
+void alignment_writer_add(
+    alignment_writer_t* const writer,
+    const alignment_record_t* const record,
+    const char* const pattern,
+    const char* const text,
+    cigar_t* const cigar,
+    const int score);
+
+/*
+ * Output
+ */
+void alignment_writer_flush(
+    alignment_writer_t* const writer);
+void alignment_writer_detach(
+    alignment_writer_t* const writer,
+    char** const buffer,
+    size_t* const size);
+
+#endif /* ALIGNMENT_WRITER_H_ */
@@ -35,7 +35,7 @@
  * Setup
  */
 cigar_t* cigar_new(
-    const int max_operations,
+    const wf_coord_t max_operations,
     mm_allocator_t* const mm_allocator) {
   // Allocate
   cigar_t* const cigar = mm_allocator_alloc(mm_allocator,cigar_t);
@@ -58,7 +58,7 @@ void cigar_clear(
 }
 void cigar_resize(
     cigar_t* const cigar,
-    const int max_operations) {
+    const wf_coord_t max_operations) {
   // Check maximum operations
   if (max_operations > cigar->max_operations) {
     cigar->max_operations = max_operations;
@@ -80,7 +80,8 @@ void cigar_free(
  */
 int cigar_get_matches(
     cigar_t* const cigar) {
-  int i, num_matches=0;
+  wf_coord_t i;
+  int num_matches=0;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     num_matches += (cigar->operations[i]=='M');
   }
@@ -88,12 +89,12 @@ int cigar_get_matches(
 }
 void cigar_add_mismatches(
     char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     cigar_t* const cigar) {
   // Refine adding mismatches
-  int i, p=0, t=0;
+  wf_coord_t i, p=0, t=0;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     // Check limits
     if (p >= pattern_length || t >= text_length) break;
@@ -128,7 +129,8 @@ void cigar_add_mismatches(
  */
 int cigar_score_edit(
     cigar_t* const cigar) {
-  int score = 0, i;
+  int score = 0;
+  wf_coord_t i;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     switch (cigar->operations[i]) {
       case 'M': break;
@@ -143,7 +145,8 @@ int cigar_score_edit(
 int cigar_score_gap_linear(
     cigar_t* const cigar,
     linear_penalties_t* const penalties) {
-  int score = 0, i;
+  int score = 0;
+  wf_coord_t i;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     switch (cigar->operations[i]) {
       case 'M': score -= penalties->match; break;
@@ -159,7 +162,8 @@ int cigar_score_gap_affine(
     cigar_t* const cigar,
     affine_penalties_t* const penalties) {
   char last_op = '\0';
-  int score = 0, i;
+  int score = 0;
+  wf_coord_t i;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     switch (cigar->operations[i]) {
       case 'M':
@@ -207,7 +211,7 @@ int cigar_score_gap_affine2p(
     affine2p_penalties_t* const penalties) {
   char last_op = '\0';
   int score = 0, op_length = 0;
-  int i;
+  wf_coord_t i;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     // Account for operation
     if (cigar->operations[i] != last_op && last_op != '\0') {
@@ -229,13 +233,13 @@ int cigar_cmp(
     cigar_t* const cigar_a,
     cigar_t* const cigar_b) {
   // Compare lengths
-  const int length_cigar_a = cigar_a->end_offset - cigar_a->begin_offset;
-  const int length_cigar_b = cigar_b->end_offset - cigar_b->begin_offset;
-  if (length_cigar_a != length_cigar_b) return length_cigar_a - length_cigar_b;
+  const wf_coord_t length_cigar_a = cigar_a->end_offset - cigar_a->begin_offset;
+  const wf_coord_t length_cigar_b = cigar_b->end_offset - cigar_b->begin_offset;
+  if (length_cigar_a != length_cigar_b) return (length_cigar_a < length_cigar_b) ? -1 : 1;
   // Compare operations
   char* const operations_a = cigar_a->operations + cigar_a->begin_offset;
   char* const operations_b = cigar_b->operations + cigar_b->begin_offset;
-  int i;
+  wf_coord_t i;
   for (i=0;i<length_cigar_a;++i) {
     if (operations_a[i] != operations_b[i]) {
       return operations_a[i] - operations_b[i];
@@ -259,7 +263,7 @@ void cigar_append(
     cigar_t* const cigar_dst,
     cigar_t* const cigar_src) {
   // Append
-  const int cigar_length = cigar_src->end_offset - cigar_src->begin_offset;
+  const wf_coord_t cigar_length = cigar_src->end_offset - cigar_src->begin_offset;
   char* const operations_src = cigar_src->operations + cigar_src->begin_offset;
   char* const operations_dst = cigar_dst->operations + cigar_dst->end_offset;
   memcpy(operations_dst,operations_src,cigar_length);
@@ -268,10 +272,10 @@ void cigar_append(
 }
 void cigar_append_deletion(
     cigar_t* const cigar,
-    const int length) {
+    const wf_coord_t length) {
   // Append deletions
   char* const operations = cigar->operations + cigar->end_offset;
-  int i;
+  wf_coord_t i;
   for (i=0;i<length;++i) {
     operations[i] = 'D';
   }
@@ -280,10 +284,10 @@ void cigar_append_deletion(
 }
 void cigar_append_insertion(
     cigar_t* const cigar,
-    const int length) {
+    const wf_coord_t length) {
   // Append insertions
   char* const operations = cigar->operations + cigar->end_offset;
-  int i;
+  wf_coord_t i;
   for (i=0;i<length;++i) {
     operations[i] = 'I';
   }
@@ -293,15 +297,15 @@ void cigar_append_insertion(
 bool cigar_check_alignment(
     FILE* const stream,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     cigar_t* const cigar,
     const bool verbose) {
   // Parameters
   char* const operations = cigar->operations;
   // Traverse CIGAR
-  int pattern_pos=0, text_pos=0, i;
+  wf_coord_t pattern_pos=0, text_pos=0, i;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     switch (operations[i]) {
       case 'M':
@@ -309,7 +313,7 @@ bool cigar_check_alignment(
         if (pattern[pattern_pos] != text[text_pos]) {
           if (verbose) {
             fprintf(stream,
-                "[AlignCheck] Alignment not matching (pattern[%d]=%c != text[%d]=%c)\n",
+                "[AlignCheck] Alignment not matching (pattern[%"PRIcoord"]=%c != text[%"PRIcoord"]=%c)\n",
                 pattern_pos,pattern[pattern_pos],text_pos,text[text_pos]);
           }
           return false;
@@ -322,7 +326,7 @@ bool cigar_check_alignment(
         if (pattern[pattern_pos] == text[text_pos]) {
           if (verbose) {
             fprintf(stream,
-                "[AlignCheck] Alignment not mismatching (pattern[%d]=%c == text[%d]=%c)\n",
+                "[AlignCheck] Alignment not mismatching (pattern[%"PRIcoord"]=%c == text[%"PRIcoord"]=%c)\n",
                 pattern_pos,pattern[pattern_pos],text_pos,text[text_pos]);
           }
           return false;
@@ -346,7 +350,7 @@ bool cigar_check_alignment(
   if (pattern_pos != pattern_length) {
     if (verbose) {
       fprintf(stream,
-          "[AlignCheck] Alignment incorrect length (pattern-aligned=%d,pattern-length=%d)\n",
+          "[AlignCheck] Alignment incorrect length (pattern-aligned=%"PRIcoord",pattern-length=%"PRIcoord")\n",
           pattern_pos,pattern_length);
     }
     return false;
@@ -354,7 +358,7 @@ bool cigar_check_alignment(
   if (text_pos != text_length) {
     if (verbose) {
       fprintf(stream,
-          "[AlignCheck] Alignment incorrect length (text-aligned=%d,text-length=%d)\n",
+          "[AlignCheck] Alignment incorrect length (text-aligned=%"PRIcoord",text-length=%"PRIcoord")\n",
           text_pos,text_length);
     }
     return false;
@@ -373,21 +377,21 @@ void cigar_print(
   if (cigar->begin_offset >= cigar->end_offset) return;
   // Print operations
   char last_op = cigar->operations[cigar->begin_offset];
-  int last_op_length = 1;
-  int i;
+  wf_coord_t last_op_length = 1;
+  wf_coord_t i;
   for (i=cigar->begin_offset+1;i<cigar->end_offset;++i) {
     if (cigar->operations[i]==last_op) {
       ++last_op_length;
     } else {
       if (print_matches || last_op != 'M') {
-        fprintf(stream,"%d%c",last_op_length,last_op);
+        fprintf(stream,"%"PRIcoord"%c",last_op_length,last_op);
       }
       last_op = cigar->operations[i];
       last_op_length = 1;
     }
   }
   if (print_matches || last_op != 'M') {
-    fprintf(stream,"%d%c",last_op_length,last_op);
+    fprintf(stream,"%"PRIcoord"%c",last_op_length,last_op);
   }
 }
 int cigar_sprint(
@@ -403,21 +407,21 @@ int cigar_sprint(
   }
   // Print operations
   char last_op = cigar->operations[cigar->begin_offset];
-  int last_op_length = 1;
-  int i;
+  wf_coord_t last_op_length = 1;
+  wf_coord_t i;
   for (i=cigar->begin_offset+1;i<cigar->end_offset;++i) {
     if (cigar->operations[i]==last_op) {
       ++last_op_length;
     } else {
       if (print_matches || last_op != 'M') {
-        pos += sprintf(buffer+pos,"%d%c",last_op_length,last_op);
+        pos += sprintf(buffer+pos,"%"PRIcoord"%c",last_op_length,last_op);
       }
       last_op = cigar->operations[i];
       last_op_length = 1;
     }
   }
   if (print_matches || last_op != 'M') {
-    pos += sprintf(buffer+pos,"%d%c",last_op_length,last_op);
+    pos += sprintf(buffer+pos,"%"PRIcoord"%c",last_op_length,last_op);
   }
   // Return
   buffer[pos] = '\0';
@@ -426,20 +430,20 @@ int cigar_sprint(
 void cigar_print_pretty(
     FILE* const stream,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     cigar_t* const cigar,
     mm_allocator_t* const mm_allocator) {
   // Parameters
   char* const operations = cigar->operations;
   // Allocate alignment buffers
-  const int max_buffer_length = text_length+pattern_length+1;
+  const wf_coord_t max_buffer_length = text_length+pattern_length+1;
   char* const pattern_alg = mm_allocator_calloc(mm_allocator,max_buffer_length,char,true);
   char* const ops_alg = mm_allocator_calloc(mm_allocator,max_buffer_length,char,true);
   char* const text_alg = mm_allocator_calloc(mm_allocator,max_buffer_length,char,true);
   // Compute alignment buffers
-  int i, alg_pos = 0, pattern_pos = 0, text_pos = 0;
+  wf_coord_t i, alg_pos = 0, pattern_pos = 0, text_pos = 0;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     switch (operations[i]) {
       case 'M':
@@ -44,9 +44,9 @@
 typedef struct {
   // Operations buffer
   char* operations;
-  int max_operations;
-  int begin_offset;
-  int end_offset;
+  wf_coord_t max_operations;
+  wf_coord_t begin_offset;
+  wf_coord_t end_offset;
   // Score
   int score;
   // MM
@@ -57,13 +57,13 @@ typedef struct {
  * Setup
  */
 cigar_t* cigar_new(
-    const int max_operations,
+    const wf_coord_t max_operations,
     mm_allocator_t* const mm_allocator);
 void cigar_clear(
     cigar_t* const cigar);
 void cigar_resize(
     cigar_t* const cigar,
-    const int max_operations);
+    const wf_coord_t max_operations);
 void cigar_free(
     cigar_t* const cigar);
 
@@ -74,9 +74,9 @@ int cigar_get_matches(
     cigar_t* const cigar);
 void cigar_add_mismatches(
     char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     cigar_t* const cigar);
 
 /*
@@ -109,17 +109,17 @@ void cigar_append(
     cigar_t* const cigar_src);
 void cigar_append_deletion(
     cigar_t* const cigar,
-    const int length);
+    const wf_coord_t length);
 void cigar_append_insertion(
     cigar_t* const cigar,
-    const int length);
+    const wf_coord_t length);
 
 bool cigar_check_alignment(
     FILE* const stream,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     cigar_t* const cigar,
     const bool verbose);
 
@@ -137,9 +137,9 @@ int cigar_sprint(
 void cigar_print_pretty(
     FILE* const stream,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     cigar_t* const cigar,
     mm_allocator_t* const mm_allocator);
 
@@ -52,6 +52,7 @@ WFAligner::WFAligner(
     case MemoryMed: this->attributes.memory_mode = wavefront_memory_med; break;
     case MemoryLow: this->attributes.memory_mode = wavefront_memory_low; break;
     case MemoryUltralow: this->attributes.memory_mode = wavefront_memory_ultralow; break;
+    case MemoryCheckpoint: this->attributes.memory_mode = wavefront_memory_checkpoint; break;
     default: this->attributes.memory_mode = wavefront_memory_high; break;
   }
   this->attributes.alignment_scope = (alignmentScope==Score) ? compute_score : compute_alignment;
@@ -149,14 +150,14 @@ void WFAligner::setHeuristicNone() {
   wavefront_aligner_set_heuristic_none(wfAligner);
 }
 void WFAligner::setHeuristicBandedStatic(
-    const int band_min_k,
-    const int band_max_k) {
+    const wf_coord_t band_min_k,
+    const wf_coord_t band_max_k) {
   wavefront_aligner_set_heuristic_banded_static(
       wfAligner,band_min_k,band_max_k);
 }
 void WFAligner::setHeuristicBandedAdaptive(
-    const int band_min_k,
-    const int band_max_k,
+    const wf_coord_t band_min_k,
+    const wf_coord_t band_max_k,
     const int steps_between_cutoffs) {
   wavefront_aligner_set_heuristic_banded_adaptive(
       wfAligner,band_min_k,band_max_k,steps_between_cutoffs);
@@ -193,7 +194,7 @@ void WFAligner::setHeuristicZDrop(
  * Custom extend-match function (lambda)
  */
 void WFAligner::setMatchFunct(
-    int (*matchFunct)(int,int,void*),
+    int (*matchFunct)(wf_coord_t,wf_coord_t,void*),
     void* matchFunctArguments) {
   wavefront_aligner_set_match_funct(wfAligner,matchFunct,matchFunctArguments);
 }
@@ -210,6 +211,15 @@ void WFAligner::setMaxMemory(
     const uint64_t maxMemoryAbort) {
   wavefront_aligner_set_max_memory(wfAligner,maxMemoryResident,maxMemoryAbort);
 }
+void WFAligner::setMemoryGovernor(
+    mm_governor_t* const memoryGovernor) {
+  wavefront_aligner_set_governor(wfAligner,memoryGovernor);
+}
+void WFAligner::preallocate(
+    const wf_coord_t maxPatternLength,
+    const wf_coord_t maxTextLength) {
+  wavefront_aligner_preallocate(wfAligner,maxPatternLength,maxTextLength);
+}
 // Parallelization
 void WFAligner::setMaxNumThreads(
         const int maxNumThreads) {
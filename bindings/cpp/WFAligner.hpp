@@ -54,6 +54,7 @@ public:
     MemoryMed,
     MemoryLow,
     MemoryUltralow,
+    MemoryCheckpoint,
   };
   enum AlignmentScope {
     Score,
@@ -106,11 +107,11 @@ public:
   // Heuristics
   void setHeuristicNone();
   void setHeuristicBandedStatic(
-      const int band_min_k,
-      const int band_max_k);
+      const wf_coord_t band_min_k,
+      const wf_coord_t band_max_k);
   void setHeuristicBandedAdaptive(
-      const int band_min_k,
-      const int band_max_k,
+      const wf_coord_t band_min_k,
+      const wf_coord_t band_max_k,
       const int steps_between_cutoffs = 1);
   void setHeuristicWFadaptive(
       const int min_wavefront_length,
@@ -128,7 +129,7 @@ public:
       const int steps_between_cutoffs = 1);
   // Custom extend-match function (lambda)
   void setMatchFunct(
-      int (*matchFunct)(int,int,void*),
+      int (*matchFunct)(wf_coord_t,wf_coord_t,void*),
       void* matchFunctArguments);
   // Limits
   void setMaxAlignmentScore(
@@ -136,6 +137,11 @@ public:
   void setMaxMemory(
       const uint64_t maxMemoryResident,
       const uint64_t maxMemoryAbort);
+  void setMemoryGovernor(
+      mm_governor_t* const memoryGovernor);
+  void preallocate(
+      const wf_coord_t maxPatternLength,
+      const wf_coord_t maxTextLength);
   // Parallelization
   void setMaxNumThreads(
       const int maxNumThreads);
@@ -0,0 +1,114 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: WFA Sample-Code (memory governor with paused alignments)
+ */
+
+#include "wavefront/wavefront_align.h"
+
+/*
+ * Random sequences (deterministic)
+ */
+uint64_t rand_state = 1;
+int rand_next(const int max) {
+  rand_state = rand_state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (int)((rand_state >> 33) % max);
+}
+void generate_pair(
+    char* const pattern,
+    char* const text,
+    const int length) {
+  const char alphabet[] = "ACGT";
+  int i, j = 0;
+  for (i=0;i<length;++i) pattern[i] = alphabet[rand_next(4)];
+  pattern[length] = '\0';
+  for (i=0;i<length;++i) {
+    const int op = rand_next(100);
+    if (op < 4) text[j++] = alphabet[rand_next(4)]; // Mismatch
+    else if (op < 6) continue;                      // Deletion
+    else if (op < 8) { text[j++] = alphabet[rand_next(4)]; text[j++] = pattern[i]; } // Insertion
+    else text[j++] = pattern[i];                    // Match
+  }
+  text[j] = '\0';
+}
+
+int main(int argc,char* argv[]) {
+  // Pattern & Text
+  char pattern[2001], text[4001];
+  generate_pair(pattern,text,2000);
+  const int pattern_length = strlen(pattern);
+  const int text_length = strlen(text);
+  // Configure alignment attributes (resumable alignments)
+  wavefront_aligner_attr_t attributes = wavefront_aligner_attr_default;
+  attributes.distance_metric = gap_affine;
+  attributes.affine_penalties.match = 0;
+  attributes.affine_penalties.mismatch = 4;
+  attributes.affine_penalties.gap_opening = 6;
+  attributes.affine_penalties.gap_extension = 2;
+  attributes.memory_mode = wavefront_memory_high;
+  // Reference alignment (no governor)
+  wavefront_aligner_t* const wf_reference = wavefront_aligner_new(&attributes);
+  wavefront_align(wf_reference,pattern,pattern_length,text,text_length);
+  const int reference_score = wf_reference->cigar->score;
+  wavefront_aligner_delete(wf_reference);
+  // Two aligners sharing a governor (always under memory pressure)
+  mm_governor_t* const mm_governor = mm_governor_new(1,mm_governor_wait);
+  attributes.system.max_alignment_score = 200;
+  wavefront_aligner_t* const wf_aligner_a = wavefront_aligner_new(&attributes);
+  attributes.system.max_alignment_score = INT_MAX;
+  wavefront_aligner_t* const wf_aligner_b = wavefront_aligner_new(&attributes);
+  wavefront_aligner_set_governor(wf_aligner_a,mm_governor);
+  wavefront_aligner_set_governor(wf_aligner_b,mm_governor);
+  // Pause A (max-score reached)
+  int status = wavefront_align(wf_aligner_a,pattern,pattern_length,text,text_length);
+  if (status != WF_STATUS_MAX_SCORE_REACHED) {
+    fprintf(stderr,"[WFA::Governor] Alignment A was not paused (status=%d)\n",status);
+    exit(1);
+  }
+  // Align B (the governor must not reap the paused aligner A)
+  wavefront_align(wf_aligner_b,pattern,pattern_length,text,text_length);
+  const int score_b = wf_aligner_b->cigar->score;
+  // Resume A
+  wavefront_aligner_set_max_alignment_score(wf_aligner_a,INT_MAX);
+  status = wavefront_align_resume(wf_aligner_a);
+  const int score_a = wf_aligner_a->cigar->score;
+  // Report
+  fprintf(stderr,"[WFA::Governor] Score reference=%d resumed=%d concurrent=%d (status=%d)\n",
+      reference_score,score_a,score_b,status);
+  mm_governor_print(stderr,mm_governor);
+  // Free
+  wavefront_aligner_delete(wf_aligner_a);
+  wavefront_aligner_delete(wf_aligner_b);
+  mm_governor_delete(mm_governor);
+  // Check
+  if (status != WF_STATUS_SUCCESSFUL || score_a != reference_score || score_b != reference_score) {
+    fprintf(stderr,"[WFA::Governor] Scores differ\n");
+    exit(1);
+  }
+  return 0;
+}
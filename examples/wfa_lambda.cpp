@@ -44,8 +44,8 @@ const int patternLength = sizeof(pattern)/sizeof(int);
 const int textLength = sizeof(text)/sizeof(int);
 
 int match_function(
-    int v,
-    int h,
+    wf_coord_t v,
+    wf_coord_t h,
     void* arguments) {
   // Check boundaries
   if (v > patternLength || h > textLength) return 0;
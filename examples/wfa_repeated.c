@@ -44,6 +44,8 @@ int main(int argc,char* argv[]) {
   attributes.affine_penalties.gap_extension = 2;
   // Initialize Wavefront Aligner
   wavefront_aligner_t* const wf_aligner = wavefront_aligner_new(&attributes);
+  // Preallocate for the longest sequences (no allocations once warmed up)
+  wavefront_aligner_preallocate(wf_aligner,strlen(pattern),strlen(text));
   // Repeat alignment (for the sake of it)
   int i;
   for (i=0;i<100000;++i) {
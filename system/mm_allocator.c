@@ -56,6 +56,25 @@
 #define MM_ALLOCATOR_REQUEST_SET_FREE(request) ((request)->size |= MM_ALLOCATOR_FREED_FLAG)
 #define MM_ALLOCATOR_REQUEST_SIZE(request)     ((request)->size & ~(MM_ALLOCATOR_FREED_FLAG))
 
+/*
+ * Arena references (memory released all at once on clear)
+ */
+#define MM_ALLOCATOR_ARENA_SEGMENT_IDX          (UINT32_MAX-1)
+
+/*
+ * Pages length (mmap-ed memory is rounded up to whole huge-pages)
+ */
+#define MM_ALLOCATOR_PAGES_LENGTH(num_bytes) \
+  (DIV_CEIL((num_bytes),MM_ALLOCATOR_HUGE_PAGE_SIZE)*MM_ALLOCATOR_HUGE_PAGE_SIZE)
+
+/*
+ * Governor accounting
+ */
+#define MM_ALLOCATOR_GOVERNOR_ADD(mm_allocator,num_bytes) \
+  if ((mm_allocator)->mm_governor != NULL) mm_governor_add((mm_allocator)->mm_governor,num_bytes)
+#define MM_ALLOCATOR_GOVERNOR_SUB(mm_allocator,num_bytes) \
+  if ((mm_allocator)->mm_governor != NULL) mm_governor_sub((mm_allocator)->mm_governor,num_bytes)
+
 /*
  * Reference (Header of every memory allocated)
  */
@@ -81,6 +100,7 @@ typedef struct {
   // Request
   void* mem;
   uint64_t size;
+  mm_pages_t pages;             // Pages backing the request
   // Log
 #ifdef MM_ALLOCATOR_LOG
   uint64_t timestamp;
@@ -99,11 +119,57 @@ typedef struct {
   // Memory
   uint64_t size;                // Total memory available
   void* memory;                 // Memory
+  mm_pages_t pages;             // Pages backing the memory
   uint64_t used;                // Bytes used (offset to memory next free byte)
   // Requests
   vector_t* requests;           // Memory requests (mm_allocator_request_t)
 } mm_allocator_segment_t;
 
+/*
+ * Memory pages
+ */
+void* mm_allocator_pages_allocate(
+    const mm_pages_t pages,
+    const uint64_t num_bytes,
+    mm_pages_t* const pages_used) {
+  // Small requests are not worth a huge-page
+  if (pages != mm_pages_malloc && num_bytes >= MM_ALLOCATOR_HUGE_PAGE_SIZE) {
+    const uint64_t mmap_bytes = MM_ALLOCATOR_PAGES_LENGTH(num_bytes);
+    void* memory;
+#ifdef MAP_HUGETLB
+    // Explicit huge-pages (requires pages reserved by the system)
+    if (pages == mm_pages_huge_explicit) {
+      memory = mmap(NULL,mmap_bytes,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB,-1,0);
+      if (memory != MAP_FAILED) {
+        *pages_used = mm_pages_huge_explicit;
+        return memory;
+      }
+    }
+#endif
+    // Transparent huge-pages
+    memory = mmap(NULL,mmap_bytes,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+    if (memory != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+      madvise(memory,mmap_bytes,MADV_HUGEPAGE); // Best effort (THP might be disabled)
+#endif
+      *pages_used = mm_pages_huge;
+      return memory;
+    }
+  }
+  // Fallback to malloc
+  *pages_used = mm_pages_malloc;
+  return malloc(num_bytes);
+}
+void mm_allocator_pages_free(
+    void* const memory,
+    const uint64_t num_bytes,
+    const mm_pages_t pages) {
+  if (pages == mm_pages_malloc) {
+    free(memory);
+  } else {
+    munmap(memory,MM_ALLOCATOR_PAGES_LENGTH(num_bytes));
+  }
+}
 /*
  * Segments
  */
@@ -116,12 +182,15 @@ mm_allocator_segment_t* mm_allocator_segment_new(
   segment->idx = segment_idx;
   // Memory
   segment->size = mm_allocator->segment_size;
-  segment->memory = malloc(mm_allocator->segment_size);
+  segment->memory = mm_allocator_pages_allocate(
+      mm_allocator->pages,mm_allocator->segment_size,&segment->pages);
   segment->used = 0;
   // Requests
   segment->requests = vector_new(MM_ALLOCATOR_SEGMENT_INITIAL_REQUESTS,mm_allocator_request_t);
   // Add to segments
   vector_insert(mm_allocator->segments,segment,mm_allocator_segment_t*);
+  MM_ALLOCATOR_GOVERNOR_ADD(mm_allocator,segment->size);
+  ++(mm_allocator->num_allocations);
   // Return
   return segment;
 }
@@ -133,7 +202,7 @@ void mm_allocator_segment_clear(
 void mm_allocator_segment_delete(
     mm_allocator_segment_t* const segment) {
   vector_delete(segment->requests);
-  free(segment->memory);
+  mm_allocator_pages_free(segment->memory,segment->size,segment->pages);
   free(segment);
 }
 mm_allocator_request_t* mm_allocator_segment_get_request(
@@ -150,9 +219,18 @@ uint64_t mm_allocator_segment_get_num_requests(
  */
 mm_allocator_t* mm_allocator_new(
     const uint64_t segment_size) {
+  return mm_allocator_new_pages(segment_size,mm_pages_malloc);
+}
+mm_allocator_t* mm_allocator_new_pages(
+    const uint64_t segment_size,
+    const mm_pages_t pages) {
   // Allocate handler
   mm_allocator_t* const mm_allocator = (mm_allocator_t*) malloc(sizeof(mm_allocator_t));
   mm_allocator->request_ticker = 0;
+  mm_allocator->pages = pages;
+  mm_allocator->arena = false;
+  mm_allocator->mm_governor = NULL;
+  mm_allocator->num_allocations = 0;
   // Segments
   mm_allocator->segment_size = segment_size;
   mm_allocator->segments = vector_new(MM_ALLOCATOR_INITIAL_SEGMENTS,mm_allocator_segment_t*);
@@ -170,8 +248,63 @@ mm_allocator_t* mm_allocator_new(
   // Return
   return mm_allocator;
 }
+mm_allocator_t* mm_allocator_new_arena(
+    const uint64_t segment_size) {
+  mm_allocator_t* const mm_allocator = mm_allocator_new_pages(segment_size,mm_pages_malloc);
+  mm_allocator->arena = true;
+  return mm_allocator;
+}
+void mm_allocator_grow_arena(
+    mm_allocator_t* const mm_allocator,
+    const uint64_t num_bytes) {
+  // Replace the first segment (requests up to half a segment are served from it)
+  mm_allocator_segment_t* const segment =
+      *(vector_get_elm(mm_allocator->segments,0,mm_allocator_segment_t*));
+  const uint64_t segment_size = 2*num_bytes;
+  if (segment->size >= segment_size) return;
+  MM_ALLOCATOR_GOVERNOR_SUB(mm_allocator,segment->size);
+  mm_allocator_pages_free(segment->memory,segment->size,segment->pages);
+  segment->size = segment_size;
+  segment->memory = mm_allocator_pages_allocate(mm_allocator->pages,segment_size,&segment->pages);
+  segment->used = 0;
+  MM_ALLOCATOR_GOVERNOR_ADD(mm_allocator,segment_size);
+  ++(mm_allocator->num_allocations);
+}
+void mm_allocator_clear_arena(
+    mm_allocator_t* const mm_allocator) {
+  // Account for the memory served since the last clear
+  uint64_t num_bytes_used = 0, i;
+  for (i=0;i<=mm_allocator->current_segment_idx;++i) {
+    num_bytes_used += (*(vector_get_elm(mm_allocator->segments,i,mm_allocator_segment_t*)))->used;
+  }
+  const bool arena_overflow =
+      (mm_allocator->current_segment_idx > 0) ||
+      (vector_get_used(mm_allocator->malloc_requests) > 0);
+  // Reset to the first segment (the rest are reset as they are reused)
+  mm_allocator_segment_t* const segment =
+      *(vector_get_elm(mm_allocator->segments,0,mm_allocator_segment_t*));
+  segment->used = 0;
+  mm_allocator->current_segment_idx = 0;
+  // Free malloc memory (large requests)
+  VECTOR_ITERATE(mm_allocator->malloc_requests,malloc_request,m,mm_malloc_request_t) {
+    if (malloc_request->size > 0) {
+      num_bytes_used += malloc_request->size;
+      mm_allocator_pages_free(malloc_request->mem,malloc_request->size,malloc_request->pages);
+      MM_ALLOCATOR_GOVERNOR_SUB(mm_allocator,malloc_request->size);
+    }
+  }
+  vector_clear(mm_allocator->malloc_requests);
+  mm_allocator->malloc_requests_freed = 0;
+  // Grow the first segment to serve the whole cycle next time (steady state without allocations)
+  if (arena_overflow) mm_allocator_grow_arena(mm_allocator,num_bytes_used);
+}
 void mm_allocator_clear(
     mm_allocator_t* const mm_allocator) {
+  // Arena mode
+  if (mm_allocator->arena) {
+    mm_allocator_clear_arena(mm_allocator);
+    return;
+  }
   // Clear segments
   vector_clear(mm_allocator->segments_free);
   VECTOR_ITERATE(mm_allocator->segments,segment_ptr,p,mm_allocator_segment_t*) {
@@ -181,13 +314,29 @@ void mm_allocator_clear(
   mm_allocator->current_segment_idx = 0;
   // Clear malloc memory
   VECTOR_ITERATE(mm_allocator->malloc_requests,malloc_request,m,mm_malloc_request_t) {
-    if (malloc_request->size > 0) free(malloc_request->mem); // Free malloc requests
+    if (malloc_request->size > 0) { // Free malloc requests
+      mm_allocator_pages_free(malloc_request->mem,malloc_request->size,malloc_request->pages);
+      MM_ALLOCATOR_GOVERNOR_SUB(mm_allocator,malloc_request->size);
+    }
   }
   vector_clear(mm_allocator->malloc_requests);
   mm_allocator->malloc_requests_freed = 0;
 }
+void mm_allocator_reserve(
+    mm_allocator_t* const mm_allocator,
+    const uint64_t num_bytes) {
+  // Only arenas can be reserved (all memory is released at once)
+  if (!mm_allocator->arena) {
+    fprintf(stderr,"MMAllocator error. Memory can only be reserved in arena mode\n");
+    exit(1);
+  }
+  mm_allocator_clear_arena(mm_allocator);
+  mm_allocator_grow_arena(mm_allocator,num_bytes);
+}
 void mm_allocator_delete(
     mm_allocator_t* const mm_allocator) {
+  // Detach from governor
+  mm_allocator_set_governor(mm_allocator,NULL);
   // Free segments
   VECTOR_ITERATE(mm_allocator->segments,segment_ptr,p,mm_allocator_segment_t*) {
     mm_allocator_segment_delete(*segment_ptr);
@@ -196,12 +345,40 @@ void mm_allocator_delete(
   vector_delete(mm_allocator->segments_free);
   // Free malloc memory
   VECTOR_ITERATE(mm_allocator->malloc_requests,malloc_request,m,mm_malloc_request_t) {
-    if (malloc_request->size > 0) free(malloc_request->mem); // Free malloc requests
+    if (malloc_request->size > 0) { // Free malloc requests
+      mm_allocator_pages_free(malloc_request->mem,malloc_request->size,malloc_request->pages);
+    }
   }
   vector_delete(mm_allocator->malloc_requests);
   // Free handler
   free(mm_allocator);
 }
+/*
+ * Governor
+ */
+uint64_t mm_allocator_get_size_allocated(
+    mm_allocator_t* const mm_allocator) {
+  // Segments
+  uint64_t num_bytes = 0;
+  VECTOR_ITERATE(mm_allocator->segments,segment_ptr,p,mm_allocator_segment_t*) {
+    num_bytes += (*segment_ptr)->size;
+  }
+  // Malloc requests (freed ones have size zero)
+  VECTOR_ITERATE(mm_allocator->malloc_requests,malloc_request,m,mm_malloc_request_t) {
+    num_bytes += malloc_request->size;
+  }
+  return num_bytes;
+}
+void mm_allocator_set_governor(
+    mm_allocator_t* const mm_allocator,
+    mm_governor_t* const mm_governor) {
+  if (mm_allocator->mm_governor == mm_governor) return;
+  // Transfer the memory already allocated
+  const uint64_t num_bytes = mm_allocator_get_size_allocated(mm_allocator);
+  MM_ALLOCATOR_GOVERNOR_SUB(mm_allocator,num_bytes);
+  mm_allocator->mm_governor = mm_governor;
+  MM_ALLOCATOR_GOVERNOR_ADD(mm_allocator,num_bytes);
+}
 /*
  * Accessors
  */
@@ -258,6 +435,54 @@ mm_allocator_segment_t* mm_allocator_fetch_segment(
   mm_allocator->current_segment_idx = segment->idx;
   return segment;
 }
+mm_allocator_segment_t* mm_allocator_fetch_segment_arena(
+    mm_allocator_t* const mm_allocator,
+    const uint64_t num_bytes) {
+  // Fetch current segment
+  mm_allocator_segment_t* const curr_segment =
+      mm_allocator_get_segment(mm_allocator,mm_allocator->current_segment_idx);
+  // Check overall segment size
+  if (num_bytes > curr_segment->size/2) { // Never buy anything you cannot afford twice
+    return NULL; // Memory request over max-request size
+  }
+  // Check available segment size
+  if (curr_segment->used + num_bytes <= curr_segment->size) {
+    return curr_segment;
+  }
+  // Next segment (reset) or new one
+  const uint64_t next_segment_idx = mm_allocator->current_segment_idx + 1;
+  mm_allocator_segment_t* segment;
+  if (next_segment_idx < mm_allocator_get_num_segments(mm_allocator)) {
+    segment = mm_allocator_get_segment(mm_allocator,next_segment_idx);
+    segment->used = 0;
+  } else {
+    segment = mm_allocator_segment_new(mm_allocator);
+  }
+  mm_allocator->current_segment_idx = next_segment_idx;
+  return segment;
+}
+void* mm_allocator_allocate_arena(
+    mm_allocator_t* const mm_allocator,
+    mm_allocator_segment_t* const segment,
+    const uint64_t num_bytes_allocated,
+    const bool zero_mem,
+    const uint64_t align_bytes) {
+  // Allocate memory (bump)
+  void* const memory_base = segment->memory + segment->used;
+  if (zero_mem) memset(memory_base,0,num_bytes_allocated); // Set zero
+  segment->used += num_bytes_allocated;
+  // Compute aligned memory
+  void* memory_aligned = memory_base + sizeof(mm_allocator_reference_t) + align_bytes;
+  if (align_bytes > 0) {
+    memory_aligned = memory_aligned - ((uintptr_t)memory_aligned % align_bytes);
+  }
+  // Set mm_reference (no request is recorded)
+  mm_allocator_reference_t* const mm_reference = (mm_allocator_reference_t*)(memory_aligned - sizeof(mm_allocator_reference_t));
+  mm_reference->segment_idx = MM_ALLOCATOR_ARENA_SEGMENT_IDX;
+  mm_reference->request_idx = 0;
+  // Return memory
+  return memory_aligned;
+}
 void* mm_allocator_allocate(
     mm_allocator_t* const mm_allocator,
     const uint64_t num_bytes,
@@ -284,9 +509,15 @@ void* mm_allocator_allocate(
 #ifdef MM_ALLOCATOR_FORCE_MALLOC
   mm_allocator_segment_t* const segment = NULL; // Force malloc memory
 #else
-  mm_allocator_segment_t* const segment = mm_allocator_fetch_segment(mm_allocator,num_bytes_allocated);
+  mm_allocator_segment_t* const segment = (mm_allocator->arena) ?
+      mm_allocator_fetch_segment_arena(mm_allocator,num_bytes_allocated) :
+      mm_allocator_fetch_segment(mm_allocator,num_bytes_allocated);
 #endif
-  if (segment != NULL) {
+  if (segment != NULL && mm_allocator->arena) {
+    // Arena memory
+    return mm_allocator_allocate_arena(
+        mm_allocator,segment,num_bytes_allocated,zero_mem,align_bytes);
+  } else if (segment != NULL) {
     // Allocate memory
     void* const memory_base = segment->memory + segment->used;
     if (zero_mem) memset(memory_base,0,num_bytes_allocated); // Set zero
@@ -315,7 +546,8 @@ void* mm_allocator_allocate(
     return memory_aligned;
   } else {
     // Malloc memory
-    void* const memory_base = malloc(num_bytes_allocated);
+    mm_pages_t pages;
+    void* const memory_base = mm_allocator_pages_allocate(mm_allocator->pages,num_bytes_allocated,&pages);
     if (zero_mem) memset(memory_base,0,num_bytes_allocated); // Set zero
     // Compute aligned memory
     void* memory_aligned = memory_base + sizeof(mm_allocator_reference_t) + align_bytes;
@@ -331,6 +563,9 @@ void* mm_allocator_allocate(
     vector_alloc_new(mm_allocator->malloc_requests,mm_malloc_request_t,request);
     request->mem = memory_base;
     request->size = num_bytes_allocated;
+    request->pages = pages;
+    MM_ALLOCATOR_GOVERNOR_ADD(mm_allocator,num_bytes_allocated);
+    ++(mm_allocator->num_allocations);
 #ifdef MM_ALLOCATOR_LOG
     request->timestamp = (mm_allocator->request_ticker)++;
     request->func_name = (char*)func_name;
@@ -357,8 +592,9 @@ void mm_allocator_free_malloc_request(
     exit(1);
   }
   // Free request
+  mm_allocator_pages_free(request->mem,request->size,request->pages);
+  MM_ALLOCATOR_GOVERNOR_SUB(mm_allocator,request->size);
   request->size = 0;
-  free(request->mem);
   ++(mm_allocator->malloc_requests_freed);
   // Check number of freed requests
   if (mm_allocator->malloc_requests_freed >= 1000) {
@@ -425,7 +661,10 @@ void mm_allocator_free(
   // Get reference
   void* const effective_memory = memory - sizeof(mm_allocator_reference_t);
   mm_allocator_reference_t* const mm_reference = (mm_allocator_reference_t*) effective_memory;
-  if (mm_reference->segment_idx == UINT32_MAX) {
+  if (mm_reference->segment_idx == MM_ALLOCATOR_ARENA_SEGMENT_IDX) {
+    // Arena memory (released on clear)
+    return;
+  } else if (mm_reference->segment_idx == UINT32_MAX) {
     // Free malloc memory
     mm_allocator_free_malloc_request(mm_allocator,mm_reference);
   } else {
@@ -437,6 +676,10 @@ void mm_allocator_free(
 /*
  * Utils
  */
+uint64_t mm_allocator_get_num_allocations(
+    mm_allocator_t* const mm_allocator) {
+  return mm_allocator->num_allocations;
+}
 void mm_allocator_get_occupation(
     mm_allocator_t* const mm_allocator,
     uint64_t* const bytes_used_malloc,
@@ -590,6 +833,9 @@ void mm_allocator_print(
   const uint64_t segment_size = mm_allocator->segment_size;
   fprintf(stream,"  => Segments.allocated %" PRIu64 "\n",num_segments);
   fprintf(stream,"  => Segments.size      %" PRIu64 " MB\n",segment_size/(1024*1024));
+  fprintf(stream,"  => Segments.pages     %s\n",
+      (mm_allocator->pages==mm_pages_malloc) ? "malloc" :
+      (mm_allocator->pages==mm_pages_huge) ? "huge" : "huge-explicit");
   fprintf(stream,"  => Memory.available   %" PRIu64 " MB\n",num_segments*(segment_size/(1024*1024)));
   // Print memory information
   uint64_t bytes_used_malloc, bytes_used_allocator;
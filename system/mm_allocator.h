@@ -36,12 +36,23 @@
 #define MM_ALLOCATOR_H_
 
 #include "utils/vector.h"
+#include "system/mm_governor.h"
 
 /*
  * Configuration
  */
 //#define MM_ALLOCATOR_LOG
 #define MM_ALLOCATOR_ALIGNMENT 8 // 64bits
+#define MM_ALLOCATOR_HUGE_PAGE_SIZE BUFFER_SIZE_2M
+
+/*
+ * Memory pages backing segments (and large malloc-requests)
+ */
+typedef enum {
+  mm_pages_malloc        = 0, // Plain malloc memory
+  mm_pages_huge          = 1, // Anonymous mmap advised with MADV_HUGEPAGE (transparent huge-pages)
+  mm_pages_huge_explicit = 2, // Explicit 2MB pages (MAP_HUGETLB); falls back to mm_pages_huge
+} mm_pages_t;
 
 /*
  * MM-Allocator
@@ -49,6 +60,8 @@
 typedef struct {
   // Metadata
   uint64_t request_ticker;        // Request ticker
+  mm_pages_t pages;               // Memory pages backing segments (and large requests)
+  bool arena;                     // Arena mode (bump allocation; free is a no-op; clear resets all)
   // Memory segments
   uint64_t segment_size;          // Memory segment size (bytes)
   vector_t* segments;             // Memory segments (mm_allocator_segment_t*)
@@ -57,6 +70,10 @@ typedef struct {
   // Malloc memory
   vector_t* malloc_requests;      // Malloc requests (mm_malloc_request_t)
   uint64_t malloc_requests_freed; // Total malloc request freed and still in vector
+  // Governor
+  mm_governor_t* mm_governor;     // Process-wide memory governor (accounts segments & malloc requests)
+  // Stats
+  uint64_t num_allocations;       // Memory allocations requested to the system (segments & malloc requests)
 } mm_allocator_t;
 
 /*
@@ -64,11 +81,26 @@ typedef struct {
  */
 mm_allocator_t* mm_allocator_new(
     const uint64_t segment_size);
+mm_allocator_t* mm_allocator_new_pages(
+    const uint64_t segment_size,
+    const mm_pages_t pages);
+mm_allocator_t* mm_allocator_new_arena(
+    const uint64_t segment_size);
 void mm_allocator_clear(
     mm_allocator_t* const mm_allocator);
+void mm_allocator_reserve(
+    mm_allocator_t* const mm_allocator,
+    const uint64_t num_bytes);
 void mm_allocator_delete(
     mm_allocator_t* const mm_allocator);
 
+/*
+ * Governor
+ */
+void mm_allocator_set_governor(
+    mm_allocator_t* const mm_allocator,
+    mm_governor_t* const mm_governor);
+
 /*
  * Allocator
  */
@@ -114,6 +146,8 @@ void mm_allocator_free(
 /*
  * Utils
  */
+uint64_t mm_allocator_get_num_allocations(
+    mm_allocator_t* const mm_allocator);
 void mm_allocator_get_occupation(
     mm_allocator_t* const mm_allocator,
     uint64_t* const bytes_used_malloc,
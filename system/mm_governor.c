@@ -0,0 +1,258 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Process-wide memory governor. Keeps a global budget shared
+ *   by many aligners (and threads), accounting the memory of every attached
+ *   MM-Allocator and reaping idle clients under memory pressure.
+ */
+
+#include "utils/commons.h"
+#include "mm_governor.h"
+
+/*
+ * Constants
+ */
+#define MM_GOVERNOR_INITIAL_CLIENTS 16
+
+/*
+ * Setup
+ */
+mm_governor_t* mm_governor_new(
+    const uint64_t max_memory,
+    const mm_governor_policy_t policy) {
+  // Allocate handler
+  mm_governor_t* const mm_governor = (mm_governor_t*) malloc(sizeof(mm_governor_t));
+  // Budget
+  mm_governor->max_memory = max_memory;
+  mm_governor->policy = policy;
+  // Accounting
+  mm_governor->memory_used = 0;
+  mm_governor->memory_peak = 0;
+  // Clients
+  mm_governor->clients = vector_new(MM_GOVERNOR_INITIAL_CLIENTS,mm_governor_client_t*);
+  mm_governor->num_busy = 0;
+  pthread_mutex_init(&mm_governor->mutex,NULL);
+  pthread_cond_init(&mm_governor->memory_released,NULL);
+  // Stats
+  mm_governor->num_reaps = 0;
+  mm_governor->num_waits = 0;
+  mm_governor->num_rejected = 0;
+  // Return
+  return mm_governor;
+}
+void mm_governor_delete(
+    mm_governor_t* const mm_governor) {
+  // Check clients
+  if (vector_get_used(mm_governor->clients) > 0) {
+    fprintf(stderr,"MMGovernor error: deleting governor with registered clients\n");
+    exit(1);
+  }
+  // Free
+  vector_delete(mm_governor->clients);
+  pthread_mutex_destroy(&mm_governor->mutex);
+  pthread_cond_destroy(&mm_governor->memory_released);
+  free(mm_governor);
+}
+/*
+ * Clients
+ */
+mm_governor_client_t* mm_governor_register(
+    mm_governor_t* const mm_governor,
+    void* const handler,
+    void (*reap)(void* const handler)) {
+  // Allocate client
+  mm_governor_client_t* const client = (mm_governor_client_t*) malloc(sizeof(mm_governor_client_t));
+  client->handler = handler;
+  client->reap = reap;
+  client->busy = false;
+  client->paused = false;
+  client->reaped = false;
+  // Register
+  pthread_mutex_lock(&mm_governor->mutex);
+  vector_insert(mm_governor->clients,client,mm_governor_client_t*);
+  pthread_mutex_unlock(&mm_governor->mutex);
+  // Return
+  return client;
+}
+void mm_governor_unregister(
+    mm_governor_t* const mm_governor,
+    mm_governor_client_t* const client) {
+  pthread_mutex_lock(&mm_governor->mutex);
+  // Remove from clients (swap with the last one)
+  mm_governor_client_t** const clients = vector_get_mem(mm_governor->clients,mm_governor_client_t*);
+  const uint64_t num_clients = vector_get_used(mm_governor->clients);
+  uint64_t i;
+  for (i=0;i<num_clients;++i) {
+    if (clients[i] == client) {
+      clients[i] = clients[num_clients-1];
+      vector_dec_used(mm_governor->clients);
+      break;
+    }
+  }
+  // Release (if busy)
+  if (client->busy) {
+    --(mm_governor->num_busy);
+    pthread_cond_broadcast(&mm_governor->memory_released);
+  }
+  pthread_mutex_unlock(&mm_governor->mutex);
+  free(client);
+}
+/*
+ * Accounting
+ */
+void mm_governor_add(
+    mm_governor_t* const mm_governor,
+    const uint64_t num_bytes) {
+  const uint64_t memory_used =
+      __atomic_add_fetch(&mm_governor->memory_used,num_bytes,__ATOMIC_RELAXED);
+  // Update peak
+  uint64_t memory_peak = __atomic_load_n(&mm_governor->memory_peak,__ATOMIC_RELAXED);
+  while (memory_used > memory_peak &&
+         !__atomic_compare_exchange_n(&mm_governor->memory_peak,&memory_peak,
+             memory_used,true,__ATOMIC_RELAXED,__ATOMIC_RELAXED));
+}
+void mm_governor_sub(
+    mm_governor_t* const mm_governor,
+    const uint64_t num_bytes) {
+  __atomic_sub_fetch(&mm_governor->memory_used,num_bytes,__ATOMIC_RELAXED);
+}
+uint64_t mm_governor_get_used(
+    mm_governor_t* const mm_governor) {
+  return __atomic_load_n(&mm_governor->memory_used,__ATOMIC_RELAXED);
+}
+bool mm_governor_exhausted(
+    mm_governor_t* const mm_governor) {
+  return mm_governor_get_used(mm_governor) > mm_governor->max_memory;
+}
+/*
+ * Reap idle clients (requires lock)
+ */
+void mm_governor_reap_idle(
+    mm_governor_t* const mm_governor) {
+  VECTOR_ITERATE(mm_governor->clients,client_ptr,n,mm_governor_client_t*) {
+    mm_governor_client_t* const client = *client_ptr;
+    if (client->busy || client->paused || client->reaped) continue;
+    // Reap client
+    client->reap(client->handler);
+    client->reaped = true;
+    ++(mm_governor->num_reaps);
+    // Check budget
+    if (!mm_governor_exhausted(mm_governor)) return;
+  }
+}
+/*
+ * Acquire/Release
+ *   Under memory pressure, idle clients are reaped first. If the budget is
+ *   still exhausted, the client waits (or fails) until busy clients release
+ *   their memory. When no client is busy nobody can release memory, so the
+ *   client is allowed to proceed anyway (progress is always guaranteed).
+ *   A paused client keeps its memory (it is neither reaped nor waited for)
+ *   until it acquires again to resume its job.
+ */
+bool mm_governor_acquire(
+    mm_governor_t* const mm_governor,
+    mm_governor_client_t* const client) {
+  pthread_mutex_lock(&mm_governor->mutex);
+  bool waited = false;
+  while (mm_governor_exhausted(mm_governor)) {
+    // Reap idle clients
+    mm_governor_reap_idle(mm_governor);
+    if (!mm_governor_exhausted(mm_governor)) break;
+    if (mm_governor->num_busy == 0) break; // Nobody else can release memory
+    // Fail
+    if (mm_governor->policy == mm_governor_fail) {
+      ++(mm_governor->num_rejected);
+      pthread_mutex_unlock(&mm_governor->mutex);
+      return false;
+    }
+    // Wait for busy clients to release
+    if (!waited) {
+      ++(mm_governor->num_waits);
+      waited = true;
+    }
+    pthread_cond_wait(&mm_governor->memory_released,&mm_governor->mutex);
+  }
+  // Set busy
+  client->busy = true;
+  client->paused = false;
+  client->reaped = false;
+  ++(mm_governor->num_busy);
+  pthread_mutex_unlock(&mm_governor->mutex);
+  return true;
+}
+void mm_governor_release(
+    mm_governor_t* const mm_governor,
+    mm_governor_client_t* const client) {
+  pthread_mutex_lock(&mm_governor->mutex);
+  if (client->busy) {
+    client->busy = false;
+    --(mm_governor->num_busy);
+  }
+  pthread_cond_broadcast(&mm_governor->memory_released);
+  pthread_mutex_unlock(&mm_governor->mutex);
+}
+void mm_governor_pause(
+    mm_governor_t* const mm_governor,
+    mm_governor_client_t* const client) {
+  pthread_mutex_lock(&mm_governor->mutex);
+  if (client->busy) {
+    client->busy = false;
+    --(mm_governor->num_busy);
+  }
+  client->paused = true;
+  pthread_cond_broadcast(&mm_governor->memory_released);
+  pthread_mutex_unlock(&mm_governor->mutex);
+}
+void mm_governor_reap(
+    mm_governor_t* const mm_governor) {
+  pthread_mutex_lock(&mm_governor->mutex);
+  if (mm_governor_exhausted(mm_governor)) {
+    mm_governor_reap_idle(mm_governor);
+  }
+  pthread_mutex_unlock(&mm_governor->mutex);
+}
+/*
+ * Display
+ */
+void mm_governor_print(
+    FILE* const stream,
+    mm_governor_t* const mm_governor) {
+  fprintf(stream,"MMGovernor.report\n");
+  fprintf(stream,"  => Memory.budget  %" PRIu64 " MB (%s)\n",
+      CONVERT_B_TO_MB(mm_governor->max_memory),
+      (mm_governor->policy==mm_governor_wait) ? "wait" : "fail");
+  fprintf(stream,"  => Memory.used    %" PRIu64 " MB\n",
+      CONVERT_B_TO_MB(mm_governor_get_used(mm_governor)));
+  fprintf(stream,"  => Memory.peak    %" PRIu64 " MB\n",
+      CONVERT_B_TO_MB(mm_governor->memory_peak));
+  fprintf(stream,"  => Clients        %" PRIu64 " (busy=%" PRIu64 ")\n",
+      (uint64_t)vector_get_used(mm_governor->clients),mm_governor->num_busy);
+  fprintf(stream,"  => Reaps          %" PRIu64 "\n",mm_governor->num_reaps);
+  fprintf(stream,"  => Waits          %" PRIu64 "\n",mm_governor->num_waits);
+  fprintf(stream,"  => Rejected       %" PRIu64 "\n",mm_governor->num_rejected);
+}
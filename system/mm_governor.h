@@ -0,0 +1,136 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Process-wide memory governor. Keeps a global budget shared
+ *   by many aligners (and threads), accounting the memory of every attached
+ *   MM-Allocator and reaping idle clients under memory pressure.
+ */
+
+#ifndef MM_GOVERNOR_H_
+#define MM_GOVERNOR_H_
+
+#include <pthread.h>
+#include "utils/vector.h"
+
+/*
+ * Governor policy (when the budget is exhausted)
+ */
+typedef enum {
+  mm_governor_wait = 0, // Block until other clients release memory
+  mm_governor_fail = 1, // Fail the request (caller can downgrade to a lower memory-mode)
+} mm_governor_policy_t;
+
+/*
+ * Governor client (registered memory consumer)
+ */
+typedef struct {
+  void* handler;                     // Client handler (e.g. wavefront aligner)
+  void (*reap)(void* const handler); // Release all the memory buffered by an idle client
+  bool busy;                         // Client is using its memory (cannot be reaped)
+  bool paused;                       // Client holds an unfinished job (cannot be reaped)
+  bool reaped;                       // Client already reaped (since it was last busy)
+} mm_governor_client_t;
+
+/*
+ * Memory Governor
+ */
+typedef struct {
+  // Budget
+  uint64_t max_memory;               // Maximum memory allowed across all clients (Bytes)
+  mm_governor_policy_t policy;       // Policy when the budget is exhausted
+  // Accounting (atomic)
+  uint64_t memory_used;              // Memory currently allocated by all clients (Bytes)
+  uint64_t memory_peak;              // Maximum memory allocated at any time (Bytes)
+  // Clients
+  vector_t* clients;                 // Registered clients (mm_governor_client_t*)
+  uint64_t num_busy;                 // Clients currently busy
+  pthread_mutex_t mutex;             // Protects clients
+  pthread_cond_t memory_released;    // Signals clients released
+  // Stats
+  uint64_t num_reaps;                // Idle clients reaped
+  uint64_t num_waits;                // Acquires that had to wait
+  uint64_t num_rejected;             // Acquires rejected (fail-policy)
+} mm_governor_t;
+
+/*
+ * Setup
+ */
+mm_governor_t* mm_governor_new(
+    const uint64_t max_memory,
+    const mm_governor_policy_t policy);
+void mm_governor_delete(
+    mm_governor_t* const mm_governor);
+
+/*
+ * Clients
+ */
+mm_governor_client_t* mm_governor_register(
+    mm_governor_t* const mm_governor,
+    void* const handler,
+    void (*reap)(void* const handler));
+void mm_governor_unregister(
+    mm_governor_t* const mm_governor,
+    mm_governor_client_t* const client);
+
+/*
+ * Accounting
+ */
+void mm_governor_add(
+    mm_governor_t* const mm_governor,
+    const uint64_t num_bytes);
+void mm_governor_sub(
+    mm_governor_t* const mm_governor,
+    const uint64_t num_bytes);
+uint64_t mm_governor_get_used(
+    mm_governor_t* const mm_governor);
+bool mm_governor_exhausted(
+    mm_governor_t* const mm_governor);
+
+/*
+ * Acquire/Release (client starts/stops using memory)
+ */
+bool mm_governor_acquire(
+    mm_governor_t* const mm_governor,
+    mm_governor_client_t* const client);
+void mm_governor_release(
+    mm_governor_t* const mm_governor,
+    mm_governor_client_t* const client);
+void mm_governor_pause(
+    mm_governor_t* const mm_governor,
+    mm_governor_client_t* const client);
+void mm_governor_reap(
+    mm_governor_t* const mm_governor);
+
+/*
+ * Display
+ */
+void mm_governor_print(
+    FILE* const stream,
+    mm_governor_t* const mm_governor);
+
+#endif /* MM_GOVERNOR_H_ */
@@ -86,6 +86,11 @@ double counter_get_stddev(const profiler_counter_t* const counter) {
 void counter_combine_sum(
     profiler_counter_t* const counter_dst,
     profiler_counter_t* const counter_src) {
+  if (counter_src->samples == 0) return;
+  if (counter_dst->samples == 0) { // Empty counter (min is not valid)
+    *counter_dst = *counter_src;
+    return;
+  }
   counter_dst->total += counter_src->total;
   counter_dst->samples += counter_src->samples;
   counter_dst->min = MIN(counter_dst->min,counter_src->min);
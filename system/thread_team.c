@@ -0,0 +1,180 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Persistent team of worker threads. Workers stay alive between
+ *   tasks (spinning for a while, then sleeping), so that short parallel tasks
+ *   (e.g. one per score-step) avoid the cost of forking/joining threads.
+ */
+
+#include "thread_team.h"
+#include <sched.h>
+
+/*
+ * Spin-wait hint
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#define THREAD_TEAM_PAUSE() __builtin_ia32_pause()
+#else
+#define THREAD_TEAM_PAUSE()
+#endif
+
+/*
+ * Workers
+ */
+uint64_t thread_team_wait_task(
+    thread_team_t* const thread_team,
+    const uint64_t last_tag) {
+  // Spin
+  uint64_t tag;
+  int i;
+  for (i=0;i<THREAD_TEAM_SPIN_ITERATIONS;++i) {
+    tag = __atomic_load_n(&thread_team->task_tag,__ATOMIC_ACQUIRE);
+    if (tag != last_tag) return tag;
+    THREAD_TEAM_PAUSE();
+  }
+  // Sleep (the poster checks sleepers after publishing the task)
+  pthread_mutex_lock(&thread_team->mutex);
+  __atomic_add_fetch(&thread_team->num_sleeping,1,__ATOMIC_SEQ_CST);
+  while ((tag = __atomic_load_n(&thread_team->task_tag,__ATOMIC_SEQ_CST)) == last_tag) {
+    pthread_cond_wait(&thread_team->task_posted,&thread_team->mutex);
+  }
+  __atomic_sub_fetch(&thread_team->num_sleeping,1,__ATOMIC_SEQ_CST);
+  pthread_mutex_unlock(&thread_team->mutex);
+  return tag;
+}
+void* thread_team_worker(
+    void* const arg) {
+  thread_team_worker_t* const worker = arg;
+  thread_team_t* const thread_team = worker->team;
+  uint64_t tag = 0;
+  while (true) {
+    // Wait for a new task
+    tag = thread_team_wait_task(thread_team,tag);
+    if (thread_team->quit) break;
+    // Run (if taking part)
+    const int num_threads = tag & 0xFFFF;
+    if (worker->thread_id >= num_threads) continue;
+    thread_team->task(thread_team->task_args,worker->thread_id,num_threads);
+    __atomic_sub_fetch(&thread_team->task_pending,1,__ATOMIC_RELEASE);
+  }
+  return NULL;
+}
+/*
+ * Setup
+ */
+void thread_team_post(
+    thread_team_t* const thread_team,
+    const int num_threads) {
+  // Publish task
+  const uint64_t counter = (thread_team->task_tag >> 16) + 1;
+  __atomic_store_n(&thread_team->task_tag,(counter<<16)|num_threads,__ATOMIC_SEQ_CST);
+  // Wake up sleeping workers
+  if (__atomic_load_n(&thread_team->num_sleeping,__ATOMIC_SEQ_CST) > 0) {
+    pthread_mutex_lock(&thread_team->mutex);
+    pthread_cond_broadcast(&thread_team->task_posted);
+    pthread_mutex_unlock(&thread_team->mutex);
+  }
+}
+thread_team_t* thread_team_new(
+    const int max_threads) {
+  // Allocate handler
+  thread_team_t* const thread_team = (thread_team_t*) malloc(sizeof(thread_team_t));
+  thread_team->max_threads = MAX(max_threads,1);
+  // Task
+  thread_team->task = NULL;
+  thread_team->task_args = NULL;
+  thread_team->task_tag = 0;
+  thread_team->task_pending = 0;
+  thread_team->quit = false;
+  // Sleeping workers
+  thread_team->num_sleeping = 0;
+  pthread_mutex_init(&thread_team->mutex,NULL);
+  pthread_cond_init(&thread_team->task_posted,NULL);
+  // Workers
+  const int num_workers = thread_team->max_threads - 1;
+  thread_team->workers = (num_workers > 0) ? malloc(num_workers*sizeof(thread_team_worker_t)) : NULL;
+  int i;
+  for (i=0;i<num_workers;++i) {
+    thread_team_worker_t* const worker = thread_team->workers + i;
+    worker->team = thread_team;
+    worker->thread_id = i + 1;
+    if (pthread_create(&worker->thread,NULL,thread_team_worker,worker) != 0) {
+      fprintf(stderr,"[WFA::ThreadTeam] Error creating worker thread\n");
+      exit(1);
+    }
+  }
+  // Return
+  return thread_team;
+}
+void thread_team_delete(
+    thread_team_t* const thread_team) {
+  // Stop workers
+  const int num_workers = thread_team->max_threads - 1;
+  thread_team->quit = true;
+  thread_team_post(thread_team,0);
+  int i;
+  for (i=0;i<num_workers;++i) {
+    pthread_join(thread_team->workers[i].thread,NULL);
+  }
+  // Free
+  pthread_mutex_destroy(&thread_team->mutex);
+  pthread_cond_destroy(&thread_team->task_posted);
+  if (thread_team->workers != NULL) free(thread_team->workers);
+  free(thread_team);
+}
+/*
+ * Run task
+ */
+void thread_team_run(
+    thread_team_t* const thread_team,
+    const int num_threads,
+    thread_team_task_t const task,
+    void* const task_args) {
+  // Single thread
+  const int team_threads = MIN(num_threads,thread_team->max_threads);
+  if (team_threads <= 1) {
+    task(task_args,0,1);
+    return;
+  }
+  // Post task
+  thread_team->task = task;
+  thread_team->task_args = task_args;
+  __atomic_store_n(&thread_team->task_pending,team_threads-1,__ATOMIC_RELAXED);
+  thread_team_post(thread_team,team_threads);
+  // Run our share
+  task(task_args,0,team_threads);
+  // Wait for the workers (yield if they are not running)
+  int spins = 0;
+  while (__atomic_load_n(&thread_team->task_pending,__ATOMIC_ACQUIRE) > 0) {
+    if (++spins < THREAD_TEAM_SPIN_ITERATIONS) {
+      THREAD_TEAM_PAUSE();
+    } else {
+      sched_yield();
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Persistent team of worker threads. Workers stay alive between
+ *   tasks (spinning for a while, then sleeping), so that short parallel tasks
+ *   (e.g. one per score-step) avoid the cost of forking/joining threads.
+ */
+
+#ifndef THREAD_TEAM_H_
+#define THREAD_TEAM_H_
+
+#include <pthread.h>
+#include "utils/commons.h"
+
+/*
+ * Configuration
+ */
+#define THREAD_TEAM_SPIN_ITERATIONS  2000 // Idle spins before sleeping (or yielding)
+
+/*
+ * Team task (executed by threads [0,num_threads); the caller is thread 0)
+ */
+typedef void (*thread_team_task_t)(void* const args,const int thread_id,const int num_threads);
+
+/*
+ * Thread Team
+ */
+typedef struct _thread_team_t thread_team_t;
+typedef struct {
+  thread_team_t* team;               // Team
+  int thread_id;                     // Worker id (1..max_threads-1)
+  pthread_t thread;                  // Worker thread
+} thread_team_worker_t;
+struct _thread_team_t {
+  // Workers
+  int max_threads;                   // Team size (including the caller)
+  thread_team_worker_t* workers;     // Worker threads
+  // Current task
+  thread_team_task_t task;           // Task function
+  void* task_args;                   // Task arguments
+  uint64_t task_tag;                 // Task counter and number of threads (atomic; tag<<16|threads)
+  int task_pending;                  // Workers still running the task (atomic)
+  bool quit;                         // Workers must exit
+  // Sleeping workers
+  int num_sleeping;                  // Workers waiting on @task_posted
+  pthread_mutex_t mutex;             // Protects sleeping
+  pthread_cond_t task_posted;        // Signals a new task
+};
+
+/*
+ * Setup
+ */
+thread_team_t* thread_team_new(
+    const int max_threads);
+void thread_team_delete(
+    thread_team_t* const thread_team);
+
+/*
+ * Run task (returns when all threads are done)
+ */
+void thread_team_run(
+    thread_team_t* const thread_team,
+    const int num_threads,
+    thread_team_task_t const task,
+    void* const task_args);
+
+#endif /* THREAD_TEAM_H_ */
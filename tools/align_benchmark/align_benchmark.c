@@ -29,9 +29,12 @@
  * DESCRIPTION: Wavefront Alignment Algorithms benchmarking tool
  */
 #include <omp.h>
+#include <pthread.h>
 
 #include "utils/commons.h"
-#include "utils/sequence_buffer.h"
+#include "utils/sequence_dataset.h"
+#include "utils/sequence_pack.h"
+#include "utils/sequence_paf.h"
 #include "system/profiler_timer.h"
 
 #include "alignment/score_matrix.h"
@@ -54,20 +57,31 @@
 typedef struct {
   // I/O
   char *input_filename;
+  char *sequences_filename;
+  char *query_sequences_filename;
   char *output_filename;
   bool output_full;
+  bool output_alignments;               // PAF/SAM output
+  alignment_format_t output_format;
   // I/O internals
-  FILE* input_file;
-  char* line1;
-  char* line2;
-  size_t line1_allocated;
-  size_t line2_allocated;
+  sequence_dataset_t* input_dataset;    // Input (.seq)
+  sequence_pack_t* input_pack;          // Input (.wfp)
+  sequence_paf_t* input_paf;            // Input (.paf)
   FILE* output_file;
   // Penalties
   affine_penalties_t affine_penalties;
   // Wavefront parameters
   bool wfa_score_only;
+  wavefront_memory_t wfa_memory_mode;
+  wavefront_pcigar_t wfa_pcigar_width;
   int wfa_max_threads;
+  int wfa_min_offsets_per_thread;
+  int wfa_preallocate;
+  int wfa_checkpoint_memory;
+  bool wfa_lockstep;
+  // Parallel
+  int num_threads;
+  int batch_size;
   // Misc
   bool check_display;
   bool check_correct;
@@ -75,6 +89,7 @@ typedef struct {
   bool check_alignments;
   int check_metric;
   int check_bandwidth;
+  bool check_allocations;
   int plot;
   // Profile
   profiler_timer_t timer_global;
@@ -85,15 +100,17 @@ typedef struct {
 benchmark_args parameters = {
   // I/O
   .input_filename = NULL,
+  .sequences_filename = NULL,
+  .query_sequences_filename = NULL,
   .output_filename = NULL,
   .output_full = false,
+  .output_alignments = false,
+  .output_format = alignment_format_paf,
   .output_file = NULL,
   // I/O internals
-  .input_file = NULL,
-  .line1 = NULL,
-  .line2 = NULL,
-  .line1_allocated = 0,
-  .line2_allocated = 0,
+  .input_dataset = NULL,
+  .input_pack = NULL,
+  .input_paf = NULL,
   // Penalties
   .affine_penalties = {
       .match = 0,
@@ -103,7 +120,16 @@ benchmark_args parameters = {
   },
   // Wavefront parameters
   .wfa_score_only = false,
+  .wfa_memory_mode = wavefront_memory_ultralow,
+  .wfa_pcigar_width = wavefront_pcigar_32bits,
   .wfa_max_threads = 1,
+  .wfa_min_offsets_per_thread = -1,
+  .wfa_preallocate = 0,
+  .wfa_checkpoint_memory = -1,
+  .wfa_lockstep = false,
+  // Parallel
+  .num_threads = 1,
+  .batch_size = 100,
   // Misc
   .check_bandwidth = -1,
   .check_display = false,
@@ -111,6 +137,7 @@ benchmark_args parameters = {
   .check_score = false,
   .check_alignments = false,
   .check_metric = ALIGN_DEBUG_CHECK_DISTANCE_METRIC_GAP_AFFINE,
+  .check_allocations = false,
   .plot = 0,
   // System
   .progress = 100000,
@@ -120,35 +147,59 @@ benchmark_args parameters = {
 /*
  * Configuration
  */
-wavefront_aligner_t* align_input_configure_wavefront(
-    align_input_t* const align_input) {
+void align_input_configure_attributes(
+    wavefront_aligner_attr_t* const attributes) {
   // Set attributes
-  wavefront_aligner_attr_t attributes = wavefront_aligner_attr_default;
+  *attributes = wavefront_aligner_attr_default;
   if (parameters.wfa_score_only) {
-    attributes.alignment_scope = compute_score;
+    attributes->alignment_scope = compute_score;
   }
   // WF-Heuristic
-  attributes.heuristic.strategy = wf_heuristic_none;
+  attributes->heuristic.strategy = wf_heuristic_none;
   // Select flavor
-  attributes.affine_penalties = parameters.affine_penalties;
+  attributes->affine_penalties = parameters.affine_penalties;
   // Misc
-  attributes.memory_mode = wavefront_memory_ultralow;
-  attributes.plot.enabled = (parameters.plot > 0);
-  attributes.plot.resolution_points = parameters.plot;
-  attributes.system.verbose = parameters.verbose;
-  attributes.system.max_num_threads = parameters.wfa_max_threads;
+  attributes->memory_mode = parameters.wfa_memory_mode;
+  attributes->pcigar_width = parameters.wfa_pcigar_width;
+  attributes->plot.enabled = (parameters.plot > 0);
+  attributes->plot.resolution_points = parameters.plot;
+  attributes->system.verbose = parameters.verbose;
+  attributes->system.max_num_threads = parameters.wfa_max_threads;
+  if (parameters.wfa_min_offsets_per_thread >= 0) {
+    attributes->system.min_offsets_per_thread = parameters.wfa_min_offsets_per_thread;
+  }
+  if (parameters.wfa_checkpoint_memory >= 0) {
+    attributes->system.max_memory_checkpoint = (uint64_t)parameters.wfa_checkpoint_memory * BUFFER_SIZE_1M;
+  }
+  attributes->system.batch_lockstep = parameters.wfa_lockstep;
+}
+wavefront_aligner_t* align_input_configure_wavefront(
+    align_input_t* const align_input) {
+  // Set attributes
+  wavefront_aligner_attr_t attributes;
+  align_input_configure_attributes(&attributes);
   // Allocate
-  return wavefront_aligner_new(&attributes);
+  wavefront_aligner_t* const wf_aligner = wavefront_aligner_new(&attributes);
+  if (parameters.wfa_preallocate > 0) {
+    wavefront_aligner_preallocate(wf_aligner,parameters.wfa_preallocate,parameters.wfa_preallocate);
+  }
+  return wf_aligner;
 }
 void align_input_configure_global(
-    align_input_t* const align_input) {
+    align_input_t* const align_input,
+    const bool output_detached) {
   // Clear
   benchmark_align_input_clear(align_input);
   // Penalties
   align_input->affine_penalties = parameters.affine_penalties;
-  // Output
-  align_input->output_file = parameters.output_file;
-  align_input->output_full = parameters.output_full;
+  // Output (pipeline workers detach their records per batch; written in order)
+  if (parameters.output_alignments && parameters.output_file != NULL) {
+    align_input->alignment_writer = alignment_writer_new(
+        parameters.output_format,(output_detached) ? NULL : parameters.output_file);
+  } else {
+    align_input->output_file = parameters.output_file;
+    align_input->output_full = parameters.output_full;
+  }
   // MM
   align_input->mm_allocator = mm_allocator_new(BUFFER_SIZE_1M);
   // WFA
@@ -169,34 +220,156 @@ void align_input_configure_global(
 void align_benchmark_free(
     align_input_t* const align_input) {
   if (align_input->wf_aligner) wavefront_aligner_delete(align_input->wf_aligner);
+  if (align_input->alignment_writer) alignment_writer_delete(align_input->alignment_writer);
   mm_allocator_delete(align_input->mm_allocator);
 }
 /*
  * I/O
  */
+typedef struct {
+  sequence_pack_decoder_t pack_decoder;   // Unpacked pair (.wfp)
+  sequence_paf_buffer_t paf_buffer;       // Extracted pair (.paf)
+} align_reader_t;
+void align_reader_init(
+    align_reader_t* const reader) {
+  sequence_pack_decoder_init(&reader->pack_decoder);
+  sequence_paf_buffer_init(&reader->paf_buffer);
+}
+void align_reader_free(
+    align_reader_t* const reader) {
+  sequence_pack_decoder_free(&reader->pack_decoder);
+  sequence_paf_buffer_free(&reader->paf_buffer);
+}
+void align_benchmark_record_default(
+    alignment_record_t* const record,
+    const int sequence_id,
+    const uint64_t pattern_length,
+    const uint64_t text_length) {
+  // Whole sequences (named after the pair)
+  memset(record,0,sizeof(alignment_record_t));
+  record->pair_id = sequence_id;
+  record->query_length = pattern_length;
+  record->query_end = pattern_length;
+  record->target_length = text_length;
+  record->target_end = text_length;
+}
+void align_benchmark_write_header() {
+  if (!parameters.output_alignments || parameters.output_file == NULL) return;
+  if (parameters.output_format != alignment_format_sam) return;
+  // SAM header (targets as references)
+  alignment_writer_t* const writer = alignment_writer_new(alignment_format_sam,parameters.output_file);
+  alignment_writer_add_header(writer);
+  alignment_record_t record;
+  memset(&record,0,sizeof(alignment_record_t));
+  uint64_t i;
+  if (parameters.input_paf != NULL) {
+    sequence_index_t* const targets = parameters.input_paf->target_index;
+    for (i=0;i<targets->num_records;++i) {
+      record.target_name = targets->records[i].name;
+      record.target_name_length = targets->records[i].name_length;
+      record.target_length = targets->records[i].length;
+      alignment_writer_add_reference(writer,&record);
+    }
+  } else if (parameters.input_pack != NULL) {
+    for (i=0;i<parameters.input_pack->num_pairs;++i) {
+      sequence_pack_pair_t pair;
+      sequence_pack_get_pair(parameters.input_pack,i,&pair);
+      align_benchmark_record_default(&record,i,pair.pattern.length,pair.text.length);
+      alignment_writer_add_reference(writer,&record);
+    }
+  } else {
+    for (i=0;i<parameters.input_dataset->num_pairs;++i) {
+      char *pattern, *text;
+      uint64_t pattern_length, text_length;
+      sequence_dataset_get_pair(parameters.input_dataset,i,
+          &pattern,&pattern_length,&text,&text_length);
+      align_benchmark_record_default(&record,i,pattern_length,text_length);
+      alignment_writer_add_reference(writer,&record);
+    }
+  }
+  alignment_writer_delete(writer);
+}
+void align_benchmark_open_input() {
+  // Map & index the input (sequences are not copied, nor NULL-terminated)
+  if (parameters.sequences_filename != NULL) {
+    parameters.input_paf = sequence_paf_new(parameters.input_filename,
+        parameters.sequences_filename,parameters.query_sequences_filename);
+  } else if (sequence_pack_probe(parameters.input_filename)) {
+    parameters.input_pack = sequence_pack_new(parameters.input_filename);
+  } else {
+    parameters.input_dataset = sequence_dataset_new(
+        parameters.input_filename,MAX(parameters.num_threads,1));
+  }
+  if (parameters.output_filename != NULL) {
+    parameters.output_file = fopen(parameters.output_filename, "w");
+  }
+  align_benchmark_write_header();
+}
+void align_benchmark_close_input() {
+  if (parameters.input_paf) sequence_paf_delete(parameters.input_paf);
+  if (parameters.input_pack) sequence_pack_delete(parameters.input_pack);
+  if (parameters.input_dataset) sequence_dataset_delete(parameters.input_dataset);
+  if (parameters.output_file) fclose(parameters.output_file);
+}
+int align_benchmark_num_pairs() {
+  if (parameters.input_paf != NULL) return parameters.input_paf->num_mappings;
+  if (parameters.input_pack != NULL) return parameters.input_pack->num_pairs;
+  return parameters.input_dataset->num_pairs;
+}
 bool align_benchmark_read_input(
-    FILE* input_file,
-    char** line1,
-    char** line2,
-    size_t* line1_allocated,
-    size_t* line2_allocated,
-    const int seqs_processed,
-    align_input_t* const align_input) {
-  // Parameters
-  int line1_length=0, line2_length=0;
-  // Read queries
-  line1_length = getline(line1,line1_allocated,input_file);
-  if (line1_length==-1) return false;
-  line2_length = getline(line2,line2_allocated,input_file);
-  if (line1_length==-1) return false;
+    const int sequence_id,
+    align_input_t* const align_input,
+    align_reader_t* const reader) {
+  // Fetch sequence-pair
+  if (sequence_id >= align_benchmark_num_pairs()) return false;
+  uint64_t pattern_length, text_length;
+  if (parameters.input_paf != NULL) {
+    // Extract (into the buffer of the calling thread)
+    sequence_paf_mapping_t mapping;
+    sequence_paf_get_pair(parameters.input_paf,&reader->paf_buffer,sequence_id,&mapping,
+        &align_input->pattern,&pattern_length,&align_input->text,&text_length);
+    alignment_record_t* const record = &align_input->alignment_record;
+    record->pair_id = sequence_id;
+    record->query_name = mapping.query_name;
+    record->query_name_length = mapping.query_name_length;
+    record->query_length = mapping.query_length;
+    record->query_begin = mapping.query_begin;
+    record->query_end = mapping.query_end;
+    record->reverse = mapping.reverse;
+    record->target_name = mapping.target_name;
+    record->target_name_length = mapping.target_name_length;
+    record->target_length = mapping.target_length;
+    record->target_begin = mapping.target_begin;
+    record->target_end = mapping.target_end;
+  } else if (parameters.input_pack != NULL) {
+    // Unpack (into the decoder of the calling thread)
+    sequence_pack_pair_t pair;
+    sequence_pack_decoder_get_pair(&reader->pack_decoder,parameters.input_pack,
+        sequence_id,&pair,&align_input->pattern,&align_input->text);
+    pattern_length = pair.pattern.length;
+    text_length = pair.text.length;
+    align_benchmark_record_default(&align_input->alignment_record,
+        sequence_id,pattern_length,text_length);
+    if (pair.id_length > 0) {
+      align_input->alignment_record.query_name = pair.id;
+      align_input->alignment_record.query_name_length = pair.id_length;
+    }
+    if (parameters.input_pack->flags & SEQUENCE_PACK_HAS_ENDS_FREE) {
+      align_input->pattern_begin_free = pair.pattern_begin_free;
+      align_input->pattern_end_free = pair.pattern_end_free;
+      align_input->text_begin_free = pair.text_begin_free;
+      align_input->text_end_free = pair.text_end_free;
+    }
+  } else {
+    sequence_dataset_get_pair(parameters.input_dataset,sequence_id,
+        &align_input->pattern,&pattern_length,&align_input->text,&text_length);
+    align_benchmark_record_default(&align_input->alignment_record,
+        sequence_id,pattern_length,text_length);
+  }
   // Configure input
-  align_input->sequence_id = seqs_processed;
-  align_input->pattern = *line1 + 1;
-  align_input->pattern_length = line1_length - 2;
-  align_input->pattern[align_input->pattern_length] = '\0';
-  align_input->text = *line2 + 1;
-  align_input->text_length = line2_length - 2;
-  align_input->text[align_input->text_length] = '\0';
+  align_input->sequence_id = sequence_id;
+  align_input->pattern_length = pattern_length;
+  align_input->text_length = text_length;
   return true;
 }
 /*
@@ -211,15 +384,20 @@ void align_benchmark_print_progress(
 void align_benchmark_print_results(
     align_input_t* const align_input,
     const int seqs_processed,
+    const int seqs_allocating,
     const bool print_stats) {
   // Print benchmark results
   fprintf(stderr,"[Benchmark]\n");
   fprintf(stderr,"=> Total.reads            %d\n",seqs_processed);
   fprintf(stderr,"=> Time.Benchmark      ");
   timer_print(stderr,&parameters.timer_global,NULL);
-  fprintf(stderr,"  => Time.Alignment    %2.3f (s)\n",
-      TIMER_CONVERT_NS_TO_S(timer_get_total_ns(&align_input->timer)));
+  fprintf(stderr,"  => Time.Alignment    %2.3f (s)%s\n",
+      TIMER_CONVERT_NS_TO_S(timer_get_total_ns(&align_input->timer)),
+      (parameters.num_threads > 1) ? " (added over all threads)" : "");
   //timer_print(stderr,&align_input->timer,&parameters.timer_global);
+  if (parameters.check_allocations) {
+    fprintf(stderr,"=> Allocations.SteadyState %d alignments allocating (after warm-up)\n",seqs_allocating);
+  }
   // Print Stats
   const bool checks_enabled =
       parameters.check_display || parameters.check_correct ||
@@ -246,33 +424,49 @@ void align_benchmark_plot_wf(
 /*
  * Benchmark
  */
+void align_benchmark_warmup(
+    align_input_t* const align_input,
+    align_reader_t* const reader) {
+  // Align all the input once (memory reaches its steady state)
+  int seqs_processed = 0;
+  while (true) {
+    const bool input_read = align_benchmark_read_input(seqs_processed,align_input,reader);
+    if (!input_read) break;
+    wavefront_align(align_input->wf_aligner,
+        align_input->pattern,align_input->pattern_length,
+        align_input->text,align_input->text_length);
+    ++seqs_processed;
+  }
+}
 void align_benchmark_sequential() {
   // PROFILE
   timer_reset(&parameters.timer_global);
   timer_start(&parameters.timer_global);
   // I/O files
-  parameters.input_file = fopen(parameters.input_filename, "r");
-  if (parameters.input_file == NULL) {
-    fprintf(stderr,"Input file '%s' couldn't be opened\n",parameters.input_filename);
-    exit(1);
-  }
-  if (parameters.output_filename != NULL) {
-    parameters.output_file = fopen(parameters.output_filename, "w");
-  }
+  align_benchmark_open_input();
   // Global configuration
   align_input_t align_input;
-  align_input_configure_global(&align_input);
+  align_input_configure_global(&align_input,false);
+  align_reader_t reader;
+  align_reader_init(&reader);
+  // Warm-up (steady-state allocations check)
+  if (parameters.check_allocations) {
+    align_benchmark_warmup(&align_input,&reader);
+    timer_reset(&parameters.timer_global);
+    timer_start(&parameters.timer_global);
+  }
   // Read-align loop
-  int seqs_processed = 0, progress = 0;
+  int seqs_processed = 0, seqs_allocating = 0, progress = 0;
   while (true) {
     // Read input sequence-pair
-    const bool input_read = align_benchmark_read_input(
-        parameters.input_file,&parameters.line1,&parameters.line2,
-        &parameters.line1_allocated,&parameters.line2_allocated,
-        seqs_processed,&align_input);
+    const bool input_read = align_benchmark_read_input(seqs_processed,&align_input,&reader);
     if (!input_read) break;
     // Execute the algorithm
+    const uint64_t num_allocations = wavefront_aligner_get_num_allocations(align_input.wf_aligner);
     benchmark_gap_affine_wavefront(&align_input,&parameters.affine_penalties);
+    if (wavefront_aligner_get_num_allocations(align_input.wf_aligner) != num_allocations) {
+      ++seqs_allocating;
+    }
     // Update progress
     ++seqs_processed;
     if (++progress == parameters.progress) {
@@ -284,13 +478,239 @@ void align_benchmark_sequential() {
   }
   // Print benchmark results
   timer_stop(&parameters.timer_global);
-  align_benchmark_print_results(&align_input,seqs_processed,true);
+  align_benchmark_print_results(&align_input,seqs_processed,seqs_allocating,true);
   // Free
   align_benchmark_free(&align_input);
-  fclose(parameters.input_file);
-  if (parameters.output_file) fclose(parameters.output_file);
-  free(parameters.line1);
-  free(parameters.line2);
+  align_reader_free(&reader);
+  align_benchmark_close_input();
+  // Check steady state
+  if (parameters.check_allocations && seqs_allocating > 0) {
+    fprintf(stderr,"[Benchmark] Error: %d alignments allocated memory in steady state\n",seqs_allocating);
+    exit(1);
+  }
+}
+/*
+ * Parallel benchmark
+ *   The input is mapped and indexed upfront, so the aligner threads (each one
+ *   with its own align_input/aligner) claim batches of sequence-pairs straight
+ *   from the dataset, align them in any order, and the main thread writes them
+ *   back in input order. Batches live in a ring that acts as the reorder buffer;
+ *   aligners stall when they wrap around a batch not yet written, bounding the
+ *   memory used by the pipeline.
+ */
+typedef enum {
+  align_batch_free    = 0,
+  align_batch_claimed = 1,
+  align_batch_aligned = 2,
+} align_batch_state_t;
+typedef struct {
+  align_batch_state_t state;      // Stage of the batch in the pipeline
+  int batch_id;                   // Batch using the slot (or next to use it, if free)
+  int sequence_id;                // Id of the first sequence-pair
+  int num_sequences;              // Sequence-pairs in the batch
+  char* output;                   // Output (formatted by the aligner thread)
+  size_t output_size;             // Output size
+} align_batch_t;
+typedef struct {
+  // Batches (ring)
+  align_batch_t* batches;
+  int num_batches;
+  int batches_total;              // Batches in the input
+  int batches_claimed;            // Batches claimed by the aligners
+  // Sync
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+} align_pipeline_t;
+typedef struct {
+  align_pipeline_t* pipeline;
+  align_input_t align_input;
+  align_reader_t reader;
+  pthread_t thread;
+} align_worker_t;
+void align_benchmark_parallel_align_lockstep(
+    align_input_t* const align_input,
+    align_reader_t* const reader,
+    const int sequence_id,
+    const int num_sequences) {
+  // Configure
+  wavefront_aligner_attr_t attributes;
+  align_input_configure_attributes(&attributes);
+  wavefront_batch_pair_t* const pairs = malloc(num_sequences*sizeof(wavefront_batch_pair_t));
+  alignment_record_t* const records = malloc(num_sequences*sizeof(alignment_record_t));
+  char* buffer = NULL;
+  int i;
+  if (parameters.input_dataset == NULL) {
+    // Unpack/extract the whole batch (pairs must stay valid until aligned)
+    uint64_t buffer_length = 0, buffer_allocated = 0;
+    for (i=0;i<num_sequences;++i) {
+      align_benchmark_read_input(sequence_id+i,align_input,reader);
+      const uint64_t pair_length = align_input->pattern_length + align_input->text_length;
+      if (buffer_length + pair_length > buffer_allocated) {
+        buffer_allocated = MAX(buffer_length+pair_length,2*buffer_allocated);
+        buffer = realloc(buffer,buffer_allocated);
+      }
+      memcpy(buffer+buffer_length,align_input->pattern,align_input->pattern_length);
+      buffer_length += align_input->pattern_length;
+      memcpy(buffer+buffer_length,align_input->text,align_input->text_length);
+      buffer_length += align_input->text_length;
+      pairs[i].pattern_length = align_input->pattern_length;
+      pairs[i].text_length = align_input->text_length;
+      records[i] = align_input->alignment_record;
+    }
+    char* sequence = buffer;
+    for (i=0;i<num_sequences;++i) {
+      pairs[i].pattern = sequence;
+      sequence += pairs[i].pattern_length;
+      pairs[i].text = sequence;
+      sequence += pairs[i].text_length;
+    }
+  } else {
+    for (i=0;i<num_sequences;++i) {
+      uint64_t pattern_length, text_length;
+      char *pattern, *text;
+      sequence_dataset_get_pair(parameters.input_dataset,sequence_id+i,
+          &pattern,&pattern_length,&text,&text_length);
+      pairs[i].pattern = pattern;
+      pairs[i].pattern_length = pattern_length;
+      pairs[i].text = text;
+      pairs[i].text_length = text_length;
+      align_benchmark_record_default(records+i,sequence_id+i,pattern_length,text_length);
+    }
+  }
+  // Align the whole batch (groups of short pairs in lockstep)
+  benchmark_gap_affine_wavefront_batch(align_input,
+      &parameters.affine_penalties,&attributes,pairs,num_sequences,sequence_id,records);
+  free(pairs);
+  free(records);
+  free(buffer);
+}
+void* align_benchmark_parallel_aligner(
+    void* const arg) {
+  align_worker_t* const worker = arg;
+  align_pipeline_t* const pipeline = worker->pipeline;
+  align_input_t* const align_input = &worker->align_input;
+  while (true) {
+    // Claim the next batch (wait for its slot to be written)
+    pthread_mutex_lock(&pipeline->mutex);
+    if (pipeline->batches_claimed == pipeline->batches_total) { // All batches claimed
+      pthread_mutex_unlock(&pipeline->mutex);
+      break;
+    }
+    const int batch_id = (pipeline->batches_claimed)++;
+    align_batch_t* const batch = pipeline->batches + (batch_id % pipeline->num_batches);
+    while (batch->state != align_batch_free || batch->batch_id != batch_id) {
+      pthread_cond_wait(&pipeline->cond,&pipeline->mutex);
+    }
+    batch->state = align_batch_claimed;
+    pthread_mutex_unlock(&pipeline->mutex);
+    // Align batch
+    const int num_pairs = align_benchmark_num_pairs();
+    batch->sequence_id = batch_id*parameters.batch_size;
+    batch->num_sequences = MIN(parameters.batch_size,num_pairs-batch->sequence_id);
+    alignment_writer_t* const alignment_writer = align_input->alignment_writer;
+    align_input->output_file = (parameters.output_file != NULL && alignment_writer == NULL) ?
+        open_memstream(&batch->output,&batch->output_size) : NULL;
+    if (parameters.wfa_lockstep) {
+      align_benchmark_parallel_align_lockstep(align_input,
+          &worker->reader,batch->sequence_id,batch->num_sequences);
+    } else {
+      int i;
+      for (i=0;i<batch->num_sequences;++i) {
+        align_benchmark_read_input(batch->sequence_id+i,align_input,&worker->reader);
+        benchmark_gap_affine_wavefront(align_input,&parameters.affine_penalties);
+      }
+    }
+    if (alignment_writer != NULL) {
+      alignment_writer_detach(alignment_writer,&batch->output,&batch->output_size);
+    } else if (align_input->output_file != NULL) {
+      fclose(align_input->output_file);
+    }
+    // Hand over to the writer
+    pthread_mutex_lock(&pipeline->mutex);
+    batch->state = align_batch_aligned;
+    pthread_cond_broadcast(&pipeline->cond);
+    pthread_mutex_unlock(&pipeline->mutex);
+  }
+  return NULL;
+}
+void align_benchmark_parallel() {
+  // PROFILE
+  timer_reset(&parameters.timer_global);
+  timer_start(&parameters.timer_global);
+  // I/O files
+  align_benchmark_open_input();
+  // Pipeline
+  const int num_threads = parameters.num_threads;
+  const int num_pairs = align_benchmark_num_pairs();
+  align_pipeline_t pipeline;
+  pipeline.num_batches = 4*num_threads;
+  pipeline.batches = calloc(pipeline.num_batches,sizeof(align_batch_t));
+  int i;
+  for (i=0;i<pipeline.num_batches;++i) {
+    pipeline.batches[i].state = align_batch_free;
+    pipeline.batches[i].batch_id = i;
+  }
+  pipeline.batches_total = DIV_CEIL(num_pairs,parameters.batch_size);
+  pipeline.batches_claimed = 0;
+  pthread_mutex_init(&pipeline.mutex,NULL);
+  pthread_cond_init(&pipeline.cond,NULL);
+  // Launch aligners
+  align_worker_t* const workers = malloc(num_threads*sizeof(align_worker_t));
+  for (i=0;i<num_threads;++i) {
+    workers[i].pipeline = &pipeline;
+    align_input_configure_global(&workers[i].align_input,true);
+    align_reader_init(&workers[i].reader);
+    pthread_create(&workers[i].thread,NULL,align_benchmark_parallel_aligner,workers+i);
+  }
+  // Write batches in order
+  int batch_id, seqs_processed = 0;
+  for (batch_id=0;batch_id<pipeline.batches_total;++batch_id) {
+    align_batch_t* const batch = pipeline.batches + (batch_id % pipeline.num_batches);
+    pthread_mutex_lock(&pipeline.mutex);
+    while (batch->state != align_batch_aligned) {
+      pthread_cond_wait(&pipeline.cond,&pipeline.mutex);
+    }
+    pthread_mutex_unlock(&pipeline.mutex);
+    // Output
+    if (batch->output != NULL) {
+      fwrite(batch->output,1,batch->output_size,parameters.output_file);
+      free(batch->output);
+      batch->output = NULL;
+    }
+    // Update progress
+    const int seqs_batch = batch->num_sequences;
+    if ((seqs_processed+seqs_batch)/parameters.progress != seqs_processed/parameters.progress) {
+      align_benchmark_print_progress(seqs_processed+seqs_batch);
+    }
+    seqs_processed += seqs_batch;
+    // Release batch
+    pthread_mutex_lock(&pipeline.mutex);
+    batch->state = align_batch_free;
+    batch->batch_id += pipeline.num_batches;
+    pthread_cond_broadcast(&pipeline.cond);
+    pthread_mutex_unlock(&pipeline.mutex);
+  }
+  // Join
+  for (i=0;i<num_threads;++i) pthread_join(workers[i].thread,NULL);
+  timer_stop(&parameters.timer_global);
+  // Merge stats & print benchmark results
+  align_input_t align_input;
+  benchmark_align_input_clear(&align_input);
+  timer_reset(&align_input.timer);
+  for (i=0;i<num_threads;++i) {
+    benchmark_merge_stats(&align_input,&workers[i].align_input);
+  }
+  align_benchmark_print_results(&align_input,seqs_processed,0,true);
+  // Free
+  for (i=0;i<num_threads;++i) {
+    align_benchmark_free(&workers[i].align_input);
+    align_reader_free(&workers[i].reader);
+  }
+  free(workers);
+  free(pipeline.batches);
+  pthread_mutex_destroy(&pipeline.mutex);
+  pthread_cond_destroy(&pipeline.cond);
+  align_benchmark_close_input();
 }
 /*
  * Generic Menu
@@ -299,18 +719,31 @@ void usage() {
   fprintf(stderr,
       "USE: ./align_benchmark -i <input>                                       \n"
       "        [Input & Output]                                                \n"
-      "          --input|i <File>                                              \n"
+      "          --input|i <File> (.seq or .wfp; or .paf with --sequences)     \n"
+      "          --sequences <File> (FASTA/FASTQ; targets of the .paf input)   \n"
+      "          --query-sequences <File> (FASTA/FASTQ; default=--sequences)   \n"
       "          --output|o <File>                                             \n"
       "          --output-full <File>                                          \n"
+      "          --output-format 'paf'|'sam' (with cg/cs or MD tags)           \n"
       "        [Penalties]                                                     \n"
       "          --affine-penalties|g M,X,O,E                                  \n"
       "        [Wavefront parameters]                                          \n"
       "          --wfa-score-only                                              \n"
-    //"          --wfa-max-threads <INT> (intra-parallelism; default=1)        \n"
+      "          --wfa-memory-mode 'high'|'med'|'low'|'ultralow'|'checkpoint'  \n"
+      "          --wfa-pcigar '32bits'|'64bits'|'auto'                         \n"
+      "          --wfa-preallocate <INT> (maximum sequence length)             \n"
+      "          --wfa-checkpoint-memory <INT> (MB; wavefront memory budget)   \n"
+      "          --wfa-max-threads <INT> (intra-parallelism; default=1)        \n"
+      "          --wfa-min-offsets-per-thread <INT>|'auto' (default=500)       \n"
+      "          --wfa-lockstep (align batches of short pairs in SIMD lockstep)\n"
+      "        [Parallel]                                                      \n"
+      "          --num-threads|t <INT> (inter-parallelism; default=1)          \n"
+      "          --batch-size <INT> (sequence-pairs per batch; default=100)    \n"
       "        [Misc]                                                          \n"
       "          --check|c 'correct'|'score'|'alignment'                       \n"
       "          --check-distance 'indel'|'edit'|'linear'|'affine'|'affine2p'  \n"
       "          --check-bandwidth <INT>                                       \n"
+      "          --check-allocations                                           \n"
       "        [System]                                                        \n"
       "          --help|h                                                      \n");
 }
@@ -320,15 +753,28 @@ void parse_arguments(int argc,char** argv) {
     { "input", required_argument, 0, 'i' },
     { "output", required_argument, 0, 'o' },
     { "output-full", required_argument, 0, 800 },
+    { "sequences", required_argument, 0, 801 },
+    { "query-sequences", required_argument, 0, 802 },
+    { "output-format", required_argument, 0, 803 },
     /* Penalties */
     { "affine-penalties", required_argument, 0, 'g' },
     /* Wavefront parameters */
     { "wfa-score-only", no_argument, 0, 1006 },
-    //{ "wfa-max-threads", required_argument, 0, 1007 },
+    { "wfa-memory-mode", required_argument, 0, 1008 },
+    { "wfa-pcigar", required_argument, 0, 1009 },
+    { "wfa-preallocate", required_argument, 0, 1010 },
+    { "wfa-checkpoint-memory", required_argument, 0, 1011 },
+    { "wfa-max-threads", required_argument, 0, 1007 },
+    { "wfa-lockstep", no_argument, 0, 1012 },
+    { "wfa-min-offsets-per-thread", required_argument, 0, 1013 },
+    /* Parallel */
+    { "num-threads", required_argument, 0, 't' },
+    { "batch-size", required_argument, 0, 2001 },
     /* Misc */
     { "check", required_argument, 0, 'c' },
     { "check-distance", required_argument, 0, 3001 },
     { "check-bandwidth", required_argument, 0, 3002 },
+    { "check-allocations", no_argument, 0, 3004 },
     { "plot", optional_argument, 0, 3003 },
     /* System */
     { "progress", required_argument, 0, 'P' },
@@ -341,7 +787,7 @@ void parse_arguments(int argc,char** argv) {
     exit(0);
   }
   while (1) {
-    c=getopt_long(argc,argv,"i:o:g:c:P:v::h",long_options,&option_index);
+    c=getopt_long(argc,argv,"i:o:g:c:t:P:v::h",long_options,&option_index);
     if (c==-1) break;
     switch (c) {
     /*
@@ -357,6 +803,23 @@ void parse_arguments(int argc,char** argv) {
       parameters.output_filename = optarg;
       parameters.output_full = true;
       break;
+    case 801: // --sequences
+      parameters.sequences_filename = optarg;
+      break;
+    case 802: // --query-sequences
+      parameters.query_sequences_filename = optarg;
+      break;
+    case 803: // --output-format
+      parameters.output_alignments = true;
+      if (strcmp(optarg,"paf")==0) {
+        parameters.output_format = alignment_format_paf;
+      } else if (strcmp(optarg,"sam")==0) {
+        parameters.output_format = alignment_format_sam;
+      } else {
+        fprintf(stderr,"Option '--output-format' must be in {'paf','sam'}\n");
+        exit(1);
+      }
+      break;
     /*
      * Penalties
      */
@@ -380,6 +843,63 @@ void parse_arguments(int argc,char** argv) {
     case 1007: // --wfa-max-threads
       parameters.wfa_max_threads = atoi(optarg);
       break;
+    case 1008: // --wfa-memory-mode in {'high','med','low','ultralow','checkpoint'}
+      if (strcasecmp(optarg,"high")==0) {
+        parameters.wfa_memory_mode = wavefront_memory_high;
+      } else if (strcasecmp(optarg,"med")==0) {
+        parameters.wfa_memory_mode = wavefront_memory_med;
+      } else if (strcasecmp(optarg,"low")==0) {
+        parameters.wfa_memory_mode = wavefront_memory_low;
+      } else if (strcasecmp(optarg,"ultralow")==0) {
+        parameters.wfa_memory_mode = wavefront_memory_ultralow;
+      } else if (strcasecmp(optarg,"checkpoint")==0) {
+        parameters.wfa_memory_mode = wavefront_memory_checkpoint;
+      } else {
+        fprintf(stderr,"Option '--wfa-memory-mode' must be in {'high','med','low','ultralow','checkpoint'}\n");
+        exit(1);
+      }
+      break;
+    case 1009: // --wfa-pcigar in {'32bits','64bits','auto'}
+      if (strcasecmp(optarg,"32bits")==0) {
+        parameters.wfa_pcigar_width = wavefront_pcigar_32bits;
+      } else if (strcasecmp(optarg,"64bits")==0) {
+        parameters.wfa_pcigar_width = wavefront_pcigar_64bits;
+      } else if (strcasecmp(optarg,"auto")==0) {
+        parameters.wfa_pcigar_width = wavefront_pcigar_auto;
+      } else {
+        fprintf(stderr,"Option '--wfa-pcigar' must be in {'32bits','64bits','auto'}\n");
+        exit(1);
+      }
+      break;
+    case 1010: // --wfa-preallocate
+      parameters.wfa_preallocate = atoi(optarg);
+      break;
+    case 1011: // --wfa-checkpoint-memory
+      parameters.wfa_checkpoint_memory = atoi(optarg);
+      break;
+    case 1012: // --wfa-lockstep
+      parameters.wfa_lockstep = true;
+      break;
+    case 1013: // --wfa-min-offsets-per-thread (INT or 'auto')
+      if (strcasecmp(optarg,"auto")==0) {
+        parameters.wfa_min_offsets_per_thread = 0;
+      } else {
+        parameters.wfa_min_offsets_per_thread = atoi(optarg);
+        if (parameters.wfa_min_offsets_per_thread <= 0) {
+          fprintf(stderr,"Option '--wfa-min-offsets-per-thread' must be a positive integer or 'auto'\n");
+          exit(1);
+        }
+      }
+      break;
+    /*
+     * Parallel
+     */
+    case 't': // --num-threads
+      parameters.num_threads = atoi(optarg);
+      break;
+    case 2001: // --batch-size
+      parameters.batch_size = atoi(optarg);
+      break;
     /*
      * Misc
      */
@@ -422,6 +942,9 @@ void parse_arguments(int argc,char** argv) {
     case 3002: // --check-bandwidth
       parameters.check_bandwidth = atoi(optarg);
       break;
+    case 3004: // --check-allocations
+      parameters.check_allocations = true;
+      break;
     case 3003: // --plot
       parameters.plot = (optarg==NULL) ? 1000 : atoi(optarg);
       break;
@@ -456,10 +979,27 @@ void parse_arguments(int argc,char** argv) {
     fprintf(stderr,"Option --input is required \n");
     exit(1);
   }
+  // Checks parallel
+  if (parameters.num_threads < 1 || parameters.batch_size < 1) {
+    fprintf(stderr,"Options --num-threads and --batch-size must be positive \n");
+    exit(1);
+  }
+  if (parameters.num_threads > 1 && (parameters.check_allocations || parameters.plot > 0)) {
+    fprintf(stderr,"Options --check-allocations and --plot require --num-threads 1 \n");
+    exit(1);
+  }
+  if (parameters.wfa_lockstep && (parameters.check_allocations || parameters.plot > 0)) {
+    fprintf(stderr,"Options --check-allocations and --plot cannot be used with --wfa-lockstep \n");
+    exit(1);
+  }
 }
 int main(int argc,char* argv[]) {
   // Parsing command-line options
   parse_arguments(argc,argv);
-  // Run
-  align_benchmark_sequential();
+  // Run (lockstep aligns whole batches, thus it always uses the pipeline)
+  if (parameters.num_threads == 1 && !parameters.wfa_lockstep) {
+    align_benchmark_sequential();
+  } else {
+    align_benchmark_parallel();
+  }
 }
@@ -60,7 +60,7 @@ void benchmark_edit_bpm(
     benchmark_check_alignment(align_input,bpm_matrix.cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     benchmark_print_output(align_input,edit,false,bpm_matrix.cigar);
   }
   // Free
@@ -91,7 +91,7 @@ void benchmark_edit_dp(
     benchmark_check_alignment(align_input,cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     benchmark_print_output(align_input,edit,false,cigar);
   }
   // Free
@@ -124,7 +124,7 @@ void benchmark_edit_dp_banded(
     benchmark_check_alignment(align_input,cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     benchmark_print_output(align_input,edit,false,cigar);
   }
   // Free
@@ -146,7 +146,7 @@ void benchmark_edit_wavefront(
     benchmark_check_alignment(align_input,wf_aligner->cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     const int score_only = (wf_aligner->alignment_scope == compute_score);
     benchmark_print_output(align_input,edit,score_only,wf_aligner->cigar);
   }
@@ -60,7 +60,7 @@ void benchmark_gap_affine_swg(
     benchmark_check_alignment(align_input,cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     benchmark_print_output(align_input,gap_affine,false,cigar);
   }
   // Free
@@ -91,7 +91,7 @@ void benchmark_gap_affine_swg_endsfree(
     benchmark_check_alignment(align_input,cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     benchmark_print_output(align_input,gap_affine,false,cigar);
   }
   // Free
@@ -121,7 +121,7 @@ void benchmark_gap_affine_swg_banded(
     benchmark_check_alignment(align_input,cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     benchmark_print_output(align_input,gap_affine,false,cigar);
   }
   // Free
@@ -144,8 +144,52 @@ void benchmark_gap_affine_wavefront(
     benchmark_check_alignment(align_input,wf_aligner->cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     const int score_only = (wf_aligner->alignment_scope == compute_score);
     benchmark_print_output(align_input,gap_affine,score_only,wf_aligner->cigar);
   }
 }
+void benchmark_gap_affine_wavefront_batch(
+    align_input_t* const align_input,
+    affine_penalties_t* const penalties,
+    wavefront_aligner_attr_t* const attributes,
+    wavefront_batch_pair_t* const pairs,
+    const int num_pairs,
+    const int sequence_id,
+    alignment_record_t* const records) {
+  // Parameters
+  const bool score_only = (attributes->alignment_scope == compute_score);
+  // Allocate
+  wavefront_batch_result_t* const results = mm_allocator_calloc(
+      align_input->mm_allocator,num_pairs,wavefront_batch_result_t,false);
+  int i;
+  for (i=0;i<num_pairs;++i) {
+    results[i].cigar = cigar_new(
+        pairs[i].pattern_length+pairs[i].text_length+2,
+        align_input->mm_allocator);
+  }
+  // Align
+  timer_start(&align_input->timer);
+  wavefront_align_batch(pairs,num_pairs,attributes,results,1);
+  timer_stop(&align_input->timer);
+  // Check & output (in input order)
+  for (i=0;i<num_pairs;++i) {
+    align_input->sequence_id = sequence_id + i;
+    align_input->pattern = (char*)pairs[i].pattern;
+    align_input->pattern_length = pairs[i].pattern_length;
+    align_input->text = (char*)pairs[i].text;
+    align_input->text_length = pairs[i].text_length;
+    if (records != NULL) align_input->alignment_record = records[i];
+    // DEBUG
+    if (align_input->debug_flags) {
+      benchmark_check_alignment(align_input,results[i].cigar);
+    }
+    // Output
+    if (align_input->output_file || align_input->alignment_writer) {
+      benchmark_print_output(align_input,gap_affine,score_only,results[i].cigar);
+    }
+  }
+  // Free
+  for (i=0;i<num_pairs;++i) cigar_free(results[i].cigar);
+  mm_allocator_free(align_input->mm_allocator,results);
+}
@@ -51,5 +51,13 @@ void benchmark_gap_affine_swg_endsfree(
 void benchmark_gap_affine_wavefront(
     align_input_t* const align_input,
     affine_penalties_t* const penalties);
+void benchmark_gap_affine_wavefront_batch(
+    align_input_t* const align_input,
+    affine_penalties_t* const penalties,
+    wavefront_aligner_attr_t* const attributes,
+    wavefront_batch_pair_t* const pairs,
+    const int num_pairs,
+    const int sequence_id,
+    alignment_record_t* const records);
 
 #endif /* BENCHMARK_GAP_AFFINE_H_ */
@@ -60,7 +60,7 @@ void benchmark_gap_affine2p_dp(
     benchmark_check_alignment(align_input,cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     benchmark_print_output(align_input,gap_affine_2p,false,cigar);
   }
   // Free
@@ -83,7 +83,7 @@ void benchmark_gap_affine2p_wavefront(
     benchmark_check_alignment(align_input,wf_aligner->cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     const int score_only = (wf_aligner->alignment_scope == compute_score);
     benchmark_print_output(align_input,gap_affine_2p,score_only,wf_aligner->cigar);
   }
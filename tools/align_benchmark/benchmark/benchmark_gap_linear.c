@@ -59,7 +59,7 @@ void benchmark_gap_linear_nw(
     benchmark_check_alignment(align_input,cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     benchmark_print_output(align_input,gap_linear,false,cigar);
   }
   // Free
@@ -82,7 +82,7 @@ void benchmark_gap_linear_wavefront(
     benchmark_check_alignment(align_input,wf_aligner->cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     const int score_only = (wf_aligner->alignment_scope == compute_score);
     benchmark_print_output(align_input,gap_linear,score_only,wf_aligner->cigar);
   }
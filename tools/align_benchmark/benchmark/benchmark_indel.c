@@ -51,7 +51,7 @@ void benchmark_indel_wavefront(
     benchmark_check_alignment(align_input,wf_aligner->cigar);
   }
   // Output
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     const int score_only = (wf_aligner->alignment_scope == compute_score);
     benchmark_print_output(align_input,indel,score_only,wf_aligner->cigar);
   }
@@ -50,6 +50,8 @@ void benchmark_align_input_clear(
   // Output
   align_input->output_file = NULL;
   align_input->output_full = false;
+  align_input->alignment_writer = NULL;
+  memset(&align_input->alignment_record,0,sizeof(alignment_record_t));
   // Accuracy Stats
   counter_reset(&(align_input->align));
   counter_reset(&(align_input->align_correct));
@@ -75,8 +77,8 @@ void benchmark_print_alignment(
     cigar_t* const cigar_correct) {
   // Print Sequence
   fprintf(stream,"ALIGNMENT (#%d)\n",align_input->sequence_id);
-  fprintf(stream,"  PATTERN  %s\n",align_input->pattern);
-  fprintf(stream,"  TEXT     %s\n",align_input->text);
+  fprintf(stream,"  PATTERN  %.*s\n",align_input->pattern_length,align_input->pattern);
+  fprintf(stream,"  TEXT     %.*s\n",align_input->text_length,align_input->text);
   // Print CIGARS
   if (cigar_computed != NULL && score_computed != -1) {
     fprintf(stream,"    COMPUTED\tscore=%d\t",score_computed);
@@ -131,12 +133,14 @@ void benchmark_print_output_full(
     cigar_sprint(cigar_str,cigar,true);
   }
   // Print
-  fprintf(stream,"%d\t%d\t%d\t%s\t%s\t%s\n",
+  fprintf(stream,"%d\t%d\t%d\t%.*s\t%.*s\t%s\n",
       align_input->pattern_length,     // Pattern length
       align_input->text_length,        // Text length
       score,                           // Alignment score
-      align_input->pattern,            // Pattern sequence
-      align_input->text,               // Text sequence
+      align_input->pattern_length,     // Pattern sequence
+      align_input->pattern,
+      align_input->text_length,        // Text sequence
+      align_input->text,
       (cigar_null) ? "-" : cigar_str); // CIGAR
   // Free
   if (!cigar_null) free(cigar_str);
@@ -146,7 +150,7 @@ void benchmark_print_output(
     const distance_metric_t distance_metric,
     const bool score_only,
     cigar_t* const cigar) {
-  if (align_input->output_file) {
+  if (align_input->output_file || align_input->alignment_writer) {
     // Compute score
     int score = -1;
     if (score_only) {
@@ -171,7 +175,10 @@ void benchmark_print_output(
       }
     }
     // Print summary
-    if (align_input->output_full) {
+    if (align_input->alignment_writer) {
+      alignment_writer_add(align_input->alignment_writer,&align_input->alignment_record,
+          align_input->pattern,align_input->text,cigar,score);
+    } else if (align_input->output_full) {
       benchmark_print_output_full(align_input->output_file,align_input,score,cigar);
     } else {
       benchmark_print_output_lite(align_input->output_file,align_input,score,cigar);
@@ -206,4 +213,21 @@ void benchmark_print_stats(
   fprintf(stream,"   => CIGAR.Deletions      ");
   counter_print(stream,&align_input->align_del,&align_input->align_bases,"bases     ",true);
 }
-
+void benchmark_merge_stats(
+    align_input_t* const align_input_dst,
+    align_input_t* const align_input_src) {
+  // Time
+  counter_combine_sum(&align_input_dst->timer.time_ns,&align_input_src->timer.time_ns);
+  // Accuracy Stats
+  counter_combine_sum(&align_input_dst->align,&align_input_src->align);
+  counter_combine_sum(&align_input_dst->align_correct,&align_input_src->align_correct);
+  counter_combine_sum(&align_input_dst->align_score,&align_input_src->align_score);
+  counter_combine_sum(&align_input_dst->align_score_total,&align_input_src->align_score_total);
+  counter_combine_sum(&align_input_dst->align_score_diff,&align_input_src->align_score_diff);
+  counter_combine_sum(&align_input_dst->align_cigar,&align_input_src->align_cigar);
+  counter_combine_sum(&align_input_dst->align_bases,&align_input_src->align_bases);
+  counter_combine_sum(&align_input_dst->align_matches,&align_input_src->align_matches);
+  counter_combine_sum(&align_input_dst->align_mismatches,&align_input_src->align_mismatches);
+  counter_combine_sum(&align_input_dst->align_del,&align_input_src->align_del);
+  counter_combine_sum(&align_input_dst->align_ins,&align_input_src->align_ins);
+}
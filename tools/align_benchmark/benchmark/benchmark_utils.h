@@ -36,6 +36,7 @@
 #include "system/mm_allocator.h"
 #include "system/profiler_timer.h"
 #include "alignment/score_matrix.h"
+#include "alignment/alignment_writer.h"
 #include "wavefront/wavefront_aligner.h"
 
 /*
@@ -75,6 +76,8 @@ typedef struct {
   // Output
   FILE* output_file;
   bool output_full;
+  alignment_writer_t* alignment_writer;   // PAF/SAM output (instead of the output file)
+  alignment_record_t alignment_record;    // PAF/SAM columns of the current pair
   // MM
   wavefront_aligner_t* wf_aligner;
   mm_allocator_t* mm_allocator;
@@ -129,5 +132,8 @@ void benchmark_print_stats(
     FILE* const stream,
     align_input_t* const align_input,
     const bool print_wf_stats);
+void benchmark_merge_stats(
+    align_input_t* const align_input_dst,
+    align_input_t* const align_input_src);
 
 #endif /* BENCHMARK_UTILS_H_ */
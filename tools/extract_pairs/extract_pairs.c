@@ -0,0 +1,312 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Extracts sequence-pairs from PAF mappings on indexed FASTA/FASTQ
+ *   Mappings are processed in blocks (bounding the memory used); the pairs of
+ *   each block are extracted in parallel and written in input order.
+ */
+
+#include "utils/commons.h"
+#include "utils/sequence_paf.h"
+#include "utils/sequence_pack.h"
+#include "system/thread_team.h"
+#include <getopt.h>
+
+/*
+ * Parameters
+ */
+typedef struct {
+  char* paf;
+  char* sequences;
+  char* query_sequences;
+  char* output;
+  bool output_pack;
+  uint64_t min_length;
+  uint64_t max_length;
+  int num_threads;
+  int block_size;
+} extract_parameters_t;
+extract_parameters_t parameters = {
+  .paf = NULL,
+  .sequences = NULL,
+  .query_sequences = NULL,
+  .output = NULL,
+  .output_pack = false,
+  .min_length = 0,
+  .max_length = UINT64_MAX,
+  .num_threads = 1,
+  .block_size = 10000,
+};
+
+/*
+ * Block of pairs (extracted by one thread)
+ */
+typedef struct {
+  uint64_t mapping_id;
+  uint64_t pattern_offset;
+  uint64_t pattern_length;
+  uint64_t text_offset;
+  uint64_t text_length;
+} extract_pair_t;
+typedef struct {
+  // Mappings
+  uint64_t mapping_begin;
+  uint64_t mapping_end;
+  // Pairs extracted
+  extract_pair_t* pairs;
+  uint64_t num_pairs;
+  // Sequences extracted
+  char* sequences;
+  uint64_t sequences_length;
+  uint64_t sequences_allocated;
+  sequence_paf_buffer_t buffer;
+} extract_block_t;
+typedef struct {
+  sequence_paf_t* paf;
+  extract_block_t* blocks;
+} extract_task_t;
+uint64_t extract_block_append(
+    extract_block_t* const block,
+    const char* const sequence,
+    const uint64_t length) {
+  if (block->sequences_length + length > block->sequences_allocated) {
+    block->sequences_allocated = MAX(block->sequences_length+length,2*block->sequences_allocated);
+    block->sequences = realloc(block->sequences,block->sequences_allocated);
+  }
+  const uint64_t offset = block->sequences_length;
+  memcpy(block->sequences+offset,sequence,length);
+  block->sequences_length += length;
+  return offset;
+}
+void extract_block_thread(
+    void* const args,
+    const int thread_id,
+    const int num_threads) {
+  extract_task_t* const task = args;
+  extract_block_t* const block = task->blocks + thread_id;
+  block->num_pairs = 0;
+  block->sequences_length = 0;
+  uint64_t mapping_id;
+  for (mapping_id=block->mapping_begin;mapping_id<block->mapping_end;++mapping_id) {
+    // Extract pair
+    sequence_paf_mapping_t mapping;
+    char *pattern, *text;
+    uint64_t pattern_length, text_length;
+    sequence_paf_get_pair(task->paf,&block->buffer,mapping_id,
+        &mapping,&pattern,&pattern_length,&text,&text_length);
+    // Filter by length
+    if (pattern_length < parameters.min_length || pattern_length > parameters.max_length ||
+        text_length < parameters.min_length || text_length > parameters.max_length) continue;
+    // Store
+    extract_pair_t* const pair = block->pairs + (block->num_pairs)++;
+    pair->mapping_id = mapping_id;
+    pair->pattern_length = pattern_length;
+    pair->pattern_offset = extract_block_append(block,pattern,pattern_length);
+    pair->text_length = text_length;
+    pair->text_offset = extract_block_append(block,text,text_length);
+  }
+}
+/*
+ * Output
+ */
+void extract_block_write(
+    extract_block_t* const block,
+    sequence_paf_t* const paf,
+    FILE* const output_file,
+    sequence_pack_writer_t* const writer) {
+  uint64_t i;
+  for (i=0;i<block->num_pairs;++i) {
+    extract_pair_t* const pair = block->pairs + i;
+    const char* const pattern = block->sequences + pair->pattern_offset;
+    const char* const text = block->sequences + pair->text_offset;
+    if (writer != NULL) {
+      // Packed (query name as ID)
+      sequence_paf_mapping_t mapping;
+      sequence_paf_get_mapping(paf,pair->mapping_id,&mapping);
+      sequence_pack_pair_t metadata = {
+        .id = mapping.query_name,
+        .id_length = mapping.query_name_length,
+      };
+      sequence_pack_writer_add(writer,pattern,
+          pair->pattern_length,text,pair->text_length,&metadata);
+    } else {
+      fputc('>',output_file);
+      fwrite(pattern,1,pair->pattern_length,output_file);
+      fputs("\n<",output_file);
+      fwrite(text,1,pair->text_length,output_file);
+      fputc('\n',output_file);
+    }
+  }
+}
+/*
+ * Menu
+ */
+void usage() {
+  fprintf(stderr,
+      "USE: ./extract_pairs -p PATH -s PATH [OPTIONS]...\n"
+      "      Options::\n"
+      "        --paf|p             PATH        Input mappings (PAF)\n"
+      "        --sequences|s       PATH        FASTA/FASTQ with the targets (and the queries,\n"
+      "                                        unless --query-sequences); uses PATH.fai if present\n"
+      "        --query-sequences|q PATH        FASTA/FASTQ with the queries\n"
+      "        --output|o          PATH        Output sequence-pairs (default=stdout)\n"
+      "        --output-format     seq|wfp     Output format (default=seq)\n"
+      "        --min-length        INT         Skip pairs with a sequence shorter than INT\n"
+      "        --max-length        INT         Skip pairs with a sequence longer than INT\n"
+      "        --num-threads|t     INT         Extraction threads (default=1)\n"
+      "        --block-size        INT         Mappings extracted at once (default=10000)\n"
+      "        --help|h                        \n");
+}
+void parse_arguments(int argc,char** argv) {
+  struct option long_options[] = {
+    { "paf", required_argument, 0, 'p' },
+    { "sequences", required_argument, 0, 's' },
+    { "query-sequences", required_argument, 0, 'q' },
+    { "output", required_argument, 0, 'o' },
+    { "output-format", required_argument, 0, 1000 },
+    { "min-length", required_argument, 0, 1001 },
+    { "max-length", required_argument, 0, 1002 },
+    { "num-threads", required_argument, 0, 't' },
+    { "block-size", required_argument, 0, 1003 },
+    { "help", no_argument, 0, 'h' },
+    { 0, 0, 0, 0 } };
+  int c,option_index;
+  if (argc <= 1) {
+    usage();
+    exit(0);
+  }
+  while (1) {
+    c=getopt_long(argc,argv,"p:s:q:o:t:h",long_options,&option_index);
+    if (c==-1) break;
+    switch (c) {
+      case 'p':
+        parameters.paf = optarg;
+        break;
+      case 's':
+        parameters.sequences = optarg;
+        break;
+      case 'q':
+        parameters.query_sequences = optarg;
+        break;
+      case 'o':
+        parameters.output = optarg;
+        break;
+      case 1000: // --output-format
+        if (strcmp(optarg,"seq")==0) {
+          parameters.output_pack = false;
+        } else if (strcmp(optarg,"wfp")==0) {
+          parameters.output_pack = true;
+        } else {
+          fprintf(stderr,"Option '--output-format' must be in {'seq','wfp'}\n");
+          exit(1);
+        }
+        break;
+      case 1001: // --min-length
+        parameters.min_length = strtoull(optarg,NULL,10);
+        break;
+      case 1002: // --max-length
+        parameters.max_length = strtoull(optarg,NULL,10);
+        break;
+      case 't':
+        parameters.num_threads = MAX(atoi(optarg),1);
+        break;
+      case 1003: // --block-size
+        parameters.block_size = MAX(atoi(optarg),1);
+        break;
+      case 'h':
+        usage();
+        exit(1);
+      case '?': default:
+        fprintf(stderr,"Option not recognized \n"); exit(1);
+    }
+  }
+  if (parameters.paf == NULL || parameters.sequences == NULL) {
+    fprintf(stderr,"Option --paf and --sequences are mandatory\n");
+    exit(1);
+  }
+  if (parameters.output_pack && parameters.output == NULL) {
+    fprintf(stderr,"Option --output-format 'wfp' requires --output\n");
+    exit(1);
+  }
+}
+int main(int argc,char* argv[]) {
+  // Parsing command-line options
+  parse_arguments(argc,argv);
+  // Open input & output
+  sequence_paf_t* const paf = sequence_paf_new(
+      parameters.paf,parameters.sequences,parameters.query_sequences);
+  FILE* output_file = NULL;
+  sequence_pack_writer_t* writer = NULL;
+  if (parameters.output_pack) {
+    writer = sequence_pack_writer_new(parameters.output,SEQUENCE_PACK_HAS_ID);
+  } else {
+    output_file = (parameters.output == NULL) ? stdout : fopen(parameters.output,"w");
+    if (output_file == NULL) {
+      fprintf(stderr,"[ExtractPairs] Output file '%s' couldn't be opened\n",parameters.output);
+      exit(1);
+    }
+  }
+  // Blocks (one per thread)
+  const int num_threads = parameters.num_threads;
+  const uint64_t thread_mappings = DIV_CEIL(parameters.block_size,num_threads);
+  extract_block_t* const blocks = calloc(num_threads,sizeof(extract_block_t));
+  int i;
+  for (i=0;i<num_threads;++i) {
+    blocks[i].pairs = malloc(thread_mappings*sizeof(extract_pair_t));
+    sequence_paf_buffer_init(&blocks[i].buffer);
+  }
+  extract_task_t task = { .paf = paf, .blocks = blocks };
+  thread_team_t* const thread_team = thread_team_new(num_threads);
+  // Extract
+  uint64_t mapping_id, num_pairs = 0;
+  for (mapping_id=0;mapping_id<paf->num_mappings;mapping_id+=thread_mappings*num_threads) {
+    for (i=0;i<num_threads;++i) {
+      blocks[i].mapping_begin = MIN(mapping_id+i*thread_mappings,paf->num_mappings);
+      blocks[i].mapping_end = MIN(blocks[i].mapping_begin+thread_mappings,paf->num_mappings);
+    }
+    thread_team_run(thread_team,num_threads,extract_block_thread,&task);
+    for (i=0;i<num_threads;++i) {
+      extract_block_write(blocks+i,paf,output_file,writer);
+      num_pairs += blocks[i].num_pairs;
+    }
+  }
+  fprintf(stderr,"[ExtractPairs] Extracted %"PRIu64" pairs (out of %"PRIu64" mappings)\n",
+      num_pairs,paf->num_mappings);
+  // Close & free
+  thread_team_delete(thread_team);
+  for (i=0;i<num_threads;++i) {
+    free(blocks[i].pairs);
+    free(blocks[i].sequences);
+    sequence_paf_buffer_free(&blocks[i].buffer);
+  }
+  free(blocks);
+  if (writer != NULL) sequence_pack_writer_delete(writer);
+  if (output_file != NULL && output_file != stdout) fclose(output_file);
+  sequence_paf_delete(paf);
+  return 0;
+}
@@ -0,0 +1,293 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Converts sequence-pairs (.seq or FASTA) into a packed container (.wfp)
+ */
+
+#include "utils/commons.h"
+#include "utils/sequence_pack.h"
+#include <getopt.h>
+
+/*
+ * Parameters
+ */
+typedef struct {
+  char* input;
+  char* output;
+  char* scores;
+  bool ends_free;
+  int pattern_begin_free;
+  int pattern_end_free;
+  int text_begin_free;
+  int text_end_free;
+} pack_parameters_t;
+pack_parameters_t parameters = {
+  .input = NULL,
+  .output = NULL,
+  .scores = NULL,
+  .ends_free = false,
+};
+
+/*
+ * Input (one line at a time)
+ */
+typedef struct {
+  FILE* file;
+  char* line;
+  size_t line_allocated;
+  ssize_t line_length;       // Current line (-1 at EOF)
+} pack_input_t;
+void pack_input_next_line(
+    pack_input_t* const input) {
+  input->line_length = getline(&input->line,&input->line_allocated,input->file);
+  if (input->line_length < 0) return;
+  // Trim '\n' & '\r'
+  while (input->line_length > 0 &&
+         (input->line[input->line_length-1] == '\n' ||
+          input->line[input->line_length-1] == '\r')) {
+    input->line[--(input->line_length)] = '\0';
+  }
+}
+/*
+ * Sequence (growable)
+ */
+typedef struct {
+  char* buffer;
+  uint64_t length;
+  uint64_t allocated;
+} pack_sequence_t;
+void pack_sequence_append(
+    pack_sequence_t* const sequence,
+    const char* const data,
+    const uint64_t length) {
+  if (sequence->length + length + 1 > sequence->allocated) {
+    sequence->allocated = MAX(sequence->length+length+1,2*sequence->allocated);
+    sequence->buffer = realloc(sequence->buffer,sequence->allocated);
+  }
+  memcpy(sequence->buffer+sequence->length,data,length);
+  sequence->length += length;
+  sequence->buffer[sequence->length] = '\0';
+}
+/*
+ * FASTA record (header & sequence; possibly multi-line)
+ */
+bool pack_input_fasta_record(
+    pack_input_t* const input,
+    pack_sequence_t* const id,
+    pack_sequence_t* const sequence) {
+  // Header (ID is the first word)
+  while (input->line_length == 0) pack_input_next_line(input);
+  if (input->line_length < 0) return false;
+  if (input->line[0] != '>') {
+    fprintf(stderr,"[PackDataset] Error: expected a FASTA header ('>')\n");
+    exit(1);
+  }
+  id->length = 0;
+  pack_sequence_append(id,input->line+1,strcspn(input->line+1," \t"));
+  // Sequence lines
+  sequence->length = 0;
+  pack_sequence_append(sequence,"",0);
+  while (true) {
+    pack_input_next_line(input);
+    if (input->line_length < 0 || input->line[0] == '>') break;
+    pack_sequence_append(sequence,input->line,input->line_length);
+  }
+  return true;
+}
+/*
+ * Scores (first integer of each line; e.g. align_benchmark's output)
+ */
+int pack_scores_next(
+    FILE* const scores_file,
+    const uint64_t pair_id) {
+  int score;
+  if (fscanf(scores_file,"%d%*[^\n]",&score) != 1) {
+    fprintf(stderr,"[PackDataset] Error: missing expected score of pair %"PRIu64"\n",pair_id);
+    exit(1);
+  }
+  return score;
+}
+/*
+ * Menu
+ */
+void usage() {
+  fprintf(stderr,
+      "USE: ./pack_dataset -i PATH -o PATH [OPTIONS]...\n"
+      "      Options::\n"
+      "        --input|i          PATH        Input sequence-pairs (.seq or FASTA; auto-detected)\n"
+      "                                       FASTA records are paired consecutively\n"
+      "                                       (pattern, text); the pattern name is the pair ID\n"
+      "        --output|o         PATH        Output packed container (.wfp)\n"
+      "        --scores           PATH        Expected score of each pair (first integer\n"
+      "                                       of each line; e.g. align_benchmark --output)\n"
+      "        --ends-free        P0,Pf,T0,Tf Ends-free limits stored with every pair\n"
+      "        --help|h                       \n");
+}
+void parse_arguments(int argc,char** argv) {
+  struct option long_options[] = {
+    { "input", required_argument, 0, 'i' },
+    { "output", required_argument, 0, 'o' },
+    { "scores", required_argument, 0, 1000 },
+    { "ends-free", required_argument, 0, 1001 },
+    { "help", no_argument, 0, 'h' },
+    { 0, 0, 0, 0 } };
+  int c,option_index;
+  if (argc <= 1) {
+    usage();
+    exit(0);
+  }
+  while (1) {
+    c=getopt_long(argc,argv,"i:o:h",long_options,&option_index);
+    if (c==-1) break;
+    switch (c) {
+      case 'i':
+        parameters.input = optarg;
+        break;
+      case 'o':
+        parameters.output = optarg;
+        break;
+      case 1000: // --scores
+        parameters.scores = optarg;
+        break;
+      case 1001: { // --ends-free P0,Pf,T0,Tf
+        parameters.ends_free = true;
+        char* sentinel = strtok(optarg,",");
+        parameters.pattern_begin_free = atoi(sentinel);
+        sentinel = strtok(NULL,",");
+        parameters.pattern_end_free = atoi(sentinel);
+        sentinel = strtok(NULL,",");
+        parameters.text_begin_free = atoi(sentinel);
+        sentinel = strtok(NULL,",");
+        parameters.text_end_free = atoi(sentinel);
+        break;
+      }
+      case 'h':
+        usage();
+        exit(1);
+      case '?': default:
+        fprintf(stderr,"Option not recognized \n"); exit(1);
+    }
+  }
+  if (parameters.input == NULL || parameters.output == NULL) {
+    fprintf(stderr,"Option --input and --output are mandatory\n");
+    exit(1);
+  }
+}
+int main(int argc,char* argv[]) {
+  // Parsing command-line options
+  parse_arguments(argc,argv);
+  // Open input(s)
+  pack_input_t input = { .line = NULL, .line_allocated = 0 };
+  input.file = fopen(parameters.input,"r");
+  if (input.file == NULL) {
+    fprintf(stderr,"[PackDataset] Input file '%s' couldn't be opened\n",parameters.input);
+    exit(1);
+  }
+  FILE* scores_file = NULL;
+  if (parameters.scores != NULL) {
+    scores_file = fopen(parameters.scores,"r");
+    if (scores_file == NULL) {
+      fprintf(stderr,"[PackDataset] Scores file '%s' couldn't be opened\n",parameters.scores);
+      exit(1);
+    }
+  }
+  // Detect format (.seq lines come in '>','<' couples)
+  pack_sequence_t id = {0}, text_id = {0}, pattern = {0}, text = {0};
+  pack_input_next_line(&input);
+  pack_sequence_append(&pattern,input.line,MAX(input.line_length,0));
+  pack_input_next_line(&input);
+  const bool fasta = !(input.line_length > 0 && input.line[0] == '<');
+  // Open output
+  uint32_t flags = 0;
+  if (fasta) flags |= SEQUENCE_PACK_HAS_ID;
+  if (scores_file != NULL) flags |= SEQUENCE_PACK_HAS_SCORE;
+  if (parameters.ends_free) flags |= SEQUENCE_PACK_HAS_ENDS_FREE;
+  sequence_pack_writer_t* const writer = sequence_pack_writer_new(parameters.output,flags);
+  sequence_pack_pair_t metadata = {
+    .pattern_begin_free = parameters.pattern_begin_free,
+    .pattern_end_free = parameters.pattern_end_free,
+    .text_begin_free = parameters.text_begin_free,
+    .text_end_free = parameters.text_end_free,
+  };
+  // Convert
+  uint64_t num_pairs = 0, num_bases = 0;
+  if (fasta) {
+    // Rewind to the first header
+    rewind(input.file);
+    pack_input_next_line(&input);
+    while (pack_input_fasta_record(&input,&id,&pattern)) {
+      if (!pack_input_fasta_record(&input,&text_id,&text)) {
+        fprintf(stderr,"[PackDataset] Error: odd number of FASTA records (pattern without text)\n");
+        exit(1);
+      }
+      if (scores_file != NULL) metadata.score = pack_scores_next(scores_file,num_pairs);
+      metadata.id = id.buffer;
+      metadata.id_length = id.length;
+      sequence_pack_writer_add(writer,
+          pattern.buffer,pattern.length,text.buffer,text.length,&metadata);
+      num_bases += pattern.length + text.length;
+      ++num_pairs;
+    }
+  } else {
+    while (input.line_length >= 0) {
+      // Pattern ('>') already read; text ('<') is the current line
+      if (input.line_length == 0 || input.line[0] != '<' ||
+          pattern.length == 0 || pattern.buffer[0] != '>') {
+        fprintf(stderr,"[PackDataset] Error: malformed .seq input (pair %"PRIu64")\n",num_pairs);
+        exit(1);
+      }
+      if (scores_file != NULL) metadata.score = pack_scores_next(scores_file,num_pairs);
+      sequence_pack_writer_add(writer,
+          pattern.buffer+1,pattern.length-1,input.line+1,input.line_length-1,&metadata);
+      num_bases += pattern.length + input.line_length - 2;
+      ++num_pairs;
+      // Next pair
+      pack_input_next_line(&input);
+      if (input.line_length < 0) break;
+      pattern.length = 0;
+      pack_sequence_append(&pattern,input.line,input.line_length);
+      pack_input_next_line(&input);
+      if (input.line_length < 0) {
+        fprintf(stderr,"[PackDataset] Error: odd number of lines (pattern without text)\n");
+        exit(1);
+      }
+    }
+  }
+  // Close & free
+  sequence_pack_writer_delete(writer);
+  fprintf(stderr,"[PackDataset] Packed %"PRIu64" pairs (%"PRIu64" bases) into '%s'\n",
+      num_pairs,num_bases,parameters.output);
+  fclose(input.file);
+  if (scores_file != NULL) fclose(scores_file);
+  free(input.line);
+  free(id.buffer);
+  free(text_id.buffer);
+  free(pattern.buffer);
+  free(text.buffer);
+  return 0;
+}
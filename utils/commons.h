@@ -64,6 +64,21 @@
 #include <assert.h>
 #include <signal.h>
 
+/*
+ * Sequence coordinates (lengths, positions & diagonals)
+ */
+#ifdef WFA_OFFSET_64
+typedef int64_t wf_coord_t;
+#define WF_COORD_MIN INT64_MIN
+#define WF_COORD_MAX INT64_MAX
+#define PRIcoord PRId64
+#else
+typedef int wf_coord_t;
+#define WF_COORD_MIN INT_MIN
+#define WF_COORD_MAX INT_MAX
+#define PRIcoord "d"
+#endif
+
 /*
  * Macro Utils (Stringify)
  */
@@ -58,4 +58,13 @@ const char dna_decode_table[DNA_EXTENDED_RANGE] =
   [ENC_DNA_CHAR_T] = DNA_CHAR_T,
   [ENC_DNA_CHAR_N] = DNA_CHAR_N,
 };
-
+const char dna_complement_table[256] =
+{
+  [0 ... 255] = 'N',
+  ['A'] = 'T', ['C'] = 'G', ['G'] = 'C', ['T'] = 'A', ['N'] = 'N',
+  ['a'] = 't', ['c'] = 'g', ['g'] = 'c', ['t'] = 'a', ['n'] = 'n',
+  ['R'] = 'Y', ['Y'] = 'R', ['K'] = 'M', ['M'] = 'K', ['S'] = 'S', ['W'] = 'W',
+  ['r'] = 'y', ['y'] = 'r', ['k'] = 'm', ['m'] = 'k', ['s'] = 's', ['w'] = 'w',
+  ['B'] = 'V', ['V'] = 'B', ['D'] = 'H', ['H'] = 'D',
+  ['b'] = 'v', ['v'] = 'b', ['d'] = 'h', ['h'] = 'd',
+};
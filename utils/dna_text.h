@@ -66,11 +66,13 @@
  */
 extern const uint8_t dna_encode_table[256];
 extern const char dna_decode_table[DNA_EXTENDED_RANGE];
+extern const char dna_complement_table[256];
 
 /*
  * Translation functions
  */
 #define dna_encode(character)     (dna_encode_table[(int)(character)])
 #define dna_decode(enc_char)      (dna_decode_table[(int)(enc_char)])
+#define dna_complement(character) (dna_complement_table[(uint8_t)(character)])
 
 #endif /* DNA_TEXT_H_ */
@@ -42,10 +42,10 @@
  */
 heatmap_t* heatmap_new(
     const heatmap_type type,
-    const int min_v,
-    const int max_v,
-    const int min_h,
-    const int max_h,
+    const wf_coord_t min_v,
+    const wf_coord_t max_v,
+    const wf_coord_t min_h,
+    const wf_coord_t max_h,
     const int resolution_points) {
   // Alloc
   heatmap_t* const heatmap = (heatmap_t*)malloc(sizeof(heatmap_t));
@@ -56,9 +56,9 @@ heatmap_t* heatmap_new(
   heatmap->min_h = min_h;
   heatmap->max_h = max_h;
   // Binning (mantain aspect ratio)
-  const int v_range = (max_v-min_v+1);
-  const int h_range = (max_h-min_h+1);
-  const int max_range = MAX(v_range,h_range);
+  const wf_coord_t v_range = (max_v-min_v+1);
+  const wf_coord_t h_range = (max_h-min_h+1);
+  const wf_coord_t max_range = MAX(v_range,h_range);
   if (max_range <= resolution_points) {
     heatmap->binning_factor = 1.0f;
     heatmap->num_rows = v_range;
@@ -116,8 +116,8 @@ void heatmap_delete(
  */
 void heatmap_set(
     heatmap_t* const heatmap,
-    const int v,
-    const int h,
+    const wf_coord_t v,
+    const wf_coord_t h,
     const int value) {
   // Paramters
   const int num_rows = heatmap->num_rows;
@@ -48,10 +48,10 @@ typedef struct {
   int num_rows;
   int num_columns;
   // Range
-  int min_v;
-  int max_v;
-  int min_h;
-  int max_h;
+  wf_coord_t min_v;
+  wf_coord_t max_v;
+  wf_coord_t min_h;
+  wf_coord_t max_h;
   float binning_factor;
   // Data
   int** values;
@@ -62,10 +62,10 @@ typedef struct {
  */
 heatmap_t* heatmap_new(
     const heatmap_type type,
-    const int min_v,
-    const int max_v,
-    const int min_h,
-    const int max_h,
+    const wf_coord_t min_v,
+    const wf_coord_t max_v,
+    const wf_coord_t min_h,
+    const wf_coord_t max_h,
     const int resolution_points);
 void heatmap_clear(
     heatmap_t* const heatmap);
@@ -77,8 +77,8 @@ void heatmap_delete(
  */
 void heatmap_set(
     heatmap_t* const heatmap,
-    const int v,
-    const int h,
+    const wf_coord_t v,
+    const wf_coord_t h,
     const int value);
 
 /*
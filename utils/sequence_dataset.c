@@ -0,0 +1,262 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Memory-mapped dataset of sequence-pairs (.seq format)
+ */
+
+#include "utils/sequence_dataset.h"
+#include "system/thread_team.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/*
+ * Newline scanning
+ */
+typedef struct {
+  // Chunk
+  const char* memory;       // File contents
+  uint64_t begin;           // Chunk begin
+  uint64_t end;             // Chunk end (excluded)
+  // Newlines found
+  uint64_t* line_ends;      // Positions
+  uint64_t num_lines;       // Used
+  uint64_t lines_allocated; // Allocated
+} sequence_dataset_chunk_t;
+void sequence_dataset_chunk_add(
+    sequence_dataset_chunk_t* const chunk,
+    const uint64_t position) {
+  if (chunk->num_lines == chunk->lines_allocated) {
+    chunk->lines_allocated = MAX(2*chunk->lines_allocated,1024);
+    chunk->line_ends = realloc(chunk->line_ends,chunk->lines_allocated*sizeof(uint64_t));
+    if (chunk->line_ends == NULL) {
+      fprintf(stderr,"[SequenceDataset] Error allocating line index\n");
+      exit(1);
+    }
+  }
+  chunk->line_ends[chunk->num_lines++] = position;
+}
+void sequence_dataset_chunk_scan(
+    sequence_dataset_chunk_t* const chunk) {
+  const char* const memory = chunk->memory;
+  uint64_t position = chunk->begin;
+  // Scan blocks (one comparison per byte-lane; then visit the newlines found)
+#if defined(__AVX2__)
+  const __m256i newlines = _mm256_set1_epi8('\n');
+  for (;position+32<=chunk->end;position+=32) {
+    const __m256i block = _mm256_loadu_si256((const __m256i*)(memory+position));
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block,newlines));
+    while (mask) {
+      sequence_dataset_chunk_add(chunk,position+__builtin_ctz(mask));
+      mask &= mask-1;
+    }
+  }
+#elif defined(__SSE2__)
+  const __m128i newlines = _mm_set1_epi8('\n');
+  for (;position+16<=chunk->end;position+=16) {
+    const __m128i block = _mm_loadu_si128((const __m128i*)(memory+position));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block,newlines));
+    while (mask) {
+      sequence_dataset_chunk_add(chunk,position+__builtin_ctz(mask));
+      mask &= mask-1;
+    }
+  }
+#endif
+  // Scan the remainder
+  for (;position<chunk->end;++position) {
+    if (memory[position] == '\n') sequence_dataset_chunk_add(chunk,position);
+  }
+}
+void sequence_dataset_scan_thread(
+    void* const args,
+    const int thread_id,
+    const int num_threads) {
+  sequence_dataset_chunk_t* const chunks = args;
+  sequence_dataset_chunk_scan(chunks+thread_id);
+}
+void sequence_dataset_index(
+    sequence_dataset_t* const dataset,
+    const int num_threads) {
+  // Split the file into chunks (one per thread)
+  const int num_chunks = (dataset->size >= BUFFER_SIZE_1M) ? MAX(num_threads,1) : 1;
+  sequence_dataset_chunk_t* const chunks = calloc(num_chunks,sizeof(sequence_dataset_chunk_t));
+  int i;
+  for (i=0;i<num_chunks;++i) {
+    chunks[i].memory = dataset->memory;
+    chunks[i].begin = (dataset->size*i)/num_chunks;
+    chunks[i].end = (dataset->size*(i+1))/num_chunks;
+  }
+  // Scan chunks in parallel
+  if (num_chunks > 1) {
+    thread_team_t* const thread_team = thread_team_new(num_chunks);
+    thread_team_run(thread_team,num_chunks,sequence_dataset_scan_thread,chunks);
+    thread_team_delete(thread_team);
+  } else {
+    sequence_dataset_chunk_scan(chunks);
+  }
+  // Merge chunks (in order)
+  uint64_t num_lines = 0;
+  for (i=0;i<num_chunks;++i) num_lines += chunks[i].num_lines;
+  const bool last_line_open = (dataset->size > 0 && dataset->memory[dataset->size-1] != '\n');
+  if (last_line_open) ++num_lines; // Last line without '\n'
+  dataset->line_ends = malloc(MAX(num_lines,1)*sizeof(uint64_t));
+  uint64_t* line_ends = dataset->line_ends;
+  for (i=0;i<num_chunks;++i) {
+    if (chunks[i].num_lines > 0) {
+      memcpy(line_ends,chunks[i].line_ends,chunks[i].num_lines*sizeof(uint64_t));
+      line_ends += chunks[i].num_lines;
+    }
+    free(chunks[i].line_ends);
+  }
+  if (last_line_open) *line_ends = dataset->size;
+  free(chunks);
+  // Pairs
+  if (num_lines % 2 != 0) {
+    fprintf(stderr,"[SequenceDataset] Error: odd number of lines (pattern without text)\n");
+    exit(1);
+  }
+  dataset->num_lines = num_lines;
+  dataset->num_pairs = num_lines/2;
+}
+/*
+ * Setup
+ */
+void sequence_dataset_load(
+    sequence_dataset_t* const dataset,
+    const int fd) {
+  // Read the whole input (e.g. pipes)
+  uint64_t allocated = BUFFER_SIZE_1M;
+  dataset->memory = malloc(allocated);
+  dataset->size = 0;
+  while (true) {
+    if (dataset->size == allocated) {
+      allocated *= 2;
+      dataset->memory = realloc(dataset->memory,allocated);
+    }
+    const ssize_t bytes = read(fd,dataset->memory+dataset->size,allocated-dataset->size);
+    if (bytes < 0) {
+      fprintf(stderr,"[SequenceDataset] Error reading input\n");
+      exit(1);
+    }
+    if (bytes == 0) break;
+    dataset->size += bytes;
+  }
+  dataset->mapped = false;
+}
+sequence_dataset_t* sequence_dataset_new(
+    const char* const filename,
+    const int num_threads) {
+  // Alloc
+  sequence_dataset_t* const dataset = malloc(sizeof(sequence_dataset_t));
+  // Open
+  const int fd = open(filename,O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr,"[SequenceDataset] Input file '%s' couldn't be opened\n",filename);
+    exit(1);
+  }
+  // Map (regular files) or load (otherwise)
+  struct stat file_stat;
+  dataset->memory = NULL;
+  if (fstat(fd,&file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+    dataset->size = file_stat.st_size;
+    void* const memory = mmap(NULL,dataset->size,PROT_READ,MAP_PRIVATE,fd,0);
+    if (memory != MAP_FAILED) {
+      dataset->memory = memory;
+      dataset->mapped = true;
+    }
+  }
+  if (dataset->memory == NULL) sequence_dataset_load(dataset,fd);
+  close(fd);
+  // Index lines
+  sequence_dataset_index(dataset,num_threads);
+  // Return
+  return dataset;
+}
+void sequence_dataset_delete(
+    sequence_dataset_t* const dataset) {
+  if (dataset->mapped) {
+    munmap(dataset->memory,dataset->size);
+  } else {
+    free(dataset->memory);
+  }
+  free(dataset->line_ends);
+  free(dataset);
+}
+/*
+ * Accessors
+ */
+void sequence_dataset_get_line(
+    sequence_dataset_t* const dataset,
+    const uint64_t line_id,
+    char** const sequence,
+    uint64_t* const sequence_length) {
+  // Line boundaries (skip the '>'/'<' tag; trim '\r')
+  const uint64_t line_begin = (line_id == 0) ? 0 : dataset->line_ends[line_id-1] + 1;
+  uint64_t line_end = dataset->line_ends[line_id];
+  if (line_end > line_begin && dataset->memory[line_end-1] == '\r') --line_end;
+  const uint64_t sequence_begin = MIN(line_begin+1,line_end);
+  *sequence = dataset->memory + sequence_begin;
+  *sequence_length = line_end - sequence_begin;
+}
+void sequence_dataset_get_pair(
+    sequence_dataset_t* const dataset,
+    const uint64_t pair_id,
+    char** const pattern,
+    uint64_t* const pattern_length,
+    char** const text,
+    uint64_t* const text_length) {
+  sequence_dataset_get_line(dataset,2*pair_id,pattern,pattern_length);
+  sequence_dataset_get_line(dataset,2*pair_id+1,text,text_length);
+}
+/*
+ * Iterator
+ */
+void sequence_dataset_iterator_init(
+    sequence_dataset_iterator_t* const iterator,
+    sequence_dataset_t* const dataset,
+    const uint64_t pair_begin,
+    const uint64_t pair_end) {
+  iterator->dataset = dataset;
+  iterator->pair_id = MIN(pair_begin,dataset->num_pairs);
+  iterator->pair_end = MIN(pair_end,dataset->num_pairs);
+}
+bool sequence_dataset_iterator_next(
+    sequence_dataset_iterator_t* const iterator,
+    char** const pattern,
+    uint64_t* const pattern_length,
+    char** const text,
+    uint64_t* const text_length) {
+  if (iterator->pair_id >= iterator->pair_end) return false;
+  sequence_dataset_get_pair(iterator->dataset,
+      iterator->pair_id,pattern,pattern_length,text,text_length);
+  ++(iterator->pair_id);
+  return true;
+}
@@ -0,0 +1,101 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Memory-mapped dataset of sequence-pairs (.seq format)
+ *   The file is mapped read-only and its line boundaries are indexed in
+ *   parallel. Patterns and texts are handed out as pointers into the mapping
+ *   (no copies). Note they are not NULL-terminated; always use their lengths.
+ *   Format (one pair every two lines):
+ *     >PATTERN
+ *     <TEXT
+ */
+
+#ifndef SEQUENCE_DATASET_H_
+#define SEQUENCE_DATASET_H_
+
+#include "utils/commons.h"
+
+/*
+ * Dataset
+ */
+typedef struct {
+  // Input
+  char* memory;             // File contents (mapped; or loaded if the input is not mappable)
+  uint64_t size;            // File size
+  bool mapped;              // File is memory-mapped
+  // Index
+  uint64_t* line_ends;      // End of each line (position of its '\n', or the file size)
+  uint64_t num_lines;       // Total lines
+  uint64_t num_pairs;       // Total sequence-pairs
+} sequence_dataset_t;
+
+/*
+ * Iterator (over a range of pairs; e.g. a shard)
+ */
+typedef struct {
+  sequence_dataset_t* dataset;  // Dataset
+  uint64_t pair_id;             // Next pair
+  uint64_t pair_end;            // End of the range (excluded)
+} sequence_dataset_iterator_t;
+
+/*
+ * Setup
+ */
+sequence_dataset_t* sequence_dataset_new(
+    const char* const filename,
+    const int num_threads);
+void sequence_dataset_delete(
+    sequence_dataset_t* const dataset);
+
+/*
+ * Accessors
+ */
+void sequence_dataset_get_pair(
+    sequence_dataset_t* const dataset,
+    const uint64_t pair_id,
+    char** const pattern,
+    uint64_t* const pattern_length,
+    char** const text,
+    uint64_t* const text_length);
+
+/*
+ * Iterator
+ */
+void sequence_dataset_iterator_init(
+    sequence_dataset_iterator_t* const iterator,
+    sequence_dataset_t* const dataset,
+    const uint64_t pair_begin,
+    const uint64_t pair_end);
+bool sequence_dataset_iterator_next(
+    sequence_dataset_iterator_t* const iterator,
+    char** const pattern,
+    uint64_t* const pattern_length,
+    char** const text,
+    uint64_t* const text_length);
+
+#endif /* SEQUENCE_DATASET_H_ */
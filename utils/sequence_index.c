@@ -0,0 +1,324 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Memory-mapped FASTA/FASTQ file indexed by sequence name
+ */
+
+#include "utils/sequence_index.h"
+#include "utils/dna_text.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Records
+ */
+sequence_index_record_t* sequence_index_add(
+    sequence_index_t* const index) {
+  if (index->num_records == index->records_allocated) {
+    index->records_allocated = MAX(2*index->records_allocated,1024);
+    index->records = realloc(index->records,
+        index->records_allocated*sizeof(sequence_index_record_t));
+    if (index->records == NULL) {
+      fprintf(stderr,"[SequenceIndex] Error allocating records\n");
+      exit(1);
+    }
+  }
+  return index->records + (index->num_records)++;
+}
+uint64_t sequence_index_hash(
+    const char* const name,
+    const uint64_t name_length) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  uint64_t i;
+  for (i=0;i<name_length;++i) {
+    hash = (hash ^ (uint8_t)name[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+void sequence_index_table_build(
+    sequence_index_t* const index) {
+  // Allocate (load factor <= 0.5)
+  index->table_size = 16;
+  while (index->table_size < 2*index->num_records) index->table_size *= 2;
+  index->table = calloc(index->table_size,sizeof(uint64_t));
+  // Insert (first record wins on duplicated names)
+  const uint64_t mask = index->table_size - 1;
+  uint64_t i;
+  for (i=0;i<index->num_records;++i) {
+    sequence_index_record_t* const record = index->records + i;
+    uint64_t slot = sequence_index_hash(record->name,record->name_length) & mask;
+    while (index->table[slot] != 0) {
+      sequence_index_record_t* const other = index->records + (index->table[slot]-1);
+      if (other->name_length == record->name_length &&
+          memcmp(other->name,record->name,record->name_length) == 0) break;
+      slot = (slot+1) & mask;
+    }
+    if (index->table[slot] == 0) index->table[slot] = i+1;
+  }
+}
+/*
+ * Scan (no .fai available)
+ */
+uint64_t sequence_index_line_end(
+    sequence_index_t* const index,
+    const uint64_t position) {
+  const char* const line_end = memchr(index->memory+position,'\n',index->size-position);
+  return (line_end != NULL) ? (uint64_t)(line_end - index->memory) : index->size;
+}
+uint64_t sequence_index_line_length(
+    sequence_index_t* const index,
+    const uint64_t line_begin,
+    const uint64_t line_end) {
+  // Line length (without '\r')
+  uint64_t length = line_end - line_begin;
+  if (length > 0 && index->memory[line_end-1] == '\r') --length;
+  return length;
+}
+void sequence_index_scan(
+    sequence_index_t* const index) {
+  const char* const memory = index->memory;
+  const uint64_t size = index->size;
+  uint64_t position = 0;
+  while (position < size) {
+    // Header (skip blank lines)
+    uint64_t line_end = sequence_index_line_end(index,position);
+    if (sequence_index_line_length(index,position,line_end) == 0) {
+      position = line_end + 1;
+      continue;
+    }
+    const char tag = memory[position];
+    if (tag != '>' && tag != '@') {
+      fprintf(stderr,"[SequenceIndex] Error: expected a FASTA/FASTQ header ('>' or '@')\n");
+      exit(1);
+    }
+    const bool fastq = (tag == '@');
+    sequence_index_record_t* const record = sequence_index_add(index);
+    record->name = memory + position + 1;
+    record->name_length = 0;
+    while (position+1+record->name_length < line_end &&
+           !isspace(record->name[record->name_length])) ++(record->name_length);
+    position = line_end + 1;
+    // Sequence lines
+    record->offset = MIN(position,size);
+    record->length = 0;
+    record->line_bases = 0;
+    record->line_width = 0;
+    bool last_line = false;
+    while (position < size) {
+      if (memory[position] == (fastq ? '+' : '>')) break;
+      line_end = sequence_index_line_end(index,position);
+      const uint64_t line_bases = sequence_index_line_length(index,position,line_end);
+      const uint64_t line_width = line_end + 1 - position;
+      if (line_bases == 0) { // Blank line (ends the record)
+        position = line_end + 1;
+        break;
+      }
+      if (record->line_bases == 0) {
+        record->line_bases = line_bases;
+        record->line_width = line_width;
+      } else if (last_line || line_bases > record->line_bases ||
+                 line_width - line_bases != record->line_width - record->line_bases) {
+        fprintf(stderr,"[SequenceIndex] Error: record '%.*s' has lines of different lengths\n",
+            (int)record->name_length,record->name);
+        exit(1);
+      }
+      if (line_bases < record->line_bases) last_line = true;
+      record->length += line_bases;
+      position = line_end + 1;
+    }
+    // Qualities (FASTQ)
+    if (fastq) {
+      if (position >= size || memory[position] != '+') {
+        fprintf(stderr,"[SequenceIndex] Error: record '%.*s' has no qualities\n",
+            (int)record->name_length,record->name);
+        exit(1);
+      }
+      position = sequence_index_line_end(index,position) + 1;
+      uint64_t qualities = 0;
+      while (qualities < record->length && position < size) {
+        line_end = sequence_index_line_end(index,position);
+        qualities += sequence_index_line_length(index,position,line_end);
+        position = line_end + 1;
+      }
+    }
+  }
+}
+/*
+ * Load .fai (name, length, offset, line-bases, line-width[, qualities-offset])
+ */
+bool sequence_index_load_fai(
+    sequence_index_t* const index,
+    const char* const filename) {
+  // Read the whole index
+  char* const fai_filename = malloc(strlen(filename)+5);
+  sprintf(fai_filename,"%s.fai",filename);
+  FILE* const fai_file = fopen(fai_filename,"r");
+  free(fai_filename);
+  if (fai_file == NULL) return false;
+  fseek(fai_file,0,SEEK_END);
+  const long fai_size = ftell(fai_file);
+  rewind(fai_file);
+  index->fai_memory = malloc(fai_size+1);
+  if (fread(index->fai_memory,1,fai_size,fai_file) != (size_t)fai_size) {
+    fprintf(stderr,"[SequenceIndex] Error reading index of '%s'\n",filename);
+    exit(1);
+  }
+  index->fai_memory[fai_size] = '\0';
+  fclose(fai_file);
+  // Parse records
+  char* line = index->fai_memory;
+  while (*line != '\0') {
+    char* const line_end = line + strcspn(line,"\n");
+    const bool last = (*line_end == '\0');
+    *line_end = '\0';
+    if (*line != '\0') {
+      sequence_index_record_t* const record = sequence_index_add(index);
+      char* field = strchr(line,'\t');
+      if (field == NULL) {
+        fprintf(stderr,"[SequenceIndex] Error: malformed index of '%s'\n",filename);
+        exit(1);
+      }
+      record->name = line;
+      record->name_length = field - line;
+      record->length = strtoull(field+1,&field,10);
+      record->offset = strtoull(field+1,&field,10);
+      record->line_bases = strtoul(field+1,&field,10);
+      record->line_width = strtoul(field+1,&field,10);
+      // Check bounds
+      const uint64_t last_line = (record->line_bases > 0) ? (record->length-1)/record->line_bases : 0;
+      if (record->length > 0 && (record->line_bases == 0 ||
+          record->offset + last_line*record->line_width + (record->length-1)%record->line_bases >= index->size)) {
+        fprintf(stderr,"[SequenceIndex] Error: index of '%s' doesn't match the file (record '%.*s')\n",
+            filename,(int)record->name_length,record->name);
+        exit(1);
+      }
+    }
+    if (last) break;
+    line = line_end + 1;
+  }
+  return true;
+}
+/*
+ * Setup
+ */
+sequence_index_t* sequence_index_new(
+    const char* const filename) {
+  // Alloc
+  sequence_index_t* const index = malloc(sizeof(sequence_index_t));
+  index->fai_memory = NULL;
+  index->records = NULL;
+  index->num_records = 0;
+  index->records_allocated = 0;
+  // Open & map
+  const int fd = open(filename,O_RDONLY);
+  struct stat file_stat;
+  if (fd < 0 || fstat(fd,&file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+    fprintf(stderr,"[SequenceIndex] Sequence file '%s' couldn't be opened (must be a regular file)\n",filename);
+    exit(1);
+  }
+  index->size = file_stat.st_size;
+  index->memory = NULL;
+  if (index->size > 0) {
+    index->memory = mmap(NULL,index->size,PROT_READ,MAP_PRIVATE,fd,0);
+    if (index->memory == MAP_FAILED) {
+      fprintf(stderr,"[SequenceIndex] Sequence file '%s' couldn't be mapped\n",filename);
+      exit(1);
+    }
+  }
+  close(fd);
+  // Index records (.fai or scan)
+  if (!sequence_index_load_fai(index,filename)) sequence_index_scan(index);
+  sequence_index_table_build(index);
+  // Return
+  return index;
+}
+void sequence_index_delete(
+    sequence_index_t* const index) {
+  if (index->memory != NULL) munmap(index->memory,index->size);
+  free(index->fai_memory);
+  free(index->records);
+  free(index->table);
+  free(index);
+}
+/*
+ * Accessors
+ */
+sequence_index_record_t* sequence_index_lookup(
+    sequence_index_t* const index,
+    const char* const name,
+    const uint64_t name_length) {
+  const uint64_t mask = index->table_size - 1;
+  uint64_t slot = sequence_index_hash(name,name_length) & mask;
+  while (index->table[slot] != 0) {
+    sequence_index_record_t* const record = index->records + (index->table[slot]-1);
+    if (record->name_length == name_length &&
+        memcmp(record->name,name,name_length) == 0) return record;
+    slot = (slot+1) & mask;
+  }
+  return NULL;
+}
+void sequence_index_extract(
+    sequence_index_t* const index,
+    sequence_index_record_t* const record,
+    const uint64_t begin,
+    const uint64_t end,
+    const bool reverse_complement,
+    char* const buffer) {
+  // Check range
+  if (begin > end || end > record->length) {
+    fprintf(stderr,"[SequenceIndex] Error: range [%"PRIu64",%"PRIu64") out of record '%.*s' (%"PRIu64" bases)\n",
+        begin,end,(int)record->name_length,record->name,record->length);
+    exit(1);
+  }
+  // Copy line by line
+  const char* const sequence = index->memory + record->offset;
+  const uint64_t line_bases = record->line_bases;
+  char* output = buffer;
+  uint64_t position = begin;
+  while (position < end) {
+    const uint64_t line = position / line_bases;
+    const uint64_t column = position % line_bases;
+    const uint64_t length = MIN(line_bases-column,end-position);
+    memcpy(output,sequence+line*record->line_width+column,length);
+    output += length;
+    position += length;
+  }
+  // Reverse-complement (in place)
+  if (reverse_complement) {
+    const uint64_t length = end - begin;
+    uint64_t i;
+    for (i=0;i<length/2;++i) {
+      const char base = buffer[i];
+      buffer[i] = dna_complement(buffer[length-1-i]);
+      buffer[length-1-i] = dna_complement(base);
+    }
+    if (length % 2 == 1) buffer[length/2] = dna_complement(buffer[length/2]);
+  }
+}
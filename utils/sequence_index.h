@@ -0,0 +1,90 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Memory-mapped FASTA/FASTQ file indexed by sequence name
+ *   Records are located using the samtools-style index (<file>.fai) if
+ *   present, or by scanning the mapped file otherwise. Any range of a record
+ *   can then be extracted (reverse-complemented if needed) straight from
+ *   the mapping. Multi-line records must have lines of the same length
+ *   (except the last one), as required by the .fai format.
+ */
+
+#ifndef SEQUENCE_INDEX_H_
+#define SEQUENCE_INDEX_H_
+
+#include "utils/commons.h"
+
+/*
+ * Index
+ */
+typedef struct {
+  const char* name;           // Name (not NULL-terminated)
+  uint32_t name_length;       // Name length
+  uint32_t line_bases;        // Bases per line
+  uint32_t line_width;        // Bytes per line (including the newline)
+  uint64_t offset;            // Offset of the first base
+  uint64_t length;            // Total bases
+} sequence_index_record_t;
+typedef struct {
+  // File
+  char* memory;               // File contents (mapped)
+  uint64_t size;              // File size
+  char* fai_memory;           // Index file contents (names of the records)
+  // Records
+  sequence_index_record_t* records;
+  uint64_t num_records;
+  uint64_t records_allocated;
+  // Lookup (hash-table of record positions; open addressing)
+  uint64_t* table;            // Record position+1 (0 if empty)
+  uint64_t table_size;        // Power of 2
+} sequence_index_t;
+
+/*
+ * Setup
+ */
+sequence_index_t* sequence_index_new(
+    const char* const filename);
+void sequence_index_delete(
+    sequence_index_t* const index);
+
+/*
+ * Accessors
+ */
+sequence_index_record_t* sequence_index_lookup(
+    sequence_index_t* const index,
+    const char* const name,
+    const uint64_t name_length);
+void sequence_index_extract(
+    sequence_index_t* const index,
+    sequence_index_record_t* const record,
+    const uint64_t begin,
+    const uint64_t end,
+    const bool reverse_complement,
+    char* const buffer);
+
+#endif /* SEQUENCE_INDEX_H_ */
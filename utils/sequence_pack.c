@@ -0,0 +1,414 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Packed container of sequence-pairs (.wfp format)
+ */
+
+#include "utils/sequence_pack.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Constants
+ */
+#define SEQUENCE_PACK_ALIGN(size)   ((((size)+7)/8)*8)
+#define SEQUENCE_PACK_PACKED_SIZE(length) SEQUENCE_PACK_ALIGN(((length)+3)/4)
+#define SEQUENCE_PACK_NO_CODE 0xFF
+
+static const char sequence_pack_bases[4] = {'A','C','G','T'};
+
+/*
+ * Encode/Decode tables
+ */
+uint8_t sequence_pack_encode_table[256];
+uint32_t sequence_pack_decode_table[256];  // Byte => 4 bases
+bool sequence_pack_tables_ready = false;
+void sequence_pack_tables_init() {
+  if (sequence_pack_tables_ready) return;
+  // Encode (only uppercase ACGT; anything else is an exception)
+  memset(sequence_pack_encode_table,SEQUENCE_PACK_NO_CODE,sizeof(sequence_pack_encode_table));
+  int i;
+  for (i=0;i<4;++i) sequence_pack_encode_table[(uint8_t)sequence_pack_bases[i]] = i;
+  // Decode
+  for (i=0;i<256;++i) {
+    char bases[4];
+    int j;
+    for (j=0;j<4;++j) bases[j] = sequence_pack_bases[(i >> (2*j)) & 3];
+    memcpy(sequence_pack_decode_table+i,bases,4);
+  }
+  sequence_pack_tables_ready = true;
+}
+/*
+ * Setup
+ */
+bool sequence_pack_probe(
+    const char* const filename) {
+  // Only regular files (don't consume pipes)
+  const int fd = open(filename,O_RDONLY);
+  if (fd < 0) return false;
+  struct stat file_stat;
+  char magic[8];
+  const bool is_pack =
+      fstat(fd,&file_stat) == 0 && S_ISREG(file_stat.st_mode) &&
+      read(fd,magic,sizeof(magic)) == sizeof(magic) &&
+      memcmp(magic,SEQUENCE_PACK_MAGIC,sizeof(magic)) == 0;
+  close(fd);
+  return is_pack;
+}
+sequence_pack_t* sequence_pack_new(
+    const char* const filename) {
+  sequence_pack_tables_init();
+  // Open
+  const int fd = open(filename,O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr,"[SequencePack] Input file '%s' couldn't be opened\n",filename);
+    exit(1);
+  }
+  struct stat file_stat;
+  if (fstat(fd,&file_stat) != 0 || !S_ISREG(file_stat.st_mode) ||
+      (uint64_t)file_stat.st_size < sizeof(sequence_pack_header_t)) {
+    fprintf(stderr,"[SequencePack] Input file '%s' is not a valid pack\n",filename);
+    exit(1);
+  }
+  // Map
+  sequence_pack_t* const pack = malloc(sizeof(sequence_pack_t));
+  pack->size = file_stat.st_size;
+  pack->memory = mmap(NULL,pack->size,PROT_READ,MAP_PRIVATE,fd,0);
+  close(fd);
+  if (pack->memory == MAP_FAILED) {
+    fprintf(stderr,"[SequencePack] Input file '%s' couldn't be mapped\n",filename);
+    exit(1);
+  }
+  // Check header & index
+  const sequence_pack_header_t* const header = (sequence_pack_header_t*)pack->memory;
+  if (memcmp(header->magic,SEQUENCE_PACK_MAGIC,sizeof(header->magic)) != 0 ||
+      header->version != SEQUENCE_PACK_VERSION) {
+    fprintf(stderr,"[SequencePack] Input file '%s' is not a valid pack (or version %u)\n",
+        filename,SEQUENCE_PACK_VERSION);
+    exit(1);
+  }
+  const uint64_t index_size = (header->num_pairs+1)*sizeof(uint64_t);
+  if (header->index_offset % 8 != 0 ||
+      header->index_offset > pack->size ||
+      index_size > pack->size - header->index_offset) {
+    fprintf(stderr,"[SequencePack] Input file '%s' is truncated\n",filename);
+    exit(1);
+  }
+  pack->flags = header->flags;
+  pack->num_pairs = header->num_pairs;
+  pack->index = (uint64_t*)(pack->memory + header->index_offset);
+  if (pack->index[pack->num_pairs] > header->index_offset) {
+    fprintf(stderr,"[SequencePack] Input file '%s' has a corrupted index\n",filename);
+    exit(1);
+  }
+  // Return
+  return pack;
+}
+void sequence_pack_delete(
+    sequence_pack_t* const pack) {
+  munmap(pack->memory,pack->size);
+  free(pack);
+}
+/*
+ * Accessors
+ */
+const uint8_t* sequence_pack_get_sequence(
+    const uint8_t* memory,
+    const uint64_t length,
+    const uint32_t num_exceptions,
+    sequence_pack_sequence_t* const sequence) {
+  sequence->length = length;
+  sequence->num_exceptions = num_exceptions;
+  sequence->packed = memory;
+  memory += SEQUENCE_PACK_PACKED_SIZE(length);
+  sequence->exceptions = (sequence_pack_exception_t*)memory;
+  return memory + num_exceptions*sizeof(sequence_pack_exception_t);
+}
+void sequence_pack_get_pair(
+    sequence_pack_t* const pack,
+    const uint64_t pair_id,
+    sequence_pack_pair_t* const pair) {
+  // Locate record
+  const uint64_t begin = pack->index[pair_id];
+  const uint64_t end = pack->index[pair_id+1];
+  if (begin > end || end - begin < sizeof(sequence_pack_record_t)) {
+    fprintf(stderr,"[SequencePack] Corrupted pair %"PRIu64"\n",pair_id);
+    exit(1);
+  }
+  const sequence_pack_record_t* const record = (sequence_pack_record_t*)(pack->memory + begin);
+  const uint8_t* memory = (uint8_t*)(record+1);
+  // Metadata
+  pair->id = (char*)memory;
+  pair->id_length = record->id_length;
+  pair->score = record->score;
+  pair->pattern_begin_free = record->pattern_begin_free;
+  pair->pattern_end_free = record->pattern_end_free;
+  pair->text_begin_free = record->text_begin_free;
+  pair->text_end_free = record->text_end_free;
+  memory += SEQUENCE_PACK_ALIGN(record->id_length);
+  // Sequences
+  memory = sequence_pack_get_sequence(memory,
+      record->pattern_length,record->pattern_num_exceptions,&pair->pattern);
+  memory = sequence_pack_get_sequence(memory,
+      record->text_length,record->text_num_exceptions,&pair->text);
+  if (memory > pack->memory + end) {
+    fprintf(stderr,"[SequencePack] Corrupted pair %"PRIu64"\n",pair_id);
+    exit(1);
+  }
+}
+void sequence_pack_shard(
+    sequence_pack_t* const pack,
+    const uint64_t shard_id,
+    const uint64_t num_shards,
+    uint64_t* const pair_begin,
+    uint64_t* const pair_end) {
+  // Contiguous ranges of (almost) the same number of pairs
+  *pair_begin = (pack->num_pairs*shard_id)/num_shards;
+  *pair_end = (pack->num_pairs*(shard_id+1))/num_shards;
+}
+/*
+ * Decode
+ */
+void sequence_pack_decode(
+    const sequence_pack_sequence_t* const sequence,
+    char* const buffer) {
+  // Unpack 4 bases per byte
+  const uint8_t* const packed = sequence->packed;
+  const uint64_t length = sequence->length;
+  const uint64_t num_bytes = length/4;
+  uint64_t i;
+  for (i=0;i<num_bytes;++i) {
+    memcpy(buffer+4*i,sequence_pack_decode_table+packed[i],4);
+  }
+  for (i=4*num_bytes;i<length;++i) {
+    buffer[i] = sequence_pack_bases[(packed[i/4] >> (2*(i%4))) & 3];
+  }
+  // Patch exceptions
+  const sequence_pack_exception_t* const exceptions = sequence->exceptions;
+  for (i=0;i<sequence->num_exceptions;++i) {
+    const uint64_t position = MIN(exceptions[i].position,length);
+    const uint64_t run_length = MIN(exceptions[i].length,length-position);
+    memset(buffer+position,exceptions[i].symbol,run_length);
+  }
+}
+void sequence_pack_decoder_init(
+    sequence_pack_decoder_t* const decoder) {
+  decoder->buffer = NULL;
+  decoder->buffer_allocated = 0;
+}
+void sequence_pack_decoder_free(
+    sequence_pack_decoder_t* const decoder) {
+  free(decoder->buffer);
+}
+void sequence_pack_decoder_get_pair(
+    sequence_pack_decoder_t* const decoder,
+    sequence_pack_t* const pack,
+    const uint64_t pair_id,
+    sequence_pack_pair_t* const pair,
+    char** const pattern,
+    char** const text) {
+  // Locate pair
+  sequence_pack_get_pair(pack,pair_id,pair);
+  const uint64_t pattern_length = pair->pattern.length;
+  const uint64_t text_length = pair->text.length;
+  // Allocate (both NULL-terminated)
+  const uint64_t buffer_size = pattern_length + text_length + 2;
+  if (buffer_size > decoder->buffer_allocated) {
+    decoder->buffer_allocated = MAX(buffer_size,2*decoder->buffer_allocated);
+    free(decoder->buffer);
+    decoder->buffer = malloc(decoder->buffer_allocated);
+  }
+  // Decode
+  *pattern = decoder->buffer;
+  *text = decoder->buffer + pattern_length + 1;
+  sequence_pack_decode(&pair->pattern,*pattern);
+  sequence_pack_decode(&pair->text,*text);
+  (*pattern)[pattern_length] = '\0';
+  (*text)[text_length] = '\0';
+}
+/*
+ * Writer
+ */
+sequence_pack_writer_t* sequence_pack_writer_new(
+    const char* const filename,
+    const uint32_t flags) {
+  sequence_pack_tables_init();
+  // Alloc
+  sequence_pack_writer_t* const writer = malloc(sizeof(sequence_pack_writer_t));
+  writer->file = fopen(filename,"wb");
+  if (writer->file == NULL) {
+    fprintf(stderr,"[SequencePack] Output file '%s' couldn't be opened\n",filename);
+    exit(1);
+  }
+  writer->flags = flags;
+  writer->num_pairs = 0;
+  writer->index_allocated = 1024;
+  writer->index = malloc(writer->index_allocated*sizeof(uint64_t));
+  writer->packed = NULL;
+  writer->packed_allocated = 0;
+  writer->exceptions = NULL;
+  writer->exceptions_allocated = 0;
+  // Header placeholder (completed on close)
+  sequence_pack_header_t header;
+  memset(&header,0,sizeof(header));
+  fwrite(&header,sizeof(header),1,writer->file);
+  writer->offset = sizeof(header);
+  // Return
+  return writer;
+}
+void sequence_pack_writer_write(
+    sequence_pack_writer_t* const writer,
+    const void* const data,
+    const uint64_t size) {
+  // Write (zero-padded to 8 bytes)
+  static const uint8_t padding[8] = {0};
+  const uint64_t padded_size = SEQUENCE_PACK_ALIGN(size);
+  if ((size > 0 && fwrite(data,size,1,writer->file) != 1) ||
+      (padded_size > size && fwrite(padding,padded_size-size,1,writer->file) != 1)) {
+    fprintf(stderr,"[SequencePack] Error writing output\n");
+    exit(1);
+  }
+  writer->offset += padded_size;
+}
+void sequence_pack_writer_reserve(
+    sequence_pack_writer_t* const writer,
+    const uint64_t packed_size) {
+  if (packed_size <= writer->packed_allocated) return;
+  writer->packed_allocated = MAX(packed_size,2*writer->packed_allocated);
+  free(writer->packed);
+  writer->packed = malloc(writer->packed_allocated);
+}
+uint32_t sequence_pack_writer_encode(
+    sequence_pack_writer_t* const writer,
+    const char* const sequence,
+    const uint64_t length,
+    uint8_t* const packed,
+    const uint32_t exceptions_begin) {
+  // Pack bases (and collect runs of any other symbol)
+  memset(packed,0,SEQUENCE_PACK_PACKED_SIZE(length));
+  uint32_t num_exceptions = exceptions_begin;
+  uint64_t i;
+  for (i=0;i<length;++i) {
+    const uint8_t code = sequence_pack_encode_table[(uint8_t)sequence[i]];
+    if (code != SEQUENCE_PACK_NO_CODE) {
+      packed[i/4] |= code << (2*(i%4));
+      continue;
+    }
+    // Extend the last run or open a new one
+    if (num_exceptions > exceptions_begin) {
+      sequence_pack_exception_t* const last = writer->exceptions + num_exceptions - 1;
+      if (last->symbol == sequence[i] && last->position + last->length == i &&
+          last->length < UINT32_MAX) {
+        ++(last->length);
+        continue;
+      }
+    }
+    if (num_exceptions == writer->exceptions_allocated) {
+      writer->exceptions_allocated = MAX(2*writer->exceptions_allocated,64);
+      writer->exceptions = realloc(writer->exceptions,
+          writer->exceptions_allocated*sizeof(sequence_pack_exception_t));
+    }
+    sequence_pack_exception_t* const exception = writer->exceptions + num_exceptions++;
+    memset(exception,0,sizeof(sequence_pack_exception_t));
+    exception->position = i;
+    exception->length = 1;
+    exception->symbol = sequence[i];
+  }
+  return num_exceptions - exceptions_begin;
+}
+void sequence_pack_writer_add(
+    sequence_pack_writer_t* const writer,
+    const char* const pattern,
+    const uint64_t pattern_length,
+    const char* const text,
+    const uint64_t text_length,
+    const sequence_pack_pair_t* const metadata) {
+  // Index
+  if (writer->num_pairs+1 >= writer->index_allocated) {
+    writer->index_allocated *= 2;
+    writer->index = realloc(writer->index,writer->index_allocated*sizeof(uint64_t));
+  }
+  writer->index[writer->num_pairs++] = writer->offset;
+  // Record
+  sequence_pack_record_t record;
+  memset(&record,0,sizeof(record));
+  record.pattern_length = pattern_length;
+  record.text_length = text_length;
+  if (metadata != NULL) {
+    if (writer->flags & SEQUENCE_PACK_HAS_ID) record.id_length = metadata->id_length;
+    if (writer->flags & SEQUENCE_PACK_HAS_SCORE) record.score = metadata->score;
+    if (writer->flags & SEQUENCE_PACK_HAS_ENDS_FREE) {
+      record.pattern_begin_free = metadata->pattern_begin_free;
+      record.pattern_end_free = metadata->pattern_end_free;
+      record.text_begin_free = metadata->text_begin_free;
+      record.text_end_free = metadata->text_end_free;
+    }
+  }
+  // Encode (pattern then text; exceptions of both in a row)
+  const uint64_t pattern_packed_size = SEQUENCE_PACK_PACKED_SIZE(pattern_length);
+  const uint64_t text_packed_size = SEQUENCE_PACK_PACKED_SIZE(text_length);
+  sequence_pack_writer_reserve(writer,pattern_packed_size+text_packed_size);
+  record.pattern_num_exceptions = sequence_pack_writer_encode(
+      writer,pattern,pattern_length,writer->packed,0);
+  record.text_num_exceptions = sequence_pack_writer_encode(
+      writer,text,text_length,writer->packed+pattern_packed_size,record.pattern_num_exceptions);
+  // Write
+  sequence_pack_writer_write(writer,&record,sizeof(record));
+  if (record.id_length > 0) sequence_pack_writer_write(writer,metadata->id,record.id_length);
+  sequence_pack_writer_write(writer,writer->packed,pattern_packed_size);
+  sequence_pack_writer_write(writer,writer->exceptions,
+      record.pattern_num_exceptions*sizeof(sequence_pack_exception_t));
+  sequence_pack_writer_write(writer,writer->packed+pattern_packed_size,text_packed_size);
+  sequence_pack_writer_write(writer,writer->exceptions+record.pattern_num_exceptions,
+      record.text_num_exceptions*sizeof(sequence_pack_exception_t));
+}
+void sequence_pack_writer_delete(
+    sequence_pack_writer_t* const writer) {
+  // Index
+  writer->index[writer->num_pairs] = writer->offset;
+  sequence_pack_header_t header;
+  memset(&header,0,sizeof(header));
+  memcpy(header.magic,SEQUENCE_PACK_MAGIC,sizeof(header.magic));
+  header.version = SEQUENCE_PACK_VERSION;
+  header.flags = writer->flags;
+  header.num_pairs = writer->num_pairs;
+  header.index_offset = writer->offset;
+  sequence_pack_writer_write(writer,writer->index,(writer->num_pairs+1)*sizeof(uint64_t));
+  // Header
+  fseek(writer->file,0,SEEK_SET);
+  if (fwrite(&header,sizeof(header),1,writer->file) != 1 || fclose(writer->file) != 0) {
+    fprintf(stderr,"[SequencePack] Error writing output\n");
+    exit(1);
+  }
+  // Free
+  free(writer->index);
+  free(writer->packed);
+  free(writer->exceptions);
+  free(writer);
+}
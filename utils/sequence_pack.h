@@ -0,0 +1,205 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Packed container of sequence-pairs (.wfp format)
+ *   Binary alternative to the .seq format. Bases are 2-bit packed (A=0,C=1,
+ *   G=2,T=3; 4 bases per byte) and any other symbol (e.g. N) is kept as a run
+ *   in an exception list. Pairs are indexed by offset, so any pair (or range of
+ *   pairs; e.g. a shard) can be reached in O(1) from the mapped file.
+ *   Layout (host byte order; all sections aligned to 8 bytes):
+ *     [Header]
+ *     [Pair] x num_pairs
+ *       [Record] [ID] [Packed pattern] [Pattern exceptions]
+ *                     [Packed text] [Text exceptions]
+ *     [Index] num_pairs+1 offsets (last one marks the end of the pairs)
+ */
+
+#ifndef SEQUENCE_PACK_H_
+#define SEQUENCE_PACK_H_
+
+#include "utils/commons.h"
+
+/*
+ * File format
+ */
+#define SEQUENCE_PACK_MAGIC          "WFAPACK\0"
+#define SEQUENCE_PACK_VERSION        1
+
+#define SEQUENCE_PACK_HAS_ID         0x00000001u // Pairs carry an ID
+#define SEQUENCE_PACK_HAS_SCORE      0x00000002u // Pairs carry an expected score
+#define SEQUENCE_PACK_HAS_ENDS_FREE  0x00000004u // Pairs carry ends-free limits
+
+typedef struct {
+  char magic[8];                 // SEQUENCE_PACK_MAGIC
+  uint32_t version;              // SEQUENCE_PACK_VERSION
+  uint32_t flags;                // Metadata present (SEQUENCE_PACK_HAS_*)
+  uint64_t num_pairs;            // Total sequence-pairs
+  uint64_t index_offset;         // Offset of the pair index
+  uint64_t reserved[4];
+} sequence_pack_header_t;
+typedef struct {
+  uint64_t pattern_length;       // Pattern length (bases)
+  uint64_t text_length;          // Text length (bases)
+  uint32_t pattern_num_exceptions;
+  uint32_t text_num_exceptions;
+  uint32_t id_length;            // ID length (0 if none)
+  int32_t score;                 // Expected score (if SEQUENCE_PACK_HAS_SCORE)
+  int32_t pattern_begin_free;    // Ends-free (if SEQUENCE_PACK_HAS_ENDS_FREE)
+  int32_t pattern_end_free;
+  int32_t text_begin_free;
+  int32_t text_end_free;
+} sequence_pack_record_t;
+typedef struct {
+  uint64_t position;             // First base of the run
+  uint32_t length;               // Run length
+  char symbol;                   // Symbol of the run (e.g. 'N')
+  char padding[3];
+} sequence_pack_exception_t;
+
+/*
+ * Pair (view into the mapped file; nothing is copied)
+ */
+typedef struct {
+  const uint8_t* packed;                        // Packed bases
+  uint64_t length;                              // Length (bases)
+  const sequence_pack_exception_t* exceptions;  // Non-ACGT runs
+  uint32_t num_exceptions;                      // Total runs
+} sequence_pack_sequence_t;
+typedef struct {
+  // Sequences
+  sequence_pack_sequence_t pattern;
+  sequence_pack_sequence_t text;
+  // Metadata
+  const char* id;                // ID (not NULL-terminated)
+  uint32_t id_length;
+  int score;
+  int pattern_begin_free;
+  int pattern_end_free;
+  int text_begin_free;
+  int text_end_free;
+} sequence_pack_pair_t;
+
+/*
+ * Pack (reader)
+ */
+typedef struct {
+  // File
+  uint8_t* memory;               // File contents (mapped)
+  uint64_t size;                 // File size
+  // Contents
+  uint32_t flags;                // Metadata present
+  uint64_t num_pairs;            // Total sequence-pairs
+  const uint64_t* index;         // Offset of each pair (num_pairs+1)
+} sequence_pack_t;
+
+/*
+ * Decoder (unpacked sequences; reused across pairs)
+ */
+typedef struct {
+  char* buffer;                  // Pattern followed by text
+  uint64_t buffer_allocated;     // Allocated
+} sequence_pack_decoder_t;
+
+/*
+ * Writer
+ */
+typedef struct {
+  // Output
+  FILE* file;                    // Output file
+  uint64_t offset;               // Current offset
+  uint32_t flags;                // Metadata written
+  // Index
+  uint64_t* index;               // Offset of each pair
+  uint64_t num_pairs;            // Pairs written
+  uint64_t index_allocated;      // Allocated
+  // Encoding buffers
+  uint8_t* packed;               // Packed bases
+  uint64_t packed_allocated;
+  sequence_pack_exception_t* exceptions;
+  uint64_t exceptions_allocated;
+} sequence_pack_writer_t;
+
+/*
+ * Setup
+ */
+bool sequence_pack_probe(
+    const char* const filename);
+sequence_pack_t* sequence_pack_new(
+    const char* const filename);
+void sequence_pack_delete(
+    sequence_pack_t* const pack);
+
+/*
+ * Accessors
+ */
+void sequence_pack_get_pair(
+    sequence_pack_t* const pack,
+    const uint64_t pair_id,
+    sequence_pack_pair_t* const pair);
+void sequence_pack_shard(
+    sequence_pack_t* const pack,
+    const uint64_t shard_id,
+    const uint64_t num_shards,
+    uint64_t* const pair_begin,
+    uint64_t* const pair_end);
+
+/*
+ * Decode
+ */
+void sequence_pack_decode(
+    const sequence_pack_sequence_t* const sequence,
+    char* const buffer);
+void sequence_pack_decoder_init(
+    sequence_pack_decoder_t* const decoder);
+void sequence_pack_decoder_free(
+    sequence_pack_decoder_t* const decoder);
+void sequence_pack_decoder_get_pair(
+    sequence_pack_decoder_t* const decoder,
+    sequence_pack_t* const pack,
+    const uint64_t pair_id,
+    sequence_pack_pair_t* const pair,
+    char** const pattern,
+    char** const text);
+
+/*
+ * Writer
+ */
+sequence_pack_writer_t* sequence_pack_writer_new(
+    const char* const filename,
+    const uint32_t flags);
+void sequence_pack_writer_add(
+    sequence_pack_writer_t* const writer,
+    const char* const pattern,
+    const uint64_t pattern_length,
+    const char* const text,
+    const uint64_t text_length,
+    const sequence_pack_pair_t* const metadata);
+void sequence_pack_writer_delete(
+    sequence_pack_writer_t* const writer);
+
+#endif /* SEQUENCE_PACK_H_ */
@@ -0,0 +1,211 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Sequence-pairs from PAF mappings (on indexed FASTA/FASTQ)
+ */
+
+#include "utils/sequence_paf.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Index PAF lines (skip blank lines and comments)
+ */
+void sequence_paf_index(
+    sequence_paf_t* const paf) {
+  uint64_t lines_allocated = 1024;
+  paf->line_begins = malloc(lines_allocated*sizeof(uint64_t));
+  paf->num_mappings = 0;
+  uint64_t position = 0;
+  while (position < paf->size) {
+    const char* const line_end = memchr(paf->memory+position,'\n',paf->size-position);
+    const uint64_t next = (line_end != NULL) ? (uint64_t)(line_end-paf->memory)+1 : paf->size;
+    const char first = paf->memory[position];
+    if (first != '\n' && first != '\r' && first != '#') {
+      if (paf->num_mappings == lines_allocated) {
+        lines_allocated *= 2;
+        paf->line_begins = realloc(paf->line_begins,lines_allocated*sizeof(uint64_t));
+      }
+      paf->line_begins[paf->num_mappings++] = position;
+    }
+    position = next;
+  }
+}
+/*
+ * Setup
+ */
+sequence_paf_t* sequence_paf_new(
+    const char* const paf_filename,
+    const char* const target_filename,
+    const char* const query_filename) {
+  // Alloc
+  sequence_paf_t* const paf = malloc(sizeof(sequence_paf_t));
+  // Open & map PAF
+  const int fd = open(paf_filename,O_RDONLY);
+  struct stat file_stat;
+  if (fd < 0 || fstat(fd,&file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+    fprintf(stderr,"[SequencePAF] PAF file '%s' couldn't be opened (must be a regular file)\n",paf_filename);
+    exit(1);
+  }
+  paf->size = file_stat.st_size;
+  paf->memory = NULL;
+  if (paf->size > 0) {
+    paf->memory = mmap(NULL,paf->size,PROT_READ,MAP_PRIVATE,fd,0);
+    if (paf->memory == MAP_FAILED) {
+      fprintf(stderr,"[SequencePAF] PAF file '%s' couldn't be mapped\n",paf_filename);
+      exit(1);
+    }
+  }
+  close(fd);
+  sequence_paf_index(paf);
+  // Sequences
+  paf->target_index = sequence_index_new(target_filename);
+  paf->query_index = (query_filename == NULL || strcmp(query_filename,target_filename) == 0) ?
+      paf->target_index : sequence_index_new(query_filename);
+  // Return
+  return paf;
+}
+void sequence_paf_delete(
+    sequence_paf_t* const paf) {
+  if (paf->query_index != paf->target_index) sequence_index_delete(paf->query_index);
+  sequence_index_delete(paf->target_index);
+  if (paf->memory != NULL) munmap(paf->memory,paf->size);
+  free(paf->line_begins);
+  free(paf);
+}
+/*
+ * Accessors
+ */
+void sequence_paf_error(
+    sequence_paf_t* const paf,
+    const uint64_t mapping_id,
+    const char* const message) {
+  const char* const line = paf->memory + paf->line_begins[mapping_id];
+  const char* const line_end = memchr(line,'\n',paf->memory+paf->size-line);
+  const int line_length = (line_end != NULL) ? line_end-line : paf->memory+paf->size-line;
+  fprintf(stderr,"[SequencePAF] Error: %s (mapping %"PRIu64": '%.*s')\n",
+      message,mapping_id,MIN(line_length,200),line);
+  exit(1);
+}
+void sequence_paf_get_mapping(
+    sequence_paf_t* const paf,
+    const uint64_t mapping_id,
+    sequence_paf_mapping_t* const mapping) {
+  // Split the first 9 columns
+  const char* fields[9];
+  uint64_t lengths[9];
+  const char* position = paf->memory + paf->line_begins[mapping_id];
+  const char* const end = paf->memory + paf->size;
+  int i;
+  for (i=0;i<9;++i) {
+    fields[i] = position;
+    while (position < end && *position != '\t' && *position != '\n' && *position != '\r') ++position;
+    lengths[i] = position - fields[i];
+    if (i < 8 && (position == end || *position != '\t')) {
+      sequence_paf_error(paf,mapping_id,"less than 9 columns");
+    }
+    ++position;
+  }
+  // Coordinates
+  uint64_t values[9] = {0};
+  const int numeric_fields[6] = {1,2,3,6,7,8};
+  for (i=0;i<6;++i) {
+    const int field = numeric_fields[i];
+    uint64_t j;
+    if (lengths[field] == 0) sequence_paf_error(paf,mapping_id,"empty coordinate");
+    for (j=0;j<lengths[field];++j) {
+      const char digit = fields[field][j];
+      if (digit < '0' || digit > '9') sequence_paf_error(paf,mapping_id,"invalid coordinate");
+      values[field] = 10*values[field] + (digit - '0');
+    }
+  }
+  if (lengths[4] != 1 || (fields[4][0] != '+' && fields[4][0] != '-')) {
+    sequence_paf_error(paf,mapping_id,"invalid strand");
+  }
+  // Mapping
+  mapping->query_name = fields[0];
+  mapping->query_name_length = lengths[0];
+  mapping->query_length = values[1];
+  mapping->query_begin = values[2];
+  mapping->query_end = values[3];
+  mapping->reverse = (fields[4][0] == '-');
+  mapping->target_name = fields[5];
+  mapping->target_name_length = lengths[5];
+  mapping->target_length = values[6];
+  mapping->target_begin = values[7];
+  mapping->target_end = values[8];
+  if (mapping->query_begin > mapping->query_end || mapping->target_begin > mapping->target_end) {
+    sequence_paf_error(paf,mapping_id,"invalid range");
+  }
+}
+void sequence_paf_buffer_init(
+    sequence_paf_buffer_t* const buffer) {
+  buffer->buffer = NULL;
+  buffer->buffer_allocated = 0;
+}
+void sequence_paf_buffer_free(
+    sequence_paf_buffer_t* const buffer) {
+  free(buffer->buffer);
+}
+void sequence_paf_get_pair(
+    sequence_paf_t* const paf,
+    sequence_paf_buffer_t* const buffer,
+    const uint64_t mapping_id,
+    sequence_paf_mapping_t* const mapping,
+    char** const pattern,
+    uint64_t* const pattern_length,
+    char** const text,
+    uint64_t* const text_length) {
+  // Locate sequences
+  sequence_paf_get_mapping(paf,mapping_id,mapping);
+  sequence_index_record_t* const query = sequence_index_lookup(
+      paf->query_index,mapping->query_name,mapping->query_name_length);
+  if (query == NULL) sequence_paf_error(paf,mapping_id,"query not found");
+  sequence_index_record_t* const target = sequence_index_lookup(
+      paf->target_index,mapping->target_name,mapping->target_name_length);
+  if (target == NULL) sequence_paf_error(paf,mapping_id,"target not found");
+  *pattern_length = mapping->query_end - mapping->query_begin;
+  *text_length = mapping->target_end - mapping->target_begin;
+  // Allocate (both NULL-terminated)
+  const uint64_t buffer_size = *pattern_length + *text_length + 2;
+  if (buffer_size > buffer->buffer_allocated) {
+    buffer->buffer_allocated = MAX(buffer_size,2*buffer->buffer_allocated);
+    free(buffer->buffer);
+    buffer->buffer = malloc(buffer->buffer_allocated);
+  }
+  // Extract
+  *pattern = buffer->buffer;
+  *text = buffer->buffer + *pattern_length + 1;
+  sequence_index_extract(paf->query_index,query,
+      mapping->query_begin,mapping->query_end,mapping->reverse,*pattern);
+  sequence_index_extract(paf->target_index,target,
+      mapping->target_begin,mapping->target_end,false,*text);
+  (*pattern)[*pattern_length] = '\0';
+  (*text)[*text_length] = '\0';
+}
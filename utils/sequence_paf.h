@@ -0,0 +1,115 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Sequence-pairs from PAF mappings (on indexed FASTA/FASTQ)
+ *   The PAF file is mapped and its lines indexed; each mapping is turned into
+ *   a sequence-pair on demand, extracting the query range (pattern) and the
+ *   target range (text) from the mapped sequence files. The query is
+ *   reverse-complemented on the '-' strand. Pairs can be fetched from any
+ *   thread (each one with its own buffer).
+ */
+
+#ifndef SEQUENCE_PAF_H_
+#define SEQUENCE_PAF_H_
+
+#include "utils/commons.h"
+#include "utils/sequence_index.h"
+
+/*
+ * Mapping (PAF columns 1-9)
+ */
+typedef struct {
+  // Query (pattern)
+  const char* query_name;         // Name (not NULL-terminated)
+  uint32_t query_name_length;
+  uint64_t query_length;          // Full length
+  uint64_t query_begin;           // Range (0-based; end excluded)
+  uint64_t query_end;
+  bool reverse;                   // Strand '-'
+  // Target (text)
+  const char* target_name;        // Name (not NULL-terminated)
+  uint32_t target_name_length;
+  uint64_t target_length;         // Full length
+  uint64_t target_begin;          // Range (0-based; end excluded)
+  uint64_t target_end;
+} sequence_paf_mapping_t;
+
+/*
+ * PAF
+ */
+typedef struct {
+  // Mappings
+  char* memory;                   // PAF contents (mapped)
+  uint64_t size;                  // PAF size
+  uint64_t* line_begins;          // Begin of each mapping line
+  uint64_t num_mappings;          // Total mappings
+  // Sequences
+  sequence_index_t* query_index;  // Queries
+  sequence_index_t* target_index; // Targets (can be the same as the queries)
+} sequence_paf_t;
+
+/*
+ * Buffer (extracted sequences; one per thread)
+ */
+typedef struct {
+  char* buffer;                   // Pattern followed by text
+  uint64_t buffer_allocated;      // Allocated
+} sequence_paf_buffer_t;
+
+/*
+ * Setup
+ */
+sequence_paf_t* sequence_paf_new(
+    const char* const paf_filename,
+    const char* const target_filename,
+    const char* const query_filename);
+void sequence_paf_delete(
+    sequence_paf_t* const paf);
+
+/*
+ * Accessors
+ */
+void sequence_paf_get_mapping(
+    sequence_paf_t* const paf,
+    const uint64_t mapping_id,
+    sequence_paf_mapping_t* const mapping);
+void sequence_paf_buffer_init(
+    sequence_paf_buffer_t* const buffer);
+void sequence_paf_buffer_free(
+    sequence_paf_buffer_t* const buffer);
+void sequence_paf_get_pair(
+    sequence_paf_t* const paf,
+    sequence_paf_buffer_t* const buffer,
+    const uint64_t mapping_id,
+    sequence_paf_mapping_t* const mapping,
+    char** const pattern,
+    uint64_t* const pattern_length,
+    char** const text,
+    uint64_t* const text_length);
+
+#endif /* SEQUENCE_PAF_H_ */
@@ -37,23 +37,23 @@
  */
 void strings_padded_add_padding(
     const char* const buffer,
-    const int buffer_length,
-    const int begin_padding_length,
-    const int end_padding_length,
+    const wf_coord_t buffer_length,
+    const wf_coord_t begin_padding_length,
+    const wf_coord_t end_padding_length,
     const char padding_value,
     char** const buffer_padded,
     char** const buffer_padded_begin,
     const bool reverse_sequence,
     mm_allocator_t* const mm_allocator) {
   // Allocate
-  const int buffer_padded_length = begin_padding_length + buffer_length + end_padding_length;
+  const wf_coord_t buffer_padded_length = begin_padding_length + buffer_length + end_padding_length;
   *buffer_padded = mm_allocator_malloc(mm_allocator,buffer_padded_length);
   // Add begin padding
   memset(*buffer_padded,padding_value,begin_padding_length);
   // Copy buffer
   *buffer_padded_begin = *buffer_padded + begin_padding_length;
   if (reverse_sequence) {
-    int i;
+    wf_coord_t i;
     for (i=0;i<buffer_length;i++) {
       (*buffer_padded_begin)[i] = buffer[buffer_length-1-i];
     }
@@ -65,9 +65,9 @@ void strings_padded_add_padding(
 }
 strings_padded_t* strings_padded_new(
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const int padding_length,
     const bool reverse_sequences,
     mm_allocator_t* const mm_allocator) {
@@ -75,11 +75,11 @@ strings_padded_t* strings_padded_new(
   strings_padded_t* const strings_padded =
       mm_allocator_alloc(mm_allocator,strings_padded_t);
   strings_padded->mm_allocator = mm_allocator;
-  // Compute padding dimensions
-  const int pattern_begin_padding_length = 0;
-  const int pattern_end_padding_length = padding_length;
-  const int text_begin_padding_length = 0;
-  const int text_end_padding_length = padding_length;
+  // Compute padding dimensions (both ends; allows reading backwards)
+  const wf_coord_t pattern_begin_padding_length = padding_length;
+  const wf_coord_t pattern_end_padding_length = padding_length;
+  const wf_coord_t text_begin_padding_length = padding_length;
+  const wf_coord_t text_end_padding_length = padding_length;
   // Add padding
   strings_padded_add_padding(
       pattern,pattern_length,
@@ -93,14 +93,17 @@ strings_padded_t* strings_padded_new(
       &(strings_padded->text_padded_buffer),
       &(strings_padded->text_padded),
       reverse_sequences,mm_allocator);
+  // Set lengths
+  strings_padded->pattern_length = pattern_length;
+  strings_padded->text_length = text_length;
   // Return
   return strings_padded;
 }
 strings_padded_t* strings_padded_new_rhomb(
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const int padding_length,
     const bool reverse_sequences,
     mm_allocator_t* const mm_allocator) {
@@ -109,10 +112,10 @@ strings_padded_t* strings_padded_new_rhomb(
       mm_allocator_alloc(mm_allocator,strings_padded_t);
   strings_padded->mm_allocator = mm_allocator;
   // Compute padding dimensions
-  const int pattern_begin_padding_length = text_length + padding_length;
-  const int pattern_end_padding_length = pattern_length + text_length + padding_length;
-  const int text_begin_padding_length = padding_length;
-  const int text_end_padding_length = text_length + padding_length;
+  const wf_coord_t pattern_begin_padding_length = text_length + padding_length;
+  const wf_coord_t pattern_end_padding_length = pattern_length + text_length + padding_length;
+  const wf_coord_t text_begin_padding_length = padding_length;
+  const wf_coord_t text_end_padding_length = text_length + padding_length;
   // Add padding
   strings_padded_add_padding(
       pattern,pattern_length,
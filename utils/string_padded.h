@@ -43,8 +43,8 @@
  */
 typedef struct {
   // Dimensions
-  int pattern_length;
-  int text_length;
+  wf_coord_t pattern_length;
+  wf_coord_t text_length;
   // Padded strings
   char* pattern_padded;
   char* text_padded;
@@ -59,17 +59,17 @@ typedef struct {
  */
 strings_padded_t* strings_padded_new(
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const int padding_length,
     const bool reverse_sequences,
     mm_allocator_t* const mm_allocator);
 strings_padded_t* strings_padded_new_rhomb(
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const int padding_length,
     const bool reverse_sequences,
     mm_allocator_t* const mm_allocator);
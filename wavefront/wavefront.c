@@ -38,14 +38,16 @@ void wavefront_allocate(
     wavefront_t* const wavefront,
     const int wf_elements_allocated,
     const bool allocate_backtrace,
+    const bool pcigar_64bits,
     mm_allocator_t* const mm_allocator) {
   // Allocate memory
   wavefront->wf_elements_allocated = wf_elements_allocated;
   wavefront->offsets_mem = mm_allocator_calloc(
       mm_allocator,wf_elements_allocated,wf_offset_t,false);
+  wavefront->bt_pcigar_64bits = pcigar_64bits;
   if (allocate_backtrace) {
-    wavefront->bt_pcigar_mem = mm_allocator_calloc(
-        mm_allocator,wf_elements_allocated,pcigar_t,false);
+    wavefront->bt_pcigar_mem = mm_allocator_malloc(
+        mm_allocator,wf_elements_allocated*PCIGAR_SIZE(pcigar_64bits));
     wavefront->bt_prev_mem = mm_allocator_calloc(
         mm_allocator,wf_elements_allocated,bt_block_idx_t,false);
   } else {
@@ -66,12 +68,26 @@ void wavefront_resize(
   if (wavefront->bt_pcigar_mem) {
     mm_allocator_free(mm_allocator,wavefront->bt_pcigar_mem);
     mm_allocator_free(mm_allocator,wavefront->bt_prev_mem);
-    wavefront->bt_pcigar_mem = mm_allocator_calloc(
-        mm_allocator,wf_elements_allocated,pcigar_t,false);
+    wavefront->bt_pcigar_mem = mm_allocator_malloc(mm_allocator,
+        wf_elements_allocated*PCIGAR_SIZE(wavefront->bt_pcigar_64bits));
     wavefront->bt_prev_mem = mm_allocator_calloc(
         mm_allocator,wf_elements_allocated,bt_block_idx_t,false);
   }
 }
+void wavefront_resize_pcigar(
+    wavefront_t* const wavefront,
+    const bool pcigar_64bits,
+    mm_allocator_t* const mm_allocator) {
+  // Check width
+  if (wavefront->bt_pcigar_64bits == pcigar_64bits) return;
+  wavefront->bt_pcigar_64bits = pcigar_64bits;
+  // Reallocate backtrace pcigars (Content is lost)
+  if (wavefront->bt_pcigar_mem) {
+    mm_allocator_free(mm_allocator,wavefront->bt_pcigar_mem);
+    wavefront->bt_pcigar_mem = mm_allocator_malloc(mm_allocator,
+        wavefront->wf_elements_allocated*PCIGAR_SIZE(pcigar_64bits));
+  }
+}
 void wavefront_free(
     wavefront_t* const wavefront,
     mm_allocator_t* const mm_allocator) {
@@ -86,8 +102,8 @@ void wavefront_free(
  */
 void wavefront_init(
     wavefront_t* const wavefront,
-    const int min_lo,
-    const int max_hi) {
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi) {
   // Limits
   wavefront->null = false;
   wavefront->lo =  1;
@@ -96,7 +112,8 @@ void wavefront_init(
   wavefront->offsets = wavefront->offsets_mem - min_lo; // Center at k=0
   if (wavefront->bt_pcigar_mem) {
     wavefront->bt_occupancy_max = 0;
-    wavefront->bt_pcigar = wavefront->bt_pcigar_mem - min_lo; // Center at k=0
+    wavefront->bt_pcigar = (uint8_t*)wavefront->bt_pcigar_mem -
+        (int64_t)min_lo*PCIGAR_SIZE(wavefront->bt_pcigar_64bits); // Center at k=0
     wavefront->bt_prev = wavefront->bt_prev_mem - min_lo; // Center at k=0
   }
   // Internals
@@ -107,8 +124,8 @@ void wavefront_init(
 }
 void wavefront_init_null(
     wavefront_t* const wavefront,
-    const int min_lo,
-    const int max_hi) {
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi) {
   // Limits
   wavefront->null = true;
   wavefront->lo =  1;
@@ -117,7 +134,8 @@ void wavefront_init_null(
   wavefront->offsets = wavefront->offsets_mem - min_lo; // Center at k=0
   if (wavefront->bt_pcigar_mem) {
     wavefront->bt_occupancy_max = 0;
-    wavefront->bt_pcigar = wavefront->bt_pcigar_mem - min_lo; // Center at k=0
+    wavefront->bt_pcigar = (uint8_t*)wavefront->bt_pcigar_mem -
+        (int64_t)min_lo*PCIGAR_SIZE(wavefront->bt_pcigar_64bits); // Center at k=0
     wavefront->bt_prev = wavefront->bt_prev_mem - min_lo; // Center at k=0
   }
   // Initialize
@@ -127,7 +145,7 @@ void wavefront_init_null(
     wavefront->offsets_mem[i] = WAVEFRONT_OFFSET_NULL;
   }
   if (wavefront->bt_pcigar_mem) { // TODO: Really needed?
-    memset(wavefront->bt_pcigar_mem,0,wf_elements*sizeof(pcigar_t));
+    memset(wavefront->bt_pcigar_mem,0,wf_elements*PCIGAR_SIZE(wavefront->bt_pcigar_64bits));
     memset(wavefront->bt_prev_mem,0,wf_elements*sizeof(bt_block_idx_t));
   }
   // Internals
@@ -138,8 +156,8 @@ void wavefront_init_null(
 }
 void wavefront_init_victim(
     wavefront_t* const wavefront,
-    const int min_lo,
-    const int max_hi) {
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi) {
   // Delegate init
   wavefront_init(wavefront,min_lo,max_hi);
   // Set Null
@@ -150,8 +168,8 @@ void wavefront_init_victim(
  */
 void wavefront_set_limits(
     wavefront_t* const wavefront,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Set effective limits
   wavefront->lo = lo;
   wavefront->hi = hi;
@@ -166,7 +184,8 @@ uint64_t wavefront_get_size(
     wavefront_t* const wavefront) {
   uint64_t total_size = wavefront->wf_elements_allocated*sizeof(wf_offset_t);
   if (wavefront->bt_pcigar_mem) {
-    total_size += wavefront->wf_elements_allocated*(sizeof(pcigar_t)+sizeof(bt_block_idx_t));
+    total_size += wavefront->wf_elements_allocated*
+        (PCIGAR_SIZE(wavefront->bt_pcigar_64bits)+sizeof(bt_block_idx_t));
   }
   return total_size;
 }
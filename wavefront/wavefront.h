@@ -42,7 +42,7 @@
  */
 typedef struct {
   int score;          // Score
-  int k;              // Diagonal
+  wf_coord_t k;       // Diagonal
   wf_offset_t offset; // Offset
 } wavefront_pos_t;
 
@@ -57,24 +57,25 @@ typedef enum {
 typedef struct {
   // Dimensions
   bool null;                           // Is null interval?
-  int lo;                              // Lowest diagonal (inclusive)
-  int hi;                              // Highest diagonal (inclusive)
+  wf_coord_t lo;                       // Lowest diagonal (inclusive)
+  wf_coord_t hi;                       // Highest diagonal (inclusive)
   // Wavefront elements
   wf_offset_t* offsets;                // Offsets (k-centered)
   wf_offset_t* offsets_mem;            // Offsets base memory (Internal)
   // Piggyback backtrace
   int bt_occupancy_max;                // Maximum number of pcigar-ops stored on the Backtrace-block
-  pcigar_t* bt_pcigar;                 // Backtrace-block pcigar (k-centered)
+  bool bt_pcigar_64bits;               // Backtrace-block pcigars stored using 64-bits (otherwise 32-bits)
+  void* bt_pcigar;                     // Backtrace-block pcigar (k-centered; pcigar32_t or pcigar64_t)
   bt_block_idx_t* bt_prev;             // Backtrace-block previous-index (k-centered)
-  pcigar_t* bt_pcigar_mem;             // Backtrace-block (base memory - Internal)
+  void* bt_pcigar_mem;                 // Backtrace-block (base memory - Internal)
   bt_block_idx_t* bt_prev_mem;         // Backtrace-block previous-index (base memory - Internal)
   // Slab internals
   wavefront_status_type status;        // Wavefront status (memory state)
   int wf_elements_allocated;           // Total wf-elements allocated (max. wf. size)
-  int wf_elements_allocated_min;       // Minimum diagonal-element wf-element allocated
-  int wf_elements_allocated_max;       // Maximum diagonal-element wf-element allocated
-  int wf_elements_init_min;            // Minimum diagonal-element initialized (inclusive)
-  int wf_elements_init_max;            // Maximum diagonal-element initialized (inclusive)
+  wf_coord_t wf_elements_allocated_min; // Minimum diagonal-element wf-element allocated
+  wf_coord_t wf_elements_allocated_max; // Maximum diagonal-element wf-element allocated
+  wf_coord_t wf_elements_init_min;     // Minimum diagonal-element initialized (inclusive)
+  wf_coord_t wf_elements_init_max;     // Maximum diagonal-element initialized (inclusive)
 } wavefront_t;
 
 /*
@@ -104,11 +105,16 @@ void wavefront_allocate(
     wavefront_t* const wavefront,
     const int wf_elements_allocated,
     const bool allocate_backtrace,
+    const bool pcigar_64bits,
     mm_allocator_t* const mm_allocator);
 void wavefront_resize(
     wavefront_t* const wavefront,
     const int wf_elements_allocated,
     mm_allocator_t* const mm_allocator);
+void wavefront_resize_pcigar(
+    wavefront_t* const wavefront,
+    const bool pcigar_64bits,
+    mm_allocator_t* const mm_allocator);
 void wavefront_free(
     wavefront_t* const wavefront,
     mm_allocator_t* const mm_allocator);
@@ -118,24 +124,24 @@ void wavefront_free(
  */
 void wavefront_init(
     wavefront_t* const wavefront,
-    const int min_lo,
-    const int max_hi);
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi);
 void wavefront_init_null(
     wavefront_t* const wavefront,
-    const int min_lo,
-    const int max_hi);
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi);
 void wavefront_init_victim(
     wavefront_t* const wavefront,
-    const int min_lo,
-    const int max_hi);
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi);
 
 /*
  * Accessors
  */
 void wavefront_set_limits(
     wavefront_t* const wavefront,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 
 /*
  * Utils
@@ -46,8 +46,8 @@
  */
 void wavefront_align_checks(
     wavefront_aligner_t* const wf_aligner,
-    const int pattern_length,
-    const int text_length) {
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length) {
   alignment_form_t* const form = &wf_aligner->alignment_form;
   if (wf_aligner->bialigner != NULL) {
     const bool ends_free =
@@ -60,6 +60,13 @@ void wavefront_align_checks(
       exit(1);
     }
   }
+#ifdef WFA_OFFSET_16
+  if (pattern_length > WAVEFRONT_SEQUENCE_MAX || text_length > WAVEFRONT_SEQUENCE_MAX) {
+    fprintf(stderr,"[WFA] Sequences too long for 16-bit offsets (|P|=%d,|T|=%d > %d). "
+        "Rebuild without BUILD_WFA_OFFSET16=1\n",pattern_length,text_length,WAVEFRONT_SEQUENCE_MAX);
+    exit(1);
+  }
+#endif
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
   const bool is_heuristic_drop =
       (wf_aligner->heuristic.strategy & wf_heuristic_xdrop) ||
@@ -74,7 +81,8 @@ void wavefront_align_checks(
         form->text_begin_free > text_length ||
         form->text_end_free > text_length) {
       fprintf(stderr,"[WFA] Ends-free parameters must be not larger than the sequences "
-          "(P0=%d,Pf=%d,T0=%d,Tf=%d). Must be (P0<=|P|,Pf<=|P|,T0<=|T|,Tf<=|T|) where (|P|,|T|)=(%d,%d)\n",
+          "(P0=%"PRIcoord",Pf=%"PRIcoord",T0=%"PRIcoord",Tf=%"PRIcoord"). "
+          "Must be (P0<=|P|,Pf<=|P|,T0<=|T|,Tf<=|T|) where (|P|,|T|)=(%"PRIcoord",%"PRIcoord")\n",
           form->pattern_begin_free,form->pattern_end_free,
           form->text_begin_free,form->text_end_free,
           pattern_length,text_length);
@@ -109,9 +117,9 @@ void wavefront_align_unidirectional_cleanup(
 void wavefront_align_unidirectional(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length) {
+    const wf_coord_t text_length) {
   // Prepare alignment
   wavefront_unialign_init(
       wf_aligner,pattern,pattern_length,text,text_length,
@@ -133,9 +141,9 @@ void wavefront_align_unidirectional(
 void wavefront_align_bidirectional(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length) {
+    const wf_coord_t text_length) {
   // DEBUG
   wavefront_debug_prologue(wf_aligner,pattern,pattern_length,text,text_length);
   // Bidirectional alignment
@@ -153,11 +161,18 @@ void wavefront_align_bidirectional(
 int wavefront_align(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length) {
+    const wf_coord_t text_length) {
   // Checks
   wavefront_align_checks(wf_aligner,pattern_length,text_length);
+  // Memory governor (wait for memory or fail)
+  mm_governor_t* const mm_governor = wf_aligner->mm_governor;
+  mm_governor_client_t* const mm_governor_client = wf_aligner->mm_governor_client;
+  if (mm_governor_client != NULL && !mm_governor_acquire(mm_governor,mm_governor_client)) {
+    wf_aligner->align_status.status = WF_STATUS_OOM;
+    return WF_STATUS_OOM;
+  }
   // Plot
   if (wf_aligner->plot != NULL) {
     wavefront_plot_resize(wf_aligner->plot,pattern_length,text_length);
@@ -168,6 +183,15 @@ int wavefront_align(
   } else {
     wavefront_align_unidirectional(wf_aligner,pattern,pattern_length,text,text_length);
   }
+  // Memory governor (aligner becomes idle, or paused if it can be resumed)
+  if (mm_governor_client != NULL) {
+    if (wf_aligner->align_status.status == WF_STATUS_MAX_SCORE_REACHED &&
+        wf_aligner->bialigner == NULL) {
+      mm_governor_pause(mm_governor,mm_governor_client);
+    } else {
+      mm_governor_release(mm_governor,mm_governor_client);
+    }
+  }
   // Return
   return wf_aligner->align_status.status;
 }
@@ -181,12 +205,21 @@ int wavefront_align_resume(
     fprintf(stderr,"[WFA] Alignment cannot be resumed\n");
     exit(1);
   }
+  // Memory governor (wait for memory or fail)
+  mm_governor_t* const mm_governor = wf_aligner->mm_governor;
+  mm_governor_client_t* const mm_governor_client = wf_aligner->mm_governor_client;
+  if (mm_governor_client != NULL && !mm_governor_acquire(mm_governor,mm_governor_client)) {
+    align_status->status = WF_STATUS_OOM;
+    return WF_STATUS_OOM;
+  }
   // Resume aligning sequences
   wavefront_unialign(wf_aligner);
   // Finish alignment
   if (align_status->status == WF_STATUS_MAX_SCORE_REACHED) {
+    if (mm_governor_client != NULL) mm_governor_pause(mm_governor,mm_governor_client);
     return WF_STATUS_MAX_SCORE_REACHED; // Alignment paused
   }
+  if (mm_governor_client != NULL) mm_governor_release(mm_governor,mm_governor_client);
   wavefront_align_unidirectional_cleanup(wf_aligner);
   // DEBUG
   wavefront_debug_epilogue(wf_aligner);
@@ -33,6 +33,7 @@
 #define WAVEFRONT_ALIGN_H_
 
 #include "wavefront_aligner.h"
+#include "wavefront_batch.h"
 
 /*
  * Wavefront Alignment
@@ -40,9 +41,9 @@
 int wavefront_align(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length);
+    const wf_coord_t text_length);
 int wavefront_align_resume(
     wavefront_aligner_t* const wf_aligner);
 
@@ -62,13 +62,15 @@ char* wavefront_align_strerror(const int error_code) {
  */
 wavefront_aligner_t* wavefront_aligner_init_mm(
     mm_allocator_t* mm_allocator,
+    wavefront_slab_t* const wavefront_slab,
+    const mm_pages_t mm_pages,
     const bool memory_modular,
     const bool bt_piggyback,
     const bool bi_alignment) {
   // MM
   bool mm_allocator_own;
   if (mm_allocator == NULL) {
-    mm_allocator = mm_allocator_new((bi_alignment) ? BUFFER_SIZE_4K : BUFFER_SIZE_4M);
+    mm_allocator = mm_allocator_new_pages((bi_alignment) ? BUFFER_SIZE_4K : BUFFER_SIZE_4M,mm_pages);
     mm_allocator_own = true;
   } else {
     mm_allocator_own = false;
@@ -79,13 +81,23 @@ wavefront_aligner_t* wavefront_aligner_init_mm(
   // Configure MM
   wf_aligner->mm_allocator = mm_allocator;
   wf_aligner->mm_allocator_own = mm_allocator_own;
+  wf_aligner->mm_governor = NULL;
+  wf_aligner->mm_governor_client = NULL;
   // Slab
   if (bi_alignment) {
     wf_aligner->wavefront_slab = NULL;
+    wf_aligner->wavefront_slab_own = false;
+  } else if (wavefront_slab != NULL) {
+    wf_aligner->wavefront_slab = wavefront_slab;
+    wf_aligner->wavefront_slab_own = false;
   } else {
     const wf_slab_mode_t slab_mode = (memory_modular) ? wf_slab_reuse : wf_slab_tight;
     wf_aligner->wavefront_slab = wavefront_slab_new(1000,bt_piggyback,slab_mode,wf_aligner->mm_allocator);
+    wf_aligner->wavefront_slab_own = true;
   }
+  // Arena (sub-aligners sharing a slab only work on views of the sequences)
+  wf_aligner->mm_arena = mm_allocator_new_arena(
+      (wavefront_slab != NULL) ? BUFFER_SIZE_4K : BUFFER_SIZE_256K);
   // Return
   return wf_aligner;
 }
@@ -164,6 +176,10 @@ void wavefront_aligner_init_alignment(
   // Mode
   wf_aligner->align_mode = (bi_alignment) ? wf_align_biwfa : wf_align_regular;
   wf_aligner->align_mode_tag = NULL;
+  wf_aligner->align_status.status = WF_STATUS_SUCCESSFUL;
+  wf_aligner->align_status.score = 0;
+  wf_aligner->pattern_length = 0;
+  wf_aligner->text_length = 0;
   // Score & form
   wf_aligner->alignment_scope = attributes->alignment_scope;
   wf_aligner->alignment_form = attributes->alignment_form;
@@ -171,13 +187,31 @@ void wavefront_aligner_init_alignment(
   wavefront_aligner_init_penalties(wf_aligner,attributes);
   // Memory mode
   wf_aligner->memory_mode = attributes->memory_mode;
+  wf_aligner->pcigar_width = attributes->pcigar_width;
+  wf_aligner->pcigar_error_rate = 0.0f;
   wavefront_aligner_init_heuristic(wf_aligner,attributes);
   // Custom matching functions
   wf_aligner->match_funct = attributes->match_funct;
   wf_aligner->match_funct_arguments = attributes->match_funct_arguments;
 }
-wavefront_aligner_t* wavefront_aligner_new(
-    wavefront_aligner_attr_t* attributes) {
+void wavefront_aligner_init_thread_team(
+    wavefront_aligner_t* const wf_aligner,
+    const int max_num_threads) {
+#ifdef WFA_PARALLEL
+  // Keep the current team if large enough
+  if (max_num_threads <= 1) return;
+  if (wf_aligner->thread_team != NULL &&
+      wf_aligner->thread_team->max_threads >= max_num_threads) return;
+  // (Re)create the team (workers stay alive until the aligner is deleted)
+  if (wf_aligner->thread_team_own) thread_team_delete(wf_aligner->thread_team);
+  wf_aligner->thread_team = thread_team_new(max_num_threads);
+  wf_aligner->thread_team_own = true;
+#endif
+}
+wavefront_aligner_t* wavefront_aligner_new_shared(
+    wavefront_aligner_attr_t* attributes,
+    wavefront_slab_t* const wavefront_slab,
+    thread_team_t* const thread_team) {
   // Parameters
   if (attributes == NULL) attributes = &wavefront_aligner_attr_default;
   const bool score_only = (attributes->alignment_scope == compute_score);
@@ -187,9 +221,11 @@ wavefront_aligner_t* wavefront_aligner_new(
   const bool memory_modular = score_only || memory_succint;
   const bool bt_piggyback = !score_only && memory_succint;
   const bool bi_alignment = (attributes->memory_mode == wavefront_memory_ultralow);
+  const bool checkpoint = !score_only && (attributes->memory_mode == wavefront_memory_checkpoint);
   // Handler
   wavefront_aligner_t* const wf_aligner = wavefront_aligner_init_mm(
-      attributes->mm_allocator,memory_modular,bt_piggyback,bi_alignment);
+      attributes->mm_allocator,wavefront_slab,attributes->system.mm_pages,
+      memory_modular,bt_piggyback,bi_alignment);
   // Plot
   if (attributes->plot.enabled) {
     wf_aligner->plot = wavefront_plot_new(attributes->distance_metric,
@@ -199,6 +235,12 @@ wavefront_aligner_t* wavefront_aligner_new(
   }
   // Alignment
   wavefront_aligner_init_alignment(wf_aligner,attributes,memory_modular,bt_piggyback,bi_alignment);
+  if (checkpoint) {
+    wf_aligner->checkpoint = wavefront_checkpoint_new(wf_aligner->mm_allocator);
+    wavefront_slab_set_mode(wf_aligner->wavefront_slab,wf_slab_reuse); // Recycle released WFs
+  } else {
+    wf_aligner->checkpoint = NULL;
+  }
   if (bi_alignment) {
     wf_aligner->bialigner = wavefront_bialigner_new(attributes,wf_aligner->plot);
   } else {
@@ -208,24 +250,40 @@ wavefront_aligner_t* wavefront_aligner_new(
         &wf_aligner->wf_components,PATTERN_LENGTH_INIT,TEXT_LENGTH_INIT,
         &wf_aligner->penalties,memory_modular,bt_piggyback,
         wf_aligner->mm_allocator);
+    if (wf_aligner->wf_components.bt_buffer != NULL) {
+      wf_backtrace_buffer_set_spill(wf_aligner->wf_components.bt_buffer,
+          attributes->system.max_memory_bt_spill,attributes->system.bt_spill_dir);
+    }
   }
   // Sequences
   wf_aligner->sequences = NULL;
+  wf_aligner->pattern = NULL;
+  wf_aligner->text = NULL;
+  wf_aligner->sequences_reverse = false;
+  wf_aligner->sequences_eos = false;
   // CIGAR
   const int cigar_length = (score_only) ? 10 : 2*(PATTERN_LENGTH_INIT+TEXT_LENGTH_INIT);
   wf_aligner->cigar = cigar_new(cigar_length,wf_aligner->mm_allocator);
   // System
   wf_aligner->system = attributes->system;
+  wf_aligner->thread_team_own = false;
+  wf_aligner->thread_team = thread_team;
+  if (thread_team == NULL && !bi_alignment) { // BiWFA sub-aligners share one team
+    wavefront_aligner_init_thread_team(wf_aligner,attributes->system.max_num_threads);
+  }
+  wavefront_parallel_tuner_init(&wf_aligner->parallel_tuner);
   // Return
   return wf_aligner;
 }
+wavefront_aligner_t* wavefront_aligner_new(
+    wavefront_aligner_attr_t* attributes) {
+  return wavefront_aligner_new_shared(attributes,NULL,NULL);
+}
 void wavefront_aligner_reap(
     wavefront_aligner_t* const wf_aligner) {
   // Padded sequences
-  if (wf_aligner->sequences != NULL) {
-    strings_padded_delete(wf_aligner->sequences);
-    wf_aligner->sequences = NULL;
-  }
+  wf_aligner->sequences = NULL;
+  mm_allocator_clear(wf_aligner->mm_arena);
   // Select alignment mode
   if (wf_aligner->bialigner != NULL) {
     wavefront_bialigner_reap(wf_aligner->bialigner);
@@ -233,7 +291,33 @@ void wavefront_aligner_reap(
     // Wavefront components
     wavefront_components_reap(&wf_aligner->wf_components);
     // Slab
-    wavefront_slab_reap(wf_aligner->wavefront_slab);
+    if (wf_aligner->wavefront_slab_own) wavefront_slab_reap(wf_aligner->wavefront_slab);
+  }
+}
+void wavefront_aligner_preallocate(
+    wavefront_aligner_t* const wf_aligner,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length) {
+  // Padded sequences (plus headroom for the padding)
+  const bool top_aligner =
+      (wf_aligner->align_mode == wf_align_regular || wf_aligner->align_mode == wf_align_biwfa);
+  if (top_aligner && wf_aligner->match_funct == NULL) {
+    wf_aligner->sequences = NULL;
+    mm_allocator_reserve(wf_aligner->mm_arena,max_pattern_length+max_text_length+BUFFER_SIZE_1K);
+  }
+  // CIGAR
+  if (wf_aligner->alignment_scope == compute_alignment) {
+    cigar_resize(wf_aligner->cigar,2*(max_pattern_length+max_text_length));
+  }
+  // Select alignment mode
+  if (wf_aligner->bialigner != NULL) {
+    wavefront_bialigner_preallocate(wf_aligner->bialigner,max_pattern_length,max_text_length);
+  } else {
+    // Wavefront components
+    wavefront_components_resize(&wf_aligner->wf_components,
+        max_pattern_length,max_text_length,&wf_aligner->penalties);
+    // Slab (keep all wavefronts across alignments)
+    wavefront_slab_set_mode(wf_aligner->wavefront_slab,wf_slab_reuse);
   }
 }
 void wavefront_aligner_delete(
@@ -241,10 +325,12 @@ void wavefront_aligner_delete(
   // Parameters
   mm_allocator_t* const mm_allocator = wf_aligner->mm_allocator;
   const bool mm_allocator_own = wf_aligner->mm_allocator_own;
-  // Padded sequences
-  if (wf_aligner->sequences != NULL) {
-    strings_padded_delete(wf_aligner->sequences);
+  // Governor
+  if (wf_aligner->mm_governor != NULL) {
+    wavefront_aligner_set_governor(wf_aligner,NULL);
   }
+  // Padded sequences
+  mm_allocator_delete(wf_aligner->mm_arena);
   // Select alignment mode
   if (wf_aligner->bialigner != NULL) {
     wavefront_bialigner_delete(wf_aligner->bialigner);
@@ -252,7 +338,11 @@ void wavefront_aligner_delete(
     // Wavefront components
     wavefront_components_free(&wf_aligner->wf_components);
     // Slab
-    wavefront_slab_delete(wf_aligner->wavefront_slab);
+    if (wf_aligner->wavefront_slab_own) wavefront_slab_delete(wf_aligner->wavefront_slab);
+  }
+  // Checkpoints
+  if (wf_aligner->checkpoint != NULL) {
+    wavefront_checkpoint_delete(wf_aligner->checkpoint,mm_allocator);
   }
   // CIGAR
   cigar_free(wf_aligner->cigar);
@@ -260,6 +350,10 @@ void wavefront_aligner_delete(
   if (wf_aligner->plot != NULL && wf_aligner->align_mode <= 1) {
     wavefront_plot_delete(wf_aligner->plot);
   }
+  // Thread team
+  if (wf_aligner->thread_team_own) {
+    thread_team_delete(wf_aligner->thread_team);
+  }
   // MM
   mm_allocator_free(mm_allocator,wf_aligner);
   if (mm_allocator_own) {
@@ -275,10 +369,10 @@ void wavefront_aligner_set_alignment_end_to_end(
 }
 void wavefront_aligner_set_alignment_free_ends(
     wavefront_aligner_t* const wf_aligner,
-    const int pattern_begin_free,
-    const int pattern_end_free,
-    const int text_begin_free,
-    const int text_end_free) {
+    const wf_coord_t pattern_begin_free,
+    const wf_coord_t pattern_end_free,
+    const wf_coord_t text_begin_free,
+    const wf_coord_t text_end_free) {
   wf_aligner->alignment_form.span = alignment_endsfree;
   wf_aligner->alignment_form.pattern_begin_free = pattern_begin_free;
   wf_aligner->alignment_form.pattern_end_free = pattern_end_free;
@@ -297,8 +391,8 @@ void wavefront_aligner_set_heuristic_none(
 }
 void wavefront_aligner_set_heuristic_banded_static(
     wavefront_aligner_t* const wf_aligner,
-    const int band_min_k,
-    const int band_max_k) {
+    const wf_coord_t band_min_k,
+    const wf_coord_t band_max_k) {
   wavefront_heuristic_set_banded_static(&wf_aligner->heuristic,band_min_k,band_max_k);
   if (wf_aligner->bialigner != NULL) {
     wavefront_bialigner_set_heuristic(wf_aligner->bialigner,&wf_aligner->heuristic);
@@ -306,8 +400,8 @@ void wavefront_aligner_set_heuristic_banded_static(
 }
 void wavefront_aligner_set_heuristic_banded_adaptive(
     wavefront_aligner_t* const wf_aligner,
-    const int band_min_k,
-    const int band_max_k,
+    const wf_coord_t band_min_k,
+    const wf_coord_t band_max_k,
     const int score_steps) {
   wavefront_heuristic_set_banded_adaptive(
       &wf_aligner->heuristic,band_min_k,band_max_k,score_steps);
@@ -362,7 +456,7 @@ void wavefront_aligner_set_heuristic_zdrop(
  */
 void wavefront_aligner_set_match_funct(
     wavefront_aligner_t* const wf_aligner,
-    int (*match_funct)(int,int,void*),
+    int (*match_funct)(wf_coord_t,wf_coord_t,void*),
     void* const match_funct_arguments) {
   wf_aligner->match_funct = match_funct;
   wf_aligner->match_funct_arguments = match_funct_arguments;
@@ -394,6 +488,31 @@ void wavefront_aligner_set_max_memory(
         wf_aligner->bialigner,max_memory_resident,max_memory_abort);
   }
 }
+void wavefront_aligner_governor_reap(
+    void* const wf_aligner) {
+  wavefront_aligner_reap((wavefront_aligner_t*)wf_aligner);
+}
+void wavefront_aligner_set_governor(
+    wavefront_aligner_t* const wf_aligner,
+    mm_governor_t* const mm_governor) {
+  // Unregister from the previous governor
+  if (wf_aligner->mm_governor_client != NULL) {
+    mm_governor_unregister(wf_aligner->mm_governor,wf_aligner->mm_governor_client);
+    wf_aligner->mm_governor_client = NULL;
+  }
+  // Account memory (of all the aligners)
+  wf_aligner->mm_governor = mm_governor;
+  mm_allocator_set_governor(wf_aligner->mm_allocator,mm_governor);
+  mm_allocator_set_governor(wf_aligner->mm_arena,mm_governor);
+  if (wf_aligner->bialigner != NULL) {
+    wavefront_bialigner_set_governor(wf_aligner->bialigner,mm_governor);
+  }
+  // Register (only the top-level aligner can be reaped when idle)
+  if (mm_governor != NULL) {
+    wf_aligner->mm_governor_client = mm_governor_register(
+        mm_governor,wf_aligner,wavefront_aligner_governor_reap);
+  }
+}
 void wavefront_aligner_set_max_num_threads(
         wavefront_aligner_t* const wf_aligner,
         const int max_num_threads) {
@@ -401,6 +520,8 @@ void wavefront_aligner_set_max_num_threads(
     if (wf_aligner->bialigner != NULL) {
         wavefront_bialigner_set_max_num_threads(
           wf_aligner->bialigner,max_num_threads);
+    } else {
+        wavefront_aligner_init_thread_team(wf_aligner,max_num_threads);
     }
 }
 void wavefront_aligner_set_min_offsets_per_thread(
@@ -432,6 +553,20 @@ uint64_t wavefront_aligner_get_size(
     return sub_aligners + bt_buffer_size + slab_size;
   }
 }
+uint64_t wavefront_aligner_get_num_allocations(
+    wavefront_aligner_t* const wf_aligner) {
+  // System allocations (including those of a shared MM-Allocator)
+  uint64_t num_allocations =
+      mm_allocator_get_num_allocations(wf_aligner->mm_allocator) +
+      mm_allocator_get_num_allocations(wf_aligner->mm_arena);
+  // Sub-aligners or new wavefronts
+  if (wf_aligner->bialigner != NULL) {
+    num_allocations += wavefront_bialigner_get_num_allocations(wf_aligner->bialigner);
+  } else {
+    num_allocations += wavefront_slab_get_num_allocations(wf_aligner->wavefront_slab);
+  }
+  return num_allocations;
+}
 /*
  * Display
  */
@@ -468,7 +603,7 @@ void wavefront_aligner_print_scope(
   if (wf_aligner->alignment_form.span == alignment_end2end) {
     fprintf(stream,"(%s,end2end)",scope_label);
   } else {
-    fprintf(stream,"(%s,endsfree,%d,%d,%d,%d)",
+    fprintf(stream,"(%s,endsfree,%"PRIcoord",%"PRIcoord",%"PRIcoord",%"PRIcoord")",
         scope_label,
         wf_aligner->alignment_form.pattern_begin_free,
         wf_aligner->alignment_form.pattern_end_free,
@@ -485,6 +620,7 @@ void wavefront_aligner_print_mode(
     case wavefront_memory_med: fprintf(stream,"MMed)"); break;
     case wavefront_memory_low: fprintf(stream,"MLow)"); break;
     case wavefront_memory_ultralow: fprintf(stream,"BiWFA)"); break;
+    case wavefront_memory_checkpoint: fprintf(stream,"MCheckpoint)"); break;
   }
 }
 
@@ -39,12 +39,15 @@
 #include "system/profiler_timer.h"
 #include "system/mm_allocator.h"
 #include "system/mm_stack.h"
+#include "system/thread_team.h"
 #include "alignment/cigar.h"
 #include "wavefront_slab.h"
 #include "wavefront_penalties.h"
 #include "wavefront_attributes.h"
 #include "wavefront_components.h"
 #include "wavefront_bialigner.h"
+#include "wavefront_checkpoint.h"
+#include "wavefront_parallel.h"
 
 /*
  * Error codes & messages
@@ -61,6 +64,16 @@
 extern char* wf_error_msg[5];
 char* wavefront_align_strerror(const int error_code);
 
+/*
+ * Sequence views (character at position v/h, accounting for reverse views)
+ */
+#define WAVEFRONT_PATTERN_CHAR(wf_aligner,v) \
+  (((wf_aligner)->sequences_reverse) ? \
+      (wf_aligner)->pattern[(wf_aligner)->pattern_length-1-(v)] : (wf_aligner)->pattern[(v)])
+#define WAVEFRONT_TEXT_CHAR(wf_aligner,h) \
+  (((wf_aligner)->sequences_reverse) ? \
+      (wf_aligner)->text[(wf_aligner)->text_length-1-(h)] : (wf_aligner)->text[(h)])
+
 /*
  * Alignment status
  */
@@ -96,11 +109,15 @@ typedef struct _wavefront_aligner_t {
   char* align_mode_tag;                       // WFA mode tag
   wavefront_align_status_t align_status;      // Current alignment status
   // Sequences
-  strings_padded_t* sequences;                // Padded sequences
-  char* pattern;                              // Pattern sequence (padded)
-  int pattern_length;                         // Pattern length
-  char* text;                                 // Text sequence (padded)
-  int text_length;                            // Text length
+  strings_padded_t* sequences;                // Padded sequences (MM-Arena; NULL for BiWFA views)
+  char* pattern;                              // Pattern sequence (padded or view)
+  wf_coord_t pattern_length;                  // Pattern length
+  char* text;                                 // Text sequence (padded or view)
+  wf_coord_t text_length;                     // Text length
+  bool sequences_reverse;                     // Sequences are read backwards (from their end)
+  bool sequences_eos;                         // Sentinels written on the view (to be restored)
+  char pattern_eos;                           // Pattern character overwritten by the sentinel
+  char text_eos;                              // Text character overwritten by the sentinel
   // Custom function to compare sequences
   alignment_match_funct_t match_funct;        // Custom matching function (match(v,h,args))
   void* match_funct_arguments;                // Generic arguments passed to matching function (args)
@@ -110,11 +127,14 @@ typedef struct _wavefront_aligner_t {
   wavefront_penalties_t penalties;            // Alignment penalties
   wavefront_heuristic_t heuristic;            // Heuristic's parameters
   wavefront_memory_t memory_mode;             // Wavefront memory strategy (modular wavefronts and piggyback)
+  wavefront_pcigar_t pcigar_width;            // Packed-CIGAR width (piggyback modes)
+  float pcigar_error_rate;                    // Running divergence estimate (auto packed-CIGAR width)
   // Wavefront components
   wavefront_components_t wf_components;       // Wavefront components
   affine2p_matrix_type component_begin;       // Alignment begin component
   affine2p_matrix_type component_end;         // Alignment end component
   wavefront_pos_t alignment_end_pos;          // Alignment end position
+  wavefront_checkpoint_t* checkpoint;         // Checkpointed wavefronts (NULL unless checkpoint mode)
   // Bidirectional Alignment
   wavefront_bialigner_t* bialigner;           // BiWFA aligner
   // CIGAR
@@ -122,11 +142,18 @@ typedef struct _wavefront_aligner_t {
   // MM
   bool mm_allocator_own;                      // Ownership of MM-Allocator
   mm_allocator_t* mm_allocator;               // MM-Allocator
+  mm_allocator_t* mm_arena;                   // MM-Arena (per-alignment memory; reset at every alignment)
+  bool wavefront_slab_own;                    // Ownership of MM-Wavefront-Slab
   wavefront_slab_t* wavefront_slab;           // MM-Wavefront-Slab (Allocates/Reuses the individual wavefronts)
+  mm_governor_t* mm_governor;                 // Process-wide memory governor (NULL if none)
+  mm_governor_client_t* mm_governor_client;   // Governor registration (top-level aligner only)
   // Display
   wavefront_plot_t* plot;                     // Wavefront plot
   // System
   alignment_system_t system;                  // System related parameters
+  bool thread_team_own;                       // Ownership of the thread team
+  thread_team_t* thread_team;                 // Persistent thread team (intra-alignment parallelism; NULL if none)
+  wavefront_parallel_tuner_t parallel_tuner;  // Parallel granularity (auto-tuned if min_offsets_per_thread is 0)
 } wavefront_aligner_t;
 
 /*
@@ -134,8 +161,16 @@ typedef struct _wavefront_aligner_t {
  */
 wavefront_aligner_t* wavefront_aligner_new(
     wavefront_aligner_attr_t* attributes);
+wavefront_aligner_t* wavefront_aligner_new_shared(
+    wavefront_aligner_attr_t* attributes,
+    wavefront_slab_t* const wavefront_slab,
+    thread_team_t* const thread_team);
 void wavefront_aligner_reap(
     wavefront_aligner_t* const wf_aligner);
+void wavefront_aligner_preallocate(
+    wavefront_aligner_t* const wf_aligner,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length);
 void wavefront_aligner_delete(
     wavefront_aligner_t* const wf_aligner);
 
@@ -146,10 +181,10 @@ void wavefront_aligner_set_alignment_end_to_end(
     wavefront_aligner_t* const wf_aligner);
 void wavefront_aligner_set_alignment_free_ends(
     wavefront_aligner_t* const wf_aligner,
-    const int pattern_begin_free,
-    const int pattern_end_free,
-    const int text_begin_free,
-    const int text_end_free);
+    const wf_coord_t pattern_begin_free,
+    const wf_coord_t pattern_end_free,
+    const wf_coord_t text_begin_free,
+    const wf_coord_t text_end_free);
 
 /*
  * Heuristic configuration
@@ -176,12 +211,12 @@ void wavefront_aligner_set_heuristic_zdrop(
     const int score_steps);
 void wavefront_aligner_set_heuristic_banded_static(
     wavefront_aligner_t* const wf_aligner,
-    const int band_min_k,
-    const int band_max_k);
+    const wf_coord_t band_min_k,
+    const wf_coord_t band_max_k);
 void wavefront_aligner_set_heuristic_banded_adaptive(
     wavefront_aligner_t* const wf_aligner,
-    const int band_min_k,
-    const int band_max_k,
+    const wf_coord_t band_min_k,
+    const wf_coord_t band_max_k,
     const int score_steps);
 
 /*
@@ -189,7 +224,7 @@ void wavefront_aligner_set_heuristic_banded_adaptive(
  */
 void wavefront_aligner_set_match_funct(
     wavefront_aligner_t* const wf_aligner,
-    int (*match_funct)(int,int,void*),
+    int (*match_funct)(wf_coord_t,wf_coord_t,void*),
     void* const match_funct_arguments);
 
 /*
@@ -202,6 +237,9 @@ void wavefront_aligner_set_max_memory(
     wavefront_aligner_t* const wf_aligner,
     const uint64_t max_memory_resident,
     const uint64_t max_memory_abort);
+void wavefront_aligner_set_governor(
+    wavefront_aligner_t* const wf_aligner,
+    mm_governor_t* const mm_governor);
 void wavefront_aligner_set_max_num_threads(
         wavefront_aligner_t* const wf_aligner,
         const int max_num_threads);
@@ -213,6 +251,8 @@ void wavefront_aligner_set_min_offsets_per_thread(
  */
 uint64_t wavefront_aligner_get_size(
     wavefront_aligner_t* const wf_aligner);
+uint64_t wavefront_aligner_get_num_allocations(
+    wavefront_aligner_t* const wf_aligner);
 
 /*
  * Display
@@ -77,6 +77,7 @@ wavefront_aligner_attr_t wavefront_aligner_attr_default = {
     },
     // Memory model
     .memory_mode = wavefront_memory_high,
+    .pcigar_width = wavefront_pcigar_32bits,
     // MM
     .mm_allocator = NULL, // Use private MM
     // Display
@@ -93,9 +94,14 @@ wavefront_aligner_attr_t wavefront_aligner_attr_default = {
         .max_memory_compact = -1,  // Automatically set based on memory-mode
         .max_memory_resident = -1, // Automatically set based on memory-mode
         .max_memory_abort = UINT64_MAX, // Unlimited
+        .mm_pages = mm_pages_malloc,    // Plain malloc memory
+        .max_memory_bt_spill = 0,       // Never spill BT-buffer to disk
+        .bt_spill_dir = NULL,           // Default temporary directory
+        .max_memory_checkpoint = BUFFER_SIZE_32M, // Wavefront memory budget of 32MB
         .verbose = 0, // Quiet
         .check_alignment_correct = false,
         .max_num_threads = 1,           // Single thread by default
-        .min_offsets_per_thread = 500   // Minimum WF-length to spawn a thread
+        .min_offsets_per_thread = 500,  // Minimum WF-length to spawn a thread
+        .batch_lockstep = false,        // Align batch pairs one at a time
     },
 };
@@ -58,12 +58,12 @@ typedef enum {
 } alignment_span_t;
 typedef struct {
   // Mode
-  alignment_span_t span;   // Alignment form (End-to-end/Ends-free)
+  alignment_span_t span;         // Alignment form (End-to-end/Ends-free)
   // Ends-free
-  int pattern_begin_free;  // Allow free-gap at the beginning of the pattern
-  int pattern_end_free;    // Allow free-gap at the end of the pattern
-  int text_begin_free;     // Allow free-gap at the beginning of the text
-  int text_end_free;       // Allow free-gap at the end of the text
+  wf_coord_t pattern_begin_free; // Allow free-gap at the beginning of the pattern
+  wf_coord_t pattern_end_free;   // Allow free-gap at the end of the pattern
+  wf_coord_t text_begin_free;    // Allow free-gap at the beginning of the text
+  wf_coord_t text_end_free;      // Allow free-gap at the end of the text
 } alignment_form_t;
 
 /*
@@ -71,12 +71,12 @@ typedef struct {
  *
  *   typedef struct {
  *     char* pattern;
- *     int pattern_length;
+ *     wf_coord_t pattern_length;
  *     char* text;
- *     int text_length;
+ *     wf_coord_t text_length;
  *   } match_function_params_t;
  *
- *   int match_function(int v,int h,void* arguments) {
+ *   int match_function(wf_coord_t v,wf_coord_t h,void* arguments) {
  *     // Extract parameters
  *     match_function_params_t* match_arguments = (match_function_params_t*)arguments;
  *     // Check match
@@ -84,7 +84,7 @@ typedef struct {
  *     return (match_arguments->pattern[v] == match_arguments->text[h]);
  *   }
  */
-typedef int (*alignment_match_funct_t)(int,int,void*);
+typedef int (*alignment_match_funct_t)(wf_coord_t,wf_coord_t,void*);
 
 /*
  * Alignment system configuration
@@ -100,6 +100,10 @@ typedef struct {
   uint64_t max_memory_compact;   // Maximum BT-buffer memory allowed before trigger compact
   uint64_t max_memory_resident;  // Maximum memory allowed to be buffered before reap
   uint64_t max_memory_abort;     // Maximum memory allowed to be used before aborting alignment
+  mm_pages_t mm_pages;           // Pages backing the internal MM-Allocator (e.g. huge-pages for large BT-buffers)
+  uint64_t max_memory_bt_spill;  // Maximum BT-buffer memory resident before spilling compacted segments to disk (0 disables spill)
+  char* bt_spill_dir;            // Directory to place BT-buffer spill-files (NULL uses /tmp)
+  uint64_t max_memory_checkpoint; // Wavefront memory budget (checkpoint mode)
   // Verbose
   //  0 - Quiet
   //  1 - Report each sequence aligned                      (brief)
@@ -113,7 +117,8 @@ typedef struct {
   profiler_timer_t timer;        // Time alignment
   // OS
   int max_num_threads;           // Maximum number of threads to use to compute/extend WFs
-  int min_offsets_per_thread;    // Minimum amount of offsets to spawn a thread
+  int min_offsets_per_thread;    // Minimum amount of offsets to spawn a thread (0 auto-tunes it online)
+  bool batch_lockstep;           // Align batches of short pairs in lockstep (see wavefront_align_batch)
 } alignment_system_t;
 
 /*
@@ -124,8 +129,18 @@ typedef enum {
   wavefront_memory_med      = 1, // Succing-memory mode piggyback-based (medium, offloads half-full BT-blocks)
   wavefront_memory_low      = 2, // Succing-memory mode piggyback-based (slow, offloads only full BT-blocks)
   wavefront_memory_ultralow = 3, // Bidirectional WFA
+  wavefront_memory_checkpoint = 4, // Checkpointed WFs (keeps every k-th WF-set, recomputes the rest on backtrace)
 } wavefront_memory_t;
 
+/*
+ * Packed-CIGAR width (piggyback modes)
+ */
+typedef enum {
+  wavefront_pcigar_auto   = 0, // Selected from the divergence observed on previous alignments
+  wavefront_pcigar_32bits = 1, // 16 operations per BT-block (smaller BT-blocks)
+  wavefront_pcigar_64bits = 2, // 32 operations per BT-block (fewer offloads on noisy sequences)
+} wavefront_pcigar_t;
+
 /*
  * Wavefront Aligner Attributes
  */
@@ -142,6 +157,7 @@ typedef struct {
   wavefront_heuristic_t heuristic;         // Wavefront heuristic
   // Memory model
   wavefront_memory_t memory_mode;          // Wavefront memory strategy (modular wavefronts and piggyback)
+  wavefront_pcigar_t pcigar_width;         // Packed-CIGAR width used by piggyback modes
   // Custom function to compare sequences
   alignment_match_funct_t match_funct;     // Custom matching function (match(v,h,args))
   void* match_funct_arguments;             // Generic arguments passed to matching function (args)
@@ -31,39 +31,13 @@
 
 #include "wavefront_backtrace.h"
 
-/*
- * Wavefront type
- */
-#define BACKTRACE_TYPE_BITS                   4 // 4-bits for piggyback
-#define BACKTRACE_TYPE_MASK 0x000000000000000Fl // Extract mask
-
-#define BACKTRACE_PIGGYBACK_SET(offset,backtrace_type) \
-  (( ((int64_t)(offset)) << BACKTRACE_TYPE_BITS) | backtrace_type)
-
-#define BACKTRACE_PIGGYBACK_GET_TYPE(offset) \
-  ((offset) & BACKTRACE_TYPE_MASK)
-#define BACKTRACE_PIGGYBACK_GET_OFFSET(offset) \
-  ((offset) >> BACKTRACE_TYPE_BITS)
-
-typedef enum {
-  backtrace_M       = 9,
-  backtrace_D2_ext  = 8,
-  backtrace_D2_open = 7,
-  backtrace_D1_ext  = 6,
-  backtrace_D1_open = 5,
-  backtrace_I2_ext  = 4,
-  backtrace_I2_open = 3,
-  backtrace_I1_ext  = 2,
-  backtrace_I1_open = 1,
-} backtrace_type;
-
 /*
  * Backtrace Trace Patch Match/Mismsmatch
  */
 int64_t wavefront_backtrace_misms(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score];
   if (mwavefront != NULL &&
@@ -75,11 +49,8 @@ int64_t wavefront_backtrace_misms(
   }
 }
 void wavefront_backtrace_matches(
-    wavefront_aligner_t* const wf_aligner,
-    const int k,
-    wf_offset_t offset,
-    int num_matches,
-    cigar_t* const cigar) {
+    cigar_t* const cigar,
+    wf_coord_t num_matches) {
   // Parameters
   const uint64_t matches_lut = 0x4D4D4D4D4D4D4D4Dul; // Matches LUT = "MMMMMMMM"
   char* operations = cigar->operations + cigar->begin_offset;
@@ -104,7 +75,7 @@ void wavefront_backtrace_matches(
 int64_t wavefront_backtrace_del1_open(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score];
   if (mwavefront != NULL &&
@@ -118,7 +89,7 @@ int64_t wavefront_backtrace_del1_open(
 int64_t wavefront_backtrace_del2_open(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score];
   if (mwavefront != NULL &&
@@ -132,7 +103,7 @@ int64_t wavefront_backtrace_del2_open(
 int64_t wavefront_backtrace_del1_ext(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const d1wavefront = wf_aligner->wf_components.d1wavefronts[score];
   if (d1wavefront != NULL &&
@@ -146,7 +117,7 @@ int64_t wavefront_backtrace_del1_ext(
 int64_t wavefront_backtrace_del2_ext(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const d2wavefront = wf_aligner->wf_components.d2wavefronts[score];
   if (d2wavefront != NULL &&
@@ -163,7 +134,7 @@ int64_t wavefront_backtrace_del2_ext(
 int64_t wavefront_backtrace_ins1_open(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score];
   if (mwavefront != NULL &&
@@ -177,7 +148,7 @@ int64_t wavefront_backtrace_ins1_open(
 int64_t wavefront_backtrace_ins2_open(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score];
   if (mwavefront != NULL &&
@@ -191,7 +162,7 @@ int64_t wavefront_backtrace_ins2_open(
 int64_t wavefront_backtrace_ins1_ext(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const i1wavefront = wf_aligner->wf_components.i1wavefronts[score];
   if (i1wavefront != NULL &&
@@ -205,7 +176,7 @@ int64_t wavefront_backtrace_ins1_ext(
 int64_t wavefront_backtrace_ins2_ext(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    const int k) {
+    const wf_coord_t k) {
   if (score < 0) return WAVEFRONT_OFFSET_NULL;
   wavefront_t* const i2wavefront = wf_aligner->wf_components.i2wavefronts[score];
   if (i2wavefront != NULL &&
@@ -216,17 +187,113 @@ int64_t wavefront_backtrace_ins2_ext(
     return WAVEFRONT_OFFSET_NULL;
   }
 }
+/*
+ * Backtrace step (shared with the lockstep lanes)
+ */
+void wavefront_backtrace_operation(
+    cigar_t* const cigar,
+    const backtrace_type backtrace_type,
+    wf_coord_t* const k,
+    wf_offset_t* const offset) {
+  switch (backtrace_type) {
+    case backtrace_M:
+      cigar->operations[(cigar->begin_offset)--] = 'X';
+      --(*offset);
+      break;
+    case backtrace_I1_open:
+    case backtrace_I1_ext:
+    case backtrace_I2_open:
+    case backtrace_I2_ext:
+      cigar->operations[(cigar->begin_offset)--] = 'I';
+      --(*k); --(*offset);
+      break;
+    case backtrace_D1_open:
+    case backtrace_D1_ext:
+    case backtrace_D2_open:
+    case backtrace_D2_ext:
+      cigar->operations[(cigar->begin_offset)--] = 'D';
+      ++(*k);
+      break;
+    default:
+      fprintf(stderr,"[WFA::Backtrace] Wrong type trace.3\n");
+      exit(1);
+      break;
+  }
+}
+void wavefront_backtrace_affine_source(
+    const wavefront_penalties_t* const penalties,
+    const backtrace_type backtrace_type,
+    int* const score,
+    affine2p_matrix_type* const matrix_type) {
+  switch (backtrace_type) {
+    case backtrace_M:
+      *score -= penalties->mismatch;
+      *matrix_type = affine2p_matrix_M;
+      break;
+    case backtrace_I1_open:
+      *score -= penalties->gap_opening1 + penalties->gap_extension1;
+      *matrix_type = affine2p_matrix_M;
+      break;
+    case backtrace_I1_ext:
+      *score -= penalties->gap_extension1;
+      *matrix_type = affine2p_matrix_I1;
+      break;
+    case backtrace_I2_open:
+      *score -= penalties->gap_opening2 + penalties->gap_extension2;
+      *matrix_type = affine2p_matrix_M;
+      break;
+    case backtrace_I2_ext:
+      *score -= penalties->gap_extension2;
+      *matrix_type = affine2p_matrix_I2;
+      break;
+    case backtrace_D1_open:
+      *score -= penalties->gap_opening1 + penalties->gap_extension1;
+      *matrix_type = affine2p_matrix_M;
+      break;
+    case backtrace_D1_ext:
+      *score -= penalties->gap_extension1;
+      *matrix_type = affine2p_matrix_D1;
+      break;
+    case backtrace_D2_open:
+      *score -= penalties->gap_opening2 + penalties->gap_extension2;
+      *matrix_type = affine2p_matrix_M;
+      break;
+    case backtrace_D2_ext:
+      *score -= penalties->gap_extension2;
+      *matrix_type = affine2p_matrix_D2;
+      break;
+    default:
+      fprintf(stderr,"[WFA::Backtrace] Wrong type trace.2\n");
+      exit(1);
+      break;
+  }
+}
+void wavefront_backtrace_beginning(
+    cigar_t* const cigar,
+    wf_coord_t v,
+    wf_coord_t h) {
+  if (v > 0 && h > 0) {
+    // Account for beginning series of matches
+    const wf_coord_t num_matches = MIN(v,h);
+    wavefront_backtrace_matches(cigar,num_matches);
+    v -= num_matches;
+    h -= num_matches;
+  }
+  // Account for beginning insertions/deletions
+  while (v > 0) {cigar->operations[(cigar->begin_offset)--] = 'D'; --v;};
+  while (h > 0) {cigar->operations[(cigar->begin_offset)--] = 'I'; --h;};
+}
 /*
  * Backtrace wavefronts
  */
 void wavefront_backtrace_linear(
     wavefront_aligner_t* const wf_aligner,
     const int alignment_score,
-    const int alignment_k,
+    const wf_coord_t alignment_k,
     const wf_offset_t alignment_offset) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   const wavefront_penalties_t* const penalties = &wf_aligner->penalties;
   const distance_metric_t distance_metric = penalties->distance_metric;
   // Prepare cigar
@@ -236,21 +303,23 @@ void wavefront_backtrace_linear(
   cigar->operations[cigar->end_offset] = '\0';
   // Compute starting location
   int score = alignment_score;
-  int k = alignment_k;
-  int h = WAVEFRONT_H(alignment_k,alignment_offset);
-  int v = WAVEFRONT_V(alignment_k,alignment_offset);
+  wf_coord_t k = alignment_k;
+  wf_coord_t h = WAVEFRONT_H(alignment_k,alignment_offset);
+  wf_coord_t v = WAVEFRONT_V(alignment_k,alignment_offset);
   wf_offset_t offset = alignment_offset;
   // Account for ending insertions/deletions
   if (v < pattern_length) {
-    int i = pattern_length - v;
+    wf_coord_t i = pattern_length - v;
     while (i > 0) {cigar->operations[(cigar->begin_offset)--] = 'D'; --i;};
   }
   if (h < text_length) {
-    int i = text_length - h;
+    wf_coord_t i = text_length - h;
     while (i > 0) {cigar->operations[(cigar->begin_offset)--] = 'I'; --i;};
   }
   // Trace the alignment back
   while (v > 0 && h > 0 && score > 0) {
+    // Restore released wavefronts (checkpoint mode)
+    if (wf_aligner->checkpoint != NULL) wavefront_checkpoint_restore(wf_aligner,score);
     // Compute scores
     const int mismatch = score - penalties->mismatch;
     const int gap_open1 = score - penalties->gap_opening1;
@@ -264,9 +333,8 @@ void wavefront_backtrace_linear(
     // Check source score
     if (max_all < 0) break; // No source
     // Traceback Matches
-    const int max_offset = BACKTRACE_PIGGYBACK_GET_OFFSET(max_all);
-    const int num_matches = offset - max_offset;
-    wavefront_backtrace_matches(wf_aligner,k,offset,num_matches,cigar);
+    const wf_offset_t max_offset = BACKTRACE_PIGGYBACK_GET_OFFSET(max_all);
+    wavefront_backtrace_matches(cigar,offset-max_offset);
     offset = max_offset;
     // Update coordinates
     v = WAVEFRONT_V(k,offset);
@@ -274,42 +342,14 @@ void wavefront_backtrace_linear(
     if (v <= 0 || h <= 0) break;
     // Traceback Operation
     const backtrace_type backtrace_type = BACKTRACE_PIGGYBACK_GET_TYPE(max_all);
-    switch (backtrace_type) {
-      case backtrace_M:
-        score = mismatch;
-        cigar->operations[(cigar->begin_offset)--] = 'X';
-        --offset;
-        break;
-      case backtrace_I1_open:
-        score = gap_open1;
-        cigar->operations[(cigar->begin_offset)--] = 'I';
-        --k; --offset;
-        break;
-      case backtrace_D1_open:
-        score = gap_open1;
-        cigar->operations[(cigar->begin_offset)--] = 'D';
-        ++k;
-        break;
-      default:
-        fprintf(stderr,"[WFA::Backtrace] Wrong type trace.4\n");
-        exit(1);
-        break;
-    }
+    score = (backtrace_type == backtrace_M) ? mismatch : gap_open1;
+    wavefront_backtrace_operation(cigar,backtrace_type,&k,&offset);
     // Update coordinates
     v = WAVEFRONT_V(k,offset);
     h = WAVEFRONT_H(k,offset);
   }
   // Account for last operations
-  if (v > 0 && h > 0) {
-    // Account for beginning series of matches
-    const int num_matches = MIN(v,h);
-    wavefront_backtrace_matches(wf_aligner,k,offset,num_matches,cigar);
-    v -= num_matches;
-    h -= num_matches;
-  }
-  // Account for beginning insertions/deletions
-  while (v > 0) {cigar->operations[(cigar->begin_offset)--] = 'D'; --v;};
-  while (h > 0) {cigar->operations[(cigar->begin_offset)--] = 'I'; --h;};
+  wavefront_backtrace_beginning(cigar,v,h);
   // Set CIGAR
   ++(cigar->begin_offset);
   cigar->score = alignment_score;
@@ -319,11 +359,11 @@ void wavefront_backtrace_affine(
     const affine2p_matrix_type component_begin,
     const affine2p_matrix_type component_end,
     const int alignment_score,
-    const int alignment_k,
+    const wf_coord_t alignment_k,
     const wf_offset_t alignment_offset) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   const wavefront_penalties_t* const penalties = &wf_aligner->penalties;
   const distance_metric_t distance_metric = penalties->distance_metric;
   // Prepare cigar
@@ -334,23 +374,25 @@ void wavefront_backtrace_affine(
   // Compute starting location
   affine2p_matrix_type matrix_type = component_end;
   int score = alignment_score;
-  int k = alignment_k;
-  int h = WAVEFRONT_H(alignment_k,alignment_offset);
-  int v = WAVEFRONT_V(alignment_k,alignment_offset);
+  wf_coord_t k = alignment_k;
+  wf_coord_t h = WAVEFRONT_H(alignment_k,alignment_offset);
+  wf_coord_t v = WAVEFRONT_V(alignment_k,alignment_offset);
   wf_offset_t offset = alignment_offset;
   // Account for ending insertions/deletions
   if (component_end == affine2p_matrix_M) { // ends-free
     if (v < pattern_length) {
-      int i = pattern_length - v;
+      wf_coord_t i = pattern_length - v;
       while (i > 0) {cigar->operations[(cigar->begin_offset)--] = 'D'; --i;};
     }
     if (h < text_length) {
-      int i = text_length - h;
+      wf_coord_t i = text_length - h;
       while (i > 0) {cigar->operations[(cigar->begin_offset)--] = 'I'; --i;};
     }
   }
   // Trace the alignment back
   while (v > 0 && h > 0 && score > 0) {
+    // Restore released wavefronts (checkpoint mode)
+    if (wf_aligner->checkpoint != NULL) wavefront_checkpoint_restore(wf_aligner,score);
     // Compute scores
     const int mismatch = score - penalties->mismatch;
     const int gap_open1 = score - penalties->gap_opening1 - penalties->gap_extension1;
@@ -416,9 +458,8 @@ void wavefront_backtrace_affine(
     if (max_all < 0) break; // No source
     // Traceback Matches
     if (matrix_type == affine2p_matrix_M) {
-      const int max_offset = BACKTRACE_PIGGYBACK_GET_OFFSET(max_all);
-      const int num_matches = offset - max_offset;
-      wavefront_backtrace_matches(wf_aligner,k,offset,num_matches,cigar);
+      const wf_offset_t max_offset = BACKTRACE_PIGGYBACK_GET_OFFSET(max_all);
+      wavefront_backtrace_matches(cigar,offset-max_offset);
       offset = max_offset;
       // Update coordinates
       v = WAVEFRONT_V(k,offset);
@@ -427,94 +468,21 @@ void wavefront_backtrace_affine(
     }
     // Traceback Operation
     const backtrace_type backtrace_type = BACKTRACE_PIGGYBACK_GET_TYPE(max_all);
-    switch (backtrace_type) {
-      case backtrace_M:
-        score = mismatch;
-        matrix_type = affine2p_matrix_M;
-        break;
-      case backtrace_I1_open:
-        score = gap_open1;
-        matrix_type = affine2p_matrix_M;
-        break;
-      case backtrace_I1_ext:
-        score = gap_extend1;
-        matrix_type = affine2p_matrix_I1;
-        break;
-      case backtrace_I2_open:
-        score = gap_open2;
-        matrix_type = affine2p_matrix_M;
-        break;
-      case backtrace_I2_ext:
-        score = gap_extend2;
-        matrix_type = affine2p_matrix_I2;
-        break;
-      case backtrace_D1_open:
-        score = gap_open1;
-        matrix_type = affine2p_matrix_M;
-        break;
-      case backtrace_D1_ext:
-        score = gap_extend1;
-        matrix_type = affine2p_matrix_D1;
-        break;
-      case backtrace_D2_open:
-        score = gap_open2;
-        matrix_type = affine2p_matrix_M;
-        break;
-      case backtrace_D2_ext:
-        score = gap_extend2;
-        matrix_type = affine2p_matrix_D2;
-        break;
-      default:
-        fprintf(stderr,"[WFA::Backtrace] Wrong type trace.2\n");
-        exit(1);
-        break;
-    }
-    switch (backtrace_type) {
-      case backtrace_M:
-        cigar->operations[(cigar->begin_offset)--] = 'X';
-        --offset;
-        break;
-      case backtrace_I1_open:
-      case backtrace_I1_ext:
-      case backtrace_I2_open:
-      case backtrace_I2_ext:
-        cigar->operations[(cigar->begin_offset)--] = 'I';
-        --k; --offset;
-        break;
-      case backtrace_D1_open:
-      case backtrace_D1_ext:
-      case backtrace_D2_open:
-      case backtrace_D2_ext:
-        cigar->operations[(cigar->begin_offset)--] = 'D';
-        ++k;
-        break;
-      default:
-        fprintf(stderr,"[WFA::Backtrace] Wrong type trace.3\n");
-        exit(1);
-        break;
-    }
+    wavefront_backtrace_affine_source(penalties,backtrace_type,&score,&matrix_type);
+    wavefront_backtrace_operation(cigar,backtrace_type,&k,&offset);
     // Update coordinates
     v = WAVEFRONT_V(k,offset);
     h = WAVEFRONT_H(k,offset);
   }
   // Account for last operations
   if (matrix_type == affine2p_matrix_M) {
-    if (v > 0 && h > 0) {
-      // Account for beginning series of matches
-      const int num_matches = MIN(v,h);
-      wavefront_backtrace_matches(wf_aligner,k,offset,num_matches,cigar);
-      v -= num_matches;
-      h -= num_matches;
-    }
-    // Account for beginning insertions/deletions
-    while (v > 0) {cigar->operations[(cigar->begin_offset)--] = 'D'; --v;};
-    while (h > 0) {cigar->operations[(cigar->begin_offset)--] = 'I'; --h;};
+    wavefront_backtrace_beginning(cigar,v,h);
   } else {
     // DEBUG
     if (v != 0 || h != 0 || (score != 0 && penalties->match == 0)) {
       fprintf(stderr,"[WFA::Backtrace] I?/D?-Beginning backtrace error\n");
-      fprintf(stderr,">%.*s\n",pattern_length,wf_aligner->pattern);
-      fprintf(stderr,"<%.*s\n",text_length,wf_aligner->text);
+      fprintf(stderr,">%.*s\n",(int)pattern_length,wf_aligner->pattern);
+      fprintf(stderr,"<%.*s\n",(int)text_length,wf_aligner->text);
       exit(-1);
     }
   }
@@ -527,27 +495,28 @@ void wavefront_backtrace_affine(
  */
 void wavefront_backtrace_pcigar(
     wavefront_aligner_t* const wf_aligner,
-    const int alignment_k,
-    const int alignment_offset,
+    const wf_coord_t alignment_k,
+    const wf_coord_t alignment_offset,
     const pcigar_t pcigar_last,
     const bt_block_idx_t prev_idx_last) {
   // Parameters
   wf_backtrace_buffer_t* const bt_buffer =  wf_aligner->wf_components.bt_buffer;
   // Traceback pcigar-blocks
   bt_block_t bt_block_last = {
-      .pcigar = pcigar_last,
-      .prev_idx = prev_idx_last
+      .pcigar_lo = (uint32_t)pcigar_last,
+      .prev_idx = prev_idx_last,
+      .pcigar_hi = (uint32_t)(pcigar_last >> 32),
   };
   bt_block_t* const init_block = wf_backtrace_buffer_traceback_pcigar(bt_buffer,&bt_block_last);
   // Fetch initial coordinate
-  const int init_position_offset = init_block->pcigar;
+  const int init_position_offset = init_block->pcigar_lo;
   wf_backtrace_init_pos_t* const backtrace_init_pos =
       vector_get_elm(bt_buffer->alignment_init_pos,init_position_offset,wf_backtrace_init_pos_t);
   // Unpack pcigar blocks (packed alignment)
-  const int begin_v = backtrace_init_pos->v;
-  const int begin_h = backtrace_init_pos->h;
-  const int end_v = WAVEFRONT_V(alignment_k,alignment_offset);
-  const int end_h = WAVEFRONT_H(alignment_k,alignment_offset);
+  const wf_coord_t begin_v = backtrace_init_pos->v;
+  const wf_coord_t begin_h = backtrace_init_pos->h;
+  const wf_coord_t end_v = WAVEFRONT_V(alignment_k,alignment_offset);
+  const wf_coord_t end_h = WAVEFRONT_H(alignment_k,alignment_offset);
   if (wf_aligner->penalties.distance_metric <= gap_linear) {
     wf_backtrace_buffer_unpack_cigar_linear(bt_buffer,
         wf_aligner->pattern,wf_aligner->pattern_length,
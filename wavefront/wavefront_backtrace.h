@@ -34,20 +34,67 @@
 
 #include "wavefront_aligner.h"
 
+/*
+ * Wavefront type
+ */
+#define BACKTRACE_TYPE_BITS                   4 // 4-bits for piggyback
+#define BACKTRACE_TYPE_MASK 0x000000000000000Fl // Extract mask
+
+#define BACKTRACE_PIGGYBACK_SET(offset,backtrace_type) \
+  (( ((int64_t)(offset)) << BACKTRACE_TYPE_BITS) | backtrace_type)
+
+#define BACKTRACE_PIGGYBACK_GET_TYPE(offset) \
+  ((offset) & BACKTRACE_TYPE_MASK)
+#define BACKTRACE_PIGGYBACK_GET_OFFSET(offset) \
+  ((offset) >> BACKTRACE_TYPE_BITS)
+
+typedef enum {
+  backtrace_M       = 9,
+  backtrace_D2_ext  = 8,
+  backtrace_D2_open = 7,
+  backtrace_D1_ext  = 6,
+  backtrace_D1_open = 5,
+  backtrace_I2_ext  = 4,
+  backtrace_I2_open = 3,
+  backtrace_I1_ext  = 2,
+  backtrace_I1_open = 1,
+} backtrace_type;
+
+/*
+ * Backtrace step (shared with the lockstep lanes)
+ */
+void wavefront_backtrace_matches(
+    cigar_t* const cigar,
+    wf_coord_t num_matches);
+void wavefront_backtrace_operation(
+    cigar_t* const cigar,
+    const backtrace_type backtrace_type,
+    wf_coord_t* const k,
+    wf_offset_t* const offset);
+void wavefront_backtrace_affine_source(
+    const wavefront_penalties_t* const penalties,
+    const backtrace_type backtrace_type,
+    int* const score,
+    affine2p_matrix_type* const matrix_type);
+void wavefront_backtrace_beginning(
+    cigar_t* const cigar,
+    wf_coord_t v,
+    wf_coord_t h);
+
 /*
  * Backtrace wavefronts
  */
 void wavefront_backtrace_linear(
     wavefront_aligner_t* const wf_aligner,
     const int alignment_score,
-    const int alignment_k,
+    const wf_coord_t alignment_k,
     const wf_offset_t alignment_offset);
 void wavefront_backtrace_affine(
     wavefront_aligner_t* const wf_aligner,
     const affine2p_matrix_type component_begin,
     const affine2p_matrix_type component_end,
     const int alignment_score,
-    const int alignment_k,
+    const wf_coord_t alignment_k,
     const wf_offset_t alignment_offset);
 
 /*
@@ -55,8 +102,8 @@ void wavefront_backtrace_affine(
  */
 void wavefront_backtrace_pcigar(
     wavefront_aligner_t* const wf_aligner,
-    const int alignment_k,
-    const int alignment_offset,
+    const wf_coord_t alignment_k,
+    const wf_coord_t alignment_offset,
     const pcigar_t pcigar_last,
     const bt_block_idx_t prev_idx_last);
 
@@ -35,20 +35,133 @@
  * Config
  */
 #define BT_BUFFER_SEGMENT_LENGTH BUFFER_SIZE_8M
+#define BT_BUFFER_SEGMENT_SIZE(bt_buffer) (BT_BUFFER_SEGMENT_LENGTH*(uint64_t)(bt_buffer)->block_size)
+#define BT_BUFFER_SPILL_MIN_RESIDENT 2
+#define BT_BUFFER_SPILL_DIR_DEFAULT "/tmp"
 
 #define BT_BUFFER_SEGMENT_IDX(block_idx)    ((block_idx)/BT_BUFFER_SEGMENT_LENGTH)
 #define BT_BUFFER_SEGMENT_OFFSET(block_idx) ((block_idx)%BT_BUFFER_SEGMENT_LENGTH)
 
 #define BT_BUFFER_IDX(segment_idx,segment_offset) \
-  ((segment_idx)*BT_BUFFER_SEGMENT_LENGTH) + (segment_offset)
+  ((bt_block_idx_t)(segment_idx)*BT_BUFFER_SEGMENT_LENGTH + (segment_offset))
 
+/*
+ * Packed-CIGAR format
+ */
+void wf_backtrace_buffer_set_pcigar_format(
+    wf_backtrace_buffer_t* const bt_buffer,
+    const bool pcigar_64bits) {
+  bt_buffer->pcigar_64bits = pcigar_64bits;
+  if (pcigar_64bits) {
+    bt_buffer->pcigar_max_length = PCIGAR64_MAX_LENGTH;
+    bt_buffer->pcigar_full_mask = PCIGAR64_FULL_MASK;
+    bt_buffer->pcigar_almost_full_mask = PCIGAR64_ALMOST_FULL_MASK;
+    bt_buffer->pcigar_half_full_mask = PCIGAR64_HALF_FULL_MASK;
+    bt_buffer->block_size = BT_BLOCK_SIZE_PCIGAR64;
+  } else {
+    bt_buffer->pcigar_max_length = PCIGAR32_MAX_LENGTH;
+    bt_buffer->pcigar_full_mask = PCIGAR32_FULL_MASK;
+    bt_buffer->pcigar_almost_full_mask = PCIGAR32_ALMOST_FULL_MASK;
+    bt_buffer->pcigar_half_full_mask = PCIGAR32_HALF_FULL_MASK;
+    bt_buffer->block_size = BT_BLOCK_SIZE_PCIGAR32;
+  }
+}
+/*
+ * Spill
+ */
+void wf_backtrace_buffer_spill_open(
+    wf_backtrace_buffer_t* const bt_buffer) {
+  // Create an anonymous spill-file (unlinked right away)
+  const char* const spill_dir = (bt_buffer->spill_dir != NULL) ?
+      bt_buffer->spill_dir : BT_BUFFER_SPILL_DIR_DEFAULT;
+  char* const spill_path = malloc(strlen(spill_dir)+32);
+  sprintf(spill_path,"%s/wfa.bt_buffer.XXXXXX",spill_dir);
+  bt_buffer->spill_fd = mkstemp(spill_path);
+  if (bt_buffer->spill_fd == -1) {
+    fprintf(stderr,"[WFA::BacktraceBuffer] Error creating spill-file '%s'\n",spill_path);
+    exit(1);
+  }
+  unlink(spill_path);
+  free(spill_path);
+}
+bool wf_backtrace_buffer_spill_segment(
+    wf_backtrace_buffer_t* const bt_buffer) {
+  // Check spill-mode and resident segments
+  if (bt_buffer->spill_max_memory == 0) return false;
+  const uint64_t max_resident = MAX(
+      bt_buffer->spill_max_memory/BT_BUFFER_SEGMENT_SIZE(bt_buffer),BT_BUFFER_SPILL_MIN_RESIDENT);
+  const int num_segments = vector_get_used(bt_buffer->segments);
+  const int spill_idx = bt_buffer->num_segments_spilled;
+  if (num_segments - spill_idx < max_resident) return false;
+  // Only fully compacted segments are spilled (never written again, unless fully re-compacted)
+  const uint64_t spill_end = ((uint64_t)spill_idx+1) * BT_BUFFER_SEGMENT_LENGTH;
+  if (spill_end > bt_buffer->num_compacted_blocks) return false;
+  // Write segment to the spill-file
+  if (bt_buffer->spill_fd == -1) wf_backtrace_buffer_spill_open(bt_buffer);
+  bt_block_t** const segments = vector_get_mem(bt_buffer->segments,bt_block_t*);
+  bt_block_t* const segment = segments[spill_idx];
+  const off_t spill_offset = (off_t)spill_idx * BT_BUFFER_SEGMENT_SIZE(bt_buffer);
+  uint64_t written = 0;
+  while (written < BT_BUFFER_SEGMENT_SIZE(bt_buffer)) {
+    const ssize_t bytes = pwrite(bt_buffer->spill_fd,
+        (char*)segment+written,BT_BUFFER_SEGMENT_SIZE(bt_buffer)-written,spill_offset+written);
+    if (bytes <= 0) {
+      fprintf(stderr,"[WFA::BacktraceBuffer] Error writing spill-file\n");
+      exit(1);
+    }
+    written += bytes;
+  }
+  // Map it back (paged-in on demand; e.g., during backtrace)
+  void* const spilled_segment = mmap(NULL,BT_BUFFER_SEGMENT_SIZE(bt_buffer),
+      PROT_READ|PROT_WRITE,MAP_SHARED,bt_buffer->spill_fd,spill_offset);
+  if (spilled_segment == MAP_FAILED) {
+    fprintf(stderr,"[WFA::BacktraceBuffer] Error mapping spill-file\n");
+    exit(1);
+  }
+  segments[spill_idx] = spilled_segment;
+  ++(bt_buffer->num_segments_spilled);
+  // Recycle the resident memory as a new segment
+  vector_insert(bt_buffer->segments,segment,bt_block_t*);
+  return true;
+}
+void wf_backtrace_buffer_spill_clear(
+    wf_backtrace_buffer_t* const bt_buffer) {
+  // Check spilled segments
+  const int num_segments_spilled = bt_buffer->num_segments_spilled;
+  if (num_segments_spilled == 0) return;
+  // Unmap spilled segments
+  const int num_segments = vector_get_used(bt_buffer->segments);
+  bt_block_t** const segments = vector_get_mem(bt_buffer->segments,bt_block_t*);
+  int i;
+  for (i=0;i<num_segments_spilled;++i) {
+    munmap(segments[i],BT_BUFFER_SEGMENT_SIZE(bt_buffer));
+  }
+  // Keep only resident segments
+  memmove(segments,segments+num_segments_spilled,
+      (num_segments-num_segments_spilled)*sizeof(bt_block_t*));
+  vector_set_used(bt_buffer->segments,num_segments-num_segments_spilled);
+  bt_buffer->num_segments_spilled = 0;
+  // Discard spilled content
+  if (ftruncate(bt_buffer->spill_fd,0) != 0) {
+    fprintf(stderr,"[WFA::BacktraceBuffer] Error truncating spill-file\n");
+    exit(1);
+  }
+}
+void wf_backtrace_buffer_set_spill(
+    wf_backtrace_buffer_t* const bt_buffer,
+    const uint64_t max_memory_resident,
+    char* const spill_dir) {
+  // Spill-mode (disabled if zero or unlimited)
+  bt_buffer->spill_max_memory = (max_memory_resident == UINT64_MAX) ? 0 : max_memory_resident;
+  bt_buffer->spill_dir = spill_dir;
+}
 /*
  * BT-Block Segments
  */
 void wf_backtrace_buffer_segment_add(
     wf_backtrace_buffer_t* const bt_buffer) {
-  bt_block_t* const bt_segment = mm_allocator_calloc(
-      bt_buffer->mm_allocator,BT_BUFFER_SEGMENT_LENGTH,bt_block_t,false);
+  bt_block_t* const bt_segment = mm_allocator_malloc(
+      bt_buffer->mm_allocator,BT_BUFFER_SEGMENT_SIZE(bt_buffer));
   vector_insert(bt_buffer->segments,bt_segment,bt_block_t*);
 }
 void wf_backtrace_buffer_segment_reserve(
@@ -61,10 +174,13 @@ void wf_backtrace_buffer_segment_reserve(
     // Check segment position
     const uint64_t block_idx = ((uint64_t)bt_buffer->segment_idx+1) * BT_BUFFER_SEGMENT_LENGTH;
     if (block_idx >= BT_BLOCK_IDX_MAX) {
-      fprintf(stderr,"[WFA::BacktraceBuffer] Reached maximum addressable index"); exit(-1);
+      fprintf(stderr,"[WFA::BacktraceBuffer] Reached maximum addressable index "
+          "(rebuild with BUILD_WFA_BT64=1 for 64-bit BT-block indices)\n"); exit(-1);
+    }
+    // Add segment (spilling the oldest resident one if possible)
+    if (!wf_backtrace_buffer_spill_segment(bt_buffer)) {
+      wf_backtrace_buffer_segment_add(bt_buffer);
     }
-    // Add segment
-    wf_backtrace_buffer_segment_add(bt_buffer);
   }
   // Set pointer to next block free
   bt_block_t** const segments = vector_get_mem(bt_buffer->segments,bt_block_t*);
@@ -80,6 +196,7 @@ wf_backtrace_buffer_t* wf_backtrace_buffer_new(
       mm_allocator_alloc(mm_allocator,wf_backtrace_buffer_t);
   bt_buffer->mm_allocator = mm_allocator;
   // Initialize
+  wf_backtrace_buffer_set_pcigar_format(bt_buffer,false);
   bt_buffer->segment_idx = 0;
   bt_buffer->segment_offset = 0;
   bt_buffer->segments = vector_new(10,bt_block_t*);
@@ -90,11 +207,16 @@ wf_backtrace_buffer_t* wf_backtrace_buffer_new(
   bt_buffer->alignment_init_pos = vector_new(100,wf_backtrace_init_pos_t);
   bt_buffer->alignment_packed = vector_new(100,pcigar_t);
   bt_buffer->prefetch_blocks_idxs = vector_new(500,bt_block_idx_t);
+  bt_buffer->spill_max_memory = 0;
+  bt_buffer->spill_dir = NULL;
+  bt_buffer->spill_fd = -1;
+  bt_buffer->num_segments_spilled = 0;
   // Return
   return bt_buffer;
 }
 void wf_backtrace_buffer_clear(
     wf_backtrace_buffer_t* const bt_buffer) {
+  wf_backtrace_buffer_spill_clear(bt_buffer);
   bt_buffer->segment_idx = 0;
   bt_buffer->segment_offset = 0;
   bt_buffer->block_next = vector_get_mem(bt_buffer->segments,bt_block_t*)[0];
@@ -104,6 +226,7 @@ void wf_backtrace_buffer_clear(
 }
 void wf_backtrace_buffer_reap(
     wf_backtrace_buffer_t* const bt_buffer) {
+  wf_backtrace_buffer_spill_clear(bt_buffer);
   // Reap segments beyond the first
   const int num_segments = vector_get_used(bt_buffer->segments);
   bt_block_t** const segments = vector_get_mem(bt_buffer->segments,bt_block_t*);
@@ -119,8 +242,31 @@ void wf_backtrace_buffer_reap(
   bt_buffer->num_compacted_blocks = 0;
   bt_buffer->num_compactions = 0;
 }
+void wf_backtrace_buffer_set_pcigar(
+    wf_backtrace_buffer_t* const bt_buffer,
+    const bool pcigar_64bits) {
+  // Check format
+  if (bt_buffer->pcigar_64bits == pcigar_64bits) return;
+  // Free segments (sized for the previous BT-block size)
+  wf_backtrace_buffer_spill_clear(bt_buffer);
+  const int num_segments = vector_get_used(bt_buffer->segments);
+  bt_block_t** const segments = vector_get_mem(bt_buffer->segments,bt_block_t*);
+  int i;
+  for (i=0;i<num_segments;++i) {
+    mm_allocator_free(bt_buffer->mm_allocator,segments[i]);
+  }
+  vector_clear(bt_buffer->segments);
+  // Set new format and allocate initial segment
+  wf_backtrace_buffer_set_pcigar_format(bt_buffer,pcigar_64bits);
+  wf_backtrace_buffer_segment_add(bt_buffer);
+  // Clear
+  wf_backtrace_buffer_clear(bt_buffer);
+}
 void wf_backtrace_buffer_delete(
     wf_backtrace_buffer_t* const bt_buffer) {
+  // Free spilled segments
+  wf_backtrace_buffer_spill_clear(bt_buffer);
+  if (bt_buffer->spill_fd != -1) close(bt_buffer->spill_fd);
   // Free segments
   const int num_segments = vector_get_used(bt_buffer->segments);
   bt_block_t** const segments = vector_get_mem(bt_buffer->segments,bt_block_t*);
@@ -160,12 +306,13 @@ void wf_backtrace_buffer_reset_compaction(
 uint64_t wf_backtrace_buffer_get_size_allocated(
     wf_backtrace_buffer_t* const bt_buffer) {
   const uint64_t segments_used = vector_get_used(bt_buffer->segments);
-  return segments_used*BT_BUFFER_SEGMENT_LENGTH*sizeof(bt_block_t);
+  const uint64_t segments_resident = segments_used - bt_buffer->num_segments_spilled;
+  return segments_resident*BT_BUFFER_SEGMENT_SIZE(bt_buffer);
 }
 uint64_t wf_backtrace_buffer_get_size_used(
     wf_backtrace_buffer_t* const bt_buffer) {
   const bt_block_idx_t max_block_idx = BT_BUFFER_IDX(bt_buffer->segment_idx,bt_buffer->segment_offset);
-  return max_block_idx*sizeof(bt_block_t);
+  return (uint64_t)max_block_idx*bt_buffer->block_size;
 }
 void wf_backtrace_buffer_prefetch_block(
     wf_backtrace_buffer_t* const bt_buffer,
@@ -175,7 +322,7 @@ void wf_backtrace_buffer_prefetch_block(
   const int segment_offset = BT_BUFFER_SEGMENT_OFFSET(block_idx);
   // Fetch bt-block
   bt_block_t** const segments = vector_get_mem(bt_buffer->segments,bt_block_t*);
-  PREFETCH(segments[segment_idx]+segment_offset);
+  PREFETCH((uint8_t*)segments[segment_idx]+(uint64_t)segment_offset*bt_buffer->block_size);
 }
 bt_block_t* wf_backtrace_buffer_get_block(
     wf_backtrace_buffer_t* const bt_buffer,
@@ -185,14 +332,14 @@ bt_block_t* wf_backtrace_buffer_get_block(
   const int segment_offset = BT_BUFFER_SEGMENT_OFFSET(block_idx);
   // Fetch bt-block
   bt_block_t** const segments = vector_get_mem(bt_buffer->segments,bt_block_t*);
-  return &(segments[segment_idx][segment_offset]);
+  return (bt_block_t*)((uint8_t*)segments[segment_idx]+(uint64_t)segment_offset*bt_buffer->block_size);
 }
 void wf_backtrace_buffer_add_used(
     wf_backtrace_buffer_t* const bt_buffer,
     const int used) {
   // Next
   bt_buffer->segment_offset += used;
-  bt_buffer->block_next += used;
+  bt_buffer->block_next = (bt_block_t*)((uint8_t*)bt_buffer->block_next+(uint64_t)used*bt_buffer->block_size);
   // Reserve
   if (bt_buffer->segment_offset >= BT_BUFFER_SEGMENT_LENGTH) {
     wf_backtrace_buffer_segment_reserve(bt_buffer);
@@ -219,10 +366,10 @@ void wf_backtrace_buffer_store_block(
     const pcigar_t pcigar,
     const bt_block_idx_t prev_idx) {
   // Store BT-block
-  bt_buffer->block_next->pcigar = pcigar;
+  BT_BLOCK_SET_PCIGAR(bt_buffer,bt_buffer->block_next,pcigar);
   bt_buffer->block_next->prev_idx = prev_idx;
   // Next
-  ++(bt_buffer->block_next);
+  bt_buffer->block_next = BT_BLOCK_NEXT(bt_buffer,bt_buffer->block_next);
   ++(bt_buffer->segment_offset);
   // Reserve
   if (bt_buffer->segment_offset >= BT_BUFFER_SEGMENT_LENGTH) {
@@ -231,8 +378,8 @@ void wf_backtrace_buffer_store_block(
 }
 bt_block_idx_t wf_backtrace_buffer_init_block(
     wf_backtrace_buffer_t* const bt_buffer,
-    const int v,
-    const int h) {
+    const wf_coord_t v,
+    const wf_coord_t h) {
   // Parameters
   const int segment_idx = bt_buffer->segment_idx;
   const int segment_offset = bt_buffer->segment_offset;
@@ -256,7 +403,7 @@ bt_block_t* wf_backtrace_buffer_traceback_pcigar(
   vector_clear(alignment_packed);
   // Traverse-back the BT-blocks and store all the pcigars
   while (bt_block->prev_idx != BT_BLOCK_IDX_NULL) {
-    vector_insert(alignment_packed,bt_block->pcigar,pcigar_t);
+    vector_insert(alignment_packed,BT_BLOCK_GET_PCIGAR(bt_buffer,bt_block),pcigar_t);
     const bt_block_idx_t prev_idx = bt_block->prev_idx;
     bt_block = wf_backtrace_buffer_get_block(bt_buffer,prev_idx);
   }
@@ -266,23 +413,23 @@ bt_block_t* wf_backtrace_buffer_traceback_pcigar(
 void wf_backtrace_buffer_unpack_cigar_linear(
     wf_backtrace_buffer_t* const bt_buffer,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    const int begin_v,
-    const int begin_h,
-    const int end_v,
-    const int end_h,
+    const wf_coord_t begin_v,
+    const wf_coord_t begin_h,
+    const wf_coord_t end_v,
+    const wf_coord_t end_h,
     cigar_t* const cigar) {
   // Clear cigar
   char* cigar_buffer = cigar->operations;
   cigar->begin_offset = 0;
   // Add init insertions/deletions
-  int i;
-  int v = begin_v;
-  int h = begin_h;
+  wf_coord_t i;
+  wf_coord_t v = begin_v;
+  wf_coord_t h = begin_h;
   for (i=0;i<h;++i) {*cigar_buffer = 'I'; ++cigar_buffer;};
   for (i=0;i<v;++i) {*cigar_buffer = 'D'; ++cigar_buffer;};
   // Traverse-forward the pcigars and unpack the cigar
@@ -290,7 +437,7 @@ void wf_backtrace_buffer_unpack_cigar_linear(
   pcigar_t* const palignment_blocks = vector_get_mem(bt_buffer->alignment_packed,pcigar_t);
   for (i=num_palignment_blocks-1;i>=0;--i) {
     // Unpack block
-    int cigar_block_length = 0;
+    wf_coord_t cigar_block_length = 0;
     pcigar_unpack_linear(
         palignment_blocks[i],
         pattern,pattern_length,text,text_length,
@@ -300,7 +447,7 @@ void wf_backtrace_buffer_unpack_cigar_linear(
     cigar_buffer += cigar_block_length;
   }
   // Account for last stroke of matches
-  const int num_matches = MIN(end_v-v,end_h-h);
+  const wf_coord_t num_matches = MIN(end_v-v,end_h-h);
   for (i=0;i<num_matches;++i) {*cigar_buffer = 'M'; ++cigar_buffer;};
   v += num_matches;
   h += num_matches;
@@ -314,23 +461,23 @@ void wf_backtrace_buffer_unpack_cigar_linear(
 void wf_backtrace_buffer_unpack_cigar_affine(
     wf_backtrace_buffer_t* const bt_buffer,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    const int begin_v,
-    const int begin_h,
-    const int end_v,
-    const int end_h,
+    const wf_coord_t begin_v,
+    const wf_coord_t begin_h,
+    const wf_coord_t end_v,
+    const wf_coord_t end_h,
     cigar_t* const cigar) {
   // Clear cigar
   char* cigar_buffer = cigar->operations;
   cigar->begin_offset = 0;
   // Add init insertions/deletions
-  int i;
-  int v = begin_v;
-  int h = begin_h;
+  wf_coord_t i;
+  wf_coord_t v = begin_v;
+  wf_coord_t h = begin_h;
   for (i=0;i<h;++i) {*cigar_buffer = 'I'; ++cigar_buffer;};
   for (i=0;i<v;++i) {*cigar_buffer = 'D'; ++cigar_buffer;};
   // Traverse-forward the pcigars and unpack the cigar
@@ -339,7 +486,7 @@ void wf_backtrace_buffer_unpack_cigar_affine(
   affine_matrix_type current_matrix_type = affine_matrix_M;
   for (i=num_palignment_blocks-1;i>=0;--i) {
     // Unpack block
-    int cigar_block_length = 0;
+    wf_coord_t cigar_block_length = 0;
     pcigar_unpack_affine(
         palignment_blocks[i],
         pattern,pattern_length,text,text_length,
@@ -349,7 +496,7 @@ void wf_backtrace_buffer_unpack_cigar_affine(
     cigar_buffer += cigar_block_length;
   }
   // Account for last stroke of matches
-  const int num_matches = MIN(end_v-v,end_h-h);
+  const wf_coord_t num_matches = MIN(end_v-v,end_h-h);
   for (i=0;i<num_matches;++i) {*cigar_buffer = 'M'; ++cigar_buffer;};
   v += num_matches;
   h += num_matches;
@@ -477,8 +624,8 @@ bt_block_idx_t wf_backtrace_buffer_compact_marked(
   bt_block_idx_t read_offset = BT_BUFFER_SEGMENT_OFFSET(read_global_pos);
   bt_block_idx_t write_segidx = BT_BUFFER_SEGMENT_IDX(write_global_pos);
   bt_block_idx_t write_offset = BT_BUFFER_SEGMENT_OFFSET(write_global_pos);
-  bt_block_t* read_block = segments[read_segidx] + read_offset;
-  bt_block_t* write_block = segments[write_segidx] + write_offset;
+  bt_block_t* read_block = wf_backtrace_buffer_get_block(bt_buffer,read_global_pos);
+  bt_block_t* write_block = wf_backtrace_buffer_get_block(bt_buffer,write_global_pos);
   // Traverse all BT-blocks from the beginning (stored marked)
   const bt_block_idx_t max_block_idx = BT_BUFFER_IDX(bt_buffer->segment_idx,bt_buffer->segment_offset);
   while (read_global_pos < max_block_idx) {
@@ -486,7 +633,7 @@ bt_block_idx_t wf_backtrace_buffer_compact_marked(
     BITMAP_GET_BLOCK(bitmap,read_global_pos,block_bitmap_ptr);
     if (BM_BLOCK_IS_SET(*block_bitmap_ptr,read_global_pos)) {
       // Store pcigar in compacted BT-buffer
-      write_block->pcigar = read_block->pcigar;
+      BT_BLOCK_SET_PCIGAR(bt_buffer,write_block,BT_BLOCK_GET_PCIGAR(bt_buffer,read_block));
       // Translate and store index in compacted BT-buffer
       if (read_block->prev_idx == BT_BLOCK_IDX_NULL ||
           read_block->prev_idx < num_compacted_blocks) {
@@ -495,7 +642,8 @@ bt_block_idx_t wf_backtrace_buffer_compact_marked(
         write_block->prev_idx = num_compacted_blocks + bitmap_erank(bitmap,read_block->prev_idx);
       }
       // Next write
-      ++write_offset; ++write_block; ++write_global_pos;
+      ++write_offset; ++write_global_pos;
+      write_block = BT_BLOCK_NEXT(bt_buffer,write_block);
       if (write_offset >= BT_BUFFER_SEGMENT_LENGTH) {
         // Next segment
         write_block = segments[++write_segidx];
@@ -503,7 +651,8 @@ bt_block_idx_t wf_backtrace_buffer_compact_marked(
       }
     }
     // Next read
-    ++read_offset; ++read_block; ++read_global_pos;
+    ++read_offset; ++read_global_pos;
+    read_block = BT_BLOCK_NEXT(bt_buffer,read_block);
     if (read_offset >= BT_BUFFER_SEGMENT_LENGTH) {
       // Next segment
       if (++read_segidx >= num_segments) break;
@@ -519,8 +668,8 @@ bt_block_idx_t wf_backtrace_buffer_compact_marked(
   // DEBUG
   if (verbose >= 3) {
     fprintf(stderr,"[WFA::BacktraceBuffer] Compacted from %lu MB to %lu MB (%2.2f%%)",
-        CONVERT_B_TO_MB(read_global_pos*sizeof(bt_block_t)),
-        CONVERT_B_TO_MB(write_global_pos*sizeof(bt_block_t)),
+        CONVERT_B_TO_MB((uint64_t)read_global_pos*bt_buffer->block_size),
+        CONVERT_B_TO_MB((uint64_t)write_global_pos*bt_buffer->block_size),
         100.0f*(float)write_global_pos/(float)read_global_pos);
   }
   // Return last index
@@ -44,21 +44,44 @@
 /*
  * Separated Backtrace Block
  */
-typedef uint32_t bt_block_idx_t; // Up to 2^31 references (~32GB of not-compactable pCIGARs)
+#ifdef WFA_BT_BLOCK_IDX_64
+typedef uint64_t bt_block_idx_t; // Unbounded references (BT-blocks grow 4 Bytes)
+#define BT_BLOCK_IDX_MAX   UINT64_MAX
+#define BT_BLOCK_IDX_NULL  UINT64_MAX
+#else
+typedef uint32_t bt_block_idx_t; // Up to 2^32 references (~32GB of not-compactable pCIGARs)
 #define BT_BLOCK_IDX_MAX   UINT32_MAX
 #define BT_BLOCK_IDX_NULL  UINT32_MAX
+#endif
 
 typedef struct {
-  pcigar_t pcigar;            // Packed CIGAR
+  uint32_t pcigar_lo;         // Packed CIGAR (32 LSB)
   bt_block_idx_t prev_idx;    // Index of the previous BT-block
+  uint32_t pcigar_hi;         // Packed CIGAR (32 MSB; only stored using 64-bit pCIGARs)
 } __attribute__((packed)) bt_block_t;
+#define BT_BLOCK_SIZE_PCIGAR32 (sizeof(bt_block_t)-sizeof(uint32_t))
+#define BT_BLOCK_SIZE_PCIGAR64 (sizeof(bt_block_t))
+
+/*
+ * BT-Block accessors (BT-blocks size depends on the pCIGAR width)
+ */
+#define BT_BLOCK_NEXT(bt_buffer,bt_block) \
+  ((bt_block_t*)((uint8_t*)(bt_block)+(bt_buffer)->block_size))
+#define BT_BLOCK_GET_PCIGAR(bt_buffer,bt_block) \
+  (((bt_buffer)->pcigar_64bits) ? \
+      (((pcigar_t)(bt_block)->pcigar_hi << 32) | (bt_block)->pcigar_lo) : \
+      ((pcigar_t)(bt_block)->pcigar_lo))
+#define BT_BLOCK_SET_PCIGAR(bt_buffer,bt_block,pcigar) { \
+  (bt_block)->pcigar_lo = (uint32_t)(pcigar); \
+  if ((bt_buffer)->pcigar_64bits) (bt_block)->pcigar_hi = (uint32_t)((pcigar) >> 32); \
+}
 
 /*
  * Backtrace initial positions
  */
 typedef struct {
-  int v;
-  int h;
+  wf_coord_t v;
+  wf_coord_t h;
 } wf_backtrace_init_pos_t;
 
 /*
@@ -74,9 +97,21 @@ typedef struct {
   vector_t* alignment_init_pos;        // Buffer to store alignment's initial coordinates (h,v) (wf_backtrace_init_pos_t)
   bt_block_idx_t num_compacted_blocks; // Total compacted blocks in BT-buffer compacted (dense from 0..num_compacted_blocks-1)
   int num_compactions;                 // Total compactions performed
+  // Packed-CIGAR format
+  bool pcigar_64bits;                  // BT-blocks store 64-bit pCIGARs (otherwise 32-bit)
+  int pcigar_max_length;               // Maximum operations per pCIGAR
+  pcigar_t pcigar_full_mask;           // Occupancy mask (completely full)
+  pcigar_t pcigar_almost_full_mask;    // Occupancy mask (all slots busy but one)
+  pcigar_t pcigar_half_full_mask;      // Occupancy mask (more than half the slots busy)
+  int block_size;                      // BT-block size (Bytes)
   // Internal buffers
   vector_t* alignment_packed;          // Temporal buffer to store final alignment (pcigar_t)
   vector_t* prefetch_blocks_idxs;      // Temporal buffer to store blocks_idxs (bt_block_idx_t)
+  // Spill (fully compacted segments moved to a memory-mapped file)
+  uint64_t spill_max_memory;           // Maximum memory kept resident (0 if spill disabled)
+  char* spill_dir;                     // Directory to create the spill-file
+  int spill_fd;                        // Spill-file descriptor (-1 if not created yet)
+  int num_segments_spilled;            // Total segments spilled (always the first ones)
   // MM
   mm_allocator_t* mm_allocator;
 } wf_backtrace_buffer_t;
@@ -93,6 +128,21 @@ void wf_backtrace_buffer_reap(
 void wf_backtrace_buffer_delete(
     wf_backtrace_buffer_t* const bt_buffer);
 
+/*
+ * Packed-CIGAR format
+ */
+void wf_backtrace_buffer_set_pcigar(
+    wf_backtrace_buffer_t* const bt_buffer,
+    const bool pcigar_64bits);
+
+/*
+ * Spill
+ */
+void wf_backtrace_buffer_set_spill(
+    wf_backtrace_buffer_t* const bt_buffer,
+    const uint64_t max_memory_resident,
+    char* const spill_dir);
+
 /*
  * Accessors
  */
@@ -109,8 +159,8 @@ bt_block_idx_t wf_backtrace_buffer_get_mem(
  */
 bt_block_idx_t wf_backtrace_buffer_init_block(
     wf_backtrace_buffer_t* const bt_buffer,
-    const int v,
-    const int h);
+    const wf_coord_t v,
+    const wf_coord_t h);
 
 /*
  * Unpack CIGAR
@@ -121,28 +171,28 @@ bt_block_t* wf_backtrace_buffer_traceback_pcigar(
 void wf_backtrace_buffer_unpack_cigar_linear(
     wf_backtrace_buffer_t* const bt_buffer,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    const int begin_v,
-    const int begin_h,
-    const int end_v,
-    const int end_h,
+    const wf_coord_t begin_v,
+    const wf_coord_t begin_h,
+    const wf_coord_t end_v,
+    const wf_coord_t end_h,
     cigar_t* const cigar);
 void wf_backtrace_buffer_unpack_cigar_affine(
     wf_backtrace_buffer_t* const bt_buffer,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    const int begin_v,
-    const int begin_h,
-    const int end_v,
-    const int end_h,
+    const wf_coord_t begin_v,
+    const wf_coord_t begin_h,
+    const wf_coord_t end_v,
+    const wf_coord_t end_h,
     cigar_t* const cigar);
 
 /*
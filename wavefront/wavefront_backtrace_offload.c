@@ -35,51 +35,71 @@
 /*
  * Backtrace-blocks offloading
  */
-void wavefront_backtrace_offload_blocks_selective(
+FORCE_INLINE void wavefront_backtrace_offload_blocks_selective_kernel(
     wf_offset_t* const out_offsets,
-    pcigar_t* const out_bt_pcigar,
+    void* const out_bt_pcigar,
     bt_block_idx_t* const out_bt_prev,
-    const int lo,
-    const int hi,
+    const wf_coord_t lo,
+    const wf_coord_t hi,
     const pcigar_t occupation_mask,
-    wf_backtrace_buffer_t* const bt_buffer) {
+    wf_backtrace_buffer_t* const bt_buffer,
+    const bool pcigar_64bits) {
   // Fetch BT-buffer free memory
   int bt_blocks_available;
   bt_block_t* bt_block_mem;
   bt_block_idx_t global_pos = wf_backtrace_buffer_get_mem(bt_buffer,&bt_block_mem,&bt_blocks_available);
   bt_block_idx_t current_pos = global_pos;
-  const int max_pos = current_pos + bt_blocks_available;
+  bt_block_idx_t max_pos = current_pos + bt_blocks_available;
   // Check PCIGAR buffers full and off-load if needed
-  int k;
+  wf_coord_t k;
   for (k=lo;k<=hi;++k) {
-    if (out_offsets[k]>=0 && PCIGAR_IS_UTILISED(out_bt_pcigar[k],occupation_mask)) {
+    const pcigar_t pcigar = PCIGAR_GET(out_bt_pcigar,k,pcigar_64bits);
+    if (out_offsets[k]>=0 && PCIGAR_IS_UTILISED(pcigar,occupation_mask)) {
       // Store
-      bt_block_mem->pcigar = out_bt_pcigar[k];
+      BT_BLOCK_SET_PCIGAR(bt_buffer,bt_block_mem,pcigar);
       bt_block_mem->prev_idx = out_bt_prev[k];
-      bt_block_mem++;
+      bt_block_mem = BT_BLOCK_NEXT(bt_buffer,bt_block_mem);
       // Reset
-      out_bt_pcigar[k] = 0;
+      PCIGAR_SET(out_bt_pcigar,k,0,pcigar_64bits);
       out_bt_prev[k] = current_pos;
       current_pos++;
       // Update pos
       if (current_pos >= max_pos) {
         wf_backtrace_buffer_add_used(bt_buffer,current_pos-global_pos);
         global_pos = wf_backtrace_buffer_get_mem(bt_buffer,&bt_block_mem,&bt_blocks_available);
+        max_pos = global_pos + bt_blocks_available;
       }
     }
   }
   wf_backtrace_buffer_add_used(bt_buffer,current_pos-global_pos);
 }
+void wavefront_backtrace_offload_blocks_selective(
+    wf_offset_t* const out_offsets,
+    void* const out_bt_pcigar,
+    bt_block_idx_t* const out_bt_prev,
+    const wf_coord_t lo,
+    const wf_coord_t hi,
+    const pcigar_t occupation_mask,
+    wf_backtrace_buffer_t* const bt_buffer) {
+  // Specialize the kernel for the pCIGAR storage width
+  if (bt_buffer->pcigar_64bits) {
+    wavefront_backtrace_offload_blocks_selective_kernel(
+        out_offsets,out_bt_pcigar,out_bt_prev,lo,hi,occupation_mask,bt_buffer,true);
+  } else {
+    wavefront_backtrace_offload_blocks_selective_kernel(
+        out_offsets,out_bt_pcigar,out_bt_prev,lo,hi,occupation_mask,bt_buffer,false);
+  }
+}
 /*
  * Backtrace offloading (linear)
  */
 int wavefront_backtrace_offload_blocks_linear(
     wavefront_aligner_t* const wf_aligner,
     wf_offset_t* const out_offsets,
-    pcigar_t* const out_bt_pcigar,
+    void* const out_bt_pcigar,
     bt_block_idx_t* const out_bt_prev,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
   const wavefront_memory_t wavefront_memory = wf_aligner->memory_mode;
   wf_backtrace_buffer_t* const bt_buffer = wf_aligner->wf_components.bt_buffer;
@@ -88,14 +108,14 @@ int wavefront_backtrace_offload_blocks_linear(
     case wavefront_memory_med:
       wavefront_backtrace_offload_blocks_selective(
           out_offsets,out_bt_pcigar,out_bt_prev,
-          lo,hi,PCIGAR_HALF_FULL_MASK,bt_buffer);
-      return PCIGAR_MAX_LENGTH/2; // Half occupancy
+          lo,hi,bt_buffer->pcigar_half_full_mask,bt_buffer);
+      return bt_buffer->pcigar_max_length/2; // Half occupancy
       break;
     case wavefront_memory_low:
       wavefront_backtrace_offload_blocks_selective(
           out_offsets,out_bt_pcigar,out_bt_prev,
-          lo,hi,PCIGAR_FULL_MASK,bt_buffer);
-      return PCIGAR_MAX_LENGTH-1; // At least 1-slots free
+          lo,hi,bt_buffer->pcigar_full_mask,bt_buffer);
+      return bt_buffer->pcigar_max_length-1; // At least 1-slots free
       break;
     default:
       fprintf(stderr,"[WFA::compute] Wrong memory-mode\n");
@@ -105,12 +125,13 @@ int wavefront_backtrace_offload_blocks_linear(
 void wavefront_backtrace_offload_linear(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Paramters
   wavefront_t* const wf_m = wavefront_set->out_mwavefront;
   const wavefront_t* const m_misms = wavefront_set->in_mwavefront_misms;
   const wavefront_t* const m_open1 = wavefront_set->in_mwavefront_open1;
+  const int pcigar_max_length = wf_aligner->wf_components.bt_buffer->pcigar_max_length;
   // Compute BT occupancy maximum
   int occ_max_m = 0, occ_max_indel = 0;
   if (!m_open1->null) occ_max_indel = m_open1->bt_occupancy_max;
@@ -119,9 +140,9 @@ void wavefront_backtrace_offload_linear(
   // Set new occupancy
   wf_m->bt_occupancy_max = occ_max;
   // Offload if necessary (Gap-Linear)
-  if (!wf_m->null && occ_max >= PCIGAR_MAX_LENGTH) {
+  if (!wf_m->null && occ_max >= pcigar_max_length) {
     wf_offset_t* const out_m  = wavefront_set->out_mwavefront->offsets;
-    pcigar_t* const out_m_bt_pcigar = wavefront_set->out_mwavefront->bt_pcigar;
+    void* const out_m_bt_pcigar = wavefront_set->out_mwavefront->bt_pcigar;
     bt_block_idx_t* const out_m_bt_prev = wavefront_set->out_mwavefront->bt_prev;
     wavefront_set->out_mwavefront->bt_occupancy_max =
         wavefront_backtrace_offload_blocks_linear(
@@ -134,10 +155,10 @@ void wavefront_backtrace_offload_linear(
 int wavefront_backtrace_offload_blocks_affine(
     wavefront_aligner_t* const wf_aligner,
     wf_offset_t* const out_offsets,
-    pcigar_t* const out_bt_pcigar,
+    void* const out_bt_pcigar,
     bt_block_idx_t* const out_bt_prev,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
   const wavefront_memory_t wavefront_memory = wf_aligner->memory_mode;
   wf_backtrace_buffer_t* const bt_buffer = wf_aligner->wf_components.bt_buffer;
@@ -146,13 +167,13 @@ int wavefront_backtrace_offload_blocks_affine(
     case wavefront_memory_med:
       wavefront_backtrace_offload_blocks_selective(
           out_offsets,out_bt_pcigar,out_bt_prev,
-          lo,hi,PCIGAR_HALF_FULL_MASK,bt_buffer);
-      return PCIGAR_MAX_LENGTH/2; // Half occupancy
+          lo,hi,bt_buffer->pcigar_half_full_mask,bt_buffer);
+      return bt_buffer->pcigar_max_length/2; // Half occupancy
     case wavefront_memory_low:
       wavefront_backtrace_offload_blocks_selective(
           out_offsets,out_bt_pcigar,out_bt_prev,
-          lo,hi,PCIGAR_ALMOST_FULL_MASK,bt_buffer);
-      return PCIGAR_MAX_LENGTH-2; // At least 2-slots free
+          lo,hi,bt_buffer->pcigar_almost_full_mask,bt_buffer);
+      return bt_buffer->pcigar_max_length-2; // At least 2-slots free
     default:
       fprintf(stderr,"[WFA::compute] Wrong memory-mode\n");
       exit(1);
@@ -230,35 +251,36 @@ void wavefront_backtrace_offload_occupation_affine(
 void wavefront_backtrace_offload_affine(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
+  const int pcigar_max_length = wf_aligner->wf_components.bt_buffer->pcigar_max_length;
   // Compute maximum occupancy
   wavefront_backtrace_offload_occupation_affine(wf_aligner,wavefront_set);
   // Offload if necessary (Gap-Affine)
   const wavefront_t* const wf_m = wavefront_set->out_mwavefront;
-  if (!wf_m->null && wf_m->bt_occupancy_max >= PCIGAR_MAX_LENGTH-1) {
+  if (!wf_m->null && wf_m->bt_occupancy_max >= pcigar_max_length-1) {
     wf_offset_t* const out_m  = wavefront_set->out_mwavefront->offsets;
-    pcigar_t* const out_m_bt_pcigar = wavefront_set->out_mwavefront->bt_pcigar;
+    void* const out_m_bt_pcigar = wavefront_set->out_mwavefront->bt_pcigar;
     bt_block_idx_t* const out_m_bt_prev = wavefront_set->out_mwavefront->bt_prev;
     wavefront_set->out_mwavefront->bt_occupancy_max =
         wavefront_backtrace_offload_blocks_affine(
             wf_aligner,out_m,out_m_bt_pcigar,out_m_bt_prev,lo,hi);
   }
   const wavefront_t* const wf_i1 = wavefront_set->out_i1wavefront;
-  if (!wf_i1->null && wf_i1->bt_occupancy_max >= PCIGAR_MAX_LENGTH-1) {
+  if (!wf_i1->null && wf_i1->bt_occupancy_max >= pcigar_max_length-1) {
     wf_offset_t* const out_i1 = wavefront_set->out_i1wavefront->offsets;
-    pcigar_t* const out_i1_bt_pcigar = wavefront_set->out_i1wavefront->bt_pcigar;
+    void* const out_i1_bt_pcigar = wavefront_set->out_i1wavefront->bt_pcigar;
     bt_block_idx_t* const out_i1_bt_prev = wavefront_set->out_i1wavefront->bt_prev;
     wavefront_set->out_i1wavefront->bt_occupancy_max =
         wavefront_backtrace_offload_blocks_affine(
             wf_aligner,out_i1,out_i1_bt_pcigar,out_i1_bt_prev,lo,hi);
   }
   const wavefront_t* const wf_d1 = wavefront_set->out_d1wavefront;
-  if (!wf_d1->null && wf_d1->bt_occupancy_max >= PCIGAR_MAX_LENGTH-1) {
+  if (!wf_d1->null && wf_d1->bt_occupancy_max >= pcigar_max_length-1) {
     wf_offset_t* const out_d1 = wavefront_set->out_d1wavefront->offsets;
-    pcigar_t* const out_d1_bt_pcigar  = wavefront_set->out_d1wavefront->bt_pcigar;
+    void* const out_d1_bt_pcigar  = wavefront_set->out_d1wavefront->bt_pcigar;
     bt_block_idx_t* const out_d1_bt_prev = wavefront_set->out_d1wavefront->bt_prev;
     wavefront_set->out_d1wavefront->bt_occupancy_max =
         wavefront_backtrace_offload_blocks_affine(
@@ -267,18 +289,18 @@ void wavefront_backtrace_offload_affine(
   if (distance_metric == gap_affine) return;
   // Offload if necessary (Gap-Affine-2p)
   const wavefront_t* const wf_i2 = wavefront_set->out_i2wavefront;
-  if (!wf_i2->null && wf_i2->bt_occupancy_max >= PCIGAR_MAX_LENGTH-1) {
+  if (!wf_i2->null && wf_i2->bt_occupancy_max >= pcigar_max_length-1) {
     wf_offset_t* const out_i2 = wavefront_set->out_i2wavefront->offsets;
-    pcigar_t* const out_i2_bt_pcigar = wavefront_set->out_i2wavefront->bt_pcigar;
+    void* const out_i2_bt_pcigar = wavefront_set->out_i2wavefront->bt_pcigar;
     bt_block_idx_t* const out_i2_bt_prev = wavefront_set->out_i2wavefront->bt_prev;
     wavefront_set->out_i2wavefront->bt_occupancy_max =
         wavefront_backtrace_offload_blocks_affine(
             wf_aligner,out_i2,out_i2_bt_pcigar,out_i2_bt_prev,lo,hi);
   }
   const wavefront_t* const wf_d2 = wavefront_set->out_d2wavefront;
-  if (!wf_d2->null && wf_d2->bt_occupancy_max >= PCIGAR_MAX_LENGTH-1) {
+  if (!wf_d2->null && wf_d2->bt_occupancy_max >= pcigar_max_length-1) {
     wf_offset_t* const out_d2 = wavefront_set->out_d2wavefront->offsets;
-    pcigar_t* const out_d2_bt_pcigar = wavefront_set->out_d2wavefront->bt_pcigar;
+    void* const out_d2_bt_pcigar = wavefront_set->out_d2wavefront->bt_pcigar;
     bt_block_idx_t* const out_d2_bt_prev = wavefront_set->out_d2wavefront->bt_prev;
     wavefront_set->out_d2wavefront->bt_occupancy_max =
         wavefront_backtrace_offload_blocks_affine(
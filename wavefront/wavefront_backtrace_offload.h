@@ -40,15 +40,15 @@
 int wavefront_backtrace_offload_blocks_linear(
     wavefront_aligner_t* const wf_aligner,
     wf_offset_t* const out_offsets,
-    pcigar_t* const out_bt_pcigar,
+    void* const out_bt_pcigar,
     bt_block_idx_t* const out_bt_prev,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 void wavefront_backtrace_offload_linear(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 
 /*
  * Backtrace offloading (gap-affine)
@@ -56,14 +56,14 @@ void wavefront_backtrace_offload_linear(
 int wavefront_backtrace_offload_blocks_affine(
     wavefront_aligner_t* const wf_aligner,
     wf_offset_t* const out_offsets,
-    pcigar_t* const out_bt_pcigar,
+    void* const out_bt_pcigar,
     bt_block_idx_t* const out_bt_prev,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 void wavefront_backtrace_offload_affine(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 
 #endif /* WAVEFRONT_BACKTRACE_OFFLOAD_H_ */
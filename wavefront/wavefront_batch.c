@@ -0,0 +1,450 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: WaveFront alignment module for batches of sequence pairs
+ */
+
+#include "wavefront_batch.h"
+#include "wavefront_align.h"
+#include "wavefront_lockstep.h"
+
+#ifdef WFA_PARALLEL
+#include <omp.h>
+#endif
+
+/*
+ * Batch Alignment (one pair)
+ */
+void wavefront_align_batch_pair(
+    wavefront_aligner_t* const wf_aligner,
+    const wavefront_batch_pair_t* const pair,
+    wavefront_batch_result_t* const result) {
+  // Align
+  result->status = wavefront_align(wf_aligner,
+      pair->pattern,pair->pattern_length,
+      pair->text,pair->text_length);
+  result->score = wf_aligner->cigar->score;
+  // Output CIGAR
+  cigar_t* const cigar = result->cigar;
+  if (cigar == NULL) return;
+  if (cigar->max_operations < wf_aligner->cigar->max_operations) {
+    // Caller's allocator may be shared among results
+#ifdef WFA_PARALLEL
+    #pragma omp critical (wavefront_batch_cigar)
+#endif
+    cigar_resize(cigar,wf_aligner->cigar->max_operations);
+  }
+  cigar_copy(cigar,wf_aligner->cigar);
+}
+/*
+ * Batch Alignment (lockstep group)
+ */
+void wavefront_align_batch_lockstep(
+    wavefront_aligner_t* const wf_aligner,
+    wavefront_lockstep_t* const wf_lockstep,
+    const wavefront_batch_pair_t* const pairs,
+    const int* const pair_idxs,
+    const int num_group_pairs,
+    wavefront_batch_result_t* const results) {
+  // Parameters
+  const bool compute_cigar = (wf_aligner->alignment_scope == compute_alignment);
+  const wf_coord_t max_length =
+      wavefront_lockstep_max_length(wf_aligner->memory_mode,wf_aligner->alignment_scope);
+  const char* patterns[WF_LOCKSTEP_LANES];
+  wf_coord_t pattern_lengths[WF_LOCKSTEP_LANES];
+  const char* texts[WF_LOCKSTEP_LANES];
+  wf_coord_t text_lengths[WF_LOCKSTEP_LANES];
+  cigar_t* cigars[WF_LOCKSTEP_LANES];
+  int scores[WF_LOCKSTEP_LANES];
+  int lane_idxs[WF_LOCKSTEP_LANES];
+  // Assign pairs to lanes
+  int num_lanes = 0, i;
+  for (i=0;i<num_group_pairs;++i) {
+    const int idx = pair_idxs[i];
+    const wavefront_batch_pair_t* const pair = pairs + idx;
+    cigar_t* const cigar = results[idx].cigar;
+    // Long pairs are aligned one at a time
+    if (pair->pattern_length > max_length || pair->text_length > max_length) {
+      wavefront_align_batch_pair(wf_aligner,pair,results+idx);
+      continue;
+    }
+    // Prepare CIGAR
+    if (cigar != NULL) {
+      const wf_coord_t max_operations = pair->pattern_length + pair->text_length + 2;
+      if (cigar->max_operations < max_operations) {
+#ifdef WFA_PARALLEL
+        #pragma omp critical (wavefront_batch_cigar)
+#endif
+        cigar_resize(cigar,max_operations);
+      }
+      cigar_clear(cigar);
+    }
+    // Add lane
+    patterns[num_lanes] = pair->pattern;
+    pattern_lengths[num_lanes] = pair->pattern_length;
+    texts[num_lanes] = pair->text;
+    text_lengths[num_lanes] = pair->text_length;
+    cigars[num_lanes] = (compute_cigar) ? cigar : NULL;
+    lane_idxs[num_lanes] = idx;
+    ++num_lanes;
+  }
+  if (num_lanes == 0) return;
+  // Align (lockstep)
+  wavefront_lockstep_align(wf_lockstep,num_lanes,
+      patterns,pattern_lengths,texts,text_lengths,
+      scores,(compute_cigar) ? cigars : NULL);
+  // Store results
+  for (i=0;i<num_lanes;++i) {
+    wavefront_batch_result_t* const result = results + lane_idxs[i];
+    result->status = WF_STATUS_SUCCESSFUL;
+    result->score = scores[i];
+    if (result->cigar != NULL) result->cigar->score = scores[i];
+  }
+}
+/*
+ * Batch Alignment (group of pairs)
+ */
+void wavefront_align_batch_group(
+    wavefront_aligner_t* const wf_aligner,
+    wavefront_lockstep_t* const wf_lockstep,
+    const wavefront_batch_pair_t* const pairs,
+    const int* const pair_idxs,
+    const int num_group_pairs,
+    wavefront_batch_result_t* const results) {
+  if (wf_lockstep != NULL) {
+    wavefront_align_batch_lockstep(wf_aligner,wf_lockstep,
+        pairs,pair_idxs,num_group_pairs,results);
+  } else {
+    int i;
+    for (i=0;i<num_group_pairs;++i) {
+      const int idx = pair_idxs[i];
+      wavefront_align_batch_pair(wf_aligner,pairs+idx,results+idx);
+    }
+  }
+}
+wavefront_lockstep_t* wavefront_align_batch_lockstep_new(
+    wavefront_aligner_t* const wf_aligner) {
+  if (!wf_aligner->system.batch_lockstep) return NULL;
+  if (!wavefront_lockstep_supported(wf_aligner)) return NULL;
+  return wavefront_lockstep_new(&wf_aligner->penalties);
+}
+/*
+ * Batch Alignment (pair order)
+ */
+typedef struct {
+  int pair_idx;
+  wf_coord_t length;
+} wavefront_batch_sort_t;
+int wavefront_align_batch_sort_cmp(
+    const void* const a,
+    const void* const b) {
+  const wavefront_batch_sort_t* const sort_a = (const wavefront_batch_sort_t*)a;
+  const wavefront_batch_sort_t* const sort_b = (const wavefront_batch_sort_t*)b;
+  if (sort_a->length != sort_b->length) return (sort_a->length < sort_b->length) ? -1 : 1;
+  return sort_a->pair_idx - sort_b->pair_idx;
+}
+int* wavefront_align_batch_order(
+    const wavefront_batch_pair_t* const pairs,
+    const int num_pairs,
+    const bool sort_by_length) {
+  int* const pair_idxs = malloc(num_pairs*sizeof(int));
+  int i;
+  if (!sort_by_length) {
+    for (i=0;i<num_pairs;++i) pair_idxs[i] = i;
+    return pair_idxs;
+  }
+  // Lanes of similar length finish at similar scores (less idle lanes)
+  wavefront_batch_sort_t* const sort = malloc(num_pairs*sizeof(wavefront_batch_sort_t));
+  for (i=0;i<num_pairs;++i) {
+    sort[i].pair_idx = i;
+    sort[i].length = MAX(pairs[i].pattern_length,pairs[i].text_length);
+  }
+  qsort(sort,num_pairs,sizeof(wavefront_batch_sort_t),wavefront_align_batch_sort_cmp);
+  for (i=0;i<num_pairs;++i) pair_idxs[i] = sort[i].pair_idx;
+  free(sort);
+  return pair_idxs;
+}
+/*
+ * Batch Alignment
+ */
+void wavefront_align_batch_sequential(
+    const wavefront_batch_pair_t* const pairs,
+    const int num_pairs,
+    wavefront_aligner_attr_t* const attributes,
+    wavefront_batch_result_t* const results) {
+  // Setup
+  wavefront_aligner_t* const wf_aligner = wavefront_aligner_new(attributes);
+  wavefront_lockstep_t* const wf_lockstep = wavefront_align_batch_lockstep_new(wf_aligner);
+  const int group_size = (wf_lockstep != NULL) ? WF_LOCKSTEP_LANES : 1;
+  int* const pair_idxs = wavefront_align_batch_order(pairs,num_pairs,wf_lockstep!=NULL);
+  // Align
+  int i;
+  for (i=0;i<num_pairs;i+=group_size) {
+    wavefront_align_batch_group(wf_aligner,wf_lockstep,
+        pairs,pair_idxs+i,MIN(group_size,num_pairs-i),results);
+  }
+  // Free
+  free(pair_idxs);
+  if (wf_lockstep != NULL) wavefront_lockstep_delete(wf_lockstep);
+  wavefront_aligner_delete(wf_aligner);
+}
+#ifdef WFA_PARALLEL
+/*
+ * Batch Scheduling (cost model)
+ *   Aligning a pair takes O(ns), where the number of differences (s) is guessed
+ *   from the length difference plus the divergence observed on a few k-mers
+ *   sampled along the pattern (i.e., a k-mer survives with probability (1-d)^k).
+ */
+#define WF_BATCH_COST_MIN_LENGTH  4096  // Shorter pairs are not sampled
+#define WF_BATCH_COST_SAMPLES       16  // K-mers sampled
+#define WF_BATCH_COST_KMER          12  // K-mer length
+#define WF_BATCH_COST_WINDOW       256  // Text searched around the expected k-mer position
+#define WF_BATCH_COST_MAX_DIVERGENCE 0.5
+
+double wavefront_align_batch_divergence(
+    const wavefront_batch_pair_t* const pair) {
+  // Parameters
+  const char* const pattern = pair->pattern;
+  const char* const text = pair->text;
+  const int64_t pattern_length = pair->pattern_length;
+  const int64_t text_length = pair->text_length;
+  // Look for each k-mer around its expected diagonal
+  int num_found = 0, i;
+  for (i=0;i<WF_BATCH_COST_SAMPLES;++i) {
+    const int64_t v = (pattern_length-WF_BATCH_COST_KMER)*i/(WF_BATCH_COST_SAMPLES-1);
+    const int64_t h_expected = v*text_length/pattern_length;
+    const int64_t h_min = MAX(h_expected-WF_BATCH_COST_WINDOW,0);
+    const int64_t h_max = MIN(h_expected+WF_BATCH_COST_WINDOW,text_length-WF_BATCH_COST_KMER);
+    const char* const kmer = pattern + v;
+    int64_t h;
+    for (h=h_min;h<=h_max;++h) {
+      if (text[h]==kmer[0] && memcmp(text+h,kmer,WF_BATCH_COST_KMER)==0) {
+        ++num_found;
+        break;
+      }
+    }
+  }
+  // Divergence
+  if (num_found == 0) return WF_BATCH_COST_MAX_DIVERGENCE;
+  const double divergence =
+      1.0 - pow((double)num_found/(double)WF_BATCH_COST_SAMPLES,1.0/(double)WF_BATCH_COST_KMER);
+  return MIN(divergence,WF_BATCH_COST_MAX_DIVERGENCE);
+}
+uint64_t wavefront_align_batch_cost(
+    const wavefront_batch_pair_t* const pair,
+    uint64_t* const differences) {
+  const uint64_t pattern_length = pair->pattern_length;
+  const uint64_t text_length = pair->text_length;
+  const uint64_t length = MAX(pattern_length,text_length);
+  uint64_t num_differences = length - MIN(pattern_length,text_length);
+  if (MIN(pattern_length,text_length) >= WF_BATCH_COST_MIN_LENGTH) {
+    num_differences += (uint64_t)(wavefront_align_batch_divergence(pair)*(double)length);
+  }
+  *differences = num_differences;
+  return length * (num_differences+1);
+}
+/*
+ * Batch Scheduling (plan)
+ *   Pairs (or lockstep groups) become jobs. Jobs expected to take longer than
+ *   a fair share of the batch (total-cost/threads) get several threads, as long
+ *   as their wavefronts are wide enough (min_offsets_per_thread). These run
+ *   first, one after another, while the rest of the team aligns the remaining
+ *   jobs (longest-processing-time first) and fills the gaps.
+ */
+typedef struct {
+  int pairs_offset;               // First pair of the job (in the pair order)
+  int num_pairs;                  // Pairs in the job (one pair or a lockstep group)
+  uint64_t cost;                  // Estimated cost
+  int num_threads;                // Threads assigned (intra-alignment parallelism)
+} wavefront_batch_job_t;
+typedef struct {
+  int* pair_idxs;                 // Pair order (each job covers consecutive pairs)
+  wavefront_batch_job_t* jobs;    // Jobs (multithreaded jobs first, then LPT order)
+  int num_jobs;
+  int num_jobs_mt;                // Jobs with several threads
+  int max_job_threads;            // Maximum threads used by any job
+} wavefront_batch_plan_t;
+int wavefront_align_batch_job_cmp(
+    const void* const a,
+    const void* const b) {
+  const wavefront_batch_job_t* const job_a = (const wavefront_batch_job_t*)a;
+  const wavefront_batch_job_t* const job_b = (const wavefront_batch_job_t*)b;
+  const bool mt_a = (job_a->num_threads > 1);
+  const bool mt_b = (job_b->num_threads > 1);
+  if (mt_a != mt_b) return mt_a ? -1 : 1;
+  if (job_a->cost != job_b->cost) return (job_a->cost > job_b->cost) ? -1 : 1;
+  return job_a->pairs_offset - job_b->pairs_offset;
+}
+void wavefront_align_batch_plan(
+    wavefront_batch_plan_t* const plan,
+    const wavefront_batch_pair_t* const pairs,
+    const int num_pairs,
+    wavefront_aligner_attr_t* const attributes,
+    const int team_size) {
+  // Pair order
+  const bool lockstep = attributes->system.batch_lockstep;
+  const wf_coord_t max_length =
+      wavefront_lockstep_max_length(attributes->memory_mode,attributes->alignment_scope);
+  plan->pair_idxs = wavefront_align_batch_order(pairs,num_pairs,lockstep);
+  // Jobs
+  uint64_t* const job_differences = malloc(num_pairs*sizeof(uint64_t));
+  plan->jobs = malloc(num_pairs*sizeof(wavefront_batch_job_t));
+  plan->num_jobs = 0;
+  uint64_t total_cost = 0;
+  int i = 0;
+  while (i < num_pairs) {
+    wavefront_batch_job_t* const job = plan->jobs + plan->num_jobs;
+    job->pairs_offset = i;
+    job->num_pairs = 0;
+    job->cost = 0;
+    job->num_threads = 1;
+    uint64_t differences = 0;
+    do {
+      const wavefront_batch_pair_t* const pair = pairs + plan->pair_idxs[i];
+      const bool short_pair =
+          pair->pattern_length <= max_length && pair->text_length <= max_length;
+      if (job->num_pairs > 0 && !short_pair) break; // Long pairs go alone
+      job->cost += wavefront_align_batch_cost(pair,&differences);
+      ++(job->num_pairs);
+      ++i;
+      if (!lockstep || !short_pair) break;
+    } while (i < num_pairs && job->num_pairs < WF_LOCKSTEP_LANES);
+    job_differences[plan->num_jobs] = differences;
+    total_cost += job->cost;
+    ++(plan->num_jobs);
+  }
+  // Threads per job
+  plan->num_jobs_mt = 0;
+  plan->max_job_threads = 1;
+  if (team_size > 1) {
+    const uint64_t fair_share = MAX(total_cost/team_size,1);
+    const int min_offsets_per_thread = (attributes->system.min_offsets_per_thread > 0) ?
+        attributes->system.min_offsets_per_thread : WF_PARALLEL_OFFSETS_PER_THREAD;
+    const int max_job_threads = MIN(team_size,omp_get_num_procs()); // Spinning on shared cores stalls
+    for (i=0;i<plan->num_jobs;++i) {
+      wavefront_batch_job_t* const job = plan->jobs + i;
+      if (job->num_pairs > 1) continue; // Lockstep groups use one thread
+      const uint64_t wide_threads = (2*job_differences[i])/min_offsets_per_thread;
+      const uint64_t share_threads = DIV_CEIL(job->cost,fair_share);
+      uint64_t num_threads = MIN(wide_threads,share_threads);
+      num_threads = MIN(num_threads,(uint64_t)max_job_threads);
+      job->num_threads = MAX((int)num_threads,1);
+      if (job->num_threads > 1) {
+        ++(plan->num_jobs_mt);
+        plan->max_job_threads = MAX(plan->max_job_threads,job->num_threads);
+      }
+    }
+    // Leave at least one thread for the single-threaded jobs
+    if (plan->num_jobs_mt > 0 && plan->num_jobs_mt < plan->num_jobs) {
+      plan->max_job_threads = MIN(plan->max_job_threads,team_size-1);
+      for (i=0;i<plan->num_jobs;++i) {
+        plan->jobs[i].num_threads = MIN(plan->jobs[i].num_threads,plan->max_job_threads);
+      }
+    }
+    // Order
+    qsort(plan->jobs,plan->num_jobs,sizeof(wavefront_batch_job_t),wavefront_align_batch_job_cmp);
+    plan->num_jobs_mt = 0;
+    while (plan->num_jobs_mt < plan->num_jobs &&
+           plan->jobs[plan->num_jobs_mt].num_threads > 1) ++(plan->num_jobs_mt);
+  }
+  free(job_differences);
+}
+void wavefront_align_batch_plan_free(
+    wavefront_batch_plan_t* const plan) {
+  free(plan->pair_idxs);
+  free(plan->jobs);
+}
+/*
+ * Batch Alignment (parallel)
+ */
+void wavefront_align_batch_job(
+    wavefront_aligner_t* const wf_aligner,
+    wavefront_lockstep_t* const wf_lockstep,
+    const wavefront_batch_pair_t* const pairs,
+    wavefront_batch_plan_t* const plan,
+    const int job_idx,
+    wavefront_batch_result_t* const results) {
+  const wavefront_batch_job_t* const job = plan->jobs + job_idx;
+  wavefront_align_batch_group(wf_aligner,wf_lockstep,
+      pairs,plan->pair_idxs+job->pairs_offset,job->num_pairs,results);
+}
+void wavefront_align_batch_parallel(
+    const wavefront_batch_pair_t* const pairs,
+    wavefront_aligner_attr_t* const attributes,
+    wavefront_batch_result_t* const results,
+    wavefront_batch_plan_t* const plan,
+    const int team_size) {
+  // Multithreaded jobs run on thread 0 (using its aligner thread team), next to the rest of the team
+  const int num_jobs_st = plan->num_jobs - plan->num_jobs_mt;
+  const int outer_size = MIN(team_size-plan->max_job_threads+1,
+      num_jobs_st + ((plan->num_jobs_mt > 0) ? 1 : 0));
+  wavefront_aligner_attr_t thread_attributes = *attributes;
+  thread_attributes.system.max_num_threads = 1;
+  #pragma omp parallel num_threads(outer_size)
+  {
+    wavefront_aligner_t* const wf_aligner = wavefront_aligner_new(&thread_attributes);
+    wavefront_lockstep_t* const wf_lockstep = wavefront_align_batch_lockstep_new(wf_aligner);
+    int i;
+    // Multithreaded jobs (intra-alignment parallelism)
+    if (plan->num_jobs_mt > 0 && omp_get_thread_num() == 0) {
+      wavefront_aligner_t* const wf_aligner_mt = wavefront_aligner_new(attributes);
+      for (i=0;i<plan->num_jobs_mt;++i) {
+        wavefront_aligner_set_max_num_threads(wf_aligner_mt,plan->jobs[i].num_threads);
+        wavefront_align_batch_job(wf_aligner_mt,NULL,pairs,plan,i,results);
+      }
+      wavefront_aligner_delete(wf_aligner_mt);
+    }
+    // Single-threaded jobs (inter-alignment parallelism)
+    #pragma omp for schedule(dynamic,1)
+    for (i=plan->num_jobs_mt;i<plan->num_jobs;++i) {
+      wavefront_align_batch_job(wf_aligner,wf_lockstep,pairs,plan,i,results);
+    }
+    if (wf_lockstep != NULL) wavefront_lockstep_delete(wf_lockstep);
+    wavefront_aligner_delete(wf_aligner);
+  }
+}
+#endif
+void wavefront_align_batch(
+    const wavefront_batch_pair_t* const pairs,
+    const int num_pairs,
+    wavefront_aligner_attr_t* const attributes,
+    wavefront_batch_result_t* const results,
+    const int num_threads) {
+  if (num_pairs <= 0) return;
+#ifdef WFA_PARALLEL
+  const int team_size = (num_threads > 0) ? num_threads : omp_get_max_threads();
+  if (team_size > 1) {
+    wavefront_batch_plan_t plan;
+    wavefront_align_batch_plan(&plan,pairs,num_pairs,attributes,team_size);
+    wavefront_align_batch_parallel(pairs,attributes,results,&plan,team_size);
+    wavefront_align_batch_plan_free(&plan);
+    return;
+  }
+#endif
+  wavefront_align_batch_sequential(pairs,num_pairs,attributes,results);
+}
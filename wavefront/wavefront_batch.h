@@ -0,0 +1,74 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: WaveFront alignment module for batches of sequence pairs
+ */
+
+#ifndef WAVEFRONT_BATCH_H_
+#define WAVEFRONT_BATCH_H_
+
+#include "wavefront_aligner.h"
+
+/*
+ * Batch
+ *   Pairs are dealt to a team of threads (each with its own aligner) on demand,
+ *   longest first according to a cost estimate (length and sampled divergence).
+ *   Pairs expected to outlast a fair share of the batch are aligned first using
+ *   several threads (intra-alignment parallelism; up to the number of cores),
+ *   while the rest of the team aligns the remaining pairs. Results are written
+ *   in the slot of each pair; thus, the output order does not depend on the
+ *   scheduling.
+ */
+typedef struct {
+  const char* pattern;            // Pattern sequence
+  wf_coord_t pattern_length;      // Pattern length
+  const char* text;               // Text sequence
+  wf_coord_t text_length;         // Text length
+} wavefront_batch_pair_t;
+typedef struct {
+  int status;                     // Alignment status (WF_STATUS_*)
+  int score;                      // Alignment score
+  cigar_t* cigar;                 // CIGAR (caller-owned, resized as needed; NULL if not wanted)
+} wavefront_batch_result_t;
+
+/*
+ * Batch Alignment
+ *   num_threads <= 0 uses all available threads. Multithreading requires the
+ *   library to be built with BUILD_WFA_PARALLEL=1 (otherwise, pairs are aligned
+ *   sequentially). With attributes->system.batch_lockstep, short pairs are
+ *   sorted by length and aligned WF_LOCKSTEP_LANES at a time, one pair per
+ *   SIMD lane (indel, edit or gap-affine end-to-end; see wavefront_lockstep.h).
+ */
+void wavefront_align_batch(
+    const wavefront_batch_pair_t* const pairs,
+    const int num_pairs,
+    wavefront_aligner_attr_t* const attributes,
+    wavefront_batch_result_t* const results,
+    const int num_threads);
+
+#endif /* WAVEFRONT_BATCH_H_ */
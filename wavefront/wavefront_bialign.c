@@ -45,7 +45,7 @@
  * Config
  */
 #define WF_BIALIGN_FALLBACK_MIN_SCORE  250
-#define WF_BIALIGN_FALLBACK_MIN_LENGTH 100
+#define WF_BIALIGN_SEQUENCES_PADDING   10
 
 /*
  * Debug
@@ -54,12 +54,12 @@ void wavefront_bialign_debug(
     wf_bialign_breakpoint_t* const breakpoint,
     const int align_level) {
   // Parameters
-  const int breakpoint_h = WAVEFRONT_H(breakpoint->k_forward,breakpoint->offset_forward);
-  const int breakpoint_v = WAVEFRONT_V(breakpoint->k_forward,breakpoint->offset_forward);
+  const wf_coord_t breakpoint_h = WAVEFRONT_H(breakpoint->k_forward,breakpoint->offset_forward);
+  const wf_coord_t breakpoint_v = WAVEFRONT_V(breakpoint->k_forward,breakpoint->offset_forward);
   // Prinf debug info
   fprintf(stderr,"[WFA::BiAlign][Recursion=%d] ",align_level);
   int i; for (i=0;i<align_level;++i) fprintf(stderr,"   ");
-  fprintf(stderr,"Breakpoint at (h,v,score,comp) = (%d,%d,%d,",
+  fprintf(stderr,"Breakpoint at (h,v,score,comp) = (%"PRIcoord",%"PRIcoord",%d,",
       breakpoint_h,breakpoint_v,breakpoint->score);
   switch (breakpoint->component) {
     case affine2p_matrix_M:  fprintf(stderr,"M");  break;
@@ -84,28 +84,28 @@ void wavefront_bialign_breakpoint_indel2indel(
     const affine2p_matrix_type component,
     wf_bialign_breakpoint_t* const breakpoint) {
   // Parameters
-  const int text_length = wf_aligner->text_length;
-  const int pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
   const int gap_open =
       (component==affine2p_matrix_I1 || component==affine2p_matrix_D1) ?
       wf_aligner->penalties.gap_opening1 : wf_aligner->penalties.gap_opening2;
   // Check wavefronts overlapping
-  const int lo_0 = dwf_0->lo;
-  const int hi_0 = dwf_0->hi;
-  const int lo_1 = WAVEFRONT_K_INVERSE(dwf_1->hi,pattern_length,text_length);
-  const int hi_1 = WAVEFRONT_K_INVERSE(dwf_1->lo,pattern_length,text_length);
+  const wf_coord_t lo_0 = dwf_0->lo;
+  const wf_coord_t hi_0 = dwf_0->hi;
+  const wf_coord_t lo_1 = WAVEFRONT_K_INVERSE(dwf_1->hi,pattern_length,text_length);
+  const wf_coord_t hi_1 = WAVEFRONT_K_INVERSE(dwf_1->lo,pattern_length,text_length);
   if (hi_1 < lo_0 || hi_0 < lo_1) return;
   // Compute overlapping interval
-  const int min_hi = MIN(hi_0,hi_1);
-  const int max_lo = MAX(lo_0,lo_1);
-  int k_0;
+  const wf_coord_t min_hi = MIN(hi_0,hi_1);
+  const wf_coord_t max_lo = MAX(lo_0,lo_1);
+  wf_coord_t k_0;
   for (k_0=max_lo;k_0<=min_hi;k_0++) {
-    const int k_1 = WAVEFRONT_K_INVERSE(k_0,pattern_length,text_length);
+    const wf_coord_t k_1 = WAVEFRONT_K_INVERSE(k_0,pattern_length,text_length);
     // Fetch offsets
     const wf_offset_t doffset_0 = dwf_0->offsets[k_0];
     const wf_offset_t doffset_1 = dwf_1->offsets[k_1];
-    const int dh_0 = WAVEFRONT_H(k_0,doffset_0);
-    const int dh_1 = WAVEFRONT_H(k_1,doffset_1);
+    const wf_coord_t dh_0 = WAVEFRONT_H(k_0,doffset_0);
+    const wf_coord_t dh_1 = WAVEFRONT_H(k_1,doffset_1);
     // Check breakpoint d2d
     if (dh_0 + dh_1 >= text_length && score_0 + score_1 - gap_open < breakpoint->score) {
       if (breakpoint_forward) {
@@ -140,25 +140,25 @@ void wavefront_bialign_breakpoint_m2m(
     wavefront_t* const mwf_1,
     wf_bialign_breakpoint_t* const breakpoint) {
   // Parameters
-  const int text_length = wf_aligner->text_length;
-  const int pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
   // Check wavefronts overlapping
-  const int lo_0 = mwf_0->lo;
-  const int hi_0 = mwf_0->hi;
-  const int lo_1 = WAVEFRONT_K_INVERSE(mwf_1->hi,pattern_length,text_length);
-  const int hi_1 = WAVEFRONT_K_INVERSE(mwf_1->lo,pattern_length,text_length);
+  const wf_coord_t lo_0 = mwf_0->lo;
+  const wf_coord_t hi_0 = mwf_0->hi;
+  const wf_coord_t lo_1 = WAVEFRONT_K_INVERSE(mwf_1->hi,pattern_length,text_length);
+  const wf_coord_t hi_1 = WAVEFRONT_K_INVERSE(mwf_1->lo,pattern_length,text_length);
   if (hi_1 < lo_0 || hi_0 < lo_1) return;
   // Compute overlapping interval
-  const int min_hi = MIN(hi_0,hi_1);
-  const int max_lo = MAX(lo_0,lo_1);
-  int k_0;
+  const wf_coord_t min_hi = MIN(hi_0,hi_1);
+  const wf_coord_t max_lo = MAX(lo_0,lo_1);
+  wf_coord_t k_0;
   for (k_0=max_lo;k_0<=min_hi;k_0++) {
-    const int k_1 = WAVEFRONT_K_INVERSE(k_0,pattern_length,text_length);
+    const wf_coord_t k_1 = WAVEFRONT_K_INVERSE(k_0,pattern_length,text_length);
     // Fetch offsets
     const wf_offset_t moffset_0 = mwf_0->offsets[k_0];
     const wf_offset_t moffset_1 = mwf_1->offsets[k_1];
-    const int mh_0 = WAVEFRONT_H(k_0,moffset_0);
-    const int mh_1 = WAVEFRONT_H(k_1,moffset_1);
+    const wf_coord_t mh_0 = WAVEFRONT_H(k_0,moffset_0);
+    const wf_coord_t mh_1 = WAVEFRONT_H(k_1,moffset_1);
     // Check breakpoint m2m
     if (mh_0 + mh_1 >= text_length && score_0 + score_1 < breakpoint->score) {
       if (breakpoint_forward) {
@@ -196,11 +196,12 @@ void wavefront_bialign_overlap(
     wf_bialign_breakpoint_t* const breakpoint) {
   // Parameters
   const int max_score_scope = wf_aligner_0->wf_components.max_score_scope;
+  const int wavefront_mask = wf_aligner_0->wf_components.wavefront_mask;
   const distance_metric_t distance_metric = wf_aligner_0->penalties.distance_metric;
   const int gap_opening1 = wf_aligner_0->penalties.gap_opening1;
   const int gap_opening2 = wf_aligner_0->penalties.gap_opening2;
   // Fetch wavefronts-0
-  const int score_mod_0 = score_0 % max_score_scope;
+  const int score_mod_0 = score_0 & wavefront_mask;
   wavefront_t* const mwf_0 = wf_aligner_0->wf_components.mwavefronts[score_mod_0];
   if (mwf_0 == NULL) return;
   wavefront_t* d1wf_0 = NULL, *i1wf_0 = NULL;
@@ -219,7 +220,7 @@ void wavefront_bialign_overlap(
     // Compute score
     const int score_i = score_1 - i;
     if (score_i < 0) break;
-    const int score_mod_i = score_i % max_score_scope;
+    const int score_mod_i = score_i & wavefront_mask;
     // Check I2/D2-breakpoints (gap_affine_2p)
     if (distance_metric == gap_affine_2p) {
       if (score_0 + score_i - gap_opening2 >= breakpoint->score) continue;
@@ -273,9 +274,9 @@ void wavefront_bialign_find_breakpoint_init(
     wavefront_aligner_t* const alg_forward,
     wavefront_aligner_t* const alg_reverse,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const distance_metric_t distance_metric,
     alignment_form_t* const form,
     const affine2p_matrix_type component_begin,
@@ -350,12 +351,12 @@ int wavefront_bialign_overlap_gopen_adjust(
       return 0;
   }
 }
-int wavefront_bialign_find_breakpoint(
+int wavefront_bialign_find_breakpoint_kernel(
     wavefront_bialigner_t* const bialigner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const distance_metric_t distance_metric,
     alignment_form_t* const form,
     const affine2p_matrix_type component_begin,
@@ -379,9 +380,10 @@ int wavefront_bialign_find_breakpoint(
   }
   // Parameters
   const int max_alignment_score = alg_forward->system.max_alignment_score;
-  const int max_antidiagonal = DPMATRIX_ANTIDIAGONAL(pattern_length,text_length) - 1; // Note: Even removing -1
+  const wf_coord_t max_antidiagonal = DPMATRIX_ANTIDIAGONAL(pattern_length,text_length) - 1; // Note: Even removing -1
   void (*wf_align_compute)(wavefront_aligner_t* const,const int) = alg_forward->align_status.wf_align_compute;
-  int score_forward = 0, score_reverse = 0, forward_max_ak = 0, reverse_max_ak = 0;
+  int score_forward = 0, score_reverse = 0;
+  wf_coord_t forward_max_ak = 0, reverse_max_ak = 0;
   bool end_reached;
   // Plot
   const bool plot_enabled = (alg_forward->plot != NULL);
@@ -396,7 +398,7 @@ int wavefront_bialign_find_breakpoint(
   end_reached = wavefront_extend_end2end_max(alg_reverse,score_reverse,&reverse_max_ak);
   if (end_reached) return alg_reverse->align_status.status;
   // Compute wavefronts of increasing score until both wavefronts overlap
-  int max_ak = 0;
+  wf_coord_t max_ak = 0;
   bool last_wf_forward;
   while (true) {
     // Check close-to-collision
@@ -471,15 +473,38 @@ int wavefront_bialign_find_breakpoint(
   // Return OK
   return WF_STATUS_SUCCESSFUL;
 }
+int wavefront_bialign_find_breakpoint(
+    wavefront_bialigner_t* const bialigner,
+    const char* const pattern,
+    const wf_coord_t pattern_length,
+    const char* const text,
+    const wf_coord_t text_length,
+    const distance_metric_t distance_metric,
+    alignment_form_t* const form,
+    const affine2p_matrix_type component_begin,
+    const affine2p_matrix_type component_end,
+    wf_bialign_breakpoint_t* const breakpoint,
+    const int align_level) {
+  // Find breakpoint
+  const int align_status = wavefront_bialign_find_breakpoint_kernel(
+      bialigner,pattern,pattern_length,text,text_length,
+      distance_metric,form,component_begin,component_end,
+      breakpoint,align_level);
+  // Restore the sequences (sentinels)
+  wavefront_unialign_sequences_eos_restore(bialigner->alg_forward);
+  wavefront_unialign_sequences_eos_restore(bialigner->alg_reverse);
+  // Return
+  return align_status;
+}
 /*
  * Bidirectional Alignment (base cases)
  */
 void wavefront_bialign_base(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_form_t* const form,
     const affine2p_matrix_type component_begin,
     const affine2p_matrix_type component_end,
@@ -498,6 +523,7 @@ void wavefront_bialign_base(
   }
   // Wavefront align sequences
   wavefront_unialign(alg_subsidiary);
+  wavefront_unialign_sequences_eos_restore(alg_subsidiary);
   wf_aligner->align_status.status = alg_subsidiary->align_status.status;
   // DEBUG
   if (verbose >= 2) {
@@ -511,17 +537,18 @@ void wavefront_bialign_base(
 void wavefront_bialign_exception(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_form_t* const form,
     const affine2p_matrix_type component_begin,
     const affine2p_matrix_type component_end,
     const int align_level,
     const int align_status) {
-  // Check max-score reached or unfeasible alignment
+  // Check max-score reached, unfeasible alignment or out of memory
   if (align_status == WF_STATUS_MAX_SCORE_REACHED ||
-      align_status == WF_STATUS_UNFEASIBLE) {
+      align_status == WF_STATUS_UNFEASIBLE ||
+      align_status == WF_STATUS_OOM) {
     wf_aligner->align_status.status = align_status;
     return;
   }
@@ -584,19 +611,19 @@ void wavefront_bialign_init_half_1(
 void wavefront_bialign_alignment(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_begin,
-    const int pattern_end,
+    const wf_coord_t pattern_begin,
+    const wf_coord_t pattern_end,
     const char* const text,
-    const int text_begin,
-    const int text_end,
+    const wf_coord_t text_begin,
+    const wf_coord_t text_end,
     alignment_form_t* const form,
     const affine2p_matrix_type component_begin,
     const affine2p_matrix_type component_end,
     const int score_remaining,
     const int align_level) {
   // Parameters
-  const int pattern_length = pattern_end - pattern_begin;
-  const int text_length = text_end - text_begin;
+  const wf_coord_t pattern_length = pattern_end - pattern_begin;
+  const wf_coord_t text_length = text_end - text_begin;
   // Trivial cases
   if (text_length == 0) {
     cigar_append_deletion(wf_aligner->cigar,pattern_length);
@@ -636,8 +663,8 @@ void wavefront_bialign_alignment(
     return;
   }
   // Breakpoint found
-  const int breakpoint_h = WAVEFRONT_H(breakpoint.k_forward,breakpoint.offset_forward);
-  const int breakpoint_v = WAVEFRONT_V(breakpoint.k_forward,breakpoint.offset_forward);
+  const wf_coord_t breakpoint_h = WAVEFRONT_H(breakpoint.k_forward,breakpoint.offset_forward);
+  const wf_coord_t breakpoint_v = WAVEFRONT_V(breakpoint.k_forward,breakpoint.offset_forward);
   // DEBUG
   if (wf_aligner->system.verbose >= 3) wavefront_bialign_debug(&breakpoint,align_level);
   // Parameters
@@ -678,9 +705,9 @@ void wavefront_bialign_alignment(
 void wavefront_bialign_compute_score(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length) {
+    const wf_coord_t text_length) {
   // Find breakpoint in the alignment
   wf_bialign_breakpoint_t breakpoint;
   const int align_status = wavefront_bialign_find_breakpoint(
@@ -693,7 +720,9 @@ void wavefront_bialign_compute_score(
     wavefront_debug_epilogue(wf_aligner->bialigner->alg_reverse);
   }
   // Check status
-  if (align_status == WF_STATUS_MAX_SCORE_REACHED || align_status == WF_STATUS_UNFEASIBLE) {
+  if (align_status == WF_STATUS_MAX_SCORE_REACHED ||
+      align_status == WF_STATUS_UNFEASIBLE ||
+      align_status == WF_STATUS_OOM) {
     wf_aligner->align_status.status = align_status;
     return;
   }
@@ -717,17 +746,30 @@ void wavefront_bialign_compute_score(
  */
 void wavefront_bialign(
     wavefront_aligner_t* const wf_aligner,
-    const char* const pattern,
-    const int pattern_length,
-    const char* const text,
-    const int text_length) {
+    const char* const pattern_original,
+    const wf_coord_t pattern_length,
+    const char* const text_original,
+    const wf_coord_t text_length) {
   // Init
   wf_aligner->align_status.status = WF_STATUS_SUCCESSFUL; // Init OK
-  // Just for outputting info at plot
-  wf_aligner->pattern = (char*)pattern;
+  // Padded sequences (shared by all sub-alignments as views)
+  mm_allocator_clear(wf_aligner->mm_arena); // Release the previous alignment (O(1))
+  if (wf_aligner->match_funct == NULL) {
+    wf_aligner->sequences = strings_padded_new(
+        pattern_original,pattern_length,text_original,text_length,
+        WF_BIALIGN_SEQUENCES_PADDING,false,wf_aligner->mm_arena);
+    wf_aligner->pattern = wf_aligner->sequences->pattern_padded;
+    wf_aligner->text = wf_aligner->sequences->text_padded;
+  } else {
+    wf_aligner->sequences = NULL;
+    wf_aligner->pattern = (char*)pattern_original;
+    wf_aligner->text = (char*)text_original;
+  }
   wf_aligner->pattern_length = pattern_length;
-  wf_aligner->text = (char*)text;
   wf_aligner->text_length = text_length;
+  wf_aligner->sequences_reverse = false;
+  const char* const pattern = wf_aligner->pattern;
+  const char* const text = wf_aligner->text;
   // Select scope
   if (wf_aligner->alignment_scope == compute_score) {
     wavefront_bialign_compute_score(wf_aligner,pattern,pattern_length,text,text_length);
@@ -34,14 +34,19 @@
 #include "utils/commons.h"
 #include "wavefront_aligner.h"
 
+/*
+ * Config
+ */
+#define WF_BIALIGN_FALLBACK_MIN_LENGTH 100 // Shorter pairs are aligned unidirectionally
+
 /*
  * Bidirectional WFA
  */
 void wavefront_bialign(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length);
+    const wf_coord_t text_length);
 
 #endif /* WAVEFRONT_BIALIGN_H_ */
@@ -56,16 +56,22 @@ wavefront_bialigner_t* wavefront_bialigner_new(
   subsidiary_attr.alignment_scope = compute_score;
   // Set other parameter for subsidiary aligners
   subsidiary_attr.system = attributes->system;
-  // Allocate forward/reverse aligners
-  wf_bialigner->alg_forward = wavefront_aligner_new(&subsidiary_attr);
+  // Shared MM-Allocator and slab (every sub-aligner clears the slab as it starts
+  // a new phase; forward/reverse wavefronts are dead once the subsidiary starts)
+  wf_bialigner->mm_allocator = mm_allocator_new_pages(BUFFER_SIZE_4M,attributes->system.mm_pages);
+  wf_bialigner->wavefront_slab = wavefront_slab_new(1000,false,wf_slab_reuse,wf_bialigner->mm_allocator);
+  subsidiary_attr.mm_allocator = wf_bialigner->mm_allocator;
+  // Allocate forward/reverse aligners (the forward one owns the thread team shared by all)
+  wf_bialigner->alg_forward = wavefront_aligner_new_shared(&subsidiary_attr,wf_bialigner->wavefront_slab,NULL);
   wf_bialigner->alg_forward->align_mode = wf_align_biwfa_breakpoint_forward;
   wf_bialigner->alg_forward->plot = plot;
-  wf_bialigner->alg_reverse = wavefront_aligner_new(&subsidiary_attr);
+  thread_team_t* const thread_team = wf_bialigner->alg_forward->thread_team;
+  wf_bialigner->alg_reverse = wavefront_aligner_new_shared(&subsidiary_attr,wf_bialigner->wavefront_slab,thread_team);
   wf_bialigner->alg_reverse->align_mode = wf_align_biwfa_breakpoint_reverse;
   wf_bialigner->alg_reverse->plot = plot;
   // Allocate subsidiary aligner
   subsidiary_attr.alignment_scope = compute_alignment;
-  wf_bialigner->alg_subsidiary = wavefront_aligner_new(&subsidiary_attr);
+  wf_bialigner->alg_subsidiary = wavefront_aligner_new_shared(&subsidiary_attr,wf_bialigner->wavefront_slab,thread_team);
   wf_bialigner->alg_subsidiary->align_mode = wf_align_biwfa_subsidiary;
   wf_bialigner->alg_subsidiary->plot = plot;
   // Return
@@ -76,12 +82,23 @@ void wavefront_bialigner_reap(
   wavefront_aligner_reap(wf_bialigner->alg_forward);
   wavefront_aligner_reap(wf_bialigner->alg_reverse);
   wavefront_aligner_reap(wf_bialigner->alg_subsidiary);
+  wavefront_slab_reap(wf_bialigner->wavefront_slab);
+}
+void wavefront_bialigner_preallocate(
+    wavefront_bialigner_t* const wf_bialigner,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length) {
+  wavefront_aligner_preallocate(wf_bialigner->alg_forward,max_pattern_length,max_text_length);
+  wavefront_aligner_preallocate(wf_bialigner->alg_reverse,max_pattern_length,max_text_length);
+  wavefront_aligner_preallocate(wf_bialigner->alg_subsidiary,max_pattern_length,max_text_length);
 }
 void wavefront_bialigner_delete(
     wavefront_bialigner_t* const wf_bialigner) {
-  wavefront_aligner_delete(wf_bialigner->alg_forward);
   wavefront_aligner_delete(wf_bialigner->alg_reverse);
   wavefront_aligner_delete(wf_bialigner->alg_subsidiary);
+  wavefront_aligner_delete(wf_bialigner->alg_forward); // Owns the thread team
+  wavefront_slab_delete(wf_bialigner->wavefront_slab);
+  mm_allocator_delete(wf_bialigner->mm_allocator);
   free(wf_bialigner);
 }
 /*
@@ -89,9 +106,16 @@ void wavefront_bialigner_delete(
  */
 uint64_t wavefront_bialigner_get_size(
     wavefront_bialigner_t* const wf_bialigner) {
-  return wavefront_aligner_get_size(wf_bialigner->alg_forward) +
-      wavefront_aligner_get_size(wf_bialigner->alg_reverse) +
-      wavefront_aligner_get_size(wf_bialigner->alg_subsidiary);
+  // Sub-aligners hold no BT-buffer (only the shared slab)
+  return wavefront_slab_get_size(wf_bialigner->wavefront_slab);
+}
+uint64_t wavefront_bialigner_get_num_allocations(
+    wavefront_bialigner_t* const wf_bialigner) {
+  return mm_allocator_get_num_allocations(wf_bialigner->mm_allocator) +
+      wavefront_slab_get_num_allocations(wf_bialigner->wavefront_slab) +
+      mm_allocator_get_num_allocations(wf_bialigner->alg_forward->mm_arena) +
+      mm_allocator_get_num_allocations(wf_bialigner->alg_reverse->mm_arena) +
+      mm_allocator_get_num_allocations(wf_bialigner->alg_subsidiary->mm_arena);
 }
 void wavefront_bialigner_set_heuristic(
     wavefront_bialigner_t* const wf_bialigner,
@@ -102,7 +126,7 @@ void wavefront_bialigner_set_heuristic(
 }
 void wavefront_bialigner_set_match_funct(
     wavefront_bialigner_t* const wf_bialigner,
-    int (*match_funct)(int,int,void*),
+    int (*match_funct)(wf_coord_t,wf_coord_t,void*),
     void* const match_funct_arguments) {
   wf_bialigner->alg_forward->match_funct = match_funct;
   wf_bialigner->alg_forward->match_funct_arguments = match_funct_arguments;
@@ -129,12 +153,25 @@ void wavefront_bialigner_set_max_memory(
   wf_bialigner->alg_subsidiary->system.max_memory_resident = max_memory_resident;
   wf_bialigner->alg_subsidiary->system.max_memory_abort = max_memory_abort;
 }
+void wavefront_bialigner_set_governor(
+    wavefront_bialigner_t* const wf_bialigner,
+    mm_governor_t* const mm_governor) {
+  mm_allocator_set_governor(wf_bialigner->mm_allocator,mm_governor); // Shared
+  wf_bialigner->alg_forward->mm_governor = mm_governor;
+  mm_allocator_set_governor(wf_bialigner->alg_forward->mm_arena,mm_governor);
+  wf_bialigner->alg_reverse->mm_governor = mm_governor;
+  mm_allocator_set_governor(wf_bialigner->alg_reverse->mm_arena,mm_governor);
+  wf_bialigner->alg_subsidiary->mm_governor = mm_governor;
+  mm_allocator_set_governor(wf_bialigner->alg_subsidiary->mm_arena,mm_governor);
+}
 void wavefront_bialigner_set_max_num_threads(
         wavefront_bialigner_t* const wf_bialigner,
         const int max_num_threads) {
-    wf_bialigner->alg_forward->system.max_num_threads = max_num_threads;
+    wavefront_aligner_set_max_num_threads(wf_bialigner->alg_forward,max_num_threads);
     wf_bialigner->alg_reverse->system.max_num_threads = max_num_threads;
+    wf_bialigner->alg_reverse->thread_team = wf_bialigner->alg_forward->thread_team;
     wf_bialigner->alg_subsidiary->system.max_num_threads = max_num_threads;
+    wf_bialigner->alg_subsidiary->thread_team = wf_bialigner->alg_forward->thread_team;
 }
 void wavefront_bialigner_set_min_offsets_per_thread(
         wavefront_bialigner_t* const wf_bialigner,
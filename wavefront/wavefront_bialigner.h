@@ -32,6 +32,7 @@
 #define WAVEFRONT_BIALIGNER_H_
 
 #include "utils/commons.h"
+#include "wavefront_slab.h"
 #include "wavefront_penalties.h"
 #include "wavefront_attributes.h"
 #include "wavefront_heuristic.h"
@@ -46,8 +47,8 @@ typedef struct {
   int score_forward;              // Score (forward)
   int score_reverse;              // Score (reverse)
   // Location
-  int k_forward;                  // Breakpoint diagonal (forward)
-  int k_reverse;                  // Breakpoint diagonal (reverse)
+  wf_coord_t k_forward;           // Breakpoint diagonal (forward)
+  wf_coord_t k_reverse;           // Breakpoint diagonal (reverse)
   wf_offset_t offset_forward;     // Offset (forward)
   wf_offset_t offset_reverse;     // Offset (reverse)
   affine2p_matrix_type component; // Component (M/I/D)
@@ -57,6 +58,8 @@ typedef struct {
   wavefront_aligner_t* alg_forward;    // Forward aligner
   wavefront_aligner_t* alg_reverse;    // Reverse aligner
   wavefront_aligner_t* alg_subsidiary; // Subsidiary aligner
+  mm_allocator_t* mm_allocator;        // MM-Allocator (shared by all sub-aligners)
+  wavefront_slab_t* wavefront_slab;    // Wavefront slab (shared by all sub-aligners)
 } wavefront_bialigner_t;
 
 /*
@@ -67,6 +70,10 @@ wavefront_bialigner_t* wavefront_bialigner_new(
     wavefront_plot_t* const plot);
 void wavefront_bialigner_reap(
     wavefront_bialigner_t* const wf_bialigner);
+void wavefront_bialigner_preallocate(
+    wavefront_bialigner_t* const wf_bialigner,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length);
 void wavefront_bialigner_delete(
     wavefront_bialigner_t* const wf_bialigner);
 
@@ -75,12 +82,14 @@ void wavefront_bialigner_delete(
  */
 uint64_t wavefront_bialigner_get_size(
     wavefront_bialigner_t* const wf_bialigner);
+uint64_t wavefront_bialigner_get_num_allocations(
+    wavefront_bialigner_t* const wf_bialigner);
 void wavefront_bialigner_set_heuristic(
     wavefront_bialigner_t* const wf_bialigner,
     wavefront_heuristic_t* const heuristic);
 void wavefront_bialigner_set_match_funct(
     wavefront_bialigner_t* const wf_bialigner,
-    int (*match_funct)(int,int,void*),
+    int (*match_funct)(wf_coord_t,wf_coord_t,void*),
     void* const match_funct_arguments);
 void wavefront_bialigner_set_max_alignment_score(
     wavefront_bialigner_t* const wf_bialigner,
@@ -89,6 +98,9 @@ void wavefront_bialigner_set_max_memory(
     wavefront_bialigner_t* const wf_bialigner,
     const uint64_t max_memory_resident,
     const uint64_t max_memory_abort);
+void wavefront_bialigner_set_governor(
+    wavefront_bialigner_t* const wf_bialigner,
+    mm_governor_t* const mm_governor);
 void wavefront_bialigner_set_max_num_threads(
     wavefront_bialigner_t* const wf_bialigner,
     const int max_num_threads);
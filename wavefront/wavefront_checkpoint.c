@@ -0,0 +1,244 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Checkpointed wavefronts (sqrt-decomposition traceback)
+ */
+
+#include "wavefront_checkpoint.h"
+#include "wavefront_aligner.h"
+#include "wavefront_heuristic.h"
+#include "wavefront_slab.h"
+
+/*
+ * Setup
+ */
+wavefront_checkpoint_t* wavefront_checkpoint_new(
+    mm_allocator_t* const mm_allocator) {
+  // Handler
+  wavefront_checkpoint_t* const wf_checkpoint =
+      mm_allocator_alloc(mm_allocator,wavefront_checkpoint_t);
+  // Allocate
+  wf_checkpoint->checkpoints = vector_new(100,int);
+  wf_checkpoint->cutoffs = vector_new(100,wf_checkpoint_cutoff_t);
+  // Clear & return
+  wavefront_checkpoint_clear(wf_checkpoint);
+  return wf_checkpoint;
+}
+void wavefront_checkpoint_clear(
+    wavefront_checkpoint_t* const wf_checkpoint) {
+  // Checkpoints
+  vector_clear(wf_checkpoint->checkpoints);
+  wf_checkpoint->checkpoint_next = -1;
+  wf_checkpoint->interval = 0;
+  wf_checkpoint->score_forward = -1;
+  wf_checkpoint->memory_kept = 0;
+  // Heuristics
+  vector_clear(wf_checkpoint->cutoffs);
+  // Traceback
+  wf_checkpoint->checkpoint_idx = INT_MAX;
+  wf_checkpoint->segment_idx = -1;
+  wf_checkpoint->segment_begin = 0;
+  wf_checkpoint->segment_end = -1;
+}
+void wavefront_checkpoint_delete(
+    wavefront_checkpoint_t* const wf_checkpoint,
+    mm_allocator_t* const mm_allocator) {
+  vector_delete(wf_checkpoint->checkpoints);
+  vector_delete(wf_checkpoint->cutoffs);
+  mm_allocator_free(mm_allocator,wf_checkpoint);
+}
+/*
+ * Wavefront-sets
+ */
+uint64_t wavefront_checkpoint_get_size(
+    wavefront_aligner_t* const wf_aligner,
+    const int score) {
+  // Parameters
+  wavefront_components_t* const wf_components = &wf_aligner->wf_components;
+  wavefront_t** const wavefronts[] = {
+      wf_components->mwavefronts,
+      wf_components->i1wavefronts, wf_components->i2wavefronts,
+      wf_components->d1wavefronts, wf_components->d2wavefronts };
+  // Add the size of the wavefront-set
+  uint64_t wf_set_size = 0;
+  int i;
+  for (i=0;i<5;++i) {
+    if (wavefronts[i] == NULL || wavefronts[i][score] == NULL) continue;
+    wf_set_size += wavefront_get_size(wavefronts[i][score]);
+  }
+  return wf_set_size;
+}
+void wavefront_checkpoint_release(
+    wavefront_aligner_t* const wf_aligner,
+    const int score) {
+  // Parameters
+  wavefront_components_t* const wf_components = &wf_aligner->wf_components;
+  wavefront_slab_t* const wavefront_slab = wf_aligner->wavefront_slab;
+  wavefront_t** const wavefronts[] = {
+      wf_components->mwavefronts,
+      wf_components->i1wavefronts, wf_components->i2wavefronts,
+      wf_components->d1wavefronts, wf_components->d2wavefronts };
+  // Return the wavefront-set to the slab
+  int i;
+  for (i=0;i<5;++i) {
+    if (wavefronts[i] == NULL || wavefronts[i][score] == NULL) continue;
+    wavefront_slab_free(wavefront_slab,wavefronts[i][score]);
+    wavefronts[i][score] = NULL;
+  }
+}
+/*
+ * Checkpoint interval
+ */
+int wavefront_checkpoint_interval(
+    wavefront_aligner_t* const wf_aligner,
+    const int score) {
+  // Parameters
+  wavefront_checkpoint_t* const wf_checkpoint = wf_aligner->checkpoint;
+  const int max_score_scope = wf_aligner->wf_components.max_score_scope;
+  const uint64_t max_memory = wf_aligner->system.max_memory_checkpoint;
+  const int min_interval = 2*max_score_scope;
+  // Fit the segment recomputed after this checkpoint in the remaining budget
+  const uint64_t wf_set_size = wavefront_checkpoint_get_size(wf_aligner,score);
+  if (wf_checkpoint->memory_kept < max_memory && wf_set_size > 0) {
+    const uint64_t interval = (max_memory - wf_checkpoint->memory_kept) / wf_set_size;
+    if (interval >= (uint64_t)min_interval) return (int)MIN(interval,(uint64_t)(INT_MAX/2));
+  }
+  // Budget exhausted (space the checkpoints as sqrt(scope*score))
+  const double interval_area = (double)max_score_scope * (double)score;
+  return MAX((int)sqrt(interval_area),min_interval);
+}
+/*
+ * Forward (checkpoint & release wavefronts)
+ */
+void wavefront_checkpoint_forward(
+    wavefront_aligner_t* const wf_aligner,
+    const int score) {
+  // Parameters
+  wavefront_checkpoint_t* const wf_checkpoint = wf_aligner->checkpoint;
+  wavefront_components_t* const wf_components = &wf_aligner->wf_components;
+  const int max_score_scope = wf_components->max_score_scope;
+  wf_checkpoint->score_forward = score;
+  // Record the limits left by the heuristic cut-off (to replay it)
+  if (wf_aligner->heuristic.strategy != wf_heuristic_none) {
+    vector_reserve(wf_checkpoint->cutoffs,score+1,false);
+    wf_checkpoint_cutoff_t* const cutoff =
+        vector_get_elm(wf_checkpoint->cutoffs,score,wf_checkpoint_cutoff_t);
+    wavefront_t* const mwavefront = wf_components->mwavefronts[score];
+    cutoff->lo = (mwavefront != NULL) ? mwavefront->lo : 0;
+    cutoff->hi = (mwavefront != NULL) ? mwavefront->hi : -1;
+    vector_set_used(wf_checkpoint->cutoffs,score+1);
+  }
+  // Keep all wavefronts while they take up to half the memory budget
+  if (vector_is_empty(wf_checkpoint->checkpoints)) {
+    wf_checkpoint->memory_kept += wavefront_checkpoint_get_size(wf_aligner,score);
+    if (wf_checkpoint->memory_kept <= wf_aligner->system.max_memory_checkpoint/2) return;
+    wf_checkpoint->checkpoint_next = score; // First checkpoint (already accounted)
+  } else if (score == wf_checkpoint->checkpoint_next) {
+    int s; // Account the wavefront-sets kept by the checkpoint
+    for (s=score-max_score_scope+1;s<=score;++s) {
+      wf_checkpoint->memory_kept += wavefront_checkpoint_get_size(wf_aligner,s);
+    }
+  }
+  // Checkpoint (keep the wavefronts needed to resume from here)
+  if (score == wf_checkpoint->checkpoint_next) {
+    vector_insert(wf_checkpoint->checkpoints,score,int);
+    wf_checkpoint->interval = wavefront_checkpoint_interval(wf_aligner,score);
+    wf_checkpoint->checkpoint_next = score + wf_checkpoint->interval;
+  }
+  // Release the oldest wavefront-set (no longer needed to compute)
+  const int score_release = score + 1 - max_score_scope;
+  if (score_release <= 0) return;
+  const int checkpoint_last = *vector_get_last_elm(wf_checkpoint->checkpoints,int);
+  if (checkpoint_last-max_score_scope < score_release && score_release <= checkpoint_last) {
+    return; // Part of the last checkpoint
+  }
+  wavefront_checkpoint_release(wf_aligner,score_release);
+}
+/*
+ * Traceback (recompute released wavefronts)
+ */
+void wavefront_checkpoint_recompute(
+    wavefront_aligner_t* const wf_aligner,
+    const int score_begin,
+    const int score_end) {
+  // Parameters
+  wavefront_checkpoint_t* const wf_checkpoint = wf_aligner->checkpoint;
+  const wavefront_align_status_t align_status = wf_aligner->align_status;
+  const wavefront_pos_t alignment_end_pos = wf_aligner->alignment_end_pos;
+  const wf_heuristic_strategy heuristic_strategy = wf_aligner->heuristic.strategy;
+  wf_checkpoint_cutoff_t* const cutoffs = (heuristic_strategy != wf_heuristic_none) ?
+      vector_get_mem(wf_checkpoint->cutoffs,wf_checkpoint_cutoff_t) : NULL;
+  // Recompute the wavefronts (replaying the cut-offs instead of the heuristic)
+  wf_aligner->heuristic.strategy = wf_heuristic_none;
+  int score;
+  for (score=score_begin;score<=score_end;++score) {
+    (*align_status.wf_align_compute)(wf_aligner,score);
+    (*align_status.wf_align_extend)(wf_aligner,score);
+    if (cutoffs != NULL) {
+      wavefront_heuristic_cufoff_replay(wf_aligner,score,cutoffs[score].lo,cutoffs[score].hi);
+    }
+  }
+  // Restore the state of the alignment
+  wf_aligner->heuristic.strategy = heuristic_strategy;
+  wf_aligner->alignment_end_pos = alignment_end_pos;
+  wf_aligner->align_status = align_status;
+}
+void wavefront_checkpoint_restore(
+    wavefront_aligner_t* const wf_aligner,
+    const int score) {
+  // Parameters
+  wavefront_checkpoint_t* const wf_checkpoint = wf_aligner->checkpoint;
+  const int max_score_scope = wf_aligner->wf_components.max_score_scope;
+  const int score_released = wf_checkpoint->score_forward + 1 - max_score_scope;
+  const int score_min = score - max_score_scope + 1; // Lowest score read from here
+  if (score_min > score_released) return; // Never released
+  // Locate the preceding checkpoint (the traceback only moves backwards)
+  int* const checkpoints = vector_get_mem(wf_checkpoint->checkpoints,int);
+  const int num_checkpoints = vector_get_used(wf_checkpoint->checkpoints);
+  if (num_checkpoints == 0 || score <= checkpoints[0]) return; // All kept
+  int checkpoint_idx = MIN(wf_checkpoint->checkpoint_idx,num_checkpoints-1);
+  while (checkpoint_idx > 0 && checkpoints[checkpoint_idx] >= score) --checkpoint_idx;
+  wf_checkpoint->checkpoint_idx = checkpoint_idx;
+  if (checkpoint_idx == wf_checkpoint->segment_idx) return; // Already recomputed
+  // Released segment following the checkpoint
+  const int checkpoint_next = (checkpoint_idx+1 < num_checkpoints) ?
+      checkpoints[checkpoint_idx+1] : wf_checkpoint->checkpoint_next;
+  const int segment_begin = checkpoints[checkpoint_idx] + 1;
+  const int segment_end = MIN(checkpoint_next-max_score_scope,score_released);
+  if (segment_end < score_min) return; // Only checkpointed wavefronts needed
+  // Release the previous segment
+  int s;
+  for (s=wf_checkpoint->segment_begin;s<=wf_checkpoint->segment_end;++s) {
+    wavefront_checkpoint_release(wf_aligner,s);
+  }
+  // Recompute the segment (up to the current score)
+  wf_checkpoint->segment_idx = checkpoint_idx;
+  wf_checkpoint->segment_begin = segment_begin;
+  wf_checkpoint->segment_end = MIN(segment_end,score);
+  wavefront_checkpoint_recompute(wf_aligner,segment_begin,wf_checkpoint->segment_end);
+}
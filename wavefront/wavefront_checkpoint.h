@@ -0,0 +1,99 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Checkpointed wavefronts (sqrt-decomposition traceback)
+ */
+
+#ifndef WAVEFRONT_CHECKPOINT_H_
+#define WAVEFRONT_CHECKPOINT_H_
+
+#include "utils/commons.h"
+#include "utils/vector.h"
+#include "system/mm_allocator.h"
+#include "wavefront_offset.h"
+
+// Wavefront ahead definition
+typedef struct _wavefront_aligner_t wavefront_aligner_t;
+
+/*
+ * Checkpointed wavefronts
+ *   All wavefronts are kept until they exceed half the memory budget. From then
+ *   on, every checkpoint c keeps the full wavefront-sets [c-scope+1,c] (enough to
+ *   resume the computation at c+1) and the rest are released as soon as the
+ *   forward pass no longer needs them. The next checkpoint is placed so that the
+ *   segment recomputed during the traceback fits in the remaining budget (i.e.,
+ *   (budget-memory_kept)/wavefront-set size). Once the budget is exhausted, the
+ *   distance between checkpoints grows as sqrt(scope*score), so that both the
+ *   checkpoints and the recomputed segment take O(sqrt(scope*s)) wavefront-sets.
+ */
+typedef struct {
+  wf_coord_t lo;                  // M-wavefront lo (after the cut-off)
+  wf_coord_t hi;                  // M-wavefront hi (after the cut-off)
+} wf_checkpoint_cutoff_t;
+typedef struct {
+  // Checkpoints
+  vector_t* checkpoints;          // Checkpoint scores (int)
+  int checkpoint_next;            // Next checkpoint score
+  int interval;                   // Current distance between checkpoints
+  int score_forward;              // Last score computed by the forward pass
+  uint64_t memory_kept;           // Wavefront memory kept (all-kept prefix & checkpoints)
+  // Heuristics
+  vector_t* cutoffs;              // Limits left by the heuristic cut-offs (wf_checkpoint_cutoff_t)
+  // Traceback
+  int checkpoint_idx;             // Checkpoint preceding the current traceback position
+  int segment_idx;                // Segment currently recomputed (-1 if none)
+  int segment_begin;              // First score of the recomputed segment
+  int segment_end;                // Last score of the recomputed segment
+} wavefront_checkpoint_t;
+
+/*
+ * Setup
+ */
+wavefront_checkpoint_t* wavefront_checkpoint_new(
+    mm_allocator_t* const mm_allocator);
+void wavefront_checkpoint_clear(
+    wavefront_checkpoint_t* const wf_checkpoint);
+void wavefront_checkpoint_delete(
+    wavefront_checkpoint_t* const wf_checkpoint,
+    mm_allocator_t* const mm_allocator);
+
+/*
+ * Forward (checkpoint & release wavefronts)
+ */
+void wavefront_checkpoint_forward(
+    wavefront_aligner_t* const wf_aligner,
+    const int score);
+
+/*
+ * Traceback (recompute released wavefronts)
+ */
+void wavefront_checkpoint_restore(
+    wavefront_aligner_t* const wf_aligner,
+    const int score);
+
+#endif /* WAVEFRONT_CHECKPOINT_H_ */
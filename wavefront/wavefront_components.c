@@ -39,14 +39,15 @@
 #define WF_NULL_INIT_LO     (-1024)
 #define WF_NULL_INIT_HI     ( 1024)
 #define WF_NULL_INIT_LENGTH WAVEFRONT_LENGTH(WF_NULL_INIT_LO,WF_NULL_INIT_HI)
+#define WF_RING_COMPONENTS  (affine2p_matrix_D2+1) // M/I1/I2/D1/D2
 
 /*
  * Compute dimensions
  */
 void wavefront_components_dimensions_edit(
     wavefront_components_t* const wf_components,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     int* const max_score_scope,
     int* const num_wavefronts) {
   // Compute max-scope
@@ -61,8 +62,8 @@ void wavefront_components_dimensions_edit(
 void wavefront_components_dimensions_linear(
     wavefront_components_t* const wf_components,
     wavefront_penalties_t* const penalties,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     int* const max_score_scope,
     int* const num_wavefronts) {
   // Compute max-scope
@@ -80,8 +81,8 @@ void wavefront_components_dimensions_linear(
 void wavefront_components_dimensions_affine(
     wavefront_components_t* const wf_components,
     wavefront_penalties_t* const penalties,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     int* const max_score_scope,
     int* const num_wavefronts) {
   // Compute max-scope
@@ -100,8 +101,8 @@ void wavefront_components_dimensions_affine(
 void wavefront_components_dimensions_affine2p(
     wavefront_components_t* const wf_components,
     wavefront_penalties_t* const penalties,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     int* const max_score_scope,
     int* const num_wavefronts) {
   // Compute max-scope
@@ -124,8 +125,8 @@ void wavefront_components_dimensions_affine2p(
 void wavefront_components_dimensions(
     wavefront_components_t* const wf_components,
     wavefront_penalties_t* const penalties,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     int* const max_score_scope,
     int* const num_wavefronts) {
   // Switch attending to distance-metric
@@ -156,6 +157,12 @@ void wavefront_components_dimensions(
           max_score_scope,num_wavefronts);
       break;
   }
+  // Modular wavefronts (ring length rounded up to a power of two)
+  if (wf_components->memory_modular) {
+    int ring_length = 1;
+    while (ring_length < *num_wavefronts) ring_length <<= 1;
+    *num_wavefronts = ring_length;
+  }
   // Clear historic
   wf_components->historic_max_hi = 0;
   wf_components->historic_min_lo = 0;
@@ -165,13 +172,17 @@ void wavefront_components_dimensions(
  */
 void wavefront_components_allocate_wf(
     wavefront_components_t* const wf_components,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     const distance_metric_t distance_metric) {
   // Parameters
   const int num_wavefronts = wf_components->num_wavefronts;
   const bool init_wf = wf_components->memory_modular;
   mm_allocator_t* const mm_allocator = wf_components->mm_allocator;
+  // Allocate ring (modular)
+  wf_components->wavefront_mask = num_wavefronts - 1;
+  wf_components->wavefronts_ring = (wf_components->memory_modular) ?
+      mm_allocator_calloc(mm_allocator,WF_RING_COMPONENTS*num_wavefronts,wavefront_t*,true) : NULL;
   // Allocate wavefronts
   wf_components->mwavefronts = mm_allocator_calloc(mm_allocator,num_wavefronts,wavefront_t*,init_wf);
   if (distance_metric <= gap_linear) {
@@ -193,8 +204,8 @@ void wavefront_components_allocate_wf(
 }
 void wavefront_components_allocate(
     wavefront_components_t* const wf_components,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     wavefront_penalties_t* const penalties,
     const bool memory_modular,
     const bool bt_piggyback,
@@ -213,12 +224,12 @@ void wavefront_components_allocate(
       max_pattern_length,max_text_length,penalties->distance_metric);
   // Allocate victim wavefront (outside slab)
   wavefront_t* const wavefront_victim = mm_allocator_alloc(mm_allocator,wavefront_t);
-  wavefront_allocate(wavefront_victim,WF_NULL_INIT_LENGTH,bt_piggyback,mm_allocator);
+  wavefront_allocate(wavefront_victim,WF_NULL_INIT_LENGTH,bt_piggyback,false,mm_allocator);
   wavefront_init_victim(wavefront_victim,WF_NULL_INIT_LO,WF_NULL_INIT_HI);
   wf_components->wavefront_victim = wavefront_victim;
   // Allocate null wavefront (outside slab)
   wavefront_t* const wavefront_null = mm_allocator_alloc(mm_allocator,wavefront_t);
-  wavefront_allocate(wavefront_null,WF_NULL_INIT_LENGTH,bt_piggyback,mm_allocator);
+  wavefront_allocate(wavefront_null,WF_NULL_INIT_LENGTH,bt_piggyback,false,mm_allocator);
   wavefront_init_null(wavefront_null,WF_NULL_INIT_LO,WF_NULL_INIT_HI);
   wf_components->wavefront_null = wavefront_null;
   // BT-Buffer
@@ -240,6 +251,7 @@ void wavefront_components_clear(
     if (wf_components->d1wavefronts) memset(wf_components->d1wavefronts,0,wf_size);
     if (wf_components->i2wavefronts) memset(wf_components->i2wavefronts,0,wf_size);
     if (wf_components->d2wavefronts) memset(wf_components->d2wavefronts,0,wf_size);
+    memset(wf_components->wavefronts_ring,0,WF_RING_COMPONENTS*wf_size); // Slab is cleared too
   }
   wf_components->historic_max_hi = 0;
   wf_components->historic_min_lo = 0;
@@ -251,6 +263,7 @@ void wavefront_components_free_wf(
   // Parameters
   mm_allocator_t* const mm_allocator = wf_components->mm_allocator;
   // Wavefronts components
+  if (wf_components->wavefronts_ring) mm_allocator_free(mm_allocator,wf_components->wavefronts_ring);
   mm_allocator_free(mm_allocator,wf_components->mwavefronts);
   if (wf_components->i1wavefronts) mm_allocator_free(mm_allocator,wf_components->i1wavefronts);
   if (wf_components->d1wavefronts) mm_allocator_free(mm_allocator,wf_components->d1wavefronts);
@@ -277,8 +290,8 @@ void wavefront_components_free(
  */
 void wavefront_components_resize(
     wavefront_components_t* const wf_components,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     wavefront_penalties_t* const penalties) {
   // Compute dimensions
   int num_wavefronts = 0;
@@ -300,17 +313,17 @@ void wavefront_components_resize(
 }
 void wavefront_components_resize_null__victim(
     wavefront_components_t* const wf_components,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Resize null/victim wavefronts (if needed)
   if (lo-1 < wf_components->wavefront_null->wf_elements_init_min ||
       hi+1 > wf_components->wavefront_null->wf_elements_init_max) {
     // Parameters
     mm_allocator_t* const mm_allocator = wf_components->mm_allocator;
     // Expand and leave some leeway
-    const int wf_inc = (WAVEFRONT_LENGTH(lo,hi)*3)/2;
-    const int proposed_lo = lo - wf_inc/2;
-    const int proposed_hi = hi + wf_inc/2;
+    const wf_coord_t wf_inc = (WAVEFRONT_LENGTH(lo,hi)*3)/2;
+    const wf_coord_t proposed_lo = lo - wf_inc/2;
+    const wf_coord_t proposed_hi = hi + wf_inc/2;
     const int proposed_wavefront_length = WAVEFRONT_LENGTH(proposed_lo,proposed_hi);
     // Reallocate victim wavefront
     wavefront_resize(wf_components->wavefront_victim,proposed_wavefront_length,mm_allocator);
@@ -320,6 +333,54 @@ void wavefront_components_resize_null__victim(
     wavefront_init_null(wf_components->wavefront_null,proposed_lo,proposed_hi);
   }
 }
+void wavefront_components_resize_pcigar(
+    wavefront_components_t* const wf_components,
+    const bool pcigar_64bits) {
+  // Parameters
+  wf_backtrace_buffer_t* const bt_buffer = wf_components->bt_buffer;
+  mm_allocator_t* const mm_allocator = wf_components->mm_allocator;
+  wavefront_t* const wavefront_victim = wf_components->wavefront_victim;
+  wavefront_t* const wavefront_null = wf_components->wavefront_null;
+  // Check width
+  if (bt_buffer == NULL || bt_buffer->pcigar_64bits == pcigar_64bits) return;
+  // BT-Buffer (BT-block size)
+  wf_backtrace_buffer_set_pcigar(bt_buffer,pcigar_64bits);
+  // Null/victim wavefronts (BT-vectors)
+  wavefront_resize_pcigar(wavefront_victim,pcigar_64bits,mm_allocator);
+  wavefront_init_victim(wavefront_victim,
+      wavefront_victim->wf_elements_allocated_min,wavefront_victim->wf_elements_allocated_max);
+  wavefront_resize_pcigar(wavefront_null,pcigar_64bits,mm_allocator);
+  wavefront_init_null(wavefront_null,
+      wavefront_null->wf_elements_allocated_min,wavefront_null->wf_elements_allocated_max);
+}
+/*
+ * Modular wavefronts (ring)
+ */
+wavefront_t* wavefront_components_allocate_wavefront(
+    wavefront_components_t* const wf_components,
+    wavefront_slab_t* const wavefront_slab,
+    const affine2p_matrix_type component,
+    const int score_mod,
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi) {
+  // Non-modular wavefronts are kept (allocate from slab)
+  if (!wf_components->memory_modular) {
+    return wavefront_slab_allocate(wavefront_slab,min_lo,max_hi);
+  }
+  // Reuse the slot's wavefront in place (if large enough)
+  wavefront_t** const slot = wf_components->wavefronts_ring +
+      component*wf_components->num_wavefronts + score_mod;
+  wavefront_t* wavefront = *slot;
+  if (wavefront != NULL && WAVEFRONT_LENGTH(min_lo,max_hi) <= wavefront->wf_elements_allocated) {
+    wavefront_init(wavefront,min_lo,max_hi);
+    return wavefront;
+  }
+  // Grow slot
+  if (wavefront != NULL) wavefront_slab_free(wavefront_slab,wavefront);
+  wavefront = wavefront_slab_allocate(wavefront_slab,min_lo,max_hi);
+  *slot = wavefront;
+  return wavefront;
+}
 /*
  * Mark wavefronts
  */
@@ -330,8 +391,8 @@ void wavefront_components_mark_backtrace(
   // Parameters
   wf_offset_t* const offsets = wavefront->offsets;
   bt_block_idx_t* const bt_prev = wavefront->bt_prev;
-  const int lo = wavefront->lo;
-  const int hi = wavefront->hi;
+  const wf_coord_t lo = wavefront->lo;
+  const wf_coord_t hi = wavefront->hi;
   // Mark all wavefront backtraces (batch mode)
   wf_backtrace_buffer_mark_backtrace_batch(
       bt_buffer,offsets+lo,bt_prev+lo,hi-lo+1,bitmap);
@@ -349,9 +410,9 @@ void wavefront_components_mark_wavefronts(
   const int max_score_scope = wf_components->max_score_scope;
   // Mark Active Working Set (AWS)
   int i;
-  for (i=0;i<max_score_scope;++i) {
+  for (i=0;i<max_score_scope && i<=score;++i) {
     // Compute score
-    const int score_mod = (score-i) % wf_components->max_score_scope;
+    const int score_mod = (score-i) & wf_components->wavefront_mask;
     // Mark M-wavefront
     wavefront_t* const mwavefront = wf_components->mwavefronts[score_mod];
     if (mwavefront!=NULL) wavefront_components_mark_backtrace(bt_buffer,bitmap,mwavefront);
@@ -383,11 +444,11 @@ void wavefront_components_translate_idx(
   // Parameters
   wf_offset_t* const offsets = wavefront->offsets;
   bt_block_idx_t* const bt_prev = wavefront->bt_prev;
-  const int lo = wavefront->lo;
-  const int hi = wavefront->hi;
+  const wf_coord_t lo = wavefront->lo;
+  const wf_coord_t hi = wavefront->hi;
   const bt_block_idx_t num_compacted_blocks = wf_components->bt_buffer->num_compacted_blocks;
   // Translate all wavefront block-idxs
-  int k;
+  wf_coord_t k;
   for (k=lo;k<=hi;++k) {
     if (offsets[k]>=0) {  // NOTE bt_prev[k] >= num_compacted_blocks
       bt_prev[k] = (bt_prev[k]==BT_BLOCK_IDX_NULL) ?
@@ -403,9 +464,9 @@ void wavefront_components_translate_wavefronts(
   // Mark Active Working Set (AWS)
   const int max_score_scope = wf_components->max_score_scope;
   int i;
-  for (i=0;i<max_score_scope;++i) {
+  for (i=0;i<max_score_scope && i<=score;++i) {
     // Compute score
-    const int score_mod = (score-i) % wf_components->max_score_scope;
+    const int score_mod = (score-i) & wf_components->wavefront_mask;
     // Mark M-wavefront
     wavefront_t* const mwavefront = wf_components->mwavefronts[score_mod];
     if (mwavefront!=NULL) wavefront_components_translate_idx(wf_components,bitmap,mwavefront);
@@ -34,6 +34,7 @@
 
 #include "utils/commons.h"
 #include "wavefront/wavefront.h"
+#include "wavefront/wavefront_slab.h"
 #include "wavefront/wavefront_backtrace_buffer.h"
 #include "wavefront/wavefront_penalties.h"
 
@@ -47,8 +48,9 @@ typedef struct {
   // Wavefronts dimensions
   int num_wavefronts;                          // Total number of allocated wavefronts
   int max_score_scope;                         // Maximum score-difference between dependent wavefronts
-  int historic_max_hi;                         // Maximum WF hi-limit seen during current alignment
-  int historic_min_lo;                         // Minimum WF lo-limit seen during current alignment
+  int wavefront_mask;                          // Modular index mask (num_wavefronts-1, a power of two)
+  wf_coord_t historic_max_hi;                  // Maximum WF hi-limit seen during current alignment
+  wf_coord_t historic_min_lo;                  // Minimum WF lo-limit seen during current alignment
   // Wavefronts
   wavefront_t** mwavefronts;                   // M-wavefronts
   wavefront_t** i1wavefronts;                  // I1-wavefronts
@@ -57,6 +59,7 @@ typedef struct {
   wavefront_t** d2wavefronts;                  // D2-wavefronts
   wavefront_t* wavefront_null;                 // Null wavefront (orthogonal reading)
   wavefront_t* wavefront_victim;               // Dummy wavefront (orthogonal writing)
+  wavefront_t** wavefronts_ring;               // Wavefronts owned by each modular slot (reused in place)
   // BT-Buffer
   wf_backtrace_buffer_t* bt_buffer;            // Backtrace Buffer
   // MM
@@ -68,8 +71,8 @@ typedef struct {
  */
 void wavefront_components_allocate(
     wavefront_components_t* const wf_components,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     wavefront_penalties_t* const penalties,
     const bool memory_modular,
     const bool bt_piggyback,
@@ -86,13 +89,27 @@ void wavefront_components_free(
  */
 void wavefront_components_resize(
     wavefront_components_t* const wf_components,
-    const int max_pattern_length,
-    const int max_text_length,
+    const wf_coord_t max_pattern_length,
+    const wf_coord_t max_text_length,
     wavefront_penalties_t* const penalties);
 void wavefront_components_resize_null__victim(
     wavefront_components_t* const wf_components,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
+void wavefront_components_resize_pcigar(
+    wavefront_components_t* const wf_components,
+    const bool pcigar_64bits);
+
+/*
+ * Modular wavefronts (ring)
+ */
+wavefront_t* wavefront_components_allocate_wavefront(
+    wavefront_components_t* const wf_components,
+    wavefront_slab_t* const wavefront_slab,
+    const affine2p_matrix_type component,
+    const int score_mod,
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi);
 
 /*
  * Compact
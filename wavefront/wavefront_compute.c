@@ -39,15 +39,15 @@
 void wavefront_compute_limits_input(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    int* const lo,
-    int* const hi) {
+    wf_coord_t* const lo,
+    wf_coord_t* const hi) {
   // Parameters
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
   const wavefront_t* const m_misms = wavefront_set->in_mwavefront_misms;
   const wavefront_t* const m_open1 = wavefront_set->in_mwavefront_open1;
   // Init
-  int min_lo = m_misms->lo;
-  int max_hi = m_misms->hi;
+  wf_coord_t min_lo = m_misms->lo;
+  wf_coord_t max_hi = m_misms->hi;
   // Gap-linear
   if (min_lo > m_open1->lo-1) min_lo = m_open1->lo-1;
   if (max_hi < m_open1->hi+1) max_hi = m_open1->hi+1;
@@ -85,16 +85,16 @@ void wavefront_compute_limits_input(
 }
 void wavefront_compute_limits_output(
     wavefront_aligner_t* const wf_aligner,
-    const int lo,
-    const int hi,
-    int* const effective_lo,
-    int* const effective_hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi,
+    wf_coord_t* const effective_lo,
+    wf_coord_t* const effective_hi) {
   // Parameters
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
   const int max_score_scope = wf_components->max_score_scope;
   // Add padding to avoid compute-kernel peeling
-  const int eff_lo = lo - (max_score_scope + 1);
-  const int eff_hi = hi + (max_score_scope + 1);
+  const wf_coord_t eff_lo = lo - (max_score_scope + 1);
+  const wf_coord_t eff_hi = hi + (max_score_scope + 1);
   // Consider historic (to avoid errors using heuristics)
   *effective_lo = MIN(eff_lo,wf_components->historic_min_lo);
   *effective_hi = MAX(eff_hi,wf_components->historic_max_hi);
@@ -106,8 +106,8 @@ void wavefront_compute_limits_output(
  */
 int wavefront_compute_classic_score(
     wavefront_aligner_t* const wf_aligner,
-    const int pattern_length,
-    const int text_length,
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length,
     const int wf_score) {
   // Parameters
   const int swg_match = -(wf_aligner->penalties.match);
@@ -136,29 +136,29 @@ bool wavefront_compute_endsfree_required(
 void wavefront_compute_endsfree_limits(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    int* const lo,
-    int* const hi) {
+    wf_coord_t* const lo,
+    wf_coord_t* const hi) {
   // Parameters
   alignment_form_t* const alg_form = &wf_aligner->alignment_form;
   wavefront_penalties_t* const penalties = &wf_aligner->penalties;
   // Consider ends-free conditions
-  const int endsfree_k = score/(-penalties->match);
-  *hi = (alg_form->text_begin_free >= endsfree_k) ? endsfree_k : INT_MIN;
-  *lo = (alg_form->pattern_begin_free >= endsfree_k) ? -endsfree_k : INT_MAX;
+  const wf_coord_t endsfree_k = score/(-penalties->match);
+  *hi = (alg_form->text_begin_free >= endsfree_k) ? endsfree_k : WF_COORD_MIN;
+  *lo = (alg_form->pattern_begin_free >= endsfree_k) ? -endsfree_k : WF_COORD_MAX;
 }
 void wavefront_compute_endsfree_init_offset(
     wavefront_aligner_t* const wf_aligner,
     wavefront_t* const wavefront,
-    const int k,
-    const int v,
-    const int h) {
+    const wf_coord_t k,
+    const wf_coord_t v,
+    const wf_coord_t h) {
   // Parameters
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
   wf_offset_t* const offsets = wavefront->offsets;
   // Set offset
   offsets[k] = DPMATRIX_OFFSET(h,v);
   if (wf_components->bt_piggyback) {
-    wavefront->bt_pcigar[k] = 0;
+    PCIGAR_SET(wavefront->bt_pcigar,k,0,wavefront->bt_pcigar_64bits);
     wavefront->bt_prev[k] =
         wf_backtrace_buffer_init_block(wf_components->bt_buffer,v,h);
   }
@@ -170,13 +170,13 @@ void wavefront_compute_endsfree_init(
   // Parameters
   alignment_form_t* const alg_form = &wf_aligner->alignment_form;
   wavefront_penalties_t* const penalties = &wf_aligner->penalties;
-  const int lo = wavefront->lo;
-  const int hi = wavefront->hi;
+  const wf_coord_t lo = wavefront->lo;
+  const wf_coord_t hi = wavefront->hi;
   // Consider ends-free conditions
-  int endsfree_k = score/(-penalties->match);
+  wf_coord_t endsfree_k = score/(-penalties->match);
   wf_offset_t* const offsets = wavefront->offsets;
   // Consider text begin-free
-  int k;
+  wf_coord_t k;
   if (alg_form->text_begin_free >= endsfree_k) {
     if (hi >= endsfree_k) {
       if (offsets[endsfree_k] <= DPMATRIX_OFFSET(endsfree_k,0)) {
@@ -208,16 +208,17 @@ void wavefront_compute_endsfree_init(
 }
 wavefront_t* wavefront_compute_endsfree_allocate_null(
     wavefront_aligner_t* const wf_aligner,
-    const int score) {
+    const int score,
+    const int score_mod) {
   // Parameters
   wavefront_slab_t* const wavefront_slab = wf_aligner->wavefront_slab;
   alignment_form_t* const alg_form = &wf_aligner->alignment_form;
   wavefront_penalties_t* const penalties = &wf_aligner->penalties;
   // Consider ends-free conditions
-  const int endsfree_k = score/(-penalties->match);
+  const wf_coord_t endsfree_k = score/(-penalties->match);
   const bool text_begin_free = (alg_form->text_begin_free >= endsfree_k);
   const bool pattern_begin_free = (alg_form->pattern_begin_free >= endsfree_k);
-  int lo = 0, hi = 0;
+  wf_coord_t lo = 0, hi = 0;
   if (text_begin_free && pattern_begin_free) {
     lo = -endsfree_k;
     hi = endsfree_k;
@@ -229,12 +230,13 @@ wavefront_t* wavefront_compute_endsfree_allocate_null(
     hi = -endsfree_k;
   }
   // Compute effective hi/lo dimensions
-  int effective_lo, effective_hi;
+  wf_coord_t effective_lo, effective_hi;
   wavefront_compute_limits_output(wf_aligner,lo,hi,&effective_lo,&effective_hi);
   // Allocate & initialize
-  wavefront_t* const wavefront = wavefront_slab_allocate(wavefront_slab,effective_lo,effective_hi);
+  wavefront_t* const wavefront = wavefront_components_allocate_wavefront(
+      &wf_aligner->wf_components,wavefront_slab,affine2p_matrix_M,score_mod,effective_lo,effective_hi);
   wf_offset_t* const offsets = wavefront->offsets;
-  int k;
+  wf_coord_t k;
   for (k=lo+1;k<hi;k++) {
     offsets[k] = WAVEFRONT_OFFSET_NULL;
   }
@@ -306,9 +308,9 @@ void wavefront_compute_fetch_input(
     int gap_open1 = score - penalties->gap_opening1;
     // Modular wavefront
     if (wf_components->memory_modular) {
-      const int max_score_scope = wf_components->max_score_scope;
-      if (mismatch > 0) mismatch =  mismatch % max_score_scope;
-      if (gap_open1 > 0) gap_open1 = gap_open1 % max_score_scope;
+      const int wavefront_mask = wf_components->wavefront_mask;
+      if (mismatch > 0) mismatch =  mismatch & wavefront_mask;
+      if (gap_open1 > 0) gap_open1 = gap_open1 & wavefront_mask;
     }
     // Fetch wavefronts
     wavefront_set->in_mwavefront_misms = wavefront_compute_get_mwavefront(wf_components,mismatch);
@@ -321,12 +323,12 @@ void wavefront_compute_fetch_input(
     int gap_extend2 = score - penalties->gap_extension2;
     // Modular wavefront
     if (wf_components->memory_modular) {
-      const int max_score_scope = wf_components->max_score_scope;
-      if (mismatch > 0) mismatch =  mismatch % max_score_scope;
-      if (gap_open1 > 0) gap_open1 = gap_open1 % max_score_scope;
-      if (gap_extend1 > 0) gap_extend1 = gap_extend1 % max_score_scope;
-      if (gap_open2 > 0) gap_open2 = gap_open2 % max_score_scope;
-      if (gap_extend2 > 0) gap_extend2 = gap_extend2 % max_score_scope;
+      const int wavefront_mask = wf_components->wavefront_mask;
+      if (mismatch > 0) mismatch =  mismatch & wavefront_mask;
+      if (gap_open1 > 0) gap_open1 = gap_open1 & wavefront_mask;
+      if (gap_extend1 > 0) gap_extend1 = gap_extend1 & wavefront_mask;
+      if (gap_open2 > 0) gap_open2 = gap_open2 & wavefront_mask;
+      if (gap_extend2 > 0) gap_extend2 = gap_extend2 & wavefront_mask;
     }
     // Fetch wavefronts
     wavefront_set->in_mwavefront_misms = wavefront_compute_get_mwavefront(wf_components,mismatch);
@@ -342,32 +344,6 @@ void wavefront_compute_fetch_input(
 /*
  * Output wavefronts (allocate)
  */
-void wavefront_compute_free_output(
-    wavefront_aligner_t* const wf_aligner,
-    const int score_mod) {
-  // Parameters
-  wavefront_components_t* const wf_components = &wf_aligner->wf_components;
-  const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
-  wavefront_slab_t* const wavefront_slab = wf_aligner->wavefront_slab;
-  // Free
-  if (wf_components->mwavefronts[score_mod]) {
-    wavefront_slab_free(wavefront_slab,wf_components->mwavefronts[score_mod]);
-  }
-  if (distance_metric == gap_linear) return;
-  if (wf_components->i1wavefronts[score_mod]) {
-    wavefront_slab_free(wavefront_slab,wf_components->i1wavefronts[score_mod]);
-  }
-  if (wf_components->d1wavefronts[score_mod]) {
-    wavefront_slab_free(wavefront_slab,wf_components->d1wavefronts[score_mod]);
-  }
-  if (distance_metric == gap_affine) return;
-  if (wf_components->i2wavefronts[score_mod]) {
-    wavefront_slab_free(wavefront_slab,wf_components->i2wavefronts[score_mod]);
-  }
-  if (wf_components->d2wavefronts[score_mod]) {
-    wavefront_slab_free(wavefront_slab,wf_components->d2wavefronts[score_mod]);
-  }
-}
 void wavefront_compute_allocate_output_null(
     wavefront_aligner_t* const wf_aligner,
     const int score) {
@@ -375,15 +351,11 @@ void wavefront_compute_allocate_output_null(
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
   // Modular wavefront
-  int score_mod = score;
-  if (wf_components->memory_modular) {
-    score_mod = score % wf_components->max_score_scope;
-    wavefront_compute_free_output(wf_aligner,score_mod);
-  }
+  const int score_mod = (wf_components->memory_modular) ? score & wf_components->wavefront_mask : score;
   // Consider ends-free (M!=0)
   if (wavefront_compute_endsfree_required(wf_aligner,score)) {
     wf_components->mwavefronts[score_mod] =
-        wavefront_compute_endsfree_allocate_null(wf_aligner,score);
+        wavefront_compute_endsfree_allocate_null(wf_aligner,score,score_mod);
   } else {
     wf_components->mwavefronts[score_mod] = NULL;
   }
@@ -399,16 +371,16 @@ void wavefront_compute_allocate_output(
     wavefront_aligner_t* const wf_aligner,
     wavefront_set_t* const wavefront_set,
     const int score,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
   wavefront_slab_t* const wavefront_slab = wf_aligner->wavefront_slab;
   // Consider ends-free (M!=0)
-  int effective_lo, effective_hi;
+  wf_coord_t effective_lo, effective_hi;
   if (wavefront_compute_endsfree_required(wf_aligner,score)) {
-    int endsfree_lo, endsfree_hi;
+    wf_coord_t endsfree_lo, endsfree_hi;
     wavefront_compute_endsfree_limits(wf_aligner,score,&endsfree_lo,&endsfree_hi);
     effective_lo = MIN(lo,endsfree_lo);
     effective_hi = MAX(hi,endsfree_hi);
@@ -422,26 +394,24 @@ void wavefront_compute_allocate_output(
       &effective_lo,&effective_hi);
   // Resize null/victim wavefronts
   wavefront_components_resize_null__victim(wf_components,effective_lo,effective_hi);
-  // Modular wavefront
-  int score_mod = score;
-  if (wf_components->memory_modular) {
-    score_mod = score % wf_components->max_score_scope;
-    wavefront_compute_free_output(wf_aligner,score_mod);
-  }
+  // Modular wavefront (slots are reused in place)
+  const int score_mod = (wf_components->memory_modular) ? score & wf_components->wavefront_mask : score;
   // Check
   if (score_mod >= wf_components->num_wavefronts) {
     fprintf(stderr,"[WFA::Compute] Maximum allocated wavefronts reached\n");
     exit(1);
   }
   // Allocate M-Wavefront
-  wavefront_set->out_mwavefront = wavefront_slab_allocate(wavefront_slab,effective_lo,effective_hi);
+  wavefront_set->out_mwavefront = wavefront_components_allocate_wavefront(
+      wf_components,wavefront_slab,affine2p_matrix_M,score_mod,effective_lo,effective_hi);
   wf_components->mwavefronts[score_mod] = wavefront_set->out_mwavefront;
   wf_components->mwavefronts[score_mod]->lo = lo;
   wf_components->mwavefronts[score_mod]->hi = hi;
   if (distance_metric == gap_linear) return;
   // Allocate I1-Wavefront
   if (!wavefront_set->in_mwavefront_open1->null || !wavefront_set->in_i1wavefront_ext->null) {
-    wavefront_set->out_i1wavefront = wavefront_slab_allocate(wavefront_slab,effective_lo,effective_hi);
+    wavefront_set->out_i1wavefront = wavefront_components_allocate_wavefront(
+        wf_components,wavefront_slab,affine2p_matrix_I1,score_mod,effective_lo,effective_hi);
     wf_components->i1wavefronts[score_mod] = wavefront_set->out_i1wavefront;
     wf_components->i1wavefronts[score_mod]->lo = lo;
     wf_components->i1wavefronts[score_mod]->hi = hi;
@@ -451,7 +421,8 @@ void wavefront_compute_allocate_output(
   }
   // Allocate D1-Wavefront
   if (!wavefront_set->in_mwavefront_open1->null || !wavefront_set->in_d1wavefront_ext->null) {
-    wavefront_set->out_d1wavefront = wavefront_slab_allocate(wavefront_slab,effective_lo,effective_hi);
+    wavefront_set->out_d1wavefront = wavefront_components_allocate_wavefront(
+        wf_components,wavefront_slab,affine2p_matrix_D1,score_mod,effective_lo,effective_hi);
     wf_components->d1wavefronts[score_mod] = wavefront_set->out_d1wavefront;
     wf_components->d1wavefronts[score_mod]->lo = lo;
     wf_components->d1wavefronts[score_mod]->hi = hi;
@@ -462,7 +433,8 @@ void wavefront_compute_allocate_output(
   if (distance_metric == gap_affine) return;
   // Allocate I2-Wavefront
   if (!wavefront_set->in_mwavefront_open2->null || !wavefront_set->in_i2wavefront_ext->null) {
-    wavefront_set->out_i2wavefront = wavefront_slab_allocate(wavefront_slab,effective_lo,effective_hi);
+    wavefront_set->out_i2wavefront = wavefront_components_allocate_wavefront(
+        wf_components,wavefront_slab,affine2p_matrix_I2,score_mod,effective_lo,effective_hi);
     wf_components->i2wavefronts[score_mod] = wavefront_set->out_i2wavefront;
     wf_components->i2wavefronts[score_mod]->lo = lo;
     wf_components->i2wavefronts[score_mod]->hi = hi;
@@ -472,7 +444,8 @@ void wavefront_compute_allocate_output(
   }
   // Allocate D2-Wavefront
   if (!wavefront_set->in_mwavefront_open2->null || !wavefront_set->in_d2wavefront_ext->null) {
-    wavefront_set->out_d2wavefront = wavefront_slab_allocate(wavefront_slab,effective_lo,effective_hi);
+    wavefront_set->out_d2wavefront = wavefront_components_allocate_wavefront(
+        wf_components,wavefront_slab,affine2p_matrix_D2,score_mod,effective_lo,effective_hi);
     wf_components->d2wavefronts[score_mod] = wavefront_set->out_d2wavefront;
     wf_components->d2wavefronts[score_mod]->lo = lo;
     wf_components->d2wavefronts[score_mod]->hi = hi;
@@ -486,13 +459,13 @@ void wavefront_compute_allocate_output(
  */
 void wavefront_compute_init_ends_wf_lower(
     wavefront_t* const wavefront,
-    const int min_lo) {
+    const wf_coord_t min_lo) {
   // Check initialization (lowest element)
   if (wavefront->wf_elements_init_min <= min_lo) return;
   // Initialize lower elements
   wf_offset_t* const offsets = wavefront->offsets;
-  const int min_init = MIN(wavefront->wf_elements_init_min,wavefront->lo);
-  int k;
+  const wf_coord_t min_init = MIN(wavefront->wf_elements_init_min,wavefront->lo);
+  wf_coord_t k;
   for (k=min_lo;k<min_init;++k) {
     offsets[k] = WAVEFRONT_OFFSET_NULL;
   }
@@ -501,13 +474,13 @@ void wavefront_compute_init_ends_wf_lower(
 }
 void wavefront_compute_init_ends_wf_higher(
     wavefront_t* const wavefront,
-    const int max_hi) {
+    const wf_coord_t max_hi) {
   // Check initialization (highest element)
   if (wavefront->wf_elements_init_max >= max_hi) return;
   // Initialize lower elements
   wf_offset_t* const offsets = wavefront->offsets;
-  const int max_init = MAX(wavefront->wf_elements_init_max,wavefront->hi);
-  int k;
+  const wf_coord_t max_init = MAX(wavefront->wf_elements_init_max,wavefront->hi);
+  wf_coord_t k;
   for (k=max_init+1;k<=max_hi;++k) {
     offsets[k] = WAVEFRONT_OFFSET_NULL;
   }
@@ -517,8 +490,8 @@ void wavefront_compute_init_ends_wf_higher(
 void wavefront_compute_init_ends(
     wavefront_aligner_t* const wf_aligner,
     wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
   // Init missing elements, instead of loop peeling (M)
@@ -569,30 +542,30 @@ void wavefront_compute_trim_ends(
     wavefront_aligner_t* const wf_aligner,
     wavefront_t* const wavefront) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   wf_offset_t* const offsets = wavefront->offsets;
   // Trim from hi
-  int k;
-  const int lo = wavefront->lo;
+  wf_coord_t k;
+  const wf_coord_t lo = wavefront->lo;
   for (k=wavefront->hi;k>=lo;--k) {
     // Fetch offset
     const wf_offset_t offset = offsets[k];
     // Check boundaries
-    const uint32_t h = WAVEFRONT_H(k,offset); // Make unsigned to avoid checking negative
-    const uint32_t v = WAVEFRONT_V(k,offset); // Make unsigned to avoid checking negative
+    const wf_unsigned_offset_t h = WAVEFRONT_H(k,offset); // Make unsigned to avoid checking negative
+    const wf_unsigned_offset_t v = WAVEFRONT_V(k,offset); // Make unsigned to avoid checking negative
     if (h <= text_length && v <= pattern_length) break;
   }
   wavefront->hi = k; // Set new hi
   wavefront->wf_elements_init_max = k;
   // Trim from lo
-  const int hi = wavefront->hi;
+  const wf_coord_t hi = wavefront->hi;
   for (k=wavefront->lo;k<=hi;++k) {
     // Fetch offset
     const wf_offset_t offset = offsets[k];
     // Check boundaries
-    const uint32_t h = WAVEFRONT_H(k,offset); // Make unsigned to avoid checking negative
-    const uint32_t v = WAVEFRONT_V(k,offset); // Make unsigned to avoid checking negative
+    const wf_unsigned_offset_t h = WAVEFRONT_H(k,offset); // Make unsigned to avoid checking negative
+    const wf_unsigned_offset_t v = WAVEFRONT_V(k,offset); // Make unsigned to avoid checking negative
     if (h <= text_length && v <= pattern_length) break;
   }
   wavefront->lo = k; // Set new lo
@@ -624,12 +597,19 @@ void wavefront_compute_process_ends(
 #ifdef WFA_PARALLEL
 int wavefront_compute_num_threads(
     wavefront_aligner_t* const wf_aligner,
-    const int lo,
-    const int hi) {
+    const wf_parallel_phase_t phase,
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
-  const int max_num_threads = wf_aligner->system.max_num_threads;
-  if (max_num_threads == 1) return 1;
+  if (wf_aligner->thread_team == NULL) return 1;
+  const int max_num_threads = MIN(wf_aligner->system.max_num_threads,wf_aligner->thread_team->max_threads);
+  if (max_num_threads <= 1) return 1;
   const int min_offsets_per_thread = wf_aligner->system.min_offsets_per_thread;
+  // Auto-tuned (at least one cache-line per thread)
+  if (min_offsets_per_thread <= 0) {
+    return wavefront_parallel_tuner_num_threads(&wf_aligner->parallel_tuner,
+        phase,WAVEFRONT_LENGTH(lo,hi),WF_COMPUTE_THREAD_ALIGNMENT,max_num_threads);
+  }
   // Compute minimum work-chunks worth spawning threads
   const int num_chunks = WAVEFRONT_LENGTH(lo,hi)/min_offsets_per_thread;
   const int max_workers = MIN(num_chunks,max_num_threads);
@@ -638,15 +618,58 @@ int wavefront_compute_num_threads(
 void wavefront_compute_thread_limits(
     const int thread_id,
     const int num_theads,
-    const int lo,
-    const int hi,
-    int* const thread_lo,
-    int* const thread_hi) {
-  const int chunk_size = WAVEFRONT_LENGTH(lo,hi)/num_theads;
-  const int t_lo = lo + thread_id*chunk_size;
-  const int t_hi = (thread_id+1 == num_theads) ? hi : t_lo + chunk_size - 1;
+    const wf_coord_t lo,
+    const wf_coord_t hi,
+    wf_coord_t* const thread_lo,
+    wf_coord_t* const thread_hi) {
+  // Split at cache-line boundaries (no false-sharing; stable across compute & extend)
+  const int64_t length = WAVEFRONT_LENGTH(lo,hi);
+  const wf_coord_t align_mask = ~((wf_coord_t)WF_COMPUTE_THREAD_ALIGNMENT-1);
+  const wf_coord_t t_lo = (thread_id == 0) ? lo :
+      MAX(lo,(wf_coord_t)(lo + thread_id*length/num_theads) & align_mask);
+  const wf_coord_t t_hi = (thread_id+1 == num_theads) ? hi :
+      MAX(lo,(wf_coord_t)(lo + (thread_id+1)*length/num_theads) & align_mask) - 1;
   *thread_lo = t_lo;
   *thread_hi = t_hi;
 }
+void wavefront_compute_parallel_sample(
+    wavefront_aligner_t* const wf_aligner) {
+  if (wf_aligner->system.min_offsets_per_thread > 0) return;
+  wavefront_parallel_tuner_sample(&wf_aligner->parallel_tuner);
+}
+void wavefront_compute_task_chunking(
+    wavefront_compute_task_t* const task,
+    const int num_threads) {
+  // Static ranges (fixed granularity)
+  const wf_coord_t align_mask = ~((wf_coord_t)WF_COMPUTE_THREAD_ALIGNMENT-1);
+  task->chunk_length = 0;
+  task->chunk_next = task->lo & align_mask;
+  if (task->wf_aligner->system.min_offsets_per_thread > 0) return;
+  // Dynamic chunks (a few per thread, at cache-line boundaries)
+  const wf_coord_t length = WAVEFRONT_LENGTH(task->lo,task->hi);
+  const wf_coord_t chunk_length = length/(num_threads*WF_PARALLEL_CHUNKS_PER_THREAD);
+  task->chunk_length = MAX((wf_coord_t)WF_COMPUTE_THREAD_ALIGNMENT,chunk_length & align_mask);
+}
+bool wavefront_compute_thread_chunk(
+    wavefront_compute_task_t* const task,
+    const int thread_id,
+    const int num_threads,
+    int* const chunk_idx,
+    wf_coord_t* const thread_lo,
+    wf_coord_t* const thread_hi) {
+  // Static range (one per thread)
+  if (task->chunk_length == 0) {
+    if ((*chunk_idx)++ > 0) return false;
+    wavefront_compute_thread_limits(thread_id,num_threads,task->lo,task->hi,thread_lo,thread_hi);
+    return (*thread_lo <= *thread_hi);
+  }
+  // Dynamic chunk (starting at a cache-line boundary)
+  const wf_coord_t chunk_lo = __atomic_fetch_add(&task->chunk_next,task->chunk_length,__ATOMIC_RELAXED);
+  if (chunk_lo > task->hi) return false;
+  *thread_lo = MAX(chunk_lo,task->lo);
+  *thread_hi = MIN(chunk_lo+task->chunk_length-1,task->hi);
+  ++(*chunk_idx);
+  return true;
+}
 #endif
 
@@ -34,28 +34,87 @@
 
 #include "wavefront_aligner.h"
 
+/*
+ * Compute kernels (per-diagonal update; shared with the lockstep lanes)
+ */
+FORCE_INLINE wf_offset_t wavefront_compute_bound(
+    const wf_offset_t offset,
+    const wf_coord_t k,
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length) {
+  // Null offset out of boundaries !(h>tlen,v>plen) (branchless to allow vectorization)
+  const wf_unsigned_offset_t h = WAVEFRONT_H(k,offset); // Make unsigned to avoid checking negative
+  const wf_unsigned_offset_t v = WAVEFRONT_V(k,offset); // Make unsigned to avoid checking negative
+  wf_offset_t bounded_offset = offset;
+  if (h > text_length) bounded_offset = WAVEFRONT_OFFSET_NULL;
+  if (v > pattern_length) bounded_offset = WAVEFRONT_OFFSET_NULL;
+  return bounded_offset;
+}
+FORCE_INLINE wf_offset_t wavefront_compute_indel_diagonal(
+    const wf_coord_t k,
+    const wf_offset_t prev_lower,      // M[s-1][k-1]
+    const wf_offset_t prev_upper,      // M[s-1][k+1]
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length) {
+  const wf_offset_t ins = prev_lower + 1;
+  const wf_offset_t del = prev_upper;
+  return wavefront_compute_bound(MAX(del,ins),k,pattern_length,text_length);
+}
+FORCE_INLINE wf_offset_t wavefront_compute_edit_diagonal(
+    const wf_coord_t k,
+    const wf_offset_t prev_lower,      // M[s-1][k-1]
+    const wf_offset_t prev_mid,        // M[s-1][k]
+    const wf_offset_t prev_upper,      // M[s-1][k+1]
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length) {
+  const wf_offset_t max = MAX(prev_upper,MAX(prev_lower,prev_mid)+1);
+  return wavefront_compute_bound(max,k,pattern_length,text_length);
+}
+FORCE_INLINE void wavefront_compute_affine_diagonal(
+    const wf_coord_t k,
+    const wf_offset_t m_misms,         // M[s-x][k]
+    const wf_offset_t m_open1_lower,   // M[s-o-e][k-1]
+    const wf_offset_t i1_ext_lower,    // I1[s-e][k-1]
+    const wf_offset_t m_open1_upper,   // M[s-o-e][k+1]
+    const wf_offset_t d1_ext_upper,    // D1[s-e][k+1]
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length,
+    wf_offset_t* const out_m,
+    wf_offset_t* const out_i1,
+    wf_offset_t* const out_d1) {
+  // Update I1
+  const wf_offset_t ins1 = MAX(m_open1_lower,i1_ext_lower) + 1;
+  *out_i1 = ins1;
+  // Update D1
+  const wf_offset_t del1 = MAX(m_open1_upper,d1_ext_upper);
+  *out_d1 = del1;
+  // Update M (I1/D1 are left unbounded; out-of-bounds I1/D1 only lead out-of-bounds)
+  const wf_offset_t misms = m_misms + 1;
+  *out_m = wavefront_compute_bound(MAX(del1,MAX(misms,ins1)),k,pattern_length,text_length);
+}
+
 /*
  * Compute limits
  */
 void wavefront_compute_limits_input(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    int* const lo,
-    int* const hi);
+    wf_coord_t* const lo,
+    wf_coord_t* const hi);
 void wavefront_compute_limits_output(
     wavefront_aligner_t* const wf_aligner,
-    const int lo,
-    const int hi,
-    int* const effective_lo,
-    int* const effective_hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi,
+    wf_coord_t* const effective_lo,
+    wf_coord_t* const effective_hi);
 
 /*
  * Score translation
  */
 int wavefront_compute_classic_score(
     wavefront_aligner_t* const wf_aligner,
-    const int pattern_length,
-    const int text_length,
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length,
     const int wf_score);
 
 /*
@@ -76,8 +135,8 @@ void wavefront_compute_allocate_output(
     wavefront_aligner_t* const wf_aligner,
     wavefront_set_t* const wavefront_set,
     const int score,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 
 /*
  * Initialize wavefronts ends
@@ -85,8 +144,8 @@ void wavefront_compute_allocate_output(
 void wavefront_compute_init_ends(
     wavefront_aligner_t* const wf_aligner,
     wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 
 /*
  * Process wavefronts ends
@@ -101,21 +160,55 @@ void wavefront_compute_process_ends(
 
 /*
  * Multithread dispatcher
+ *   Tasks run on the aligner's persistent thread team. Each thread computes
+ *   (and then extends) the same static range of diagonals, split at cache-line
+ *   boundaries. If min_offsets_per_thread is 0, the number of threads of each
+ *   step is auto-tuned (see wavefront_parallel.h) and extend threads take
+ *   dynamic chunks of diagonals instead.
  */
 #ifdef WFA_PARALLEL
+#define WF_COMPUTE_THREAD_ALIGNMENT (64/sizeof(wf_offset_t)) // Offsets per cache-line
+typedef struct {
+  wavefront_aligner_t* wf_aligner;  // Aligner
+  wavefront_set_t* wavefront_set;   // Input/output wavefronts (compute)
+  wavefront_t* wf_prev;             // Previous wavefront (compute edit)
+  wavefront_t* wavefront;           // Output wavefront (compute edit) or M-wavefront (extend)
+  int score;                        // Current score
+  wf_coord_t lo;                    // Lowest diagonal
+  wf_coord_t hi;                    // Highest diagonal
+  bool endsfree;                    // Ends-free alignment (extend custom)
+  bool end_reached;                 // Any thread reached the end (extend)
+  wf_offset_t* max_antidiags;       // Maximum antidiagonal per thread (extend)
+  wf_coord_t chunk_length;          // Dynamic chunk length (extend; 0 for static ranges)
+  wf_coord_t chunk_next;            // Next dynamic chunk (atomic)
+} wavefront_compute_task_t;
 int wavefront_compute_num_threads(
     wavefront_aligner_t* const wf_aligner,
-    const int lo,
-    const int hi);
+    const wf_parallel_phase_t phase,
+    const wf_coord_t lo,
+    const wf_coord_t hi);
+void wavefront_compute_parallel_sample(
+    wavefront_aligner_t* const wf_aligner);
+void wavefront_compute_task_chunking(
+    wavefront_compute_task_t* const task,
+    const int num_threads);
 void wavefront_compute_thread_limits(
     const int thread_id,
     const int num_theads,
-    const int lo,
-    const int hi,
-    int* const thread_lo,
-    int* const thread_hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi,
+    wf_coord_t* const thread_lo,
+    wf_coord_t* const thread_hi);
+bool wavefront_compute_thread_chunk(
+    wavefront_compute_task_t* const task,
+    const int thread_id,
+    const int num_threads,
+    int* const chunk_idx,
+    wf_coord_t* const thread_lo,
+    wf_coord_t* const thread_hi);
 #else
-#define wavefront_compute_num_threads(wf_aligner,lo,hi) 1
+#define wavefront_compute_num_threads(wf_aligner,phase,lo,hi) 1
+#define wavefront_compute_parallel_sample(wf_aligner)
 #endif
 
 #endif /* WAVEFRONT_COMPUTE_H_ */
@@ -33,21 +33,17 @@
 #include "wavefront_compute.h"
 #include "wavefront_backtrace_offload.h"
 
-#ifdef WFA_PARALLEL
-#include <omp.h>
-#endif
-
 /*
  * Compute Kernels
  */
 void wavefront_compute_affine_idm(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   // In Offsets
   const wf_offset_t* const m_misms = wavefront_set->in_mwavefront_misms->offsets;
   const wf_offset_t* const m_open1 = wavefront_set->in_mwavefront_open1->offsets;
@@ -58,41 +54,26 @@ void wavefront_compute_affine_idm(
   wf_offset_t* const out_i1 = wavefront_set->out_i1wavefront->offsets;
   wf_offset_t* const out_d1 = wavefront_set->out_d1wavefront->offsets;
   // Compute-Next kernel loop
-  int k;
+  wf_coord_t k;
   PRAGMA_LOOP_VECTORIZE
   for (k=lo;k<=hi;++k) {
-    // Update I1
-    const wf_offset_t ins1_o = m_open1[k-1];
-    const wf_offset_t ins1_e = i1_ext[k-1];
-    const wf_offset_t ins1 = MAX(ins1_o,ins1_e) + 1;
-    out_i1[k] = ins1;
-    // Update D1
-    const wf_offset_t del1_o = m_open1[k+1];
-    const wf_offset_t del1_e = d1_ext[k+1];
-    const wf_offset_t del1 = MAX(del1_o,del1_e);
-    out_d1[k] = del1;
-    // Update M
-    const wf_offset_t misms = m_misms[k] + 1;
-    wf_offset_t max = MAX(del1,MAX(misms,ins1));
-    // Adjust offset out of boundaries !(h>tlen,v>plen) (here to allow vectorization)
-    const wf_unsigned_offset_t h = WAVEFRONT_H(k,max); // Make unsigned to avoid checking negative
-    const wf_unsigned_offset_t v = WAVEFRONT_V(k,max); // Make unsigned to avoid checking negative
-    if (h > text_length) max = WAVEFRONT_OFFSET_NULL;
-    if (v > pattern_length) max = WAVEFRONT_OFFSET_NULL;
-    out_m[k] = max;
+    wavefront_compute_affine_diagonal(k,
+        m_misms[k],m_open1[k-1],i1_ext[k-1],m_open1[k+1],d1_ext[k+1],
+        pattern_length,text_length,out_m+k,out_i1+k,out_d1+k);
   }
 }
 /*
  * Compute Kernel (Piggyback)
  */
-void wavefront_compute_affine_idm_piggyback(
+FORCE_INLINE void wavefront_compute_affine_idm_piggyback_kernel(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi,
+    const bool pcigar_64bits) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   // In Offsets
   const wf_offset_t* const m_misms = wavefront_set->in_mwavefront_misms->offsets;
   const wf_offset_t* const m_open1 = wavefront_set->in_mwavefront_open1->offsets;
@@ -103,25 +84,25 @@ void wavefront_compute_affine_idm_piggyback(
   wf_offset_t* const out_i1 = wavefront_set->out_i1wavefront->offsets;
   wf_offset_t* const out_d1 = wavefront_set->out_d1wavefront->offsets;
   // In BT-pcigar
-  const pcigar_t* const m_misms_bt_pcigar = wavefront_set->in_mwavefront_misms->bt_pcigar;
-  const pcigar_t* const m_open1_bt_pcigar = wavefront_set->in_mwavefront_open1->bt_pcigar;
-  const pcigar_t* const i1_ext_bt_pcigar  = wavefront_set->in_i1wavefront_ext->bt_pcigar;
-  const pcigar_t* const d1_ext_bt_pcigar  = wavefront_set->in_d1wavefront_ext->bt_pcigar;
+  const void* const m_misms_bt_pcigar = wavefront_set->in_mwavefront_misms->bt_pcigar;
+  const void* const m_open1_bt_pcigar = wavefront_set->in_mwavefront_open1->bt_pcigar;
+  const void* const i1_ext_bt_pcigar  = wavefront_set->in_i1wavefront_ext->bt_pcigar;
+  const void* const d1_ext_bt_pcigar  = wavefront_set->in_d1wavefront_ext->bt_pcigar;
   // In BT-prev
   const bt_block_idx_t* const m_misms_bt_prev = wavefront_set->in_mwavefront_misms->bt_prev;
   const bt_block_idx_t* const m_open1_bt_prev = wavefront_set->in_mwavefront_open1->bt_prev;
   const bt_block_idx_t* const i1_ext_bt_prev  = wavefront_set->in_i1wavefront_ext->bt_prev;
   const bt_block_idx_t* const d1_ext_bt_prev  = wavefront_set->in_d1wavefront_ext->bt_prev;
   // Out BT-pcigar
-  pcigar_t* const out_m_bt_pcigar   = wavefront_set->out_mwavefront->bt_pcigar;
-  pcigar_t* const out_i1_bt_pcigar  = wavefront_set->out_i1wavefront->bt_pcigar;
-  pcigar_t* const out_d1_bt_pcigar  = wavefront_set->out_d1wavefront->bt_pcigar;
+  void* const out_m_bt_pcigar   = wavefront_set->out_mwavefront->bt_pcigar;
+  void* const out_i1_bt_pcigar  = wavefront_set->out_i1wavefront->bt_pcigar;
+  void* const out_d1_bt_pcigar  = wavefront_set->out_d1wavefront->bt_pcigar;
   // Out BT-prev
   bt_block_idx_t* const out_m_bt_prev  = wavefront_set->out_mwavefront->bt_prev;
   bt_block_idx_t* const out_i1_bt_prev = wavefront_set->out_i1wavefront->bt_prev;
   bt_block_idx_t* const out_d1_bt_prev = wavefront_set->out_d1wavefront->bt_prev;
   // Compute-Next kernel loop
-  int k;
+  wf_coord_t k;
   PRAGMA_LOOP_VECTORIZE // Ifs predicated by the compiler
   for (k=lo;k<=hi;++k) {
     // Update I1
@@ -132,14 +113,15 @@ void wavefront_compute_affine_idm_piggyback(
     bt_block_idx_t ins1_block_idx;
     if (ins1_e >= ins1_o) {
       ins1 = ins1_e;
-      ins1_pcigar = i1_ext_bt_pcigar[k-1];
+      ins1_pcigar = PCIGAR_GET(i1_ext_bt_pcigar,k-1,pcigar_64bits);
       ins1_block_idx = i1_ext_bt_prev[k-1];
     } else {
       ins1 = ins1_o;
-      ins1_pcigar = m_open1_bt_pcigar[k-1];
+      ins1_pcigar = PCIGAR_GET(m_open1_bt_pcigar,k-1,pcigar_64bits);
       ins1_block_idx = m_open1_bt_prev[k-1];
     }
-    out_i1_bt_pcigar[k] = PCIGAR_PUSH_BACK_INS(ins1_pcigar);
+    ins1_pcigar = PCIGAR_PUSH_BACK_INS(ins1_pcigar);
+    PCIGAR_SET(out_i1_bt_pcigar,k,ins1_pcigar,pcigar_64bits);
     out_i1_bt_prev[k] = ins1_block_idx;
     out_i1[k] = ++ins1;
     // Update D1
@@ -150,34 +132,34 @@ void wavefront_compute_affine_idm_piggyback(
     bt_block_idx_t del1_block_idx;
     if (del1_e >= del1_o) {
       del1 = del1_e;
-      del1_pcigar = d1_ext_bt_pcigar[k+1];
+      del1_pcigar = PCIGAR_GET(d1_ext_bt_pcigar,k+1,pcigar_64bits);
       del1_block_idx = d1_ext_bt_prev[k+1];
     } else {
       del1 = del1_o;
-      del1_pcigar = m_open1_bt_pcigar[k+1];
+      del1_pcigar = PCIGAR_GET(m_open1_bt_pcigar,k+1,pcigar_64bits);
       del1_block_idx = m_open1_bt_prev[k+1];
     }
-    out_d1_bt_pcigar[k] = PCIGAR_PUSH_BACK_DEL(del1_pcigar);
+    del1_pcigar = PCIGAR_PUSH_BACK_DEL(del1_pcigar);
+    PCIGAR_SET(out_d1_bt_pcigar,k,del1_pcigar,pcigar_64bits);
     out_d1_bt_prev[k] = del1_block_idx;
     out_d1[k] = del1;
-    // Update M
+    // Update M (ties resolved as X > D > I)
     const wf_offset_t misms = m_misms[k] + 1;
     wf_offset_t max = MAX(del1,MAX(misms,ins1));
-    if (max == ins1) {
-      out_m_bt_pcigar[k] = out_i1_bt_pcigar[k];
-      out_m_bt_prev[k] = out_i1_bt_prev[k];
-    }
-    if (max == del1) {
-      out_m_bt_pcigar[k] = out_d1_bt_pcigar[k];
-      out_m_bt_prev[k] = out_d1_bt_prev[k];
-    }
+    pcigar_t m_pcigar;
     if (max == misms) {
-      out_m_bt_pcigar[k] = m_misms_bt_pcigar[k];
+      m_pcigar = PCIGAR_GET(m_misms_bt_pcigar,k,pcigar_64bits);
       out_m_bt_prev[k] = m_misms_bt_prev[k];
+    } else if (max == del1) {
+      m_pcigar = del1_pcigar;
+      out_m_bt_prev[k] = del1_block_idx;
+    } else {
+      m_pcigar = ins1_pcigar;
+      out_m_bt_prev[k] = ins1_block_idx;
     }
     // Coming from I/D -> X is fake to represent gap-close
     // Coming from M -> X is real to represent mismatch
-    out_m_bt_pcigar[k] = PCIGAR_PUSH_BACK_MISMS(out_m_bt_pcigar[k]);
+    PCIGAR_SET(out_m_bt_pcigar,k,PCIGAR_PUSH_BACK_MISMS(m_pcigar),pcigar_64bits);
     // Adjust offset out of boundaries !(h>tlen,v>plen) (here to allow vectorization)
     const wf_unsigned_offset_t h = WAVEFRONT_H(k,max); // Make unsigned to avoid checking negative
     const wf_unsigned_offset_t v = WAVEFRONT_V(k,max); // Make unsigned to avoid checking negative
@@ -186,17 +168,44 @@ void wavefront_compute_affine_idm_piggyback(
     out_m[k] = max;
   }
 }
+void wavefront_compute_affine_idm_piggyback(
+    wavefront_aligner_t* const wf_aligner,
+    const wavefront_set_t* const wavefront_set,
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
+  // Specialize the kernel for the pCIGAR storage width
+  if (wf_aligner->wf_components.bt_buffer->pcigar_64bits) {
+    wavefront_compute_affine_idm_piggyback_kernel(wf_aligner,wavefront_set,lo,hi,true);
+  } else {
+    wavefront_compute_affine_idm_piggyback_kernel(wf_aligner,wavefront_set,lo,hi,false);
+  }
+}
 /*
  * Compute Wavefronts (gap-affine)
  */
+#ifdef WFA_PARALLEL
+void wavefront_compute_affine_thread(
+    void* const args,
+    const int thread_id,
+    const int num_threads) {
+  wavefront_compute_task_t* const task = args;
+  wf_coord_t t_lo, t_hi;
+  wavefront_compute_thread_limits(thread_id,num_threads,task->lo,task->hi,&t_lo,&t_hi);
+  if (task->wf_aligner->wf_components.bt_piggyback) {
+    wavefront_compute_affine_idm_piggyback(task->wf_aligner,task->wavefront_set,t_lo,t_hi);
+  } else {
+    wavefront_compute_affine_idm(task->wf_aligner,task->wavefront_set,t_lo,t_hi);
+  }
+}
+#endif
 void wavefront_compute_affine_dispatcher(
     wavefront_aligner_t* const wf_aligner,
     wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
   const bool bt_piggyback = wf_aligner->wf_components.bt_piggyback;
-  const int num_threads = wavefront_compute_num_threads(wf_aligner,lo,hi);
+  const int num_threads = wavefront_compute_num_threads(wf_aligner,wf_parallel_compute,lo,hi);
   // Multithreading dispatcher
   if (num_threads == 1) {
     // Compute next wavefront
@@ -208,20 +217,13 @@ void wavefront_compute_affine_dispatcher(
   } else {
 #ifdef WFA_PARALLEL
     // Compute next wavefront in parallel
-    #pragma omp parallel num_threads(num_threads)
-    {
-      int t_lo, t_hi;
-      const int thread_id = omp_get_thread_num();
-      const int thread_num = omp_get_num_threads();
-      wavefront_compute_thread_limits(thread_id,thread_num,lo,hi,&t_lo,&t_hi);
-      if (bt_piggyback) {
-        wavefront_compute_affine_idm_piggyback(wf_aligner,wavefront_set,t_lo,t_hi);
-      } else {
-        wavefront_compute_affine_idm(wf_aligner,wavefront_set,t_lo,t_hi);
-      }
-    }
+    wavefront_compute_task_t task = {
+        .wf_aligner = wf_aligner, .wavefront_set = wavefront_set, .lo = lo, .hi = hi };
+    thread_team_run(wf_aligner->thread_team,num_threads,wavefront_compute_affine_thread,&task);
 #endif
   }
+  // Auto-tuning
+  wavefront_compute_parallel_sample(wf_aligner);
 }
 void wavefront_compute_affine(
     wavefront_aligner_t* const wf_aligner,
@@ -240,7 +242,7 @@ void wavefront_compute_affine(
   }
   wf_aligner->align_status.num_null_steps = 0;
   // Set limits
-  int hi, lo;
+  wf_coord_t hi, lo;
   wavefront_compute_limits_input(wf_aligner,&wavefront_set,&lo,&hi);
   // Allocate wavefronts
   wavefront_compute_allocate_output(wf_aligner,&wavefront_set,score,lo,hi);
@@ -40,13 +40,13 @@
 void wavefront_compute_affine_idm(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 void wavefront_compute_affine_idm_piggyback(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi);
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 
 /*
  * Compute Wavefronts (gap-affine)
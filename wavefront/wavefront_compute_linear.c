@@ -33,28 +33,24 @@
 #include "wavefront_compute.h"
 #include "wavefront_backtrace_offload.h"
 
-#ifdef WFA_PARALLEL
-#include <omp.h>
-#endif
-
 /*
  * Compute Kernels
  */
 void wavefront_compute_linear_idm(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   // In Offsets
   const wf_offset_t* const m_misms = wavefront_set->in_mwavefront_misms->offsets;
   const wf_offset_t* const m_open1 = wavefront_set->in_mwavefront_open1->offsets;
   // Out Offsets
   wf_offset_t* const out_m = wavefront_set->out_mwavefront->offsets;
   // Compute-Next kernel loop
-  int k;
+  wf_coord_t k;
   PRAGMA_LOOP_VECTORIZE
   for (k=lo;k<=hi;++k) {
     // Compute maximum Offset
@@ -73,28 +69,29 @@ void wavefront_compute_linear_idm(
 /*
  * Compute Kernel (Piggyback)
  */
-void wavefront_compute_linear_idm_piggyback(
+FORCE_INLINE void wavefront_compute_linear_idm_piggyback_kernel(
     wavefront_aligner_t* const wf_aligner,
     const wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi,
+    const bool pcigar_64bits) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   // In M
   const wf_offset_t* const m_misms = wavefront_set->in_mwavefront_misms->offsets;
-  const pcigar_t* const m_misms_bt_pcigar = wavefront_set->in_mwavefront_misms->bt_pcigar;
+  const void* const m_misms_bt_pcigar = wavefront_set->in_mwavefront_misms->bt_pcigar;
   const bt_block_idx_t* const m_misms_bt_prev = wavefront_set->in_mwavefront_misms->bt_prev;
   // In I/D
   const wf_offset_t* const m_open1 = wavefront_set->in_mwavefront_open1->offsets;
-  const pcigar_t* const m_open1_bt_pcigar = wavefront_set->in_mwavefront_open1->bt_pcigar;
+  const void* const m_open1_bt_pcigar = wavefront_set->in_mwavefront_open1->bt_pcigar;
   const bt_block_idx_t* const m_open1_bt_prev = wavefront_set->in_mwavefront_open1->bt_prev;
   // Out
   wf_offset_t* const out_m = wavefront_set->out_mwavefront->offsets;
-  pcigar_t* const out_m_bt_pcigar = wavefront_set->out_mwavefront->bt_pcigar;
+  void* const out_m_bt_pcigar = wavefront_set->out_mwavefront->bt_pcigar;
   bt_block_idx_t* const out_m_bt_prev = wavefront_set->out_mwavefront->bt_prev;
   // Compute-Next kernel loop
-  int k;
+  wf_coord_t k;
   PRAGMA_LOOP_VECTORIZE // Ifs predicated by the compiler
   for (k=lo;k<=hi;++k) {
     // Compute maximum Offset
@@ -104,15 +101,15 @@ void wavefront_compute_linear_idm_piggyback(
     wf_offset_t max = MAX(del1,MAX(misms,ins1));
     // Update pcigar & bt-block
     if (max == ins1) {
-      out_m_bt_pcigar[k] = PCIGAR_PUSH_BACK_INS(m_open1_bt_pcigar[k-1]);
+      PCIGAR_SET(out_m_bt_pcigar,k,PCIGAR_PUSH_BACK_INS(PCIGAR_GET(m_open1_bt_pcigar,k-1,pcigar_64bits)),pcigar_64bits);
       out_m_bt_prev[k] = m_open1_bt_prev[k-1];
     }
     if (max == del1) {
-      out_m_bt_pcigar[k] = PCIGAR_PUSH_BACK_DEL(m_open1_bt_pcigar[k+1]);
+      PCIGAR_SET(out_m_bt_pcigar,k,PCIGAR_PUSH_BACK_DEL(PCIGAR_GET(m_open1_bt_pcigar,k+1,pcigar_64bits)),pcigar_64bits);
       out_m_bt_prev[k] = m_open1_bt_prev[k+1];
     }
     if (max == misms) {
-      out_m_bt_pcigar[k] = PCIGAR_PUSH_BACK_MISMS(m_misms_bt_pcigar[k]);
+      PCIGAR_SET(out_m_bt_pcigar,k,PCIGAR_PUSH_BACK_MISMS(PCIGAR_GET(m_misms_bt_pcigar,k,pcigar_64bits)),pcigar_64bits);
       out_m_bt_prev[k] = m_misms_bt_prev[k];
     }
     // Adjust offset out of boundaries !(h>tlen,v>plen) (here to allow vectorization)
@@ -123,17 +120,44 @@ void wavefront_compute_linear_idm_piggyback(
     out_m[k] = max;
   }
 }
+void wavefront_compute_linear_idm_piggyback(
+    wavefront_aligner_t* const wf_aligner,
+    const wavefront_set_t* const wavefront_set,
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
+  // Specialize the kernel for the pCIGAR storage width
+  if (wf_aligner->wf_components.bt_buffer->pcigar_64bits) {
+    wavefront_compute_linear_idm_piggyback_kernel(wf_aligner,wavefront_set,lo,hi,true);
+  } else {
+    wavefront_compute_linear_idm_piggyback_kernel(wf_aligner,wavefront_set,lo,hi,false);
+  }
+}
 /*
  * Compute Wavefronts (gap-linear)
  */
+#ifdef WFA_PARALLEL
+void wavefront_compute_linear_thread(
+    void* const args,
+    const int thread_id,
+    const int num_threads) {
+  wavefront_compute_task_t* const task = args;
+  wf_coord_t t_lo, t_hi;
+  wavefront_compute_thread_limits(thread_id,num_threads,task->lo,task->hi,&t_lo,&t_hi);
+  if (task->wf_aligner->wf_components.bt_piggyback) {
+    wavefront_compute_linear_idm_piggyback(task->wf_aligner,task->wavefront_set,t_lo,t_hi);
+  } else {
+    wavefront_compute_linear_idm(task->wf_aligner,task->wavefront_set,t_lo,t_hi);
+  }
+}
+#endif
 void wavefront_compute_linear_dispatcher(
     wavefront_aligner_t* const wf_aligner,
     wavefront_set_t* const wavefront_set,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
   // Parameters
   const bool bt_piggyback = wf_aligner->wf_components.bt_piggyback;
-  const int num_threads = wavefront_compute_num_threads(wf_aligner,lo,hi);
+  const int num_threads = wavefront_compute_num_threads(wf_aligner,wf_parallel_compute,lo,hi);
   // Multithreading dispatcher
   if (num_threads == 1) {
     // Compute next wavefront
@@ -145,20 +169,13 @@ void wavefront_compute_linear_dispatcher(
   } else {
 #ifdef WFA_PARALLEL
     // Compute next wavefront in parallel
-    #pragma omp parallel num_threads(num_threads)
-    {
-      int t_lo, t_hi;
-      const int thread_id = omp_get_thread_num();
-      const int thread_num = omp_get_num_threads();
-      wavefront_compute_thread_limits(thread_id,thread_num,lo,hi,&t_lo,&t_hi);
-      if (bt_piggyback) {
-        wavefront_compute_linear_idm_piggyback(wf_aligner,wavefront_set,t_lo,t_hi);
-      } else {
-        wavefront_compute_linear_idm(wf_aligner,wavefront_set,t_lo,t_hi);
-      }
-    }
+    wavefront_compute_task_t task = {
+        .wf_aligner = wf_aligner, .wavefront_set = wavefront_set, .lo = lo, .hi = hi };
+    thread_team_run(wf_aligner->thread_team,num_threads,wavefront_compute_linear_thread,&task);
 #endif
   }
+  // Auto-tuning
+  wavefront_compute_parallel_sample(wf_aligner);
 }
 void wavefront_compute_linear(
     wavefront_aligner_t* const wf_aligner,
@@ -175,7 +192,7 @@ void wavefront_compute_linear(
   }
   wf_aligner->align_status.num_null_steps = 0;
   // Set limits
-  int hi, lo;
+  wf_coord_t hi, lo;
   wavefront_compute_limits_input(wf_aligner,&wavefront_set,&lo,&hi);
   // Allocate wavefronts
   wavefront_compute_allocate_output(wf_aligner,&wavefront_set,score,lo,hi);
@@ -42,20 +42,20 @@ bool wavefront_check_alignment(
     wavefront_aligner_t* const wf_aligner) {
   // Parameters
   const char* const pattern = wf_aligner->pattern;
-  const int pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
   const char* const text = wf_aligner->text;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   // Custom function to compare sequences
   alignment_match_funct_t match_funct = wf_aligner->match_funct;
   void* match_funct_arguments = wf_aligner->match_funct_arguments;
   // CIGAR
   cigar_t* const cigar = wf_aligner->cigar;
   char* const operations = cigar->operations;
-  const int begin_offset = cigar->begin_offset;
-  const int end_offset = cigar->end_offset;
+  const wf_coord_t begin_offset = cigar->begin_offset;
+  const wf_coord_t end_offset = cigar->end_offset;
   // Traverse CIGAR
   bool alignment_correct = true;
-  int pattern_pos=0, text_pos=0, i;
+  wf_coord_t pattern_pos=0, text_pos=0, i;
   for (i=begin_offset;i<end_offset;++i) {
     switch (operations[i]) {
       case 'M': {
@@ -64,7 +64,7 @@ bool wavefront_check_alignment(
             match_funct(pattern_pos,text_pos,match_funct_arguments) :
             pattern[pattern_pos] == text[text_pos];
         if (!is_match) {
-          fprintf(stream,"[WFA::Check] Alignment not matching (pattern[%d]=%c != text[%d]=%c)\n",
+          fprintf(stream,"[WFA::Check] Alignment not matching (pattern[%"PRIcoord"]=%c != text[%"PRIcoord"]=%c)\n",
               pattern_pos,pattern[pattern_pos],text_pos,text[text_pos]);
           alignment_correct = false;
           break;
@@ -79,7 +79,7 @@ bool wavefront_check_alignment(
             match_funct(pattern_pos,text_pos,match_funct_arguments) :
             pattern[pattern_pos] == text[text_pos];
         if (is_match) {
-          fprintf(stream,"[WFA::Check] Alignment not mismatching (pattern[%d]=%c == text[%d]=%c)\n",
+          fprintf(stream,"[WFA::Check] Alignment not mismatching (pattern[%"PRIcoord"]=%c == text[%"PRIcoord"]=%c)\n",
               pattern_pos,pattern[pattern_pos],text_pos,text[text_pos]);
           alignment_correct = false;
           break;
@@ -103,13 +103,13 @@ bool wavefront_check_alignment(
   // Check alignment length
   if (pattern_pos != pattern_length) {
     fprintf(stream,
-        "[WFA::Check] Alignment incorrect length (pattern-aligned=%d,pattern-length=%d)\n",
+        "[WFA::Check] Alignment incorrect length (pattern-aligned=%"PRIcoord",pattern-length=%"PRIcoord")\n",
         pattern_pos,pattern_length);
     alignment_correct = false;
   }
   if (text_pos != text_length) {
     fprintf(stream,
-        "[WFA::Check] Alignment incorrect length (text-aligned=%d,text-length=%d)\n",
+        "[WFA::Check] Alignment incorrect length (text-aligned=%"PRIcoord",text-length=%"PRIcoord")\n",
         text_pos,text_length);
     alignment_correct = false;
   }
@@ -124,9 +124,9 @@ void wavefront_report_lite(
     wavefront_aligner_t* const wf_aligner) {
   // Parameters
   const char* const pattern = wf_aligner->pattern;
-  const int pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
   const char* const text = wf_aligner->text;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   const int status = wf_aligner->align_status.status;
   const uint64_t memory_used = wf_aligner->align_status.memory_used;
   // Banner
@@ -136,7 +136,7 @@ void wavefront_report_lite(
       wf_aligner,wf_aligner->pattern_length,
       wf_aligner->text_length,wf_aligner->cigar->score);
   fprintf(stream,"\t%d",score);
-  fprintf(stream,"\t%d\t%d",pattern_length,text_length);
+  fprintf(stream,"\t%"PRIcoord"\t%"PRIcoord,pattern_length,text_length);
   fprintf(stream,"\t%s",(status==0) ? "OK" : "FAIL");
   fprintf(stream,"\t%2.3f",TIMER_GET_TOTAL_MS(&wf_aligner->system.timer));
   fprintf(stream,"\t%luMB\t",CONVERT_B_TO_MB(memory_used));
@@ -151,7 +151,7 @@ void wavefront_report_lite(
   if (wf_aligner->match_funct != NULL) {
     fprintf(stream,"\t-\t-");
   } else {
-    fprintf(stream,"\t%.*s\t%.*s",pattern_length,pattern,text_length,text);
+    fprintf(stream,"\t%.*s\t%.*s",(int)pattern_length,pattern,(int)text_length,text);
   }
   fprintf(stream,"\n");
 }
@@ -159,19 +159,19 @@ void wavefront_report_verbose_begin(
     FILE* const stream,
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length) {
+    const wf_coord_t text_length) {
   // Input sequences
   fprintf(stream,"[WFA::Report::Begin] [");
   wavefront_aligner_print_type(stream,wf_aligner);
   fprintf(stream,"]-Alignment (obj=%p)\n",wf_aligner);
   if (wf_aligner->match_funct != NULL) {
-    fprintf(stream,"[WFA::Report]\tPattern\t%d\tcustom-funct()\n",pattern_length);
-    fprintf(stream,"[WFA::Report]\tText\t%d\tcustom-funct()\n",text_length);
+    fprintf(stream,"[WFA::Report]\tPattern\t%"PRIcoord"\tcustom-funct()\n",pattern_length);
+    fprintf(stream,"[WFA::Report]\tText\t%"PRIcoord"\tcustom-funct()\n",text_length);
   } else {
-    fprintf(stream,"[WFA::Report]\tPattern\t%d\t%.*s\n",pattern_length,pattern_length,pattern);
-    fprintf(stream,"[WFA::Report]\tText\t%d\t%.*s\n",text_length,text_length,text);
+    fprintf(stream,"[WFA::Report]\tPattern\t%"PRIcoord"\t%.*s\n",pattern_length,(int)pattern_length,pattern);
+    fprintf(stream,"[WFA::Report]\tText\t%"PRIcoord"\t%.*s\n",text_length,(int)text_length,text);
   }
   // Alignment scope/form
   fprintf(stream,"[WFA::Report]\tScope=");
@@ -200,7 +200,7 @@ void wavefront_report_verbose_end(
   timer_print_total(stream,&wf_aligner->system.timer);
   fprintf(stream," Memory.used=%luMB",
       CONVERT_B_TO_MB(wf_aligner->align_status.memory_used));
-  fprintf(stream," WFA.components=(wfs=%d,maxlo=%d,maxhi=%d)",
+  fprintf(stream," WFA.components=(wfs=%d,maxlo=%"PRIcoord",maxhi=%"PRIcoord")",
       wf_aligner->wf_components.num_wavefronts,
       wf_aligner->wf_components.historic_min_lo,
       wf_aligner->wf_components.historic_max_hi);
@@ -218,9 +218,9 @@ void wavefront_report_verbose_end(
 void wavefront_debug_prologue(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length) {
+    const wf_coord_t text_length) {
   // Check verbose level
   if (wf_aligner->system.verbose >= 1) {
     timer_start(&wf_aligner->system.timer);
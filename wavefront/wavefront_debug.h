@@ -40,9 +40,9 @@
 void wavefront_debug_prologue(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length);
+    const wf_coord_t text_length);
 void wavefront_debug_epilogue(
     wavefront_aligner_t* const wf_aligner);
 
@@ -61,15 +61,16 @@ void wavefront_display_compute_limits(
     wavefront_aligner_t* const wf_aligner,
     const int score_begin,
     const int score_end,
-    int* const out_max_k,
-    int* const out_min_k) {
+    wf_coord_t* const out_max_k,
+    wf_coord_t* const out_min_k) {
   // Parameters
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
   // Compute min/max k
-  int i, max_k=INT_MIN, min_k=INT_MAX;
+  wf_coord_t max_k=WF_COORD_MIN, min_k=WF_COORD_MAX;
+  int i;
   for (i=score_begin;i<=score_end;++i) {
-    const int s = (wf_components->memory_modular) ? i%wf_components->max_score_scope : i;
+    const int s = (wf_components->memory_modular) ? i&wf_components->wavefront_mask : i;
     wavefront_t* const mwavefront = wf_components->mwavefronts[s];
     if (mwavefront != NULL) {
       max_k = MAX(max_k,mwavefront->hi);
@@ -109,7 +110,7 @@ void wavefront_display_print_element(
     FILE* const stream,
     wavefront_aligner_t* const wf_aligner,
     wavefront_t* const wavefront,
-    const int k,
+    const wf_coord_t k,
     const int bt_length) {
   // Check limits
   if (wavefront!=NULL && wavefront->lo <= k && k <= wavefront->hi) {
@@ -119,7 +120,8 @@ void wavefront_display_print_element(
       // Print pcigar
       if (bt_length > 0) {
         char cigar_buffer[32];
-        const int pcigar_length = pcigar_unpack(wavefront->bt_pcigar[k],cigar_buffer);
+        const int pcigar_length = pcigar_unpack(
+            PCIGAR_GET(wavefront->bt_pcigar,k,wavefront->bt_pcigar_64bits),cigar_buffer);
         const int effective_pcigar_length = MIN(bt_length,pcigar_length);
         fprintf(stream,"%.*s",effective_pcigar_length,cigar_buffer);
         PRINT_CHAR_REP(stream,' ',bt_length-effective_pcigar_length);
@@ -204,7 +206,7 @@ void wavefront_display_print_header(
   PRINT_CHAR_REP(stream,' ',WF_DISPLAY_YLABEL_LENGTH); // Align [k=   ]
   int score;
   for (score=score_begin;score<=score_end;++score) {
-    const int s = (wf_components->memory_modular) ? score%wf_components->max_score_scope : score;
+    const int s = (wf_components->memory_modular) ? score&wf_components->wavefront_mask : score;
     fprintf(stream,"|");
     wavefront_display_print_header_component(stream,wf_components->mwavefronts[s]," M",bt_length);
     if (distance_metric <= gap_linear) continue;
@@ -232,18 +234,18 @@ void wavefront_aligner_print_block(
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
   if (!wf_components->bt_piggyback) bt_length = 0; // Check BT
   // Compute dinmensions
-  int max_k, min_k;
+  wf_coord_t max_k, min_k;
   wavefront_display_compute_limits(wf_aligner,score_begin,score_end,&max_k,&min_k);
   // Header
   wavefront_display_print_header(stream,wf_aligner,score_begin,score_end,bt_length);
   // Traverse all diagonals
-  int k;
+  wf_coord_t k;
   for (k=max_k;k>=min_k;k--) {
-    fprintf(stream,"[k=%3d] ",k);
+    fprintf(stream,"[k=%3"PRIcoord"] ",k);
     // Traverse all scores
     int i;
     for (i=score_begin;i<=score_end;++i) {
-      const int s = (wf_components->memory_modular) ? i%wf_components->max_score_scope : i;
+      const int s = (wf_components->memory_modular) ? i&wf_components->wavefront_mask : i;
       fprintf(stream,"|");
       // Fetch wavefront
       wavefront_t* const mwavefront = wf_components->mwavefronts[s];
@@ -35,10 +35,6 @@
 #include "wavefront_compute.h"
 #include "wavefront_heuristic.h"
 
-#ifdef WFA_PARALLEL
-#include <omp.h>
-#endif
-
 /*
  * Termination (detect end of alignment)
  */
@@ -48,10 +44,10 @@ bool wavefront_extend_end2end_check_termination(
     const int score,
     const int score_mod) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   const affine2p_matrix_type component_end = wf_aligner->component_end;
-  const int alignment_k = DPMATRIX_DIAGONAL(text_length,pattern_length);
+  const wf_coord_t alignment_k = DPMATRIX_DIAGONAL(text_length,pattern_length);
   const wf_offset_t alignment_offset = DPMATRIX_OFFSET(text_length,pattern_length);
   // Select end component
   switch (component_end) {
@@ -123,18 +119,18 @@ bool wavefront_extend_endsfree_check_termination(
     wavefront_aligner_t* const wf_aligner,
     wavefront_t* const mwavefront,
     const int score,
-    const int k,
+    const wf_coord_t k,
     const wf_offset_t offset) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   // Check ends-free reaching boundaries
-  const int h_pos = WAVEFRONT_H(k,offset);
-  const int v_pos = WAVEFRONT_V(k,offset);
+  const wf_coord_t h_pos = WAVEFRONT_H(k,offset);
+  const wf_coord_t v_pos = WAVEFRONT_V(k,offset);
   if (h_pos >= text_length) { // Text is aligned
     // Is Pattern end-free?
-    const int pattern_left = pattern_length - v_pos;
-    const int pattern_end_free = wf_aligner->alignment_form.pattern_end_free;
+    const wf_coord_t pattern_left = pattern_length - v_pos;
+    const wf_coord_t pattern_end_free = wf_aligner->alignment_form.pattern_end_free;
     if (pattern_left <= pattern_end_free) {
       #ifdef WFA_PARALLEL
       #pragma omp critical
@@ -149,8 +145,8 @@ bool wavefront_extend_endsfree_check_termination(
   }
   if (v_pos >= pattern_length) { // Pattern is aligned
     // Is text end-free?
-    const int text_left = text_length - h_pos;
-    const int text_end_free = wf_aligner->alignment_form.text_end_free;
+    const wf_coord_t text_left = text_length - h_pos;
+    const wf_coord_t text_end_free = wf_aligner->alignment_form.text_end_free;
     if (text_left <= text_end_free) {
       #ifdef WFA_PARALLEL
       #pragma omp critical
@@ -169,9 +165,36 @@ bool wavefront_extend_endsfree_check_termination(
 /*
  * Extend kernel
  */
+FORCE_INLINE wf_offset_t wavefront_extend_matches_packed_kernel_reverse(
+    wavefront_aligner_t* const wf_aligner,
+    const wf_coord_t k,
+    wf_offset_t offset) {
+  // Fetch pattern/text blocks (ending at the next character to compare)
+  uint64_t* pattern_blocks = (uint64_t*)
+      (wf_aligner->pattern+wf_aligner->pattern_length-WAVEFRONT_V(k,offset)-8);
+  uint64_t* text_blocks = (uint64_t*)
+      (wf_aligner->text+wf_aligner->text_length-WAVEFRONT_H(k,offset)-8);
+  // Compare 64-bits blocks
+  uint64_t cmp = *pattern_blocks ^ *text_blocks;
+  while (__builtin_expect(cmp==0,0)) {
+    // Increment offset (full block)
+    offset += 8;
+    // Previous blocks
+    --pattern_blocks;
+    --text_blocks;
+    // Compare
+    cmp = *pattern_blocks ^ *text_blocks;
+  }
+  // Count equal characters (read backwards, from the most significant byte)
+  const int equal_left_bits = __builtin_clzl(cmp);
+  const int equal_chars = DIV_FLOOR(equal_left_bits,8);
+  offset += equal_chars;
+  // Return extended offset
+  return offset;
+}
 FORCE_INLINE wf_offset_t wavefront_extend_matches_packed_kernel(
     wavefront_aligner_t* const wf_aligner,
-    const int k,
+    const wf_coord_t k,
     wf_offset_t offset) {
   // Fetch pattern/text blocks
   uint64_t* pattern_blocks = (uint64_t*)(wf_aligner->pattern+WAVEFRONT_V(k,offset));
@@ -203,32 +226,38 @@ FORCE_INLINE wf_offset_t wavefront_extend_matches_packed_kernel(
 FORCE_NO_INLINE void wavefront_extend_matches_packed_end2end(
     wavefront_aligner_t* const wf_aligner,
     wavefront_t* const mwavefront,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
+  const bool reverse = wf_aligner->sequences_reverse;
   wf_offset_t* const offsets = mwavefront->offsets;
-  int k;
+  wf_coord_t k;
   for (k=lo;k<=hi;++k) {
     // Fetch offset
     const wf_offset_t offset = offsets[k];
     if (offset == WAVEFRONT_OFFSET_NULL) continue;
     // Extend offset
-    offsets[k] = wavefront_extend_matches_packed_kernel(wf_aligner,k,offset);
+    offsets[k] = (reverse) ?
+        wavefront_extend_matches_packed_kernel_reverse(wf_aligner,k,offset) :
+        wavefront_extend_matches_packed_kernel(wf_aligner,k,offset);
   }
 }
 FORCE_NO_INLINE wf_offset_t wavefront_extend_matches_packed_max(
     wavefront_aligner_t* const wf_aligner,
     wavefront_t* const mwavefront,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
+  const bool reverse = wf_aligner->sequences_reverse;
   wf_offset_t* const offsets = mwavefront->offsets;
   wf_offset_t max_antidiag = 0;
-  int k;
+  wf_coord_t k;
   for (k=lo;k<=hi;++k) {
     // Fetch offset
     const wf_offset_t offset = offsets[k];
     if (offset == WAVEFRONT_OFFSET_NULL) continue;
     // Extend offset
-    offsets[k] = wavefront_extend_matches_packed_kernel(wf_aligner,k,offset);
+    offsets[k] = (reverse) ?
+        wavefront_extend_matches_packed_kernel_reverse(wf_aligner,k,offset) :
+        wavefront_extend_matches_packed_kernel(wf_aligner,k,offset);
     // Compute max
     const wf_offset_t antidiag = WAVEFRONT_ANTIDIAGONAL(k,offsets[k]);
     if (max_antidiag < antidiag) max_antidiag = antidiag;
@@ -239,16 +268,19 @@ FORCE_NO_INLINE bool wavefront_extend_matches_packed_endsfree(
     wavefront_aligner_t* const wf_aligner,
     wavefront_t* const mwavefront,
     const int score,
-    const int lo,
-    const int hi) {
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
+  const bool reverse = wf_aligner->sequences_reverse;
   wf_offset_t* const offsets = mwavefront->offsets;
-  int k;
+  wf_coord_t k;
   for (k=lo;k<=hi;++k) {
     // Fetch offset
     wf_offset_t offset = offsets[k];
     if (offset == WAVEFRONT_OFFSET_NULL) continue;
     // Extend offset
-    offset = wavefront_extend_matches_packed_kernel(wf_aligner,k,offset);
+    offset = (reverse) ?
+        wavefront_extend_matches_packed_kernel_reverse(wf_aligner,k,offset) :
+        wavefront_extend_matches_packed_kernel(wf_aligner,k,offset);
     offsets[k] = offset;
     // Check ends-free reaching boundaries
     if (wavefront_extend_endsfree_check_termination(wf_aligner,mwavefront,score,k,offset)) {
@@ -262,22 +294,22 @@ bool wavefront_extend_matches_custom(
     wavefront_aligner_t* const wf_aligner,
     wavefront_t* const mwavefront,
     const int score,
-    const int lo,
-    const int hi,
+    const wf_coord_t lo,
+    const wf_coord_t hi,
     const bool endsfree) {
   // Parameters (custom matching function)
   alignment_match_funct_t match_funct = wf_aligner->match_funct;
   void* const func_arguments = wf_aligner->match_funct_arguments;
   // Extend diagonally each wavefront point
   wf_offset_t* const offsets = mwavefront->offsets;
-  int k;
+  wf_coord_t k;
   for (k=lo;k<=hi;++k) {
     // Check offset
     wf_offset_t offset = offsets[k];
     if (offset == WAVEFRONT_OFFSET_NULL) continue;
     // Count equal characters
-    int v = WAVEFRONT_V(k,offset);
-    int h = WAVEFRONT_H(k,offset);
+    wf_coord_t v = WAVEFRONT_V(k,offset);
+    wf_coord_t h = WAVEFRONT_H(k,offset);
     while (match_funct(v,h,func_arguments)) {
       h++; v++; offset++;
     }
@@ -291,17 +323,78 @@ bool wavefront_extend_matches_custom(
   // Alignment not finished
   return false;
 }
+/*
+ * Extend tasks (per thread)
+ */
+#ifdef WFA_PARALLEL
+void wavefront_extend_max_thread(
+    void* const args,
+    const int thread_id,
+    const int num_threads) {
+  wavefront_compute_task_t* const task = args;
+  wf_offset_t max_antidiag = 0;
+  wf_coord_t t_lo, t_hi;
+  int chunk_idx = 0;
+  while (wavefront_compute_thread_chunk(task,thread_id,num_threads,&chunk_idx,&t_lo,&t_hi)) {
+    const wf_offset_t chunk_max_antidiag =
+        wavefront_extend_matches_packed_max(task->wf_aligner,task->wavefront,t_lo,t_hi);
+    max_antidiag = MAX(max_antidiag,chunk_max_antidiag);
+  }
+  task->max_antidiags[thread_id] = max_antidiag;
+}
+void wavefront_extend_end2end_thread(
+    void* const args,
+    const int thread_id,
+    const int num_threads) {
+  wavefront_compute_task_t* const task = args;
+  wf_coord_t t_lo, t_hi;
+  int chunk_idx = 0;
+  while (wavefront_compute_thread_chunk(task,thread_id,num_threads,&chunk_idx,&t_lo,&t_hi)) {
+    wavefront_extend_matches_packed_end2end(task->wf_aligner,task->wavefront,t_lo,t_hi);
+  }
+}
+void wavefront_extend_endsfree_thread(
+    void* const args,
+    const int thread_id,
+    const int num_threads) {
+  wavefront_compute_task_t* const task = args;
+  wf_coord_t t_lo, t_hi;
+  int chunk_idx = 0;
+  while (wavefront_compute_thread_chunk(task,thread_id,num_threads,&chunk_idx,&t_lo,&t_hi)) {
+    if (wavefront_extend_matches_packed_endsfree(
+        task->wf_aligner,task->wavefront,task->score,t_lo,t_hi)) {
+      task->end_reached = true;
+      break;
+    }
+  }
+}
+void wavefront_extend_custom_thread(
+    void* const args,
+    const int thread_id,
+    const int num_threads) {
+  wavefront_compute_task_t* const task = args;
+  wf_coord_t t_lo, t_hi;
+  int chunk_idx = 0;
+  while (wavefront_compute_thread_chunk(task,thread_id,num_threads,&chunk_idx,&t_lo,&t_hi)) {
+    if (wavefront_extend_matches_custom(
+        task->wf_aligner,task->wavefront,task->score,t_lo,t_hi,task->endsfree)) {
+      task->end_reached = true;
+      break;
+    }
+  }
+}
+#endif
 /*
  * Wavefront exact "extension"
  */
 int wavefront_extend_end2end_max(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    int* const max_antidiagonal) {
+    wf_coord_t* const max_antidiagonal) {
   // Compute score
   const bool memory_modular = wf_aligner->wf_components.memory_modular;
-  const int max_score_scope = wf_aligner->wf_components.max_score_scope;
-  const int score_mod = (memory_modular) ? score % max_score_scope : score;
+  const int wavefront_mask = wf_aligner->wf_components.wavefront_mask;
+  const int score_mod = (memory_modular) ? score & wavefront_mask : score;
   *max_antidiagonal = 0; // Init
   // Fetch m-wavefront
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score_mod];
@@ -315,31 +408,28 @@ int wavefront_extend_end2end_max(
     return 0; // Not done
   }
   // Multithreading dispatcher
-  const int lo = mwavefront->lo;
-  const int hi = mwavefront->hi;
+  const wf_coord_t lo = mwavefront->lo;
+  const wf_coord_t hi = mwavefront->hi;
   wf_offset_t max_antidiag = 0;
-  const int num_threads = wavefront_compute_num_threads(wf_aligner,lo,hi);
+  const int num_threads = wavefront_compute_num_threads(wf_aligner,wf_parallel_extend,lo,hi);
   if (num_threads == 1) {
     // Extend wavefront
     max_antidiag = wavefront_extend_matches_packed_max(wf_aligner,mwavefront,lo,hi);
   } else {
 #ifdef WFA_PARALLEL
     // Extend wavefront in parallel
-    #pragma omp parallel num_threads(num_threads)
-    {
-      int t_lo, t_hi;
-      wavefront_compute_thread_limits(
-          omp_get_thread_num(),omp_get_num_threads(),lo,hi,&t_lo,&t_hi);
-      wf_offset_t t_max_antidiag = wavefront_extend_matches_packed_max(wf_aligner,mwavefront,t_lo,t_hi);
-      #ifdef WFA_PARALLEL
-      #pragma omp critical
-      #endif
-      {
-        if (t_max_antidiag > max_antidiag) max_antidiag = t_max_antidiag;
-      }
-    }
+    wf_offset_t max_antidiags[num_threads];
+    wavefront_compute_task_t task = {
+        .wf_aligner = wf_aligner, .wavefront = mwavefront,
+        .lo = lo, .hi = hi, .max_antidiags = max_antidiags };
+    wavefront_compute_task_chunking(&task,num_threads);
+    thread_team_run(wf_aligner->thread_team,num_threads,wavefront_extend_max_thread,&task);
+    int i;
+    for (i=0;i<num_threads;++i) max_antidiag = MAX(max_antidiag,max_antidiags[i]);
 #endif
   }
+  // Auto-tuning
+  wavefront_compute_parallel_sample(wf_aligner);
   // Check end-to-end finished
   const bool end_reached = wavefront_extend_end2end_check_termination(wf_aligner,mwavefront,score,score_mod);
   if (end_reached) {
@@ -359,8 +449,8 @@ int wavefront_extend_end2end(
     const int score) {
   // Compute score
   const bool memory_modular = wf_aligner->wf_components.memory_modular;
-  const int max_score_scope = wf_aligner->wf_components.max_score_scope;
-  const int score_mod = (memory_modular) ? score % max_score_scope : score;
+  const int wavefront_mask = wf_aligner->wf_components.wavefront_mask;
+  const int score_mod = (memory_modular) ? score & wavefront_mask : score;
   // Fetch m-wavefront
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score_mod];
   if (mwavefront == NULL) {
@@ -373,25 +463,24 @@ int wavefront_extend_end2end(
     return 0; // Not done
   }
   // Multithreading dispatcher
-  const int lo = mwavefront->lo;
-  const int hi = mwavefront->hi;
+  const wf_coord_t lo = mwavefront->lo;
+  const wf_coord_t hi = mwavefront->hi;
   bool end_reached = false;
-  const int num_threads = wavefront_compute_num_threads(wf_aligner,lo,hi);
+  const int num_threads = wavefront_compute_num_threads(wf_aligner,wf_parallel_extend,lo,hi);
   if (num_threads == 1) {
     // Extend wavefront
     wavefront_extend_matches_packed_end2end(wf_aligner,mwavefront,lo,hi);
   } else {
 #ifdef WFA_PARALLEL
     // Extend wavefront in parallel
-    #pragma omp parallel num_threads(num_threads)
-    {
-      int t_lo, t_hi;
-      wavefront_compute_thread_limits(
-          omp_get_thread_num(),omp_get_num_threads(),lo,hi,&t_lo,&t_hi);
-      wavefront_extend_matches_packed_end2end(wf_aligner,mwavefront,t_lo,t_hi);
-    }
+    wavefront_compute_task_t task = {
+        .wf_aligner = wf_aligner, .wavefront = mwavefront, .lo = lo, .hi = hi };
+    wavefront_compute_task_chunking(&task,num_threads);
+    thread_team_run(wf_aligner->thread_team,num_threads,wavefront_extend_end2end_thread,&task);
 #endif
   }
+  // Auto-tuning
+  wavefront_compute_parallel_sample(wf_aligner);
   // Check end-to-end finished
   end_reached = wavefront_extend_end2end_check_termination(wf_aligner,mwavefront,score,score_mod);
   if (end_reached) {
@@ -410,8 +499,8 @@ int wavefront_extend_endsfree(
     const int score) {
   // Modular wavefront
   const bool memory_modular = wf_aligner->wf_components.memory_modular;
-  const int max_score_scope = wf_aligner->wf_components.max_score_scope;
-  const int score_mod = (memory_modular) ? score % max_score_scope : score;
+  const int wavefront_mask = wf_aligner->wf_components.wavefront_mask;
+  const int score_mod = (memory_modular) ? score & wavefront_mask : score;
   // Fetch m-wavefront
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score_mod];
   if (mwavefront == NULL) {
@@ -424,27 +513,26 @@ int wavefront_extend_endsfree(
     return 0; // Not done
   }
   // Multithreading dispatcher
-  const int lo = mwavefront->lo;
-  const int hi = mwavefront->hi;
+  const wf_coord_t lo = mwavefront->lo;
+  const wf_coord_t hi = mwavefront->hi;
   bool end_reached = false;
-  const int num_threads = wavefront_compute_num_threads(wf_aligner,lo,hi);
+  const int num_threads = wavefront_compute_num_threads(wf_aligner,wf_parallel_extend,lo,hi);
   if (num_threads == 1) {
     // Extend wavefront
     end_reached = wavefront_extend_matches_packed_endsfree(wf_aligner,mwavefront,score,lo,hi);
   } else {
 #ifdef WFA_PARALLEL
     // Extend wavefront in parallel
-    #pragma omp parallel num_threads(num_threads)
-    {
-      int t_lo, t_hi;
-      wavefront_compute_thread_limits(
-          omp_get_thread_num(),omp_get_num_threads(),lo,hi,&t_lo,&t_hi);
-      if (wavefront_extend_matches_packed_endsfree(wf_aligner,mwavefront,score,t_lo,t_hi)) {
-        end_reached = true;
-      }
-    }
+    wavefront_compute_task_t task = {
+        .wf_aligner = wf_aligner, .wavefront = mwavefront,
+        .score = score, .lo = lo, .hi = hi, .end_reached = false };
+    wavefront_compute_task_chunking(&task,num_threads);
+    thread_team_run(wf_aligner->thread_team,num_threads,wavefront_extend_endsfree_thread,&task);
+    end_reached = task.end_reached;
 #endif
   }
+  // Auto-tuning
+  wavefront_compute_parallel_sample(wf_aligner);
   if (end_reached) {
     wf_aligner->align_status.status = WF_STATUS_END_REACHED;
     wf_aligner->align_status.score = score;
@@ -461,8 +549,8 @@ int wavefront_extend_custom(
     const int score) {
   // Compute score
   const bool memory_modular = wf_aligner->wf_components.memory_modular;
-  const int max_score_scope = wf_aligner->wf_components.max_score_scope;
-  const int score_mod = (memory_modular) ? score % max_score_scope : score;
+  const int wavefront_mask = wf_aligner->wf_components.wavefront_mask;
+  const int score_mod = (memory_modular) ? score & wavefront_mask : score;
   // Fetch m-wavefront
   wavefront_t* const mwavefront = wf_aligner->wf_components.mwavefronts[score_mod];
   if (mwavefront == NULL) {
@@ -476,27 +564,26 @@ int wavefront_extend_custom(
   }
   // Multithreading dispatcher
   const bool endsfree = (wf_aligner->alignment_form.span == alignment_endsfree);
-  const int lo = mwavefront->lo;
-  const int hi = mwavefront->hi;
+  const wf_coord_t lo = mwavefront->lo;
+  const wf_coord_t hi = mwavefront->hi;
   bool end_reached = false;
-  const int num_threads = wavefront_compute_num_threads(wf_aligner,lo,hi);
+  const int num_threads = wavefront_compute_num_threads(wf_aligner,wf_parallel_extend,lo,hi);
   if (num_threads == 1) {
     // Extend wavefront
     end_reached = wavefront_extend_matches_custom(wf_aligner,mwavefront,score,lo,hi,endsfree);
   } else {
 #ifdef WFA_PARALLEL
     // Extend wavefront in parallel
-    #pragma omp parallel num_threads(num_threads)
-    {
-      int t_lo, t_hi;
-      wavefront_compute_thread_limits(
-          omp_get_thread_num(),omp_get_num_threads(),lo,hi,&t_lo,&t_hi);
-      if (wavefront_extend_matches_custom(wf_aligner,mwavefront,score,t_lo,t_hi,endsfree)) {
-        end_reached = true;
-      }
-    }
+    wavefront_compute_task_t task = {
+        .wf_aligner = wf_aligner, .wavefront = mwavefront,
+        .score = score, .lo = lo, .hi = hi, .endsfree = endsfree, .end_reached = false };
+    wavefront_compute_task_chunking(&task,num_threads);
+    thread_team_run(wf_aligner->thread_team,num_threads,wavefront_extend_custom_thread,&task);
+    end_reached = task.end_reached;
 #endif
   }
+  // Auto-tuning
+  wavefront_compute_parallel_sample(wf_aligner);
   // Check end-to-end finished
   if (!endsfree) {
     end_reached = wavefront_extend_end2end_check_termination(wf_aligner,mwavefront,score,score_mod);
@@ -43,7 +43,7 @@ int wavefront_extend_end2end(
 int wavefront_extend_end2end_max(
     wavefront_aligner_t* const wf_aligner,
     const int score,
-    int* const max_antidiagonal);
+    wf_coord_t* const max_antidiagonal);
 int wavefront_extend_endsfree(
     wavefront_aligner_t* const wf_aligner,
     const int score);
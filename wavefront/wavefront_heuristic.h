@@ -54,8 +54,8 @@ typedef struct {
   wf_heuristic_strategy strategy;     // Heuristic strategy
   int steps_between_cutoffs;          // Score-steps between heuristic cut-offs
   // Static/Adaptive Banded
-  int min_k;                          // Banded: Minimum k to consider in band
-  int max_k;                          // Banded: Maximum k to consider in band
+  wf_coord_t min_k;                   // Banded: Minimum k to consider in band
+  wf_coord_t max_k;                   // Banded: Maximum k to consider in band
   // WFAdaptive
   int min_wavefront_length;           // Adaptive: Minimum wavefronts length to cut-off
   int max_distance_threshold;         // Adaptive: Maximum distance between offsets allowed
@@ -64,9 +64,9 @@ typedef struct {
   int zdrop;                          // Z-drop parameter
   // Internals
   int steps_wait;                     // Score-steps until next cut-off
-  int max_sw_score;                   // Maximum score observed (for x/z drops)
-  int max_sw_score_offset;            // Offset of the maximum score observed
-  int max_sw_score_k;                 // Diagonal of the maximum score observed
+  wf_coord_t max_sw_score;     // Maximum score observed (for x/z drops)
+  wf_coord_t max_sw_score_offset;     // Offset of the maximum score observed
+  wf_coord_t max_sw_score_k;          // Diagonal of the maximum score observed
 } wavefront_heuristic_t;
 
 /*
@@ -97,12 +97,12 @@ void wavefront_heuristic_set_zdrop(
 
 void wavefront_heuristic_set_banded_static(
     wavefront_heuristic_t* const wf_heuristic,
-    const int band_min_k,
-    const int band_max_k);
+    const wf_coord_t band_min_k,
+    const wf_coord_t band_max_k);
 void wavefront_heuristic_set_banded_adaptive(
     wavefront_heuristic_t* const wf_heuristic,
-    const int band_min_k,
-    const int band_max_k,
+    const wf_coord_t band_min_k,
+    const wf_coord_t band_max_k,
     const int steps_between_cutoffs);
 
 void wavefront_heuristic_clear(
@@ -115,6 +115,11 @@ void wavefront_heuristic_cufoff(
     wavefront_aligner_t* const wf_aligner,
     const int score,
     const int score_mod);
+void wavefront_heuristic_cufoff_replay(
+    wavefront_aligner_t* const wf_aligner,
+    const int score_mod,
+    const wf_coord_t lo,
+    const wf_coord_t hi);
 
 /*
  * Display
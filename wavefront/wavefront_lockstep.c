@@ -0,0 +1,557 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Lockstep WFA (inter-sequence SIMD over batches of short pairs)
+ */
+
+#include "wavefront_lockstep.h"
+#include "wavefront_aligner.h"
+#include "wavefront_compute.h"
+#include "wavefront_backtrace.h"
+#include "wavefront_bialign.h"
+
+/*
+ * Constants
+ */
+#define WF_LOCKSTEP_PADDING 16 // Sentinels to compare 8-chars blocks past the end
+
+/*
+ * Setup
+ */
+wavefront_lockstep_t* wavefront_lockstep_new(
+    wavefront_penalties_t* const penalties) {
+  // Allocate
+  wavefront_lockstep_t* const wf_lockstep = malloc(sizeof(wavefront_lockstep_t));
+  // Wavefronts
+  wf_lockstep->wavefronts_allocated = 256;
+  wf_lockstep->wavefronts = malloc(wf_lockstep->wavefronts_allocated*sizeof(wf_lockstep_wavefront_t));
+  int l;
+  for (l=0;l<WF_LOCKSTEP_LANES;++l) {
+    wf_lockstep->null_offsets[l] = WAVEFRONT_OFFSET_NULL;
+  }
+  // Penalties
+  wf_lockstep->penalties = *penalties;
+  // MM
+  wf_lockstep->mm_arena = mm_allocator_new_arena(BUFFER_SIZE_1M);
+  // Return
+  return wf_lockstep;
+}
+void wavefront_lockstep_delete(
+    wavefront_lockstep_t* const wf_lockstep) {
+  mm_allocator_delete(wf_lockstep->mm_arena);
+  free(wf_lockstep->wavefronts);
+  free(wf_lockstep);
+}
+/*
+ * Compatibility
+ */
+bool wavefront_lockstep_supported(
+    wavefront_aligner_t* const wf_aligner) {
+  const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
+  return (distance_metric == indel || distance_metric == edit || distance_metric == gap_affine) &&
+         wf_aligner->alignment_form.span == alignment_end2end &&
+         wf_aligner->heuristic.strategy == wf_heuristic_none &&
+         wf_aligner->match_funct == NULL &&
+         wf_aligner->system.max_alignment_score == INT_MAX;
+}
+wf_coord_t wavefront_lockstep_max_length(
+    const wavefront_memory_t memory_mode,
+    const alignment_scope_t alignment_scope) {
+  // BiWFA splits longer pairs at a breakpoint (picks other co-optimal CIGARs than the lanes)
+  if (memory_mode == wavefront_memory_ultralow && alignment_scope == compute_alignment) {
+    return WF_BIALIGN_FALLBACK_MIN_LENGTH;
+  }
+  return WF_LOCKSTEP_MAX_LENGTH;
+}
+/*
+ * Wavefronts
+ */
+wf_lockstep_wavefront_t* wavefront_lockstep_allocate(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int score,
+    const wf_coord_t lo,
+    const wf_coord_t hi) {
+  // Resize wavefronts
+  if (score >= wf_lockstep->wavefronts_allocated) {
+    wf_lockstep->wavefronts_allocated = 2*score;
+    wf_lockstep->wavefronts = realloc(wf_lockstep->wavefronts,
+        wf_lockstep->wavefronts_allocated*sizeof(wf_lockstep_wavefront_t));
+  }
+  wf_lockstep_wavefront_t* const wavefront = wf_lockstep->wavefronts + score;
+  wavefront->lo = lo;
+  wavefront->hi = hi;
+  if (lo > hi) return wavefront; // Null wavefront
+  // Allocate offsets (M; plus I and D for gap-affine)
+  const bool affine = (wf_lockstep->penalties.distance_metric == gap_affine);
+  const uint64_t num_offsets = (uint64_t)WAVEFRONT_LENGTH(lo,hi)*WF_LOCKSTEP_LANES;
+  wf_offset_t* const offsets = mm_allocator_calloc(
+      wf_lockstep->mm_arena,(affine) ? 3*num_offsets : num_offsets,wf_offset_t,false);
+  wavefront->m = offsets - (int64_t)lo*WF_LOCKSTEP_LANES;
+  wavefront->i = (affine) ? wavefront->m + num_offsets : NULL;
+  wavefront->d = (affine) ? wavefront->i + num_offsets : NULL;
+  return wavefront;
+}
+FORCE_INLINE const wf_offset_t* wavefront_lockstep_row(
+    wavefront_lockstep_t* const wf_lockstep,
+    const wf_lockstep_wavefront_t* const wavefront,
+    const wf_offset_t* const offsets,
+    const wf_coord_t k) {
+  if (wavefront == NULL || k < wavefront->lo || k > wavefront->hi) {
+    return wf_lockstep->null_offsets;
+  }
+  return offsets + (int64_t)k*WF_LOCKSTEP_LANES;
+}
+FORCE_INLINE wf_lockstep_wavefront_t* wavefront_lockstep_get(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int score) {
+  if (score < 0) return NULL;
+  wf_lockstep_wavefront_t* const wavefront = wf_lockstep->wavefronts + score;
+  return (wavefront->lo > wavefront->hi) ? NULL : wavefront;
+}
+/*
+ * Trim wavefront ends (diagonals out of bounds in all lanes)
+ */
+FORCE_INLINE bool wavefront_lockstep_row_null(
+    wavefront_lockstep_t* const wf_lockstep,
+    const wf_lockstep_wavefront_t* const wavefront,
+    const wf_coord_t k) {
+  // Parameters
+  const wf_offset_t* const pattern_length = wf_lockstep->pattern_length;
+  const wf_offset_t* const text_length = wf_lockstep->text_length;
+  const int64_t row = (int64_t)k*WF_LOCKSTEP_LANES;
+  // Check boundaries (as wavefront_compute_trim_ends())
+  int l, valid = 0;
+  for (l=0;l<WF_LOCKSTEP_LANES;++l) {
+    const wf_coord_t plen = pattern_length[l], tlen = text_length[l];
+    valid |= (wavefront_compute_bound(wavefront->m[row+l],k,plen,tlen) != WAVEFRONT_OFFSET_NULL);
+    if (wavefront->i == NULL) continue;
+    valid |= (wavefront_compute_bound(wavefront->i[row+l],k,plen,tlen) != WAVEFRONT_OFFSET_NULL);
+    valid |= (wavefront_compute_bound(wavefront->d[row+l],k,plen,tlen) != WAVEFRONT_OFFSET_NULL);
+  }
+  return !valid;
+}
+void wavefront_lockstep_trim_ends(
+    wavefront_lockstep_t* const wf_lockstep,
+    wf_lockstep_wavefront_t* const wavefront) {
+  while (wavefront->lo <= wavefront->hi && wavefront_lockstep_row_null(wf_lockstep,wavefront,wavefront->hi)) {
+    --(wavefront->hi);
+  }
+  while (wavefront->lo <= wavefront->hi && wavefront_lockstep_row_null(wf_lockstep,wavefront,wavefront->lo)) {
+    ++(wavefront->lo);
+  }
+}
+/*
+ * Compute (all lanes)
+ */
+void wavefront_lockstep_compute_edit(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int score) {
+  // Parameters
+  const distance_metric_t distance_metric = wf_lockstep->penalties.distance_metric;
+  const wf_offset_t* const pattern_length = wf_lockstep->pattern_length;
+  const wf_offset_t* const text_length = wf_lockstep->text_length;
+  // Input wavefront
+  wf_lockstep_wavefront_t* const in_prev = wavefront_lockstep_get(wf_lockstep,score-1);
+  // Compute limits (union of all lanes)
+  wf_coord_t lo = INT32_MAX, hi = INT32_MIN;
+  if (in_prev != NULL) { lo = in_prev->lo-1; hi = in_prev->hi+1; }
+  lo = MAX(lo,wf_lockstep->k_min);
+  hi = MIN(hi,wf_lockstep->k_max);
+  wf_lockstep_wavefront_t* const out = wavefront_lockstep_allocate(wf_lockstep,score,lo,hi);
+  // Compute-Next kernel loop (vectorized across lanes)
+  wf_coord_t k;
+  for (k=lo;k<=hi;++k) {
+    // In Offsets
+    const wf_offset_t* const prev_lower = wavefront_lockstep_row(wf_lockstep,in_prev,in_prev->m,k-1);
+    const wf_offset_t* const prev_mid = wavefront_lockstep_row(wf_lockstep,in_prev,in_prev->m,k);
+    const wf_offset_t* const prev_upper = wavefront_lockstep_row(wf_lockstep,in_prev,in_prev->m,k+1);
+    // Out Offsets
+    wf_offset_t* const out_m = out->m + (int64_t)k*WF_LOCKSTEP_LANES;
+    int l;
+    if (distance_metric == indel) {
+      PRAGMA_LOOP_VECTORIZE
+      for (l=0;l<WF_LOCKSTEP_LANES;++l) {
+        out_m[l] = wavefront_compute_indel_diagonal(k,
+            prev_lower[l],prev_upper[l],pattern_length[l],text_length[l]);
+      }
+    } else {
+      PRAGMA_LOOP_VECTORIZE
+      for (l=0;l<WF_LOCKSTEP_LANES;++l) {
+        out_m[l] = wavefront_compute_edit_diagonal(k,
+            prev_lower[l],prev_mid[l],prev_upper[l],pattern_length[l],text_length[l]);
+      }
+    }
+  }
+  // Trim ends
+  wavefront_lockstep_trim_ends(wf_lockstep,out);
+}
+void wavefront_lockstep_compute_affine(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int score) {
+  // Parameters
+  const wavefront_penalties_t* const penalties = &wf_lockstep->penalties;
+  const wf_offset_t* const pattern_length = wf_lockstep->pattern_length;
+  const wf_offset_t* const text_length = wf_lockstep->text_length;
+  // Input wavefronts
+  wf_lockstep_wavefront_t* const in_misms = wavefront_lockstep_get(wf_lockstep,score-penalties->mismatch);
+  wf_lockstep_wavefront_t* const in_open = wavefront_lockstep_get(wf_lockstep,
+      score-penalties->gap_opening1-penalties->gap_extension1);
+  wf_lockstep_wavefront_t* const in_ext = wavefront_lockstep_get(wf_lockstep,score-penalties->gap_extension1);
+  // Compute limits (union of all lanes)
+  wf_coord_t lo = INT32_MAX, hi = INT32_MIN;
+  if (in_misms != NULL) { lo = MIN(lo,in_misms->lo); hi = MAX(hi,in_misms->hi); }
+  if (in_open != NULL) { lo = MIN(lo,in_open->lo-1); hi = MAX(hi,in_open->hi+1); }
+  if (in_ext != NULL) { lo = MIN(lo,in_ext->lo-1); hi = MAX(hi,in_ext->hi+1); }
+  lo = MAX(lo,wf_lockstep->k_min);
+  hi = MIN(hi,wf_lockstep->k_max);
+  wf_lockstep_wavefront_t* const out = wavefront_lockstep_allocate(wf_lockstep,score,lo,hi);
+  // Compute-Next kernel loop (vectorized across lanes)
+  wf_coord_t k;
+  for (k=lo;k<=hi;++k) {
+    // In Offsets
+    const wf_offset_t* const m_misms = (in_misms) ? wavefront_lockstep_row(wf_lockstep,in_misms,in_misms->m,k) : wf_lockstep->null_offsets;
+    const wf_offset_t* const m_open_i = (in_open) ? wavefront_lockstep_row(wf_lockstep,in_open,in_open->m,k-1) : wf_lockstep->null_offsets;
+    const wf_offset_t* const m_open_d = (in_open) ? wavefront_lockstep_row(wf_lockstep,in_open,in_open->m,k+1) : wf_lockstep->null_offsets;
+    const wf_offset_t* const i_ext = (in_ext) ? wavefront_lockstep_row(wf_lockstep,in_ext,in_ext->i,k-1) : wf_lockstep->null_offsets;
+    const wf_offset_t* const d_ext = (in_ext) ? wavefront_lockstep_row(wf_lockstep,in_ext,in_ext->d,k+1) : wf_lockstep->null_offsets;
+    // Out Offsets
+    wf_offset_t* const out_m = out->m + (int64_t)k*WF_LOCKSTEP_LANES;
+    wf_offset_t* const out_i = out->i + (int64_t)k*WF_LOCKSTEP_LANES;
+    wf_offset_t* const out_d = out->d + (int64_t)k*WF_LOCKSTEP_LANES;
+    int l;
+    PRAGMA_LOOP_VECTORIZE
+    for (l=0;l<WF_LOCKSTEP_LANES;++l) {
+      wavefront_compute_affine_diagonal(k,
+          m_misms[l],m_open_i[l],i_ext[l],m_open_d[l],d_ext[l],
+          pattern_length[l],text_length[l],out_m+l,out_i+l,out_d+l);
+    }
+  }
+  // Trim ends
+  wavefront_lockstep_trim_ends(wf_lockstep,out);
+}
+void wavefront_lockstep_compute(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int score) {
+  if (wf_lockstep->penalties.distance_metric == gap_affine) {
+    wavefront_lockstep_compute_affine(wf_lockstep,score);
+  } else {
+    wavefront_lockstep_compute_edit(wf_lockstep,score);
+  }
+}
+/*
+ * Extend & Termination (lanes not aligned yet)
+ */
+FORCE_INLINE wf_offset_t wavefront_lockstep_extend_kernel(
+    const char* const pattern,
+    const char* const text,
+    const wf_coord_t k,
+    wf_offset_t offset) {
+  // Fetch pattern/text blocks
+  uint64_t* pattern_blocks = (uint64_t*)(pattern+WAVEFRONT_V(k,offset));
+  uint64_t* text_blocks = (uint64_t*)(text+WAVEFRONT_H(k,offset));
+  // Compare 64-bits blocks
+  uint64_t cmp = *pattern_blocks ^ *text_blocks;
+  while (__builtin_expect(cmp==0,0)) {
+    offset += 8;
+    ++pattern_blocks;
+    ++text_blocks;
+    cmp = *pattern_blocks ^ *text_blocks;
+  }
+  // Count equal characters
+  const int equal_right_bits = __builtin_ctzl(cmp);
+  offset += DIV_FLOOR(equal_right_bits,8);
+  return offset;
+}
+int wavefront_lockstep_extend(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int score) {
+  // Parameters
+  const int num_lanes = wf_lockstep->num_lanes;
+  const int* const lane_score = wf_lockstep->lane_score;
+  wf_lockstep_wavefront_t* const wavefront = wavefront_lockstep_get(wf_lockstep,score);
+  if (wavefront != NULL) {
+    // Lanes not aligned yet
+    uint32_t pending_mask = 0;
+    int l;
+    for (l=0;l<num_lanes;++l) {
+      if (lane_score[l] < 0) pending_mask |= (1u << l);
+    }
+    // Extend lanes not aligned yet (row by row)
+    wf_coord_t k;
+    for (k=wavefront->lo;k<=wavefront->hi;++k) {
+      wf_offset_t* const offsets = wavefront->m + (int64_t)k*WF_LOCKSTEP_LANES;
+      uint32_t valid_mask = 0;
+      PRAGMA_LOOP_VECTORIZE
+      for (l=0;l<WF_LOCKSTEP_LANES;++l) {
+        valid_mask |= (uint32_t)(offsets[l] != WAVEFRONT_OFFSET_NULL) << l;
+      }
+      valid_mask &= pending_mask;
+      while (valid_mask != 0) {
+        const int lane = __builtin_ctz(valid_mask);
+        valid_mask &= valid_mask - 1;
+        offsets[lane] = wavefront_lockstep_extend_kernel(
+            wf_lockstep->pattern[lane],wf_lockstep->text[lane],k,offsets[lane]);
+      }
+    }
+  }
+  // Check termination
+  int l, lanes_pending = 0;
+  for (l=0;l<num_lanes;++l) {
+    if (lane_score[l] >= 0) continue; // Lane already aligned
+    const wf_coord_t alignment_k = DPMATRIX_DIAGONAL(wf_lockstep->text_length[l],wf_lockstep->pattern_length[l]);
+    if (wavefront == NULL ||
+        alignment_k < wavefront->lo || alignment_k > wavefront->hi ||
+        wavefront->m[(int64_t)alignment_k*WF_LOCKSTEP_LANES+l] < wf_lockstep->text_length[l]) {
+      ++lanes_pending;
+      continue;
+    }
+    wf_lockstep->lane_score[l] = score; // Lane aligned
+  }
+  return lanes_pending;
+}
+/*
+ * Backtrace (one lane)
+ */
+FORCE_INLINE int64_t wavefront_lockstep_bt_offset(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int score,
+    const affine2p_matrix_type component,
+    const wf_coord_t k,
+    const int lane,
+    const wf_offset_t offset_delta,
+    const backtrace_type type) {
+  wf_lockstep_wavefront_t* const wavefront = wavefront_lockstep_get(wf_lockstep,score);
+  if (wavefront == NULL || k < wavefront->lo || k > wavefront->hi) return WAVEFRONT_OFFSET_NULL;
+  wf_offset_t* const offsets =
+      (component == affine2p_matrix_M) ? wavefront->m :
+      (component == affine2p_matrix_I1) ? wavefront->i : wavefront->d;
+  return BACKTRACE_PIGGYBACK_SET(offsets[(int64_t)k*WF_LOCKSTEP_LANES+lane]+offset_delta,type);
+}
+void wavefront_lockstep_backtrace_linear(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int lane,
+    cigar_t* const cigar) {
+  // Parameters (same steps as wavefront_backtrace_linear())
+  const wavefront_penalties_t* const penalties = &wf_lockstep->penalties;
+  const distance_metric_t distance_metric = penalties->distance_metric;
+  const wf_coord_t pattern_length = wf_lockstep->pattern_length[lane];
+  const wf_coord_t text_length = wf_lockstep->text_length[lane];
+  // Compute starting location
+  int score = wf_lockstep->lane_score[lane];
+  wf_coord_t k = DPMATRIX_DIAGONAL(text_length,pattern_length);
+  wf_offset_t offset = DPMATRIX_OFFSET(text_length,pattern_length);
+  wf_coord_t h = WAVEFRONT_H(k,offset);
+  wf_coord_t v = WAVEFRONT_V(k,offset);
+  // Trace the alignment back
+  while (v > 0 && h > 0 && score > 0) {
+    // Compute scores
+    const int mismatch = score - penalties->mismatch;
+    const int gap_open1 = score - penalties->gap_opening1;
+    // Compute source offsets
+    const int64_t misms = (distance_metric != indel) ?
+        wavefront_lockstep_bt_offset(wf_lockstep,mismatch,affine2p_matrix_M,k,lane,1,backtrace_M) :
+        WAVEFRONT_OFFSET_NULL;
+    const int64_t ins = wavefront_lockstep_bt_offset(wf_lockstep,gap_open1,affine2p_matrix_M,k-1,lane,1,backtrace_I1_open);
+    const int64_t del = wavefront_lockstep_bt_offset(wf_lockstep,gap_open1,affine2p_matrix_M,k+1,lane,0,backtrace_D1_open);
+    const int64_t max_all = MAX(misms,MAX(ins,del));
+    // Check source score
+    if (max_all < 0) break; // No source
+    // Traceback Matches
+    const wf_offset_t max_offset = BACKTRACE_PIGGYBACK_GET_OFFSET(max_all);
+    wavefront_backtrace_matches(cigar,offset-max_offset);
+    offset = max_offset;
+    v = WAVEFRONT_V(k,offset);
+    h = WAVEFRONT_H(k,offset);
+    if (v <= 0 || h <= 0) break;
+    // Traceback Operation
+    const backtrace_type backtrace_type = BACKTRACE_PIGGYBACK_GET_TYPE(max_all);
+    score = (backtrace_type == backtrace_M) ? mismatch : gap_open1;
+    wavefront_backtrace_operation(cigar,backtrace_type,&k,&offset);
+    // Update coordinates
+    v = WAVEFRONT_V(k,offset);
+    h = WAVEFRONT_H(k,offset);
+  }
+  // Account for last operations
+  wavefront_backtrace_beginning(cigar,v,h);
+}
+void wavefront_lockstep_backtrace_affine(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int lane,
+    cigar_t* const cigar) {
+  // Parameters (same steps as wavefront_backtrace_affine())
+  const wavefront_penalties_t* const penalties = &wf_lockstep->penalties;
+  const wf_coord_t pattern_length = wf_lockstep->pattern_length[lane];
+  const wf_coord_t text_length = wf_lockstep->text_length[lane];
+  // Compute starting location
+  affine2p_matrix_type matrix_type = affine2p_matrix_M;
+  int score = wf_lockstep->lane_score[lane];
+  wf_coord_t k = DPMATRIX_DIAGONAL(text_length,pattern_length);
+  wf_offset_t offset = DPMATRIX_OFFSET(text_length,pattern_length);
+  wf_coord_t h = WAVEFRONT_H(k,offset);
+  wf_coord_t v = WAVEFRONT_V(k,offset);
+  // Trace the alignment back
+  while (v > 0 && h > 0 && score > 0) {
+    // Compute scores
+    const int mismatch = score - penalties->mismatch;
+    const int gap_open = score - penalties->gap_opening1 - penalties->gap_extension1;
+    const int gap_extend = score - penalties->gap_extension1;
+    // Compute source offsets
+    int64_t max_all;
+    if (matrix_type == affine2p_matrix_M) {
+      const int64_t misms = wavefront_lockstep_bt_offset(wf_lockstep,mismatch,affine2p_matrix_M,k,lane,1,backtrace_M);
+      const int64_t ins_open = wavefront_lockstep_bt_offset(wf_lockstep,gap_open,affine2p_matrix_M,k-1,lane,1,backtrace_I1_open);
+      const int64_t ins_ext = wavefront_lockstep_bt_offset(wf_lockstep,gap_extend,affine2p_matrix_I1,k-1,lane,1,backtrace_I1_ext);
+      const int64_t del_open = wavefront_lockstep_bt_offset(wf_lockstep,gap_open,affine2p_matrix_M,k+1,lane,0,backtrace_D1_open);
+      const int64_t del_ext = wavefront_lockstep_bt_offset(wf_lockstep,gap_extend,affine2p_matrix_D1,k+1,lane,0,backtrace_D1_ext);
+      max_all = MAX(misms,MAX(MAX(ins_open,ins_ext),MAX(del_open,del_ext)));
+    } else if (matrix_type == affine2p_matrix_I1) {
+      const int64_t ins_open = wavefront_lockstep_bt_offset(wf_lockstep,gap_open,affine2p_matrix_M,k-1,lane,1,backtrace_I1_open);
+      const int64_t ins_ext = wavefront_lockstep_bt_offset(wf_lockstep,gap_extend,affine2p_matrix_I1,k-1,lane,1,backtrace_I1_ext);
+      max_all = MAX(ins_open,ins_ext);
+    } else {
+      const int64_t del_open = wavefront_lockstep_bt_offset(wf_lockstep,gap_open,affine2p_matrix_M,k+1,lane,0,backtrace_D1_open);
+      const int64_t del_ext = wavefront_lockstep_bt_offset(wf_lockstep,gap_extend,affine2p_matrix_D1,k+1,lane,0,backtrace_D1_ext);
+      max_all = MAX(del_open,del_ext);
+    }
+    // Check source score
+    if (max_all < 0) break; // No source
+    // Traceback Matches
+    if (matrix_type == affine2p_matrix_M) {
+      const wf_offset_t max_offset = BACKTRACE_PIGGYBACK_GET_OFFSET(max_all);
+      wavefront_backtrace_matches(cigar,offset-max_offset);
+      offset = max_offset;
+      v = WAVEFRONT_V(k,offset);
+      h = WAVEFRONT_H(k,offset);
+      if (v <= 0 || h <= 0) break;
+    }
+    // Traceback Operation
+    const backtrace_type backtrace_type = BACKTRACE_PIGGYBACK_GET_TYPE(max_all);
+    wavefront_backtrace_affine_source(penalties,backtrace_type,&score,&matrix_type);
+    wavefront_backtrace_operation(cigar,backtrace_type,&k,&offset);
+    // Update coordinates
+    v = WAVEFRONT_V(k,offset);
+    h = WAVEFRONT_H(k,offset);
+  }
+  // Account for last operations
+  if (matrix_type == affine2p_matrix_M) wavefront_backtrace_beginning(cigar,v,h);
+}
+void wavefront_lockstep_backtrace(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int lane,
+    cigar_t* const cigar) {
+  // Prepare cigar
+  cigar->end_offset = cigar->max_operations - 1;
+  cigar->begin_offset = cigar->max_operations - 2;
+  cigar->operations[cigar->end_offset] = '\0';
+  // Trace the alignment back
+  if (wf_lockstep->penalties.distance_metric == gap_affine) {
+    wavefront_lockstep_backtrace_affine(wf_lockstep,lane,cigar);
+  } else {
+    wavefront_lockstep_backtrace_linear(wf_lockstep,lane,cigar);
+  }
+  // Set CIGAR
+  ++(cigar->begin_offset);
+}
+/*
+ * Lockstep alignment
+ */
+void wavefront_lockstep_init(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int num_pairs,
+    const char** const patterns,
+    const wf_coord_t* const pattern_lengths,
+    const char** const texts,
+    const wf_coord_t* const text_lengths) {
+  // Release previous batch
+  mm_allocator_clear(wf_lockstep->mm_arena);
+  // Setup lanes (unused lanes are empty pairs, aligned at score 0)
+  wf_lockstep->num_lanes = num_pairs;
+  wf_lockstep->k_min = 0;
+  wf_lockstep->k_max = 0;
+  int l;
+  for (l=0;l<WF_LOCKSTEP_LANES;++l) {
+    if (l < num_pairs) {
+      strings_padded_t* const sequences = strings_padded_new(
+          patterns[l],pattern_lengths[l],texts[l],text_lengths[l],
+          WF_LOCKSTEP_PADDING,false,wf_lockstep->mm_arena);
+      wf_lockstep->pattern[l] = sequences->pattern_padded;
+      wf_lockstep->text[l] = sequences->text_padded;
+      wf_lockstep->pattern_length[l] = pattern_lengths[l];
+      wf_lockstep->text_length[l] = text_lengths[l];
+      wf_lockstep->lane_score[l] = -1;
+      wf_lockstep->k_min = MIN(wf_lockstep->k_min,-pattern_lengths[l]);
+      wf_lockstep->k_max = MAX(wf_lockstep->k_max,text_lengths[l]);
+    } else {
+      wf_lockstep->pattern[l] = NULL;
+      wf_lockstep->text[l] = NULL;
+      wf_lockstep->pattern_length[l] = 0;
+      wf_lockstep->text_length[l] = 0;
+      wf_lockstep->lane_score[l] = 0;
+    }
+  }
+  // Initial wavefront (all lanes at the origin)
+  wf_lockstep_wavefront_t* const wavefront = wavefront_lockstep_allocate(wf_lockstep,0,0,0);
+  for (l=0;l<WF_LOCKSTEP_LANES;++l) {
+    wavefront->m[l] = 0;
+    if (wavefront->i == NULL) continue;
+    wavefront->i[l] = WAVEFRONT_OFFSET_NULL;
+    wavefront->d[l] = WAVEFRONT_OFFSET_NULL;
+  }
+}
+void wavefront_lockstep_align(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int num_pairs,
+    const char** const patterns,
+    const wf_coord_t* const pattern_lengths,
+    const char** const texts,
+    const wf_coord_t* const text_lengths,
+    int* const scores,
+    cigar_t** const cigars) {
+  // Init
+  wavefront_lockstep_init(wf_lockstep,num_pairs,
+      patterns,pattern_lengths,texts,text_lengths);
+  // Compute wavefronts of increasing score (until all lanes are aligned)
+  int score = 0;
+  while (wavefront_lockstep_extend(wf_lockstep,score) > 0) {
+    ++score;
+    wavefront_lockstep_compute(wf_lockstep,score);
+  }
+  // Retrieve alignments (scores as in wavefront_compute_classic_score())
+  const distance_metric_t distance_metric = wf_lockstep->penalties.distance_metric;
+  const int swg_match = -(wf_lockstep->penalties.match);
+  int l;
+  for (l=0;l<num_pairs;++l) {
+    const int lane_score = wf_lockstep->lane_score[l];
+    scores[l] = (distance_metric <= edit) ? lane_score : (swg_match == 0) ? -lane_score :
+        WF_SCORE_TO_SW_SCORE(swg_match,pattern_lengths[l],text_lengths[l],lane_score);
+    if (cigars != NULL && cigars[l] != NULL) {
+      wavefront_lockstep_backtrace(wf_lockstep,l,cigars[l]);
+      cigars[l]->score = scores[l];
+    }
+  }
+}
@@ -0,0 +1,122 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Lockstep WFA (inter-sequence SIMD over batches of short pairs)
+ */
+
+#ifndef WAVEFRONT_LOCKSTEP_H_
+#define WAVEFRONT_LOCKSTEP_H_
+
+#include "utils/commons.h"
+#include "utils/string_padded.h"
+#include "system/mm_allocator.h"
+#include "alignment/cigar.h"
+#include "wavefront_offset.h"
+#include "wavefront_penalties.h"
+#include "wavefront_attributes.h"
+
+// Wavefront ahead definition
+typedef struct _wavefront_aligner_t wavefront_aligner_t;
+
+/*
+ * Constants
+ */
+#define WF_LOCKSTEP_LANES        16   // Pairs aligned at once (one per lane)
+#define WF_LOCKSTEP_MAX_LENGTH 1024   // Longer sequences are aligned one at a time
+
+/*
+ * Lockstep wavefronts
+ *   Each lane aligns one pair (indel, edit or gap-affine; end-to-end) using the
+ *   same per-diagonal kernels and backtrace steps as the regular aligner, so
+ *   CIGARs match the unidirectional memory modes. All lanes compute the
+ *   same score at the same time over the union of their diagonals. Offsets are
+ *   stored diagonal-major and lane-interleaved (i.e., offsets[k*LANES+lane]),
+ *   so that the compute kernel vectorizes across lanes.
+ */
+typedef struct {
+  wf_coord_t lo;                  // Lowest diagonal (null if lo > hi)
+  wf_coord_t hi;                  // Highest diagonal
+  wf_offset_t* m;                 // M-offsets (m[k*LANES+lane])
+  wf_offset_t* i;                 // I-offsets (i[k*LANES+lane]; gap-affine only)
+  wf_offset_t* d;                 // D-offsets (d[k*LANES+lane]; gap-affine only)
+} wf_lockstep_wavefront_t;
+typedef struct {
+  // Lanes
+  int num_lanes;                                     // Lanes in use
+  const char* pattern[WF_LOCKSTEP_LANES];            // Patterns (padded)
+  const char* text[WF_LOCKSTEP_LANES];               // Texts (padded)
+  wf_offset_t pattern_length[WF_LOCKSTEP_LANES];     // Pattern lengths
+  wf_offset_t text_length[WF_LOCKSTEP_LANES];        // Text lengths
+  int lane_score[WF_LOCKSTEP_LANES];                 // Alignment score (-1 if not aligned yet)
+  wf_coord_t k_min;                                  // Lowest diagonal of any lane
+  wf_coord_t k_max;                                  // Highest diagonal of any lane
+  // Wavefronts (one per score)
+  wf_lockstep_wavefront_t* wavefronts;
+  int wavefronts_allocated;
+  wf_offset_t null_offsets[WF_LOCKSTEP_LANES];       // Null diagonal (all lanes)
+  // Penalties
+  wavefront_penalties_t penalties;
+  // MM
+  mm_allocator_t* mm_arena;                          // Sequences & wavefronts (released per batch)
+} wavefront_lockstep_t;
+
+/*
+ * Setup
+ */
+wavefront_lockstep_t* wavefront_lockstep_new(
+    wavefront_penalties_t* const penalties);
+void wavefront_lockstep_delete(
+    wavefront_lockstep_t* const wf_lockstep);
+
+/*
+ * Compatibility (otherwise, pairs must be aligned one at a time)
+ *   Pairs longer than wavefront_lockstep_max_length() are aligned one at a time
+ *   too (in ultralow mode, only pairs that BiWFA would not split go to lanes).
+ */
+bool wavefront_lockstep_supported(
+    wavefront_aligner_t* const wf_aligner);
+wf_coord_t wavefront_lockstep_max_length(
+    const wavefront_memory_t memory_mode,
+    const alignment_scope_t alignment_scope);
+
+/*
+ * Lockstep alignment (up to WF_LOCKSTEP_LANES pairs)
+ *   Scores are returned in the classic form (as in wf_aligner->cigar->score).
+ *   CIGARs are computed only if @cigars is not NULL (NULL entries are skipped).
+ */
+void wavefront_lockstep_align(
+    wavefront_lockstep_t* const wf_lockstep,
+    const int num_pairs,
+    const char** const patterns,
+    const wf_coord_t* const pattern_lengths,
+    const char** const texts,
+    const wf_coord_t* const text_lengths,
+    int* const scores,
+    cigar_t** const cigars);
+
+#endif /* WAVEFRONT_LOCKSTEP_H_ */
@@ -37,13 +37,31 @@
 /*
  * Wavefront Offset
  */
+#if defined(WFA_OFFSET_16) && defined(WFA_OFFSET_64)
+#error "WFA_OFFSET_16 and WFA_OFFSET_64 are mutually exclusive"
+#endif
+#if defined(WFA_OFFSET_16)
+typedef int16_t wf_offset_t;           // Narrow offsets (short reads; half the bandwidth)
+typedef uint16_t wf_unsigned_offset_t;
+#elif defined(WFA_OFFSET_64)
+typedef int64_t wf_offset_t;           // Wide offsets (chromosome-scale sequences)
+typedef uint64_t wf_unsigned_offset_t;
+#else
 typedef int32_t wf_offset_t;
 typedef uint32_t wf_unsigned_offset_t;
+#endif
 
 /*
  * Constants
  */
-#define WAVEFRONT_OFFSET_NULL (INT32_MIN/2)
+#if defined(WFA_OFFSET_16)
+#define WAVEFRONT_OFFSET_NULL       (INT16_MIN/2)
+#define WAVEFRONT_SEQUENCE_MAX      (INT16_MAX/4) // Headroom for gap offsets (+1 per diagonal) above & below
+#elif defined(WFA_OFFSET_64)
+#define WAVEFRONT_OFFSET_NULL       (INT64_MIN/64) // Headroom for the backtrace piggyback (offset << 4)
+#else
+#define WAVEFRONT_OFFSET_NULL       (INT32_MIN/2)
+#endif
 
 /*
  * Translate k and offset to coordinates h,v
@@ -53,7 +71,11 @@ typedef uint32_t wf_unsigned_offset_t;
 #define WAVEFRONT_H(k,offset)             (offset)
 #define WAVEFRONT_ANTIDIAGONAL(k,offset)  (2*(offset)-(k))
 
+#ifdef WFA_OFFSET_64
+#define DPMATRIX_DIAGONAL_NULL            INT64_MAX
+#else
 #define DPMATRIX_DIAGONAL_NULL            INT_MAX
+#endif
 #define DPMATRIX_DIAGONAL(h,v)            ((h)-(v))
 #define DPMATRIX_ANTIDIAGONAL(h,v)        ((h)+(v))
 #define DPMATRIX_OFFSET(h,v)              (h)
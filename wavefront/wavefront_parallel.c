@@ -0,0 +1,109 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Auto-tuned granularity of intra-alignment parallelism
+ */
+
+#include "wavefront_parallel.h"
+
+/*
+ * Setup
+ */
+void wavefront_parallel_tuner_init(
+    wavefront_parallel_tuner_t* const tuner) {
+  // Priors (refined after a few steps)
+  tuner->offset_ns[wf_parallel_compute] = 2.0f;
+  tuner->offset_ns[wf_parallel_extend] = 4.0f;
+  tuner->thread_ns = 2000.0f;
+  // Steps
+  tuner->num_steps_single = 0;
+  tuner->num_steps_parallel = 0;
+  tuner->sample_active = false;
+}
+/*
+ * Tuning
+ */
+int wavefront_parallel_tuner_num_threads(
+    wavefront_parallel_tuner_t* const tuner,
+    const wf_parallel_phase_t phase,
+    const uint64_t length,
+    const uint64_t min_length_per_thread,
+    const int max_num_threads) {
+  // Expected work (single thread)
+  const float work_ns = (float)length * tuner->offset_ns[phase];
+  // Add threads while the step gets faster (i.e. T(n+1) < T(n) <=> thread_ns < work_ns/(n*(n+1)))
+  const int max_threads = MIN(max_num_threads,(int)(length/min_length_per_thread));
+  int num_threads = 1;
+  while (num_threads < max_threads &&
+         (float)(num_threads*(num_threads+1))*tuner->thread_ns < work_ns) {
+    ++num_threads;
+  }
+  // Decide whether to sample this step
+  if (num_threads > 1) {
+    // Run a few parallel steps single-threaded (keeps offset_ns current)
+    if ((++tuner->num_steps_parallel % WF_PARALLEL_PROBE_INTERVAL) == 0) num_threads = 1;
+  } else {
+    // Sample steps close to the break-even only (timing tiny steps costs as much as them)
+    if (4.0f*work_ns < tuner->thread_ns) return 1;
+    if ((++tuner->num_steps_single % WF_PARALLEL_SAMPLE_INTERVAL) != 0) return 1;
+    // Now and then, try two threads (re-estimates thread_ns after an outlier)
+    if (max_threads >= 2 &&
+        (tuner->num_steps_single % (4*WF_PARALLEL_SAMPLE_INTERVAL)) == 0) num_threads = 2;
+  }
+  // Start sample
+  tuner->sample_active = true;
+  tuner->sample_phase = phase;
+  tuner->sample_threads = num_threads;
+  tuner->sample_length = length;
+  timer_get_system_time(&tuner->sample_start);
+  return num_threads;
+}
+void wavefront_parallel_tuner_sample(
+    wavefront_parallel_tuner_t* const tuner) {
+  // Check sample
+  if (!tuner->sample_active) return;
+  tuner->sample_active = false;
+  struct timespec sample_end;
+  timer_get_system_time(&sample_end);
+  const float elapsed_ns =
+      (float)(sample_end.tv_sec-tuner->sample_start.tv_sec)*1e9f +
+      (float)(sample_end.tv_nsec-tuner->sample_start.tv_nsec);
+  if (elapsed_ns <= 0.0f) return; // Clock adjusted
+  // Update estimates
+  const float length = (float)tuner->sample_length;
+  const int num_threads = tuner->sample_threads;
+  float* const offset_ns = tuner->offset_ns + tuner->sample_phase;
+  if (num_threads == 1) {
+    const float sample_ns = elapsed_ns / length;
+    *offset_ns += (sample_ns - *offset_ns) / (float)(1 << WF_PARALLEL_EWMA_SHIFT);
+  } else {
+    const float overhead_ns = elapsed_ns - length*(*offset_ns)/(float)num_threads;
+    const float sample_ns = MAX(overhead_ns,0.0f) / (float)(num_threads-1);
+    tuner->thread_ns += (sample_ns - tuner->thread_ns) / (float)(1 << WF_PARALLEL_EWMA_SHIFT);
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ *                             The MIT License
+ *
+ * Wavefront Alignment Algorithms
+ * Copyright (c) 2017 by Santiago Marco-Sola  <santiagomsola@gmail.com>
+ *
+ * This file is part of Wavefront Alignment Algorithms.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * PROJECT: Wavefront Alignment Algorithms
+ * AUTHOR(S): Santiago Marco-Sola <santiagomsola@gmail.com>
+ * DESCRIPTION: Auto-tuned granularity of intra-alignment parallelism
+ */
+
+#ifndef WAVEFRONT_PARALLEL_H_
+#define WAVEFRONT_PARALLEL_H_
+
+#include "utils/commons.h"
+#include "system/profiler_timer.h"
+
+/*
+ * Configuration
+ */
+#define WF_PARALLEL_OFFSETS_PER_THREAD  256   // Expected granularity in auto mode (e.g. to plan batches)
+#define WF_PARALLEL_CHUNKS_PER_THREAD   4     // Dynamic extend chunks per thread
+#define WF_PARALLEL_SAMPLE_INTERVAL     8     // Sample one every N single-thread steps
+#define WF_PARALLEL_PROBE_INTERVAL      64    // Run one every N parallel steps single-threaded
+#define WF_PARALLEL_EWMA_SHIFT          3     // Estimates weight new samples by 1/2^3
+
+/*
+ * Parallel granularity tuner
+ *   Estimates online the time to compute/extend one offset using one thread
+ *   (sampled on single-thread steps) and the overhead of each additional
+ *   thread (sampled on parallel steps). Each step then uses the number of
+ *   threads that minimizes its expected time, that is,
+ *     length*offset_ns/threads + (threads-1)*thread_ns
+ */
+typedef enum {
+  wf_parallel_compute = 0,             // Compute next wavefront
+  wf_parallel_extend  = 1,             // Extend wavefront (uneven work per diagonal)
+} wf_parallel_phase_t;
+typedef struct {
+  // Estimates
+  float offset_ns[2];                  // Time per offset using one thread (per phase)
+  float thread_ns;                     // Overhead per additional thread (wake-up, join, imbalance)
+  // Steps
+  uint64_t num_steps_single;           // Single-thread steps worth sampling
+  uint64_t num_steps_parallel;         // Parallel steps
+  // Current sample
+  struct timespec sample_start;        // Start time
+  bool sample_active;                  // Step being timed
+  wf_parallel_phase_t sample_phase;    // Phase
+  int sample_threads;                  // Number of threads
+  uint64_t sample_length;              // Wavefront length
+} wavefront_parallel_tuner_t;
+
+/*
+ * Setup
+ */
+void wavefront_parallel_tuner_init(
+    wavefront_parallel_tuner_t* const tuner);
+
+/*
+ * Tuning
+ */
+int wavefront_parallel_tuner_num_threads(
+    wavefront_parallel_tuner_t* const tuner,
+    const wf_parallel_phase_t phase,
+    const uint64_t length,
+    const uint64_t min_length_per_thread,
+    const int max_num_threads);
+void wavefront_parallel_tuner_sample(
+    wavefront_parallel_tuner_t* const tuner);
+
+#endif /* WAVEFRONT_PARALLEL_H_ */
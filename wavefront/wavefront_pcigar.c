@@ -89,11 +89,11 @@ int pcigar_unpack(
  */
 int pcigar_unpack_extend(
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
-    int v,
-    int h,
+    const wf_coord_t text_length,
+    wf_coord_t v,
+    wf_coord_t h,
     char* cigar_buffer) {
   int num_matches = 0;
   // Fetch pattern/text blocks
@@ -126,12 +126,12 @@ int pcigar_unpack_extend(
   return num_matches;
 }
 int pcigar_unpack_extend_custom(
-    const int pattern_length,
-    const int text_length,
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    int v,
-    int h,
+    wf_coord_t v,
+    wf_coord_t h,
     char* cigar_buffer) {
   int num_matches = 0;
   while (v < pattern_length && h < text_length) {
@@ -151,15 +151,15 @@ int pcigar_unpack_extend_custom(
 void pcigar_unpack_linear(
     pcigar_t pcigar,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    int* const v_pos,
-    int* const h_pos,
+    wf_coord_t* const v_pos,
+    wf_coord_t* const h_pos,
     char* cigar_buffer,
-    int* const cigar_length) {
+    wf_coord_t* const cigar_length) {
   // Parameters
   char* const cigar_buffer_base = cigar_buffer;
   // Compute pcigar length and shift to the end of the word
@@ -170,7 +170,7 @@ void pcigar_unpack_linear(
     pcigar <<= free_slots*2;
   }
   // Unpack BT-blocks
-  int v = *v_pos, h = *h_pos, i;
+  wf_coord_t v = *v_pos, h = *h_pos, i;
   for (i=0;i<pcigar_length;++i) {
     // Extend exact-matches
     int num_matches;
@@ -203,15 +203,15 @@ void pcigar_unpack_linear(
 void pcigar_unpack_affine(
     pcigar_t pcigar,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    int* const v_pos,
-    int* const h_pos,
+    wf_coord_t* const v_pos,
+    wf_coord_t* const h_pos,
     char* cigar_buffer,
-    int* const cigar_length,
+    wf_coord_t* const cigar_length,
     affine_matrix_type* const current_matrix_type) {
   // Parameters
   char* const cigar_buffer_base = cigar_buffer;
@@ -224,7 +224,7 @@ void pcigar_unpack_affine(
   }
   // Unpack BT-blocks
   affine_matrix_type matrix_type = *current_matrix_type;
-  int v = *v_pos, h = *h_pos, i;
+  wf_coord_t v = *v_pos, h = *h_pos, i;
   for (i=0;i<pcigar_length;++i) {
     // Extend exact-matches
     if (matrix_type == affine_matrix_M) { // Extend only on the M-wavefront
@@ -35,12 +35,6 @@
 #include "utils/commons.h"
 #include "wavefront_attributes.h"
 
-/*
- * Configuration
- */
-#define PCIGAR_32BITS
-//#define PCIGAR_64BITS
-
 /*
  * Packed CIGAR
  */
@@ -56,25 +50,35 @@
 #define PCIGAR_PUSH_BACK_DEL(pcigar)   ((pcigar<<2) | PCIGAR_DELETION)
 #define PCIGAR_PUSH_BACK_MISMS(pcigar) ((pcigar<<2) | PCIGAR_MISMATCH)
 
-#ifdef PCIGAR_32BITS
-  typedef uint32_t pcigar_t;
-  #define PCIGAR_MAX_LENGTH               16
-  #define PCIGAR_FULL_MASK                0x40000000u /* Completely full */
-  #define PCIGAR_ALMOST_FULL_MASK         0x10000000u /* 15-slots busy or more */
-  #define PCIGAR_HALF_FULL_MASK           0x00010000u /*  9-slots busy or more */
-  #define PCIGAR_IS_UTILISED(pcigar,mask) ((pcigar) >= mask)
-  #define PCIGAR_EXTRACT(pcigar)          ((pcigar) >> 30)
-  #define PCIGAR_FREE_SLOTS(pcigar)       ((pcigar)!=0) ? __builtin_clz(pcigar)/2 : PCIGAR_MAX_LENGTH;
-#else
-  typedef uint64_t pcigar_t;
-  #define PCIGAR_MAX_LENGTH               32
-  #define PCIGAR_FULL_MASK                0x4000000000000000ul /* Completely full */
-  #define PCIGAR_ALMOST_FULL_MASK         0x1000000000000000ul /* 31-slots busy or more */
-  #define PCIGAR_HALF_FULL_MASK           0x0000000100000000ul /* 17-slots busy or more */
-  #define PCIGAR_IS_UTILISED(pcigar,mask) ((pcigar) >= mask)
-  #define PCIGAR_EXTRACT(pcigar)          ((pcigar) >> 62)
-  #define PCIGAR_FREE_SLOTS(pcigar)       ((pcigar)!=0) ? __builtin_clzl(pcigar)/2 : PCIGAR_MAX_LENGTH;
-#endif
+// Value (holds 32-bit pCIGARs in the lower half)
+typedef uint64_t pcigar_t;
+// Storage (per-diagonal arrays use the width selected for the BT-buffer)
+typedef uint32_t pcigar32_t;
+typedef uint64_t pcigar64_t;
+#define PCIGAR_SIZE(pcigar_64bits) ((pcigar_64bits) ? sizeof(pcigar64_t) : sizeof(pcigar32_t))
+#define PCIGAR_GET(bt_pcigar,k,pcigar_64bits) \
+  ((pcigar_64bits) ? \
+      (pcigar_t)((const pcigar64_t*)(bt_pcigar))[k] : \
+      (pcigar_t)((const pcigar32_t*)(bt_pcigar))[k])
+#define PCIGAR_SET(bt_pcigar,k,pcigar,pcigar_64bits) \
+  ((pcigar_64bits) ? \
+      (void)(((pcigar64_t*)(bt_pcigar))[k] = (pcigar64_t)(pcigar)) : \
+      (void)(((pcigar32_t*)(bt_pcigar))[k] = (pcigar32_t)(pcigar)))
+#define PCIGAR_MAX_LENGTH               32
+#define PCIGAR_FULL_MASK                0x4000000000000000ul /* Completely full */
+#define PCIGAR_IS_UTILISED(pcigar,mask) ((pcigar) >= mask)
+#define PCIGAR_EXTRACT(pcigar)          ((pcigar) >> 62)
+#define PCIGAR_FREE_SLOTS(pcigar)       ((pcigar)!=0) ? __builtin_clzl(pcigar)/2 : PCIGAR_MAX_LENGTH;
+// 32-bit pCIGARs (16 operations)
+#define PCIGAR32_MAX_LENGTH             16
+#define PCIGAR32_FULL_MASK              0x0000000040000000ul /* Completely full */
+#define PCIGAR32_ALMOST_FULL_MASK       0x0000000010000000ul /* 15-slots busy or more */
+#define PCIGAR32_HALF_FULL_MASK         0x0000000000010000ul /*  9-slots busy or more */
+// 64-bit pCIGARs (32 operations)
+#define PCIGAR64_MAX_LENGTH             32
+#define PCIGAR64_FULL_MASK              0x4000000000000000ul /* Completely full */
+#define PCIGAR64_ALMOST_FULL_MASK       0x1000000000000000ul /* 31-slots busy or more */
+#define PCIGAR64_HALF_FULL_MASK         0x0000000100000000ul /* 17-slots busy or more */
 
 
 /*
@@ -92,27 +96,27 @@ int pcigar_unpack(
 void pcigar_unpack_linear(
     pcigar_t pcigar,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    int* const v_pos,
-    int* const h_pos,
+    wf_coord_t* const v_pos,
+    wf_coord_t* const h_pos,
     char* cigar_buffer,
-    int* const cigar_length);
+    wf_coord_t* const cigar_length);
 void pcigar_unpack_affine(
     pcigar_t pcigar,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     alignment_match_funct_t const match_funct,
     void* const match_funct_arguments,
-    int* const v_pos,
-    int* const h_pos,
+    wf_coord_t* const v_pos,
+    wf_coord_t* const h_pos,
     char* cigar_buffer,
-    int* const cigar_length,
+    wf_coord_t* const cigar_length,
     affine_matrix_type* const current_matrix_type);
 
 /*
@@ -37,15 +37,15 @@
  */
 void wavefront_plot_heatmaps_allocate(
     wavefront_plot_t* const wf_plot,
-    const int pattern_length,
-    const int text_length) {
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length) {
   wavefront_plot_attr_t* const attributes = &wf_plot->attributes;
   // Compute dimensions
   const int resolution_points = attributes->resolution_points;
-  const int min_v = (wf_plot->min_v == -1) ? 0 : wf_plot->min_v;
-  const int max_v = (wf_plot->max_v == -1) ? pattern_length-1 : wf_plot->max_v;
-  const int min_h = (wf_plot->min_h == -1) ? 0 : wf_plot->min_h;
-  const int max_h = (wf_plot->max_h == -1) ? text_length-1 : wf_plot->max_h;
+  const wf_coord_t min_v = (wf_plot->min_v == -1) ? 0 : wf_plot->min_v;
+  const wf_coord_t max_v = (wf_plot->max_v == -1) ? pattern_length-1 : wf_plot->max_v;
+  const wf_coord_t min_h = (wf_plot->min_h == -1) ? 0 : wf_plot->min_h;
+  const wf_coord_t max_h = (wf_plot->max_h == -1) ? text_length-1 : wf_plot->max_h;
   // Behavior
   wf_plot->behavior_heatmap = heatmap_new(heatmap_value,
       min_v,max_v,min_h,max_h,resolution_points);
@@ -83,8 +83,8 @@ void wavefront_plot_heatmaps_free(
  */
 wavefront_plot_t* wavefront_plot_new(
     const distance_metric_t distance_metric,
-    const int pattern_length,
-    const int text_length,
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length,
     wavefront_plot_attr_t* const attributes) {
   // Handler
   wavefront_plot_t* const wf_plot = (wavefront_plot_t*)malloc(sizeof(wavefront_plot_t));
@@ -105,8 +105,8 @@ wavefront_plot_t* wavefront_plot_new(
 }
 void wavefront_plot_resize(
     wavefront_plot_t* const wf_plot,
-    const int pattern_length,
-    const int text_length) {
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length) {
   // Free heatmaps
   wavefront_plot_heatmaps_free(wf_plot);
   // Allocate new heatmaps
@@ -134,24 +134,22 @@ void wavefront_plot_component(
   // Check wavefront
   if (wavefront == NULL) return;
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
-  const char* const pattern = wf_aligner->pattern;
-  const char* const text = wf_aligner->text;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   wavefront_plot_t* const plot = wf_aligner->plot;
   const bool reverse = (wf_aligner->align_mode == wf_align_biwfa_breakpoint_reverse);
   // Traverse all offsets
-  int k;
+  wf_coord_t k;
   for (k=wavefront->lo;k<=wavefront->hi;++k) {
     const wf_offset_t offset = wavefront->offsets[k];
     if (offset < 0) continue;
     // Compute local coordinates
-    int v_local = WAVEFRONT_V(k,offset);
-    int h_local = WAVEFRONT_H(k,offset);
+    wf_coord_t v_local = WAVEFRONT_V(k,offset);
+    wf_coord_t h_local = WAVEFRONT_H(k,offset);
     if (v_local < 0 || v_local >= pattern_length) continue;
     if (h_local < 0 || h_local >= text_length) continue;
     // Compute global coordinates
-    int v_global, h_global;
+    wf_coord_t v_global, h_global;
     if (reverse) {
       v_global = plot->offset_v + (pattern_length - 1 - v_local);
       h_global = plot->offset_h + (text_length - 1 - h_local);
@@ -169,7 +167,7 @@ void wavefront_plot_component(
     if (extend) {
       while (v_local < pattern_length &&
              h_local < text_length &&
-             pattern[v_local] == text[h_local]) {
+             WAVEFRONT_PATTERN_CHAR(wf_aligner,v_local) == WAVEFRONT_TEXT_CHAR(wf_aligner,h_local)) {
         if (reverse) {
           v_global--; h_global--;
         } else {
@@ -200,7 +198,7 @@ void wavefront_plot(
   // Parameters
   const distance_metric_t distance_metric = wf_aligner->penalties.distance_metric;
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
-  const int score_mod = (wf_components->memory_modular) ? score%wf_components->max_score_scope : score;
+  const int score_mod = (wf_components->memory_modular) ? score&wf_components->wavefront_mask : score;
   // Plot wavefront components
   wavefront_plot_component(wf_aligner,
       wf_components->mwavefronts[score_mod],
@@ -229,7 +227,7 @@ void wavefront_plot_print_cigar(
     FILE* const stream,
     cigar_t* const cigar,
     const char target_operation) {
-  int i, h=0, v=0, count=0;
+  wf_coord_t i, h=0, v=0, count=0;
   for (i=cigar->begin_offset;i<cigar->end_offset;++i) {
     // Check operation
     const char operation = cigar->operations[i];
@@ -242,7 +240,7 @@ void wavefront_plot_print_cigar(
     // Print point
     if (operation == target_operation && h>0 && v>0) {
       if (count++ > 0) fprintf(stream,";");
-      fprintf(stream,"%d,%d",h-1,v-1);
+      fprintf(stream,"%"PRIcoord",%"PRIcoord,h-1,v-1);
     }
   }
 }
@@ -259,10 +257,10 @@ void wavefront_plot_print(
     fprintf(stream,"# Pattern -\n");
     fprintf(stream,"# Text -\n");
   } else {
-    fprintf(stream,"# PatternLength %d\n",wf_aligner->pattern_length);
-    fprintf(stream,"# Pattern %.*s\n",wf_aligner->pattern_length,wf_aligner->pattern);
-    fprintf(stream,"# TextLength %d\n",wf_aligner->text_length);
-    fprintf(stream,"# Text %.*s\n",wf_aligner->text_length,wf_aligner->text);
+    fprintf(stream,"# PatternLength %"PRIcoord"\n",wf_aligner->pattern_length);
+    fprintf(stream,"# Pattern %.*s\n",(int)wf_aligner->pattern_length,wf_aligner->pattern);
+    fprintf(stream,"# TextLength %"PRIcoord"\n",wf_aligner->text_length);
+    fprintf(stream,"# Text %.*s\n",(int)wf_aligner->text_length,wf_aligner->text);
   }
   fprintf(stream,"# Penalties ");
   wavefront_penalties_print(stream,&wf_aligner->penalties);
@@ -52,10 +52,10 @@ typedef struct {
   // Configuration
   wavefront_plot_attr_t attributes;
   distance_metric_t distance_metric;
-  int min_v;
-  int max_v;
-  int min_h;
-  int max_h;
+  wf_coord_t min_v;
+  wf_coord_t max_v;
+  wf_coord_t min_h;
+  wf_coord_t max_h;
   // Wavefront Heatmaps
   heatmap_t* m_heatmap;
   heatmap_t* i1_heatmap;
@@ -64,8 +64,8 @@ typedef struct {
   heatmap_t* d2_heatmap;
   heatmap_t* behavior_heatmap;
   // Offsets
-  int offset_h;
-  int offset_v;
+  wf_coord_t offset_h;
+  wf_coord_t offset_v;
 } wavefront_plot_t;
 
 /*
@@ -73,13 +73,13 @@ typedef struct {
  */
 wavefront_plot_t* wavefront_plot_new(
     const distance_metric_t distance_metric,
-    const int pattern_length,
-    const int text_length,
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length,
     wavefront_plot_attr_t* const attributes);
 void wavefront_plot_resize(
     wavefront_plot_t* const wf_plot,
-    const int pattern_length,
-    const int text_length);
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length);
 void wavefront_plot_delete(
     wavefront_plot_t* const wf_plot);
 
@@ -34,9 +34,34 @@
 /*
  * Constants
  */
-#define WF_SLAB_EXPAND_FACTOR          1.5f
 #define WF_SLAB_QUEUES_LENGTH_INIT     100
+#define WF_SLAB_CLASS_QUEUES_LENGTH_INIT 10
 
+/*
+ * Size-classes
+ */
+int wavefront_slab_class_idx(
+    wavefront_slab_t* const wavefront_slab,
+    const int wf_length) {
+  // Smallest class
+  const int init_wf_length = wavefront_slab->init_wf_length;
+  if (wf_length <= init_wf_length) return 0;
+  // Power-of-two class (ceil(log2(wf_length/init_wf_length)))
+  const uint32_t num_blocks = DIV_CEIL(wf_length,init_wf_length);
+  const int class_idx = 32 - __builtin_clz(num_blocks-1);
+  return MIN(class_idx,WF_SLAB_NUM_CLASSES-1);
+}
+wf_slab_class_t* wavefront_slab_class_member(
+    wavefront_slab_t* const wavefront_slab,
+    wavefront_t* const wavefront) {
+  // Tight-mode only recycles the smallest class
+  const int wf_length = wavefront->wf_elements_allocated;
+  const int class_idx = wavefront_slab_class_idx(wavefront_slab,wf_length);
+  if (wavefront_slab->slab_mode == wf_slab_tight && class_idx > 0) return NULL;
+  // Check wavefront was allocated by the class
+  wf_slab_class_t* const slab_class = wavefront_slab->classes + class_idx;
+  return (slab_class->wf_length == wf_length) ? slab_class : NULL;
+}
 /*
  * Setup
  */
@@ -50,97 +75,83 @@ wavefront_slab_t* wavefront_slab_new(
       mm_allocator_alloc(mm_allocator,wavefront_slab_t);
   // Attributes
   wavefront_slab->allocate_backtrace = allocate_backtrace;
+  wavefront_slab->pcigar_64bits = false;
   wavefront_slab->slab_mode = slab_mode;
   // Wavefront Slabs
   wavefront_slab->init_wf_length = init_wf_length;
-  wavefront_slab->current_wf_length = init_wf_length;
   wavefront_slab->wavefronts = vector_new(WF_SLAB_QUEUES_LENGTH_INIT,wavefront_t*);
-  wavefront_slab->wavefronts_free = vector_new(WF_SLAB_QUEUES_LENGTH_INIT,wavefront_t*);
+  // Size-classes
+  int i;
+  for (i=0;i<WF_SLAB_NUM_CLASSES;++i) {
+    wf_slab_class_t* const slab_class = wavefront_slab->classes + i;
+    slab_class->wf_length = MIN((int64_t)init_wf_length << i,INT_MAX);
+    slab_class->wavefronts_free = vector_new(
+        (i==0) ? WF_SLAB_QUEUES_LENGTH_INIT : WF_SLAB_CLASS_QUEUES_LENGTH_INIT,wavefront_t*);
+    slab_class->num_wavefronts = 0;
+    slab_class->num_allocated = 0;
+    slab_class->num_reused = 0;
+  }
   // Stats
   wavefront_slab->memory_used = 0;
+  wavefront_slab->num_allocations = 0;
   // MM
   wavefront_slab->mm_allocator = mm_allocator;
   // Return
   return wavefront_slab;
 }
-void wavefront_slab_reap_free(
-    wavefront_slab_t* const wavefront_slab) {
-  // Parameters
-  wavefront_t** const wavefronts = vector_get_mem(wavefront_slab->wavefronts,wavefront_t*);
-  const int num_wavefronts = vector_get_used(wavefront_slab->wavefronts);
-  mm_allocator_t* const mm_allocator = wavefront_slab->mm_allocator;
-  // Remove "deallocated" and free wavefronts
-  int i, valid_idx = 0;
-  for (i=0;i<num_wavefronts;++i) {
-    switch (wavefronts[i]->status) {
-      case wavefront_status_deallocated:
-        mm_allocator_free(mm_allocator,wavefronts[i]); // Delete handler
-        break;
-      case wavefront_status_busy:
-        wavefronts[valid_idx++] = wavefronts[i]; // Valid wavefront
-        break;
-      case wavefront_status_free:
-        wavefront_free(wavefronts[i],mm_allocator); // Free wavefront
-        wavefront_slab->memory_used -= wavefront_get_size(wavefronts[i]);
-        mm_allocator_free(mm_allocator,wavefronts[i]); // Delete handler
-        break;
-    }
-  }
-  vector_set_used(wavefront_slab->wavefronts,valid_idx);
-  vector_clear(wavefront_slab->wavefronts_free);
-}
 void wavefront_slab_reap_repurpose(
-    wavefront_slab_t* const wavefront_slab) {
+    wavefront_slab_t* const wavefront_slab,
+    const int num_classes_kept) {
   // Parameters
-  const int current_wf_length = wavefront_slab->current_wf_length;
   wavefront_t** const wavefronts = vector_get_mem(wavefront_slab->wavefronts,wavefront_t*);
   const int num_wavefronts = vector_get_used(wavefront_slab->wavefronts);
   mm_allocator_t* const mm_allocator = wavefront_slab->mm_allocator;
   // Clear free
-  vector_reserve(wavefront_slab->wavefronts_free,num_wavefronts,false);
-  wavefront_t** const wavefronts_free = vector_get_mem(wavefront_slab->wavefronts_free,wavefront_t*);
-  // Remove "deallocated" and repurpose all we can of current wf-length
-  int i, valid_idx = 0;
+  int i;
+  for (i=0;i<WF_SLAB_NUM_CLASSES;++i) {
+    vector_clear(wavefront_slab->classes[i].wavefronts_free);
+  }
+  // Remove "deallocated" and repurpose all we can from the kept classes
+  int valid_idx = 0;
   for (i=0;i<num_wavefronts;++i) {
     switch (wavefronts[i]->status) {
       case wavefront_status_deallocated:
         mm_allocator_free(mm_allocator,wavefronts[i]); // Delete handler
         break;
       case wavefront_status_busy:
-      case wavefront_status_free:
-        if (wavefronts[i]->wf_elements_allocated == current_wf_length) {
+      case wavefront_status_free: {
+        wf_slab_class_t* const slab_class = wavefront_slab_class_member(wavefront_slab,wavefronts[i]);
+        if (slab_class != NULL && (slab_class - wavefront_slab->classes) < num_classes_kept) {
           wavefronts[i]->status = wavefront_status_free; // Set free
-          wavefronts[valid_idx] = wavefronts[i]; // Valid wavefront
-          wavefronts_free[valid_idx] = wavefronts[i]; // Free wavefront
-          valid_idx++;
+          wavefronts[valid_idx++] = wavefronts[i]; // Valid wavefront
+          vector_insert(slab_class->wavefronts_free,wavefronts[i],wavefront_t*); // Free wavefront
         } else {
+          if (slab_class != NULL) --(slab_class->num_wavefronts);
           wavefront_free(wavefronts[i],mm_allocator); // Free wavefront
           wavefront_slab->memory_used -= wavefront_get_size(wavefronts[i]);
           mm_allocator_free(mm_allocator,wavefronts[i]); // Delete handler
         }
         break;
+      }
     }
   }
   vector_set_used(wavefront_slab->wavefronts,valid_idx);
-  vector_set_used(wavefront_slab->wavefronts_free,valid_idx);
 }
 void wavefront_slab_reap(
     wavefront_slab_t* const wavefront_slab) {
   // Back to initial size
-  wavefront_slab->current_wf_length = wavefront_slab->init_wf_length;
-  wavefront_slab_reap_repurpose(wavefront_slab); // Repurpose all wavefronts
+  wavefront_slab_reap_repurpose(wavefront_slab,1); // Repurpose only the smallest class
 }
 void wavefront_slab_clear(
     wavefront_slab_t* const wavefront_slab) {
   // Select slab mode
   switch (wavefront_slab->slab_mode) {
     case wf_slab_reuse:
-      wavefront_slab_reap_repurpose(wavefront_slab);
+      wavefront_slab_reap_repurpose(wavefront_slab,WF_SLAB_NUM_CLASSES);
       break;
     case wf_slab_tight:
       // Back to initial size
-      wavefront_slab->current_wf_length = wavefront_slab->init_wf_length;
-      wavefront_slab_reap_repurpose(wavefront_slab);
+      wavefront_slab_reap_repurpose(wavefront_slab,1);
       break;
   }
 }
@@ -148,13 +159,15 @@ void wavefront_slab_delete(
     wavefront_slab_t* const wavefront_slab) {
   // Parameters
   mm_allocator_t* const mm_allocator = wavefront_slab->mm_allocator;
-  // Delete free vector
-  vector_delete(wavefront_slab->wavefronts_free);
+  // Delete free vectors
+  int i;
+  for (i=0;i<WF_SLAB_NUM_CLASSES;++i) {
+    vector_delete(wavefront_slab->classes[i].wavefronts_free);
+  }
   // Free wavefronts
   wavefront_t** const wavefronts =
       vector_get_mem(wavefront_slab->wavefronts,wavefront_t*);
   const int num_wavefronts = vector_get_used(wavefront_slab->wavefronts);
-  int i;
   for (i=0;i<num_wavefronts;++i) {
     if (wavefronts[i]->status == wavefront_status_deallocated) {
       mm_allocator_free(mm_allocator,wavefronts[i]); // Delete handler
@@ -178,24 +191,34 @@ void wavefront_slab_set_mode(
     // Change mode
     wavefront_slab->slab_mode = slab_mode;
     // Reap
-    wavefront_slab->current_wf_length = wavefront_slab->init_wf_length;
-    wavefront_slab_reap_repurpose(wavefront_slab);
+    wavefront_slab_reap_repurpose(wavefront_slab,1);
   }
 }
+void wavefront_slab_set_pcigar(
+    wavefront_slab_t* const wavefront_slab,
+    const bool pcigar_64bits) {
+  // Check width
+  if (pcigar_64bits == wavefront_slab->pcigar_64bits) return;
+  wavefront_slab->pcigar_64bits = pcigar_64bits;
+  // Reap all (BT-vectors sized for the previous width)
+  if (wavefront_slab->allocate_backtrace) wavefront_slab_reap_repurpose(wavefront_slab,0);
+}
 /*
  * Slab Allocator
  */
 wavefront_t* wavefront_slab_allocate_new(
     wavefront_slab_t* const wavefront_slab,
     const int wf_length_requested,
-    const int min_lo,
-    const int max_hi) {
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi) {
   // Allocate a new wavefront
   mm_allocator_t* const mm_allocator = wavefront_slab->mm_allocator;
   wavefront_t* const wavefront = mm_allocator_alloc(mm_allocator,wavefront_t);
-  wavefront_allocate(wavefront,wf_length_requested,wavefront_slab->allocate_backtrace,mm_allocator);
+  wavefront_allocate(wavefront,wf_length_requested,
+      wavefront_slab->allocate_backtrace,wavefront_slab->pcigar_64bits,mm_allocator);
   vector_insert(wavefront_slab->wavefronts,wavefront,wavefront_t*);
   wavefront_slab->memory_used += wavefront_get_size(wavefront);
+  ++(wavefront_slab->num_allocations);
   // Init wavefront
   wavefront->status = wavefront_status_busy;
   wavefront_init(wavefront,min_lo,max_hi);
@@ -204,10 +227,9 @@ wavefront_t* wavefront_slab_allocate_new(
 }
 wavefront_t* wavefront_slab_allocate_free(
     wavefront_slab_t* const wavefront_slab,
-    const int min_lo,
-    const int max_hi) {
-  // Parameters
-  vector_t* const wavefronts_free = wavefront_slab->wavefronts_free;
+    vector_t* const wavefronts_free,
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi) {
   // Reuse wavefront
   wavefront_t* const wavefront = *(vector_get_last_elm(wavefronts_free,wavefront_t*));
   vector_dec_used(wavefronts_free);
@@ -219,59 +241,43 @@ wavefront_t* wavefront_slab_allocate_free(
 }
 wavefront_t* wavefront_slab_allocate(
     wavefront_slab_t* const wavefront_slab,
-    const int min_lo,
-    const int max_hi) {
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi) {
   // Parameters
-  vector_t* const wavefronts_free = wavefront_slab->wavefronts_free;
   const int wf_length = WAVEFRONT_LENGTH(min_lo,max_hi);
-  // Check slab-mode
-  if (wavefront_slab->slab_mode == wf_slab_reuse) {
-    // Check max-length of pre-allocated wavefronts
-    if (wf_length > wavefront_slab->current_wf_length) {
-      const int proposed_wf_length = (float)wf_length * WF_SLAB_EXPAND_FACTOR;
-      wavefront_slab->current_wf_length = proposed_wf_length; // New slab size
-      wavefront_slab_reap_free(wavefront_slab); // Reap free wavefronts
-    }
-    // Check for a free wavefront (pre-allocated in the slab)
-    if (vector_get_used(wavefronts_free) > 0) {
-      return wavefront_slab_allocate_free(wavefront_slab,min_lo,max_hi);
-    } else {
-      // Allocate a new wavefront
-      return wavefront_slab_allocate_new(wavefront_slab,
-          wavefront_slab->current_wf_length,min_lo,max_hi);
-    }
-  } else { // wf_slab_tight
-    if (wf_length <= wavefront_slab->init_wf_length) {
-      // Check for a free wavefront (pre-allocated in the slab)
-      if (vector_get_used(wavefronts_free) > 0) {
-        return wavefront_slab_allocate_free(wavefront_slab,min_lo,max_hi);
-      } else {
-        return wavefront_slab_allocate_new(wavefront_slab,
-            wavefront_slab->init_wf_length,min_lo,max_hi); // Allocate new
-      }
-    } else {
-      return wavefront_slab_allocate_new(wavefront_slab,
-          wf_length,min_lo,max_hi); // Allocate new
-    }
+  const int class_idx = wavefront_slab_class_idx(wavefront_slab,wf_length);
+  wf_slab_class_t* const slab_class = wavefront_slab->classes + class_idx;
+  // Check size-class (tight-mode only keeps the smallest class)
+  const bool use_class =
+      (wavefront_slab->slab_mode == wf_slab_reuse || class_idx == 0) &&
+      (wf_length <= slab_class->wf_length);
+  if (!use_class) {
+    return wavefront_slab_allocate_new(wavefront_slab,
+        wf_length,min_lo,max_hi); // Allocate new
+  }
+  // Check for a free wavefront (pre-allocated in the class)
+  vector_t* const wavefronts_free = slab_class->wavefronts_free;
+  if (vector_get_used(wavefronts_free) > 0) {
+    ++(slab_class->num_reused);
+    return wavefront_slab_allocate_free(wavefront_slab,wavefronts_free,min_lo,max_hi);
+  } else {
+    ++(slab_class->num_wavefronts);
+    ++(slab_class->num_allocated);
+    return wavefront_slab_allocate_new(wavefront_slab,
+        slab_class->wf_length,min_lo,max_hi); // Allocate new
   }
 }
 void wavefront_slab_free(
     wavefront_slab_t* const wavefront_slab,
     wavefront_t* const wavefront) {
   // Check reasons to repurpose wavefront (NOTE: Tight-mode never slab_frees())
-  //   (A) Reuse-mode and wavefront has current wf-length
-  //   (B) Tight-mode and wavefront has init wf-length
-  const int wf_length = wavefront->wf_elements_allocated;
-  const bool repurpose_reuse =
-      (wavefront_slab->slab_mode == wf_slab_reuse) &&
-      (wf_length == wavefront_slab->current_wf_length);
-  const bool repurpose_tight =
-      (wavefront_slab->slab_mode == wf_slab_tight) &&
-      (wf_length == wavefront_slab->init_wf_length);
-  if (repurpose_reuse || repurpose_tight) {
+  //   (A) Reuse-mode and wavefront belongs to any size-class
+  //   (B) Tight-mode and wavefront belongs to the smallest class (init wf-length)
+  wf_slab_class_t* const slab_class = wavefront_slab_class_member(wavefront_slab,wavefront);
+  if (slab_class != NULL) {
     // Return wavefront to slab as free (Good job recycling)
     wavefront->status = wavefront_status_free;
-    vector_insert(wavefront_slab->wavefronts_free,wavefront,wavefront_t*);
+    vector_insert(slab_class->wavefronts_free,wavefront,wavefront_t*);
   } else {
     // Delete wavefront
     wavefront->status = wavefront_status_deallocated;
@@ -286,6 +292,31 @@ uint64_t wavefront_slab_get_size(
     wavefront_slab_t* const wavefront_slab) {
   return wavefront_slab->memory_used;
 }
-
-
-
+uint64_t wavefront_slab_get_num_allocations(
+    wavefront_slab_t* const wavefront_slab) {
+  return wavefront_slab->num_allocations;
+}
+/*
+ * Display
+ */
+void wavefront_slab_print(
+    FILE* const stream,
+    wavefront_slab_t* const wavefront_slab) {
+  fprintf(stream,"[WFA::Slab] Mode=%s Memory=%" PRIu64 " MB Wavefronts=%" PRIu64 " (allocated=%" PRIu64 ")\n",
+      (wavefront_slab->slab_mode==wf_slab_reuse) ? "reuse" : "tight",
+      CONVERT_B_TO_MB(wavefront_slab->memory_used),
+      (uint64_t)vector_get_used(wavefront_slab->wavefronts),
+      wavefront_slab->num_allocations);
+  int i;
+  for (i=0;i<WF_SLAB_NUM_CLASSES;++i) {
+    wf_slab_class_t* const slab_class = wavefront_slab->classes + i;
+    const uint64_t num_requests = slab_class->num_allocated + slab_class->num_reused;
+    if (num_requests == 0 && slab_class->num_wavefronts == 0) continue;
+    fprintf(stream,"  => Class[%02d] WF-length=%d\tWavefronts=%" PRIu64 " (free=%" PRIu64 ")"
+        "\tRequests=%" PRIu64 " (allocated=%" PRIu64 ",reused=%2.1f%%)\n",
+        i,slab_class->wf_length,slab_class->num_wavefronts,
+        (uint64_t)vector_get_used(slab_class->wavefronts_free),
+        num_requests,slab_class->num_allocated,
+        PERCENTAGE(slab_class->num_reused,num_requests));
+  }
+}
@@ -40,21 +40,32 @@
 /*
  * Memory Manager for Wavefront
  */
+#define WF_SLAB_NUM_CLASSES 22 // Power-of-two size-classes (init_wf_length<<class)
 typedef enum {
   wf_slab_reuse = 1, // Keep all wavefronts (Reap only by demand)
   wf_slab_tight = 2, // Reap all if wavefronts are resized
 } wf_slab_mode_t;
+typedef struct {
+  // Wavefronts
+  int wf_length;                   // Wf-elements allocated by each wavefront of the class
+  vector_t* wavefronts_free;       // Free wavefronts (wavefront_t*)
+  // Stats
+  uint64_t num_wavefronts;         // Wavefronts currently allocated in the class
+  uint64_t num_allocated;          // Total requests served allocating a new wavefront
+  uint64_t num_reused;             // Total requests served reusing a free wavefront
+} wf_slab_class_t;
 typedef struct {
   // Attributes
   bool allocate_backtrace;         // WFs require BT-vector
+  bool pcigar_64bits;              // BT-vectors store 64-bit pCIGARs (otherwise 32-bit)
   wf_slab_mode_t slab_mode;        // Slab strategy
   // Wavefront Slabs
-  int init_wf_length;              // Initial wf-elements allocated
-  int current_wf_length;           // Current wf-elements allocated
+  int init_wf_length;              // Initial wf-elements allocated (length of the smallest class)
   vector_t* wavefronts;            // All wavefronts (wavefront_t*)
-  vector_t* wavefronts_free;       // Free wavefronts (wavefront_t*)
+  wf_slab_class_t classes[WF_SLAB_NUM_CLASSES]; // Size-classes
   // Stats
   uint64_t memory_used;            // Memory used (Bytes)
+  uint64_t num_allocations;        // Wavefronts allocated anew (i.e., not reused from the slab)
   // MM
   mm_allocator_t* mm_allocator;    // MM-Allocator
 } wavefront_slab_t;
@@ -80,14 +91,17 @@ void wavefront_slab_delete(
 void wavefront_slab_set_mode(
     wavefront_slab_t* const wavefront_slab,
     const wf_slab_mode_t slab_mode);
+void wavefront_slab_set_pcigar(
+    wavefront_slab_t* const wavefront_slab,
+    const bool pcigar_64bits);
 
 /*
  * Allocator
  */
 wavefront_t* wavefront_slab_allocate(
     wavefront_slab_t* const wavefront_slab,
-    const int min_lo,
-    const int max_hi);
+    const wf_coord_t min_lo,
+    const wf_coord_t max_hi);
 void wavefront_slab_free(
     wavefront_slab_t* const wavefront_slab,
     wavefront_t* const wavefront);
@@ -97,6 +111,15 @@ void wavefront_slab_free(
  */
 uint64_t wavefront_slab_get_size(
     wavefront_slab_t* const wavefront_slab);
+uint64_t wavefront_slab_get_num_allocations(
+    wavefront_slab_t* const wavefront_slab);
+
+/*
+ * Display
+ */
+void wavefront_slab_print(
+    FILE* const stream,
+    wavefront_slab_t* const wavefront_slab);
 
 #endif /* WAVEFRONT_SLAB_H_ */
 
@@ -50,6 +50,8 @@
  * Configuration
  */
 #define SEQUENCES_PADDING     10
+#define PCIGAR_AUTO_RATE_HI   0.06f  // Switch to 64-bit packed-CIGARs above this divergence
+#define PCIGAR_AUTO_RATE_LO   0.03f  // Switch back to 32-bit packed-CIGARs below this divergence
 
 /*
  * Setup
@@ -77,31 +79,111 @@ void wavefront_unialigner_system_clear(
   // Profile
   timer_reset(&wf_aligner->system.timer);
 }
+/*
+ * Packed-CIGAR width
+ */
+void wavefront_unialign_set_pcigar(
+    wavefront_aligner_t* const wf_aligner,
+    const bool pcigar_64bits) {
+  // BT-buffer, null/victim wavefronts and slab (switching drops their BT-vectors)
+  wavefront_components_resize_pcigar(&wf_aligner->wf_components,pcigar_64bits);
+  wavefront_slab_set_pcigar(wf_aligner->wavefront_slab,pcigar_64bits);
+}
+void wavefront_unialign_pcigar_width(
+    wavefront_aligner_t* const wf_aligner) {
+  // Check piggyback
+  wf_backtrace_buffer_t* const bt_buffer = wf_aligner->wf_components.bt_buffer;
+  if (bt_buffer == NULL) return;
+  // Select width
+  switch (wf_aligner->pcigar_width) {
+    case wavefront_pcigar_32bits:
+      wavefront_unialign_set_pcigar(wf_aligner,false);
+      break;
+    case wavefront_pcigar_64bits:
+      wavefront_unialign_set_pcigar(wf_aligner,true);
+      break;
+    case wavefront_pcigar_auto: {
+      // Estimate divergence from the previous alignment (still in the aligner)
+      const int prev_length = MAX(wf_aligner->pattern_length,wf_aligner->text_length);
+      const int prev_score = wf_aligner->align_status.score;
+      if (wf_aligner->align_status.status != WF_STATUS_SUCCESSFUL) return;
+      if (prev_length <= 0 || prev_score <= 0) return;
+      const int unit = MAX(wf_aligner->penalties.mismatch,1);
+      const float error_rate = (float)prev_score / (float)(unit*prev_length);
+      // Smooth the estimate and switch with hysteresis (switching resets the BT-buffer)
+      wf_aligner->pcigar_error_rate = 0.75f*wf_aligner->pcigar_error_rate + 0.25f*error_rate;
+      if (!bt_buffer->pcigar_64bits && wf_aligner->pcigar_error_rate > PCIGAR_AUTO_RATE_HI) {
+        wavefront_unialign_set_pcigar(wf_aligner,true);
+      } else if (bt_buffer->pcigar_64bits && wf_aligner->pcigar_error_rate < PCIGAR_AUTO_RATE_LO) {
+        wavefront_unialign_set_pcigar(wf_aligner,false);
+      }
+      break;
+    }
+  }
+}
+/*
+ * Sequence views (sentinels)
+ */
+void wavefront_unialign_sequences_eos_set(
+    wavefront_aligner_t* const wf_aligner) {
+  // Locate sentinels (just past the last character read)
+  char* const pattern_eos = (wf_aligner->sequences_reverse) ?
+      wf_aligner->pattern - 1 : wf_aligner->pattern + wf_aligner->pattern_length;
+  char* const text_eos = (wf_aligner->sequences_reverse) ?
+      wf_aligner->text - 1 : wf_aligner->text + wf_aligner->text_length;
+  // Save overwritten characters and set sentinels
+  wf_aligner->pattern_eos = *pattern_eos;
+  wf_aligner->text_eos = *text_eos;
+  *pattern_eos = '?';
+  *text_eos = '!';
+  wf_aligner->sequences_eos = true;
+}
+void wavefront_unialign_sequences_eos_restore(
+    wavefront_aligner_t* const wf_aligner) {
+  if (!wf_aligner->sequences_eos) return;
+  // Restore overwritten characters
+  if (wf_aligner->sequences_reverse) {
+    wf_aligner->pattern[-1] = wf_aligner->pattern_eos;
+    wf_aligner->text[-1] = wf_aligner->text_eos;
+  } else {
+    wf_aligner->pattern[wf_aligner->pattern_length] = wf_aligner->pattern_eos;
+    wf_aligner->text[wf_aligner->text_length] = wf_aligner->text_eos;
+  }
+  wf_aligner->sequences_eos = false;
+}
 /*
  * Resize
  */
 void wavefront_unialign_resize(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const bool reverse_sequences) {
+  // Packed-CIGAR width (before the previous alignment is overwritten)
+  wavefront_unialign_pcigar_width(wf_aligner);
   // Configure sequences and status
   wf_aligner->pattern_length = pattern_length;
   wf_aligner->text_length = text_length;
-  if (wf_aligner->match_funct == NULL) {
-    if (wf_aligner->sequences != NULL) strings_padded_delete(wf_aligner->sequences);
-    wf_aligner->sequences = strings_padded_new_rhomb(
+  if (wf_aligner->match_funct != NULL) {
+    wf_aligner->pattern = NULL;
+    wf_aligner->text = NULL;
+    wf_aligner->sequences_reverse = false;
+  } else if (wf_aligner->align_mode == wf_align_regular) {
+    mm_allocator_clear(wf_aligner->mm_arena); // Release the previous alignment (O(1))
+    wf_aligner->sequences = strings_padded_new(
             pattern,pattern_length,text,text_length,
-            SEQUENCES_PADDING,reverse_sequences,
-            wf_aligner->mm_allocator);
+            SEQUENCES_PADDING,false,wf_aligner->mm_arena);
     wf_aligner->pattern = wf_aligner->sequences->pattern_padded;
     wf_aligner->text = wf_aligner->sequences->text_padded;
+    wf_aligner->sequences_reverse = false;
   } else {
-    wf_aligner->sequences = NULL;
-    wf_aligner->pattern = NULL;
-    wf_aligner->text = NULL;
+    // BiWFA sub-aligners work on views of the padded sequences of the top aligner
+    wf_aligner->pattern = (char*)pattern;
+    wf_aligner->text = (char*)text;
+    wf_aligner->sequences_reverse = reverse_sequences;
+    wavefront_unialign_sequences_eos_set(wf_aligner);
   }
   wavefront_unialign_status_clear(&wf_aligner->align_status);
   // Heuristics clear
@@ -115,6 +197,8 @@ void wavefront_unialign_resize(
   }
   // Slab
   wavefront_slab_clear(wf_aligner->wavefront_slab);
+  // Checkpoints
+  if (wf_aligner->checkpoint != NULL) wavefront_checkpoint_clear(wf_aligner->checkpoint);
   // System
   wavefront_unialigner_system_clear(wf_aligner);
 }
@@ -123,8 +207,8 @@ void wavefront_unialign_resize(
  */
 void wavefront_unialign_initialize_wavefront_m(
     wavefront_aligner_t* const wf_aligner,
-    const int pattern_length,
-    const int text_length) {
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length) {
   // Parameters
   wavefront_slab_t* const wavefront_slab = wf_aligner->wavefront_slab;
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
@@ -132,45 +216,46 @@ void wavefront_unialign_initialize_wavefront_m(
   wavefront_penalties_t* const penalties = &wf_aligner->penalties;
   alignment_form_t* const form = &wf_aligner->alignment_form;
   // Consider ends-free
-  const int hi = (penalties->match==0) ? form->text_begin_free : 0;
-  const int lo = (penalties->match==0) ? -form->pattern_begin_free : 0;
+  const wf_coord_t hi = (penalties->match==0) ? form->text_begin_free : 0;
+  const wf_coord_t lo = (penalties->match==0) ? -form->pattern_begin_free : 0;
   // Compute dimensions
-  int effective_lo, effective_hi;
+  wf_coord_t effective_lo, effective_hi;
   wavefront_compute_limits_output(wf_aligner,lo,hi,&effective_lo,&effective_hi);
   // Initialize end2end (wavefront zero)
-  wf_components->mwavefronts[0] = wavefront_slab_allocate(wavefront_slab,effective_lo,effective_hi);
+  wf_components->mwavefronts[0] = wavefront_components_allocate_wavefront(
+      wf_components,wavefront_slab,affine2p_matrix_M,0,effective_lo,effective_hi);
   wf_components->mwavefronts[0]->offsets[0] = 0;
   wf_components->mwavefronts[0]->lo = lo;
   wf_components->mwavefronts[0]->hi = hi;
   // Store initial BT-piggypack element
   if (wf_components->bt_piggyback) {
     const bt_block_idx_t block_idx = wf_backtrace_buffer_init_block(wf_components->bt_buffer,0,0);
-    wf_components->mwavefronts[0]->bt_pcigar[0] = 0;
+    PCIGAR_SET(wf_components->mwavefronts[0]->bt_pcigar,0,0,wf_components->bt_buffer->pcigar_64bits);
     wf_components->mwavefronts[0]->bt_prev[0] = block_idx;
   }
   // Initialize ends-free
   if (form->span == alignment_endsfree && penalties->match == 0) {
     // Text begin-free
-    const int text_begin_free = form->text_begin_free;
-    int h;
+    const wf_coord_t text_begin_free = form->text_begin_free;
+    wf_coord_t h;
     for (h=1;h<=text_begin_free;++h) {
-      const int k = DPMATRIX_DIAGONAL(h,0);
+      const wf_coord_t k = DPMATRIX_DIAGONAL(h,0);
       wf_components->mwavefronts[0]->offsets[k] = DPMATRIX_OFFSET(h,0);
       if (wf_components->bt_piggyback) {
         const bt_block_idx_t block_idx = wf_backtrace_buffer_init_block(wf_components->bt_buffer,0,h);
-        wf_components->mwavefronts[0]->bt_pcigar[k] = 0;
+        PCIGAR_SET(wf_components->mwavefronts[0]->bt_pcigar,k,0,wf_components->bt_buffer->pcigar_64bits);
         wf_components->mwavefronts[0]->bt_prev[k] = block_idx;
       }
     }
     // Pattern begin-free
-    const int pattern_begin_free = form->pattern_begin_free;
-    int v;
+    const wf_coord_t pattern_begin_free = form->pattern_begin_free;
+    wf_coord_t v;
     for (v=1;v<=pattern_begin_free;++v) {
-      const int k = DPMATRIX_DIAGONAL(0,v);
+      const wf_coord_t k = DPMATRIX_DIAGONAL(0,v);
       wf_components->mwavefronts[0]->offsets[k] = DPMATRIX_OFFSET(0,v);
       if (wf_components->bt_piggyback) {
         const bt_block_idx_t block_idx = wf_backtrace_buffer_init_block(wf_components->bt_buffer,v,0);
-        wf_components->mwavefronts[0]->bt_pcigar[k] = 0;
+        PCIGAR_SET(wf_components->mwavefronts[0]->bt_pcigar,k,0,wf_components->bt_buffer->pcigar_64bits);
         wf_components->mwavefronts[0]->bt_prev[k] = block_idx;
       }
     }
@@ -185,8 +270,8 @@ void wavefront_unialign_initialize_wavefront_m(
 }
 void wavefront_unialign_initialize_wavefronts(
     wavefront_aligner_t* const wf_aligner,
-    const int pattern_length,
-    const int text_length) {
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length) {
   // Parameters
   wavefront_slab_t* const wavefront_slab = wf_aligner->wavefront_slab;
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
@@ -204,9 +289,10 @@ void wavefront_unialign_initialize_wavefronts(
     wf_components->d2wavefronts[0] = NULL;
   } else {
     // Compute dimensions
-    int effective_lo, effective_hi; // Effective lo/hi
+    wf_coord_t effective_lo, effective_hi; // Effective lo/hi
     wavefront_compute_limits_output(wf_aligner,0,0,&effective_lo,&effective_hi);
-    wavefront_t* const wavefront = wavefront_slab_allocate(wavefront_slab,effective_lo,effective_hi);
+    wavefront_t* const wavefront = wavefront_components_allocate_wavefront(
+        wf_components,wavefront_slab,wf_aligner->component_begin,0,effective_lo,effective_hi);
     // Initialize
     switch (wf_aligner->component_begin) {
       case affine2p_matrix_I1:
@@ -261,9 +347,9 @@ void wavefront_unialign_initialize_wavefronts(
 void wavefront_unialign_init(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const affine2p_matrix_type component_begin,
     const affine2p_matrix_type component_end) {
   // Parameters
@@ -354,6 +440,16 @@ bool wavefront_unialign_reached_limits(
     wf_aligner->align_status.score = score;
     return true; // Stop
   }
+  // Check process-wide memory (reap idle aligners; abort if the policy is to fail)
+  mm_governor_t* const mm_governor = wf_aligner->mm_governor;
+  if (mm_governor != NULL && mm_governor_exhausted(mm_governor)) {
+    mm_governor_reap(mm_governor);
+    if (mm_governor->policy == mm_governor_fail && mm_governor_exhausted(mm_governor)) {
+      wf_aligner->align_status.status = WF_STATUS_OOM;
+      wf_aligner->align_status.score = score;
+      return true; // Stop
+    }
+  }
   // Otherwise continue
   return false;
 }
@@ -364,8 +460,8 @@ void wavefront_unialign_terminate(
     wavefront_aligner_t* const wf_aligner,
     const int score) {
   // Parameters
-  const int pattern_length = wf_aligner->pattern_length;
-  const int text_length = wf_aligner->text_length;
+  const wf_coord_t pattern_length = wf_aligner->pattern_length;
+  const wf_coord_t text_length = wf_aligner->text_length;
   // Retrieve alignment
   if (wf_aligner->alignment_scope == compute_score) {
     cigar_clear(wf_aligner->cigar);
@@ -374,18 +470,18 @@ void wavefront_unialign_terminate(
   } else {
     // Parameters
     wavefront_components_t* const wf_components = &wf_aligner->wf_components;
-    const int alignment_end_k = wf_aligner->alignment_end_pos.k;
+    const wf_coord_t alignment_end_k = wf_aligner->alignment_end_pos.k;
     const wf_offset_t alignment_end_offset = wf_aligner->alignment_end_pos.offset;
     if (wf_components->bt_piggyback) {
       // Fetch wavefront
       const bool memory_modular = wf_aligner->wf_components.memory_modular;
-      const int max_score_scope = wf_aligner->wf_components.max_score_scope;
-      const int score_mod = (memory_modular) ? score % max_score_scope : score;
+      const int wavefront_mask = wf_aligner->wf_components.wavefront_mask;
+      const int score_mod = (memory_modular) ? score & wavefront_mask : score;
       wavefront_t* const mwavefront = wf_components->mwavefronts[score_mod];
       // Backtrace alignment from buffer (unpacking pcigar)
       wavefront_backtrace_pcigar(
           wf_aligner,alignment_end_k,alignment_end_offset,
-          mwavefront->bt_pcigar[alignment_end_k],
+          PCIGAR_GET(mwavefront->bt_pcigar,alignment_end_k,mwavefront->bt_pcigar_64bits),
           mwavefront->bt_prev[alignment_end_k]);
     } else {
       // Backtrace alignment
@@ -428,6 +524,8 @@ int wavefront_unialign(
       }
       return align_status->status;
     }
+    // Checkpoint (release the wavefronts not needed anymore)
+    if (wf_aligner->checkpoint != NULL) wavefront_checkpoint_forward(wf_aligner,score);
     // Compute (s+1)-wavefront
     ++score;
     (*wf_align_compute)(wf_aligner,score);
@@ -453,18 +551,18 @@ void wavefront_unialign_print_status(
   // Parameters
   wavefront_components_t* const wf_components = &wf_aligner->wf_components;
   // Approximate progress
-  const int dist_total = MAX(wf_aligner->text_length,wf_aligner->pattern_length);
-  int s = (wf_components->memory_modular) ? score%wf_components->max_score_scope : score;
+  const wf_coord_t dist_total = MAX(wf_aligner->text_length,wf_aligner->pattern_length);
+  int s = (wf_components->memory_modular) ? score&wf_components->wavefront_mask : score;
   wavefront_t* wavefront = wf_components->mwavefronts[s];
   if (wavefront==NULL && s>0) {
-    s = (wf_components->memory_modular) ? (score-1)%wf_components->max_score_scope : (score-1);
+    s = (wf_components->memory_modular) ? (score-1)&wf_components->wavefront_mask : (score-1);
     wavefront = wf_components->mwavefronts[s];
   }
-  int dist_max = -1, wf_len = -1, k;
+  wf_coord_t dist_max = -1, wf_len = -1, k;
   if (wavefront!=NULL) {
     wf_offset_t* const offsets = wavefront->offsets;
     for (k=wavefront->lo;k<=wavefront->hi;++k) {
-      const int dist = MAX(WAVEFRONT_V(k,offsets[k]),WAVEFRONT_H(k,offsets[k]));
+      const wf_coord_t dist = MAX(WAVEFRONT_V(k,offsets[k]),WAVEFRONT_H(k,offsets[k]));
       dist_max = MAX(dist_max,dist);
     }
     wf_len = wavefront->hi-wavefront->lo+1;
@@ -480,7 +578,7 @@ void wavefront_unialign_print_status(
   fprintf(stream,"[");
   wavefront_aligner_print_type(stream,wf_aligner);
   fprintf(stream,
-      "] SequenceLength=(%d,%d) Score %d (~ %2.3f%% aligned). "
+      "] SequenceLength=(%"PRIcoord",%"PRIcoord") Score %d (~ %2.3f%% aligned). "
       "MemoryUsed(WF-Slab,BT-buffer)=(%lu MB,%lu MB). "
       "Wavefronts ~ %2.3f Moffsets\n",
       wf_aligner->pattern_length,wf_aligner->text_length,score,aligned_progress,
@@ -34,15 +34,23 @@
 #include "utils/commons.h"
 #include "wavefront_aligner.h"
 
+/*
+ * Sequence views (sentinels)
+ */
+void wavefront_unialign_sequences_eos_set(
+    wavefront_aligner_t* const wf_aligner);
+void wavefront_unialign_sequences_eos_restore(
+    wavefront_aligner_t* const wf_aligner);
+
 /*
  * Resize
  */
 void wavefront_unialign_resize(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const bool reverse_sequences);
 
 /*
@@ -50,14 +58,14 @@ void wavefront_unialign_resize(
  */
 void wavefront_unialign_initialize_wavefronts(
     wavefront_aligner_t* const wf_aligner,
-    const int pattern_length,
-    const int text_length);
+    const wf_coord_t pattern_length,
+    const wf_coord_t text_length);
 void wavefront_unialign_init(
     wavefront_aligner_t* const wf_aligner,
     const char* const pattern,
-    const int pattern_length,
+    const wf_coord_t pattern_length,
     const char* const text,
-    const int text_length,
+    const wf_coord_t text_length,
     const affine2p_matrix_type component_begin,
     const affine2p_matrix_type component_end);
 